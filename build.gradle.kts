@@ -17,7 +17,7 @@ tasks.withType<CppCompile>().configureEach {
         val toolchain = toolChain.get()
         when {
             toolchain.name.contains("gcc") || toolchain.name.contains("clang") -> 
-                listOf("-Wall", "-Wextra", "-std=c++11", "-g", "-DMEMTRACE")
+                listOf("-Wall", "-Wextra", "-std=c++11", "-g", "-pthread", "-DMEMTRACE")
             toolchain.name.contains("visualCpp") -> 
                 listOf("/W3", "/Zi", "/EHsc", "/DMEMTRACE", "/GR")
             else -> emptyList()
@@ -36,7 +36,7 @@ tasks.withType<LinkExecutable>().configureEach {
                 "ucrt.lib", "vcruntime.lib", "msvcrt.lib"
             )
         } else {
-            emptyList()
+            listOf("-pthread")
         }
     })
 }
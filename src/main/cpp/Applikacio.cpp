@@ -3,11 +3,18 @@
  *  Ez a fajl amely bemutatja a rendszer alapveto mukodeset es fo funkcioit.
  */
 
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
 #include <sstream>
 
 #include "Applikacio.h"
 #include "MainSegedFuggvenyek.h"
+#include "Naplo.h"
+#include "ParancsVegrehajto.h"
 #include "SzervizNyilvantartoRendszer.h"
+#include "Szerver.h"
 #include "Teszt.h"
 
 bool Applikacio::applikacio() {
@@ -87,4 +94,110 @@ bool Applikacio::applikacio() {
         }
     } while (valasztottMenu != 10);
 	return false;
+}
+
+#ifdef __linux__
+/// A jelkezelo altal leallitando szerver.
+static Szerver* futoSzerver = nullptr;
+
+/// SIGINT es SIGTERM kezelo: a szerver leallitasa (async-signal-safe).
+static void leallitoJelkezelo(int) {
+    if (futoSzerver != nullptr) futoSzerver->leallit();
+}
+#endif
+
+bool Applikacio::szerver(const std::string& cim, const std::string& naploFajl) {
+#ifdef __linux__
+    SzervizNyilvantartoRendszer autoszervizAdatbazis;
+    if (!tesztDBLetrehozas(autoszervizAdatbazis)) return false;
+
+    try {
+        std::unique_ptr<Naplo> naplo;
+        if (!naploFajl.empty()) {
+            ParancsVegrehajto visszajatszo(autoszervizAdatbazis);
+            std::cout << "Naplo visszajatszva: " << Naplo::visszajatszas(naploFajl, visszajatszo) << " parancs" << std::endl;
+            naplo.reset(new Naplo(naploFajl, "init_ugyfel_ufl.txt", "init_auto_auo.txt"));
+        }
+        Szerver szerver(autoszervizAdatbazis, naplo.get());
+        szerver.figyel(cim);
+        if (szerver.getPort() != 0)
+            std::cout << "Szerver fut: TCP port " << szerver.getPort() << std::endl;
+        else
+            std::cout << "Szerver fut: " << cim << std::endl;
+
+        futoSzerver = &szerver;
+        std::signal(SIGINT, leallitoJelkezelo);
+        std::signal(SIGTERM, leallitoJelkezelo);
+        szerver.futtat();
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        futoSzerver = nullptr;
+    }
+    catch (const std::exception& e) {
+        futoSzerver = nullptr;
+        std::cerr << "Szerver hiba: " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "Szerver leallt." << std::endl;
+    return true;
+#else
+    (void)naploFajl;
+    std::cerr << "A szerver mod csak Linuxon erheto el (" << cim << ")." << std::endl;
+    return false;
+#endif
+}
+
+bool Applikacio::koteg(const std::string& forras) {
+    static const size_t OLVASAS = 1 << 20;     // egyszerre beolvasott bajtok
+    static const size_t KIIRAS = 1 << 20;      // ennyi osszegyult valasz utan irunk a kimenetre
+
+    // Csak nagy blokkokban olvasunk es irunk, igy a szinkronizalt std::cin/std::cout is egy-egy
+    // fread/fwrite hivasra fordul (a sync_with_stdio(false) nem szabadithato puffereket foglalna)
+    std::ifstream fajl;
+    if (forras != "-") {
+        fajl.open(forras.c_str(), std::ios::in | std::ios::binary);
+        if (!fajl) {
+            std::cerr << "Nem sikerult megnyitni a parancsfajlt: " << forras << std::endl;
+            return false;
+        }
+    }
+    std::istream& be = forras == "-" ? std::cin : fajl;
+
+    SzervizNyilvantartoRendszer autoszervizAdatbazis;
+    ParancsVegrehajto vegrehajto(autoszervizAdatbazis);
+    std::string adat, ki;
+    bool vege = false;
+    try {
+        while (!vege) {
+            const size_t eddig = adat.size();
+            adat.resize(eddig + OLVASAS);
+            be.read(&adat[eddig], static_cast<std::streamsize>(OLVASAS));
+            adat.resize(eddig + static_cast<size_t>(be.gcount()));
+            vege = !be;
+            // Az utolso, sorvege nelkuli parancs is lefut
+            if (vege && !adat.empty() && adat[adat.size() - 1] != '\n') adat += '\n';
+
+            size_t poz = 0;
+            for (;;) {
+                const size_t n = vegrehajto.feldolgoz(adat.data() + poz, adat.size() - poz, ki, KIIRAS);
+                poz += n;
+                if (ki.size() > KIIRAS || (n == 0 && !ki.empty())) {
+                    std::cout.write(ki.data(), static_cast<std::streamsize>(ki.size()));
+                    ki.clear();
+                }
+                if (n == 0) break;
+            }
+            adat.erase(0, poz);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cout.write(ki.data(), static_cast<std::streamsize>(ki.size()));
+        std::cout.flush();
+        std::cerr << "Koteg hiba: " << e.what() << std::endl;
+        return false;
+    }
+    const bool befejezetlen = !adat.empty();
+    if (befejezetlen) std::cout << "ERR Befejezetlen koteg\n";
+    std::cout.flush();
+    return !befejezetlen && vegrehajto.getHibak() == 0 && std::cout.good();
 }
\ No newline at end of file
@@ -7,12 +7,16 @@
 #include "Memtrace.h"
 #endif
 #include <string>
+#include <cmath>
 
 #include "Auto.h"
 #include "Datum.h"
 #include "Ugyfel.h"
 #include "Vector.hpp"
 #include "VegzettMuvelet.h"
+#include "SzervizRekord.h"
+#include "SzervizTortenet.h"
+#include "KmRegresszio.h"
 
 /*-------------------------------------------
         Konstruktorok es destruktor
@@ -37,16 +41,38 @@ Auto::Auto(const std::string& r, const std::string& m, const std::string& t, int
 /// @param v - Az autohoz tartozo szervizmuveletek listaja  
 /// @param u - Az auto tulajdonosa  
 Auto::Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const Vector<VegzettMuvelet*>& v, Ugyfel* u) : rendszam(r), marka(m), tipus(t), kmOra(k), uzembeHelyezes(d), tulajdonos(u) {
+    if (v.empty()) return;
+
+    SzervizRekordLista& rekordok = vegzettSzervizMuveletek.modosit();
+    rekordok.reserve(v.size());
     for (size_t i = 0; i < v.size(); i++)
-        vegzettSzervizMuveletek.push_back(v.at(i)->clone());
+        rekordok.push_back(v.at(i)->toRekord());
+    vegzettSzervizMuveletek.kmRegresszio(); // a regresszio most szamolodik, nem az elso (esetleg parhuzamos) olvasaskor
 }
 
-/// Masolo konstruktor.
+/// Parameteres konstruktor szervizrekordokkal.  
+/// @param r - Az auto rendszama  
+/// @param m - Az auto markaja  
+/// @param t - Az auto tipusa  
+/// @param k - A kilometerora allasa  
+/// @param d - Az uzembe helyezes datuma  
+/// @param v - Az autohoz tartozo szervizrekordok listaja  
+/// @param u - Az auto tulajdonosa  
+Auto::Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const SzervizRekordLista& v, Ugyfel* u) : rendszam(r), marka(m), tipus(t), kmOra(k), uzembeHelyezes(d), vegzettSzervizMuveletek(v), tulajdonos(u) {}
+
+/// Parameteres konstruktor megosztott szerviztortenettel (a tortenet nem masolodik).  
+/// @param r - Az auto rendszama  
+/// @param m - Az auto markaja  
+/// @param t - Az auto tipusa  
+/// @param k - A kilometerora allasa  
+/// @param d - Az uzembe helyezes datuma  
+/// @param v - Az autohoz tartozo szerviztortenet  
+/// @param u - Az auto tulajdonosa  
+Auto::Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const SzervizTortenet& v, Ugyfel* u) : rendszam(r), marka(m), tipus(t), kmOra(k), uzembeHelyezes(d), vegzettSzervizMuveletek(v), tulajdonos(u) {}
+
+/// Masolo konstruktor. A szerviztortenet megosztva marad, igy a masolas O(1).
 /// @param a - masolando Auto objektum
-Auto::Auto(const Auto& a) : rendszam(a.rendszam), marka(a.marka), tipus(a.tipus), kmOra(a.kmOra), uzembeHelyezes(a.uzembeHelyezes), tulajdonos(a.tulajdonos) {
-    for (size_t i = 0; i < a.vegzettSzervizMuveletek.size(); i++)
-        vegzettSzervizMuveletek.push_back(a.vegzettSzervizMuveletek[i]->clone());
-}
+Auto::Auto(const Auto& a) : rendszam(a.rendszam), marka(a.marka), tipus(a.tipus), kmOra(a.kmOra), uzembeHelyezes(a.uzembeHelyezes), vegzettSzervizMuveletek(a.vegzettSzervizMuveletek), tulajdonos(a.tulajdonos) {}
 
 /// Destruktor
 Auto::~Auto() { 
@@ -69,11 +95,7 @@ Auto& Auto::operator=(const Auto& a) {
         kmOra = a.kmOra;
         uzembeHelyezes = a.uzembeHelyezes;
         tulajdonos = a.tulajdonos;
-
-        vegzettSzervizMuveletek.clear();
-
-        for (size_t i = 0; i < a.vegzettSzervizMuveletek.size(); i++)
-            vegzettSzervizMuveletek.push_back(a.vegzettSzervizMuveletek[i]->clone());
+        vegzettSzervizMuveletek = a.vegzettSzervizMuveletek;
     }
     return *this;
 }
@@ -128,16 +150,53 @@ const Datum& Auto::getUzembeHelyezes() const {
     return uzembeHelyezes;
 }
 
-/// Visszaadja az autohoz tartozo szervizmuveletek listajat.
-/// @return - Szervizmuveletek vektora.
-Vector<VegzettMuvelet*>& Auto::getSzervizMuveletek() {
+/// Visszaadja az autohoz tartozo szervizrekordok listajat.
+/// @return - Szervizrekordok vektora (idorendben).
+const SzervizRekordLista& Auto::getSzervizRekordok() const {
+    return vegzettSzervizMuveletek.lista();
+}
+
+/// Visszaadja az autohoz tartozo szerviztortenet leirojat (masolasa O(1)).
+/// @return - A szerviztortenet.
+const SzervizTortenet& Auto::getSzervizTortenet() const {
     return vegzettSzervizMuveletek;
 }
 
-/// Visszaadja az autohoz tartozo szervizmuveletek listajat (const valtozat).
+/// Visszaadja a szervizrekordok (datum, km) pontjaira illesztett regresszio futo osszegeit.
+/// @return - A regresszio (O(1), novekmenyesen karbantartva).
+const KmRegresszio& Auto::getKmRegresszio() const {
+    return vegzettSzervizMuveletek.kmRegresszio();
+}
+
+/// Becsult napi futasteljesitmeny a szerviztortenet alapjan.
+/// @return - km/nap, vagy 0, ha nincs legalabb ket kulonbozo napon rogzitett muvelet.
+double Auto::becsultNapiKm() const {
+    return vegzettSzervizMuveletek.kmRegresszio().napiKm();
+}
+
+/// Megbecsuli, mikor eri el az auto a megadott km ora allast (O(1)).
+/// A becsles az utolso szervizrekordbol indul ki, a regresszio meredeksegevel.
+/// @param km - A cel km ora allas
+/// @param ki - A becsult datum (csak sikeres becslesnel irodik)
+/// @return - true, ha van ervenyes, pozitiv napi km becsles
+bool Auto::becsultDatumKmOraig(int km, Datum& ki) const {
+    double napiKm = becsultNapiKm();
+    if (napiKm <= 0.0) return false;
+    const SzervizRekord& utolso = vegzettSzervizMuveletek[vegzettSzervizMuveletek.size() - 1];
+    int32_t nap = utolso.idopont.getNapSorszam();
+    if (km > utolso.akt_kmOra)
+        nap += static_cast<int32_t>(std::ceil((km - utolso.akt_kmOra) / napiKm));
+    ki = Datum::fromNapSorszam(nap);
+    return true;
+}
+
+/// Visszaadja az autohoz tartozo szervizmuveletek listajat polimorf objektumokkent (kompatibilitasi felulet).
 /// @return - Szervizmuveletek vektora.
-const Vector<VegzettMuvelet*>& Auto::getSzervizMuveletek() const {
-    return vegzettSzervizMuveletek;
+Vector<VegzettMuvelet*> Auto::getSzervizMuveletek() const {
+    Vector<VegzettMuvelet*> v;
+    for (size_t i = 0; i < vegzettSzervizMuveletek.size(); i++)
+        v.push_back(vegzettSzervizMuveletek[i].toVegzettMuvelet());
+    return v;
 }
 
 // Visszaadja az auto tulajdonosat.
@@ -187,17 +246,23 @@ Auto* Auto::clone() const {
 }
 
 /// Hozzaad egy szervizmuveletet az auto szervizlistajahoz.
+/// @param m - A hozzaadando szervizrekord
+void Auto::addVegzettSzerviz(const SzervizRekord& m) {
+    vegzettSzervizMuveletek.push_back(m);
+}
+
+/// Hozzaad egy szervizmuveletet az auto szervizlistajahoz (kompatibilitasi felulet).
 /// @param m - A hozzadando szervizmuvelet pointere
 void Auto::addVegzettSzerviz(VegzettMuvelet* m) {
-    vegzettSzervizMuveletek.push_back(m);
+    vegzettSzervizMuveletek.push_back(m->toRekord());
+    delete m;
 }
 
 /// Torli a megadott indexu szervizmuveletet a listabol.
 /// @param idx - A torlendo muvelet pozicioja
 void Auto::torolVegzettSzerviz(size_t idx) {
     if (idx < vegzettSzervizMuveletek.size()) {
-        delete vegzettSzervizMuveletek[idx];
-        vegzettSzervizMuveletek.erase(vegzettSzervizMuveletek.begin() + idx);
+        vegzettSzervizMuveletek.erase(idx);
     }
 }
 
@@ -216,10 +281,10 @@ void Auto::kiir(std::ostream& os) const {
         << "\tSzervizmuveletek:" << (vegzettSzervizMuveletek.size() == 0 ? " nincs" : "") << "\n";
 
     for (size_t i = 0; i < vegzettSzervizMuveletek.size(); i++) {
-        vegzettSzervizMuveletek.at(i)->kiir(os);
+        vegzettSzervizMuveletek[i].kiir(os);
     }
 
-    os << std::endl;
+    os << '\n';
 }
 
 
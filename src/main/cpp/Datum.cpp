@@ -3,24 +3,70 @@
 *   A datum osztaly tagfuggvenyeinek megvalositasa.
 */
 
+#include <stdexcept>
+
 #include "Datum.h"
 
+const size_t Datum::SZOVEG_HOSSZ;
+const size_t Datum::MAX_SZOVEG_HOSSZ;
+
+/*-------------------------------------------
+          Naptari atszamitasok
+-------------------------------------------*/
+/// Ev/honap/nap harmasbol napsorszamot szamol.
+/// A szamitas 400 eves ciklusokra (era) bont, igy minden evre pontos, ciklus nelkul.
+/// Letezo naptari napot var (lasd ervenyes()); a honapot nem normalizalja.
+/// @param e - ev
+/// @param h - honap
+/// @param n - nap
+/// @return - A napsorszam
+int32_t Datum::sorszamFromDatum(int e, int h, int n) {
+    // Az evet marciustol szamoljuk, igy a szokonap mindig az ev vegere esik
+    e -= h <= 2;
+    const int era = (e >= 0 ? e : e - 399) / 400;
+    const int eraEv = e - era * 400;                                  // [0, 399]
+    const int evNapja = (153 * (h + (h > 2 ? -3 : 9)) + 2) / 5 + n - 1; // [0, 365]
+    const int eraNapja = eraEv * 365 + eraEv / 4 - eraEv / 100 + evNapja; // [0, 146096]
+    return static_cast<int32_t>(era * 146097 + eraNapja - 719468);
+}
+
+/// Napsorszambol ev/honap/nap harmast allit elo.
+/// @param s - napsorszam
+/// @param e - kimeneti ev
+/// @param h - kimeneti honap
+/// @param n - kimeneti nap
+void Datum::datumFromSorszam(int32_t s, int& e, int& h, int& n) {
+    const int z = s + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int eraNapja = z - era * 146097;                                                      // [0, 146096]
+    const int eraEv = (eraNapja - eraNapja / 1460 + eraNapja / 36524 - eraNapja / 146096) / 365;  // [0, 399]
+    const int evNapja = eraNapja - (365 * eraEv + eraEv / 4 - eraEv / 100);                     // [0, 365]
+    const int mp = (5 * evNapja + 2) / 153;                                                     // [0, 11], marciustol
+    n = evNapja - (153 * mp + 2) / 5 + 1;
+    h = mp < 10 ? mp + 3 : mp - 9;
+    e = eraEv + era * 400 + (h <= 2);
+}
+
+
+
 /*-------------------------------------------
         Konstruktorok es destruktor
 -------------------------------------------*/
 /// Alapertelmezett konstruktor
-/// 0-ra inicializalja az evet, honapot es napot.
-Datum::Datum() : ev(0), ho(0), nap(0) {}
+/// A napsorszam nullpontjara (1970.01.01) inicializal.
+Datum::Datum() : napSorszam(0) {}
 
 /// Parameteres konstruktor
 /// @param e - ev
 /// @param h - honap
 /// @param n - nap
-Datum::Datum(int e, int h, int n) : ev(e), ho(h), nap(n) {}
+Datum::Datum(int e, int h, int n) : napSorszam(0) {
+    setDatum(e, h, n);
+}
 
 /// Masolo konstruktor
 /// @param d - masolando Datum objektum
-Datum::Datum(const Datum& d) : ev(d.ev), ho(d.ho), nap(d.nap) {}
+Datum::Datum(const Datum& d) : napSorszam(d.napSorszam) {}
 
 /// Destruktor
 Datum::~Datum() {}
@@ -35,9 +81,7 @@ Datum::~Datum() {}
 /// @return - az aktualis objektum referenciaja
 Datum& Datum::operator=(const Datum& d) {
     if (this != &d) {
-        ev = d.ev;
-        ho = d.ho;
-        nap = d.nap;
+        napSorszam = d.napSorszam;
     }
     return *this;
 }
@@ -46,7 +90,42 @@ Datum& Datum::operator=(const Datum& d) {
 /// @param d - osszehasonlitando Datum objektum
 /// @return - true, ha az objektumok megegyeznek, kulonben false.
 bool Datum::operator==(const Datum& d) const {
-    return ev == d.ev && ho == d.ho && nap == d.nap;
+    return napSorszam == d.napSorszam;
+}
+
+/// Nem egyenlo operator
+/// @param d - osszehasonlitando Datum objektum
+/// @return - true, ha a ket datum kulonbozik.
+bool Datum::operator!=(const Datum& d) const {
+    return napSorszam != d.napSorszam;
+}
+
+/// Kisebb operator (korabbi datum)
+/// @param d - osszehasonlitando Datum objektum
+/// @return - true, ha az aktualis datum korabbi.
+bool Datum::operator<(const Datum& d) const {
+    return napSorszam < d.napSorszam;
+}
+
+/// Kisebb-egyenlo operator
+/// @param d - osszehasonlitando Datum objektum
+/// @return - true, ha az aktualis datum nem kesobbi.
+bool Datum::operator<=(const Datum& d) const {
+    return napSorszam <= d.napSorszam;
+}
+
+/// Nagyobb operator (kesobbi datum)
+/// @param d - osszehasonlitando Datum objektum
+/// @return - true, ha az aktualis datum kesobbi.
+bool Datum::operator>(const Datum& d) const {
+    return napSorszam > d.napSorszam;
+}
+
+/// Nagyobb-egyenlo operator
+/// @param d - osszehasonlitando Datum objektum
+/// @return - true, ha az aktualis datum nem korabbi.
+bool Datum::operator>=(const Datum& d) const {
+    return napSorszam >= d.napSorszam;
 }
 
 
@@ -56,23 +135,39 @@ bool Datum::operator==(const Datum& d) const {
 -------------------------------------------*/
 /// ev lekerdezese
 /// @return - ev
-int Datum::getEv() const { return ev; }
+int Datum::getEv() const {
+    int e, h, n;
+    datumFromSorszam(napSorszam, e, h, n);
+    return e;
+}
 
 /// Honap lekerdezese
 /// @return - honap
-int Datum::getHo() const { return ho; }
+int Datum::getHo() const {
+    int e, h, n;
+    datumFromSorszam(napSorszam, e, h, n);
+    return h;
+}
 
 /// Nap lekerdezese
 /// @return - nap
-int Datum::getNap() const { return nap; }
+int Datum::getNap() const {
+    int e, h, n;
+    datumFromSorszam(napSorszam, e, h, n);
+    return n;
+}
 
-/// Datum eltelt napok szamanak lekerdezese
+/// Datum eltelt napok szamanak lekerdezese (pontos, szokoevekkel szamolva)
 /// @param d - masik Datum objektum
+/// @return - d es az aktualis datum kozott eltelt napok (negativ, ha d a korabbi)
 int Datum::elteltNap(const Datum& d) const {
-    int e = d.getEv() - ev;
-    int h = d.getHo() - ho;
-    int n = d.getNap() - nap;
-    return e * 365 + h * 30 + n;
+    return d.napSorszam - napSorszam;
+}
+
+/// A nyers napsorszam lekerdezese (1970.01.01 = 0).
+/// @return - napsorszam
+int32_t Datum::getNapSorszam() const {
+    return napSorszam;
 }
 
 
@@ -85,9 +180,9 @@ int Datum::elteltNap(const Datum& d) const {
 /// @param h - honap
 /// @param n - nap
 void Datum::setDatum(int e, int h, int n) {
-    ev = e;
-    ho = h;
-    nap = n;
+    if (!ervenyes(e, h, n))
+        throw std::invalid_argument("Nem letezo datum! (setDatum)");
+    napSorszam = sorszamFromDatum(e, h, n);
 }
 
 
@@ -95,31 +190,145 @@ void Datum::setDatum(int e, int h, int n) {
 /*-------------------------------------------
                Segedfuggvenyek
 -------------------------------------------*/
+/// Letezo naptari nap-e.
+/// @param e - ev
+/// @param h - honap
+/// @param n - nap
+/// @return - true, ha a datum letezik
+bool Datum::ervenyes(int e, int h, int n) {
+    static const int napok[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (h < 1 || h > 12 || n < 1) return false;
+    const bool szokoev = (e % 4 == 0 && e % 100 != 0) || e % 400 == 0;
+    return n <= napok[h - 1] + (h == 2 && szokoev ? 1 : 0);
+}
+
+/// Letrehoz egy Datum objektumot a nyers napsorszambol.
+/// @param s - napsorszam (1970.01.01 = 0)
+/// @return - A letrehozott Datum objektum.
+Datum Datum::fromNapSorszam(int32_t s) {
+    Datum d;
+    d.napSorszam = s;
+    return d;
+}
+
 /// Letrehoz egy Datum objektumot egy stringbol.
 /// A string formatuma: "EEEE.HH.NN".
 /// @param str - A datumot tartalmazo string.
 /// @return - A letrehozott Datum objektum.
 Datum Datum::parseFromString(const std::string& str) {
-    int e, h, n;
-    char dot1, dot2;
-    std::istringstream iss(str);
-
-    if (!(iss >> e >> dot1 >> h >> dot2 >> n) || dot1 != '.' || dot2 != '.')
+    Datum d;
+    if (!parseMezo(str.data(), str.size(), d))
         throw std::runtime_error("Hibas datum formatum! (parseFromString)");
-
-    return Datum(e, h, n);
+    return d;
 }
 
 /// Egy Datum objektumot stringge alakit "EEEE.HH.NN" formatumban.
 /// @return std::string A formazott datum szovegkent.
 const std::string Datum::toString() const {
-    std::ostringstream oss;
+    char buf[MAX_SZOVEG_HOSSZ];
+    return std::string(buf, formatToBuffer(buf));
+}
+
+/// Egy legfeljebb maxJegy szamjegybol allo nemnegativ egeszet olvas.
+/// A fuggveny static kulcsszoval van ellatva, mert csak a jelenlegi forditasi egysegen belul hasznaljuk.
+/// @param p - Az olvasas kezdete.
+/// @param v - A puffer vege.
+/// @param maxJegy - Legfeljebb ennyi szamjegyet olvas.
+/// @param ertek - A beolvasott szam.
+/// @return - Az elso fel nem dolgozott karakter cime, vagy nullptr, ha nem volt szamjegy.
+static const char* szamOlvas(const char* p, const char* v, int maxJegy, int& ertek) {
+    const char* kezdet = p;
+    ertek = 0;
+    while (p < v && p - kezdet < maxJegy && static_cast<unsigned>(*p - '0') < 10u) {
+        ertek = ertek * 10 + (*p - '0');
+        ++p;
+    }
+    return p == kezdet ? nullptr : p;
+}
+
+/// Datum ertelmezese karakterpuffer elejerol, memoriafoglalas nelkul.
+/// @param buf - A datum elso karakterere mutato pointer (nem kell nullaval lezartnak lennie).
+/// @param hossz - A pufferbol legfeljebb ennyi karakter olvashato.
+/// @param ki - Sikeres ertelmezes eseten ide kerul az eredmeny.
+/// @return - Az ertelmezett karakterek szama, vagy 0, ha a puffer eleje nem ervenyes datum (ekkor ki nem valtozik).
+size_t Datum::parseBuffer(const char* buf, size_t hossz, Datum& ki) {
+    const char* p = buf;
+    const char* v = buf + hossz;
+    while (p < v && (*p == ' ' || *p == '\t')) ++p;
+
+    // Gyors ut: pontosan "EEEE.HH.NN", utana nem all tovabbi szamjegy
+    if (v - p >= static_cast<ptrdiff_t>(SZOVEG_HOSSZ) && p[4] == '.' && p[7] == '.'
+        && (v - p == static_cast<ptrdiff_t>(SZOVEG_HOSSZ) || static_cast<unsigned>(p[10] - '0') >= 10u)) {
+        const unsigned e0 = p[0] - '0', e1 = p[1] - '0', e2 = p[2] - '0', e3 = p[3] - '0';
+        const unsigned h0 = p[5] - '0', h1 = p[6] - '0';
+        const unsigned n0 = p[8] - '0', n1 = p[9] - '0';
+        if ((e0 | e1 | e2 | e3 | h0 | h1 | n0 | n1) < 10u) {
+            const int e = static_cast<int>(e0 * 1000 + e1 * 100 + e2 * 10 + e3);
+            const int h = static_cast<int>(h0 * 10 + h1), n = static_cast<int>(n0 * 10 + n1);
+            if (!ervenyes(e, h, n)) return 0;
+            ki.napSorszam = sorszamFromDatum(e, h, n);
+            return static_cast<size_t>(p - buf) + SZOVEG_HOSSZ;
+        }
+    }
+
+    // Altalanos ut: rovidebb (nem nullaval kiegeszitett) mezok
+    int e, h, n;
+    if (!(p = szamOlvas(p, v, 4, e)) || p == v || *p++ != '.') return 0;
+    if (!(p = szamOlvas(p, v, 2, h)) || p == v || *p++ != '.') return 0;
+    if (!(p = szamOlvas(p, v, 2, n))) return 0;
+    if (p < v && static_cast<unsigned>(*p - '0') < 10u) return 0;
+    if (!ervenyes(e, h, n)) return 0;
+
+    ki.napSorszam = sorszamFromDatum(e, h, n);
+    return static_cast<size_t>(p - buf);
+}
+
+/// Egy teljes mezo ertelmezese datumkent: a datum elott es utan csak szokoz vagy tabulator allhat.
+/// @param buf - A mezo elso karakterere mutato pointer (nem kell nullaval lezartnak lennie).
+/// @param hossz - A mezo hossza.
+/// @param ki - Sikeres ertelmezes eseten ide kerul az eredmeny.
+/// @return - true, ha a mezo ervenyes datum, kulonben false (ekkor ki nem valtozik).
+bool Datum::parseMezo(const char* buf, size_t hossz, Datum& ki) {
+    Datum d;
+    size_t i = parseBuffer(buf, hossz, d);
+    if (i == 0) return false;
+    while (i < hossz && (buf[i] == ' ' || buf[i] == '\t')) ++i;
+    if (i != hossz) return false;
+    ki = d;
+    return true;
+}
 
-    oss << std::setw(4) << std::setfill('0') << ev << "."
-        << std::setw(2) << std::setfill('0') << ho << "."
-        << std::setw(2) << std::setfill('0') << nap;
+/// A datumot "EEEE.HH.NN" formatumban a megadott pufferbe irja, memoriafoglalas nelkul.
+/// @param buf - Legalabb MAX_SZOVEG_HOSSZ meretu puffer.
+/// @return - A beirt karakterek szama (0000..9999 kozotti evszamra mindig SZOVEG_HOSSZ).
+size_t Datum::formatToBuffer(char* buf) const {
+    int e, h, n;
+    datumFromSorszam(napSorszam, e, h, n);
 
-    return oss.str();
+    char* p = buf;
+    if (e >= 0 && e <= 9999) {
+        p[0] = static_cast<char>('0' + e / 1000);
+        p[1] = static_cast<char>('0' + e / 100 % 10);
+        p[2] = static_cast<char>('0' + e / 10 % 10);
+        p[3] = static_cast<char>('0' + e % 10);
+        p += 4;
+    }
+    else {
+        // Ritka eset: negativ vagy otjegyu evszam, altalanos kiiras
+        unsigned u = e < 0 ? 0u - static_cast<unsigned>(e) : static_cast<unsigned>(e);
+        char tmp[10];
+        int db = 0;
+        do { tmp[db++] = static_cast<char>('0' + u % 10); u /= 10; } while (u != 0);
+        if (e < 0) *p++ = '-';
+        while (db > 0) *p++ = tmp[--db];
+    }
+    p[0] = '.';
+    p[1] = static_cast<char>('0' + h / 10);
+    p[2] = static_cast<char>('0' + h % 10);
+    p[3] = '.';
+    p[4] = static_cast<char>('0' + n / 10);
+    p[5] = static_cast<char>('0' + n % 10);
+    return static_cast<size_t>(p + 6 - buf);
 }
 
 
@@ -133,7 +342,6 @@ const std::string Datum::toString() const {
 /// @param d - kiirando Datum objektum
 /// @return - modositott kimeneti stream
 std::ostream& operator<<(std::ostream& os, const Datum& d) {
-    return os << std::setw(4) << std::setfill('0') << d.getEv() << "."
-        << std::setw(2) << std::setfill('0') << d.getHo() << "."
-        << std::setw(2) << std::setfill('0') << d.getNap();
+    char buf[Datum::MAX_SZOVEG_HOSSZ];
+    return os.write(buf, static_cast<std::streamsize>(d.formatToBuffer(buf)));
 }
\ No newline at end of file
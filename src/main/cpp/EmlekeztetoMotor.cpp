@@ -0,0 +1,284 @@
+/**
+*   \file EmlekeztetoMotor.cpp
+*   Az EmlekeztetoMotor tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <algorithm>
+
+#include "EmlekeztetoMotor.h"
+#include "Auto.h"
+
+/*-------------------------------------------
+        Kupacmuveletek (belso hasznalatra)
+-------------------------------------------*/
+/// Elem mozgatasa a datum-kupac teteje fele, amig kisebb a szulojenel.
+/// @param poz - Az elem pozicioja a kupacban
+void EmlekeztetoMotor::datumFel(size_t poz) {
+    size_t e = datumKupac[poz];
+    while (poz > 0) {
+        size_t szulo = (poz - 1) / 2;
+        if (datumKulcs(datumKupac[szulo]) <= datumKulcs(e)) break;
+        datumKupac[poz] = datumKupac[szulo];
+        elemek[datumKupac[poz]].datumPoz = poz;
+        poz = szulo;
+    }
+    datumKupac[poz] = e;
+    elemek[e].datumPoz = poz;
+}
+
+/// Elem mozgatasa a datum-kupac alja fele, amig nagyobb valamelyik gyerekenel.
+/// @param poz - Az elem pozicioja a kupacban
+void EmlekeztetoMotor::datumLe(size_t poz) {
+    size_t e = datumKupac[poz];
+    const size_t n = datumKupac.size();
+    while (2 * poz + 1 < n) {
+        size_t gyerek = 2 * poz + 1;
+        if (gyerek + 1 < n && datumKulcs(datumKupac[gyerek + 1]) < datumKulcs(datumKupac[gyerek])) gyerek++;
+        if (datumKulcs(e) <= datumKulcs(datumKupac[gyerek])) break;
+        datumKupac[poz] = datumKupac[gyerek];
+        elemek[datumKupac[poz]].datumPoz = poz;
+        poz = gyerek;
+    }
+    datumKupac[poz] = e;
+    elemek[e].datumPoz = poz;
+}
+
+/// Elem mozgatasa a km-kupac teteje fele, amig kisebb a szulojenel.
+/// @param poz - Az elem pozicioja a kupacban
+void EmlekeztetoMotor::kmFel(size_t poz) {
+    size_t e = kmKupac[poz];
+    while (poz > 0) {
+        size_t szulo = (poz - 1) / 2;
+        if (kmKulcs(kmKupac[szulo]) <= kmKulcs(e)) break;
+        kmKupac[poz] = kmKupac[szulo];
+        elemek[kmKupac[poz]].kmPoz = poz;
+        poz = szulo;
+    }
+    kmKupac[poz] = e;
+    elemek[e].kmPoz = poz;
+}
+
+/// Elem mozgatasa a km-kupac alja fele, amig nagyobb valamelyik gyerekenel.
+/// @param poz - Az elem pozicioja a kupacban
+void EmlekeztetoMotor::kmLe(size_t poz) {
+    size_t e = kmKupac[poz];
+    const size_t n = kmKupac.size();
+    while (2 * poz + 1 < n) {
+        size_t gyerek = 2 * poz + 1;
+        if (gyerek + 1 < n && kmKulcs(kmKupac[gyerek + 1]) < kmKulcs(kmKupac[gyerek])) gyerek++;
+        if (kmKulcs(e) <= kmKulcs(kmKupac[gyerek])) break;
+        kmKupac[poz] = kmKupac[gyerek];
+        elemek[kmKupac[poz]].kmPoz = poz;
+        poz = gyerek;
+    }
+    kmKupac[poz] = e;
+    elemek[e].kmPoz = poz;
+}
+
+/// Elem eltavolitasa mindket kupacbol es az indexbol.
+/// A kupacban az utolso elem kerul a helyere, majd a megfelelo iranyba mozdul.
+/// @param e - Az elem indexe
+void EmlekeztetoMotor::eltavolit(size_t e) {
+    size_t poz = elemek[e].datumPoz;
+    size_t utolso = datumKupac.back();
+    datumKupac.pop_back();
+    if (utolso != e) {
+        datumKupac[poz] = utolso;
+        elemek[utolso].datumPoz = poz;
+        datumFel(poz);
+        datumLe(elemek[utolso].datumPoz);
+    }
+
+    poz = elemek[e].kmPoz;
+    utolso = kmKupac.back();
+    kmKupac.pop_back();
+    if (utolso != e) {
+        kmKupac[poz] = utolso;
+        elemek[utolso].kmPoz = poz;
+        kmFel(poz);
+        kmLe(elemek[utolso].kmPoz);
+    }
+
+    index.erase(elemek[e].rendszam);
+    elemek[e].rendszam.clear();
+    szabadElemek.push_back(e);
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// Az osszes bejegyzes torlese.
+void EmlekeztetoMotor::torol() {
+    elemek.clear();
+    szabadElemek.clear();
+    datumKupac.clear();
+    kmKupac.clear();
+    index.clear();
+}
+
+/// Ujraepiti a motort az autok alapjan.
+/// A kupacokat alulrol felfele epiti fel (O(n)), nem egyenkenti beszurassal.
+/// @param autok - A rendszer autoi
+/// @param sz - A figyelmeztetesi szabalyok, amelyekbol az esedekessegek szamolodnak
+void EmlekeztetoMotor::ujraepit(const Vector<Auto>& autok, const FigyelmeztetesiSzabalyok& sz) {
+    torol();
+    elemek.reserve(autok.size());
+    datumKupac.reserve(autok.size());
+    kmKupac.reserve(autok.size());
+
+    for (size_t i = 0; i < autok.size(); i++) {
+        Elem elem;
+        if (index.count(autok[i].getRendszam()) != 0 || !sz.esedekesseg(autok[i], elem.esedekesNap, elem.esedekesKm)) continue;
+
+        elem.rendszam = autok[i].getRendszam();
+        elem.kmOra = autok[i].getKmOra();
+        elem.datumPoz = elem.kmPoz = elemek.size();
+
+        index[elem.rendszam] = elemek.size();
+        datumKupac.push_back(elemek.size());
+        kmKupac.push_back(elemek.size());
+        elemek.push_back(elem);
+    }
+
+    for (size_t i = datumKupac.size() / 2; i-- > 0; ) {
+        datumLe(i);
+        kmLe(i);
+    }
+}
+
+/// Egy auto bejegyzesenek felvetele vagy frissitese (O(log n)).
+/// Ha egyik szabaly sem vonatkozik az autora, a bejegyzes megszunik.
+/// @param a - Az auto aktualis allapota
+/// @param sz - A figyelmeztetesi szabalyok
+void EmlekeztetoMotor::frissit(const Auto& a, const FigyelmeztetesiSzabalyok& sz) {
+    int32_t esedekesNap;
+    int esedekesKm;
+    if (!sz.esedekesseg(a, esedekesNap, esedekesKm)) {
+        torol(a.getRendszam());
+        return;
+    }
+
+    size_t e;
+    bool uj = false;
+    std::map<std::string, size_t>::const_iterator it = index.find(a.getRendszam());
+    if (it != index.end()) {
+        e = it->second;
+    }
+    else {
+        uj = true;
+        if (!szabadElemek.empty()) {
+            e = szabadElemek.back();
+            szabadElemek.pop_back();
+        }
+        else {
+            e = elemek.size();
+            elemek.push_back(Elem());
+        }
+        elemek[e].rendszam = a.getRendszam();
+        index[a.getRendszam()] = e;
+    }
+
+    Elem& elem = elemek[e];
+    elem.esedekesNap = esedekesNap;
+    elem.esedekesKm = esedekesKm;
+    elem.kmOra = a.getKmOra();
+
+    if (uj) {
+        datumKupac.push_back(e);
+        kmKupac.push_back(e);
+        datumFel(datumKupac.size() - 1);
+        kmFel(kmKupac.size() - 1);
+    }
+    else {
+        // A kulcs barmelyik iranyba valtozhatott; a nem szukseges irany azonnal megall
+        datumFel(elem.datumPoz);
+        datumLe(elemek[e].datumPoz);
+        kmFel(elemek[e].kmPoz);
+        kmLe(elemek[e].kmPoz);
+    }
+}
+
+/// Egy auto bejegyzesenek torlese (O(log n)).
+/// @param r - Az auto rendszama
+void EmlekeztetoMotor::torol(const std::string& r) {
+    std::map<std::string, size_t>::const_iterator it = index.find(r);
+    if (it != index.end())
+        eltavolit(it->second);
+}
+
+
+
+/*-------------------------------------------
+              Lekerdezesek
+-------------------------------------------*/
+/// Azok az autok, amelyeknel a datum alapu figyelmeztetes legkesobb a megadott napon mar jar.
+/// A kupacot a gyokertol bejarva csak azokba az agakba lep, ahol a kulcs meg nem nagyobb a hatarnal,
+/// igy a talalatok (k) mellett legfeljebb 2k felesleges csucsot nez meg; a vegen rendez.
+/// @param ig - A referencia datum
+/// @param ki - Az eredmenylista (a vegere fuz)
+void EmlekeztetoMotor::esedekesekDatumig(const Datum& ig, Vector<Esedekesseg>& ki) const {
+    const int32_t hatar = ig.getNapSorszam();
+    const size_t elso = ki.size();
+    Vector<size_t> verem;
+    if (!datumKupac.empty()) verem.push_back(0);
+
+    while (!verem.empty()) {
+        size_t poz = verem.back();
+        verem.pop_back();
+        const Elem& elem = elemek[datumKupac[poz]];
+        if (elem.esedekesNap == FigyelmeztetesiSzabalyok::NINCS_NAP || elem.esedekesNap > hatar) continue;
+
+        Esedekesseg es;
+        es.rendszam = elem.rendszam;
+        es.esedekesDatum = Datum::fromNapSorszam(elem.esedekesNap);
+        es.esedekesKm = elem.esedekesKm;
+        es.kmOra = elem.kmOra;
+        ki.push_back(es);
+
+        if (2 * poz + 1 < datumKupac.size()) verem.push_back(2 * poz + 1);
+        if (2 * poz + 2 < datumKupac.size()) verem.push_back(2 * poz + 2);
+    }
+
+    std::sort(ki.begin() + elso, ki.end(), [](const Esedekesseg& a, const Esedekesseg& b) {
+        return a.esedekesDatum < b.esedekesDatum || (a.esedekesDatum == b.esedekesDatum && a.rendszam < b.rendszam);
+    });
+}
+
+/// Azok az autok, amelyeknel a km alapu figyelmeztetes legfeljebb tartalekKm km utan mar jar.
+/// @param tartalekKm - 0 eseten a mar esedekes autok, pozitiv ertek eseten az ennyi km-en belul esedekesek is
+/// @param ki - Az eredmenylista (a vegere fuz)
+void EmlekeztetoMotor::esedekesekKmAlapjan(int tartalekKm, Vector<Esedekesseg>& ki) const {
+    const size_t elso = ki.size();
+    Vector<size_t> verem;
+    if (!kmKupac.empty()) verem.push_back(0);
+
+    while (!verem.empty()) {
+        size_t poz = verem.back();
+        verem.pop_back();
+        if (kmKulcs(kmKupac[poz]) > tartalekKm) continue;
+
+        const Elem& elem = elemek[kmKupac[poz]];
+        Esedekesseg es;
+        es.rendszam = elem.rendszam;
+        if (elem.esedekesNap != FigyelmeztetesiSzabalyok::NINCS_NAP)
+            es.esedekesDatum = Datum::fromNapSorszam(elem.esedekesNap);
+        es.esedekesKm = elem.esedekesKm;
+        es.kmOra = elem.kmOra;
+        ki.push_back(es);
+
+        if (2 * poz + 1 < kmKupac.size()) verem.push_back(2 * poz + 1);
+        if (2 * poz + 2 < kmKupac.size()) verem.push_back(2 * poz + 2);
+    }
+
+    std::sort(ki.begin() + elso, ki.end(), [](const Esedekesseg& a, const Esedekesseg& b) {
+        long long ha = static_cast<long long>(a.esedekesKm) - a.kmOra;
+        long long hb = static_cast<long long>(b.esedekesKm) - b.kmOra;
+        return ha < hb || (ha == hb && a.rendszam < b.rendszam);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+*   \file FigyelmeztetesiSzabalyok.cpp
+*   A figyelmeztetesi szabalyok forditasanak es kiertekelesenek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <stdexcept>
+
+#include "FigyelmeztetesiSzabalyok.h"
+#include "EmlekeztetoMotor.h"
+#include "Auto.h"
+#include "SzervizRekord.h"
+
+const int32_t FigyelmeztetesiSzabalyok::NINCS_NAP;
+const int FigyelmeztetesiSzabalyok::NINCS_KM;
+
+/*-------------------------------------------
+            FigyelmeztetesiSzabaly
+-------------------------------------------*/
+/// A muvelettipushoz tartozo maszk bit.
+/// @param t - A muvelet tipusa
+/// @return - JAVITAS, KARBANTARTAS vagy VIZSGA
+unsigned char FigyelmeztetesiSzabaly::tipusBit(MuveletTipus t) {
+    switch (t) {
+    case MuveletTipus::Javitas: return JAVITAS;
+    case MuveletTipus::Karbantartas: return KARBANTARTAS;
+    case MuveletTipus::Vizsga: return VIZSGA;
+    }
+    return 0;
+}
+
+
+
+/// Maszkonkent a viszonyitasi muvelet: a maszk tipusai kozul a legkesobbi muvelet indexe + 1.
+/// Visszafele csak addig keres, amig mindharom tipus utolso muvelete meg nincs meg.
+/// @param rekordok - Az auto szervizmuveletei
+/// @param hivatkozas - Maszkonkent az index + 1 (0, ha az autonak nincs a maszk tipusai kozul muvelete)
+static void hivatkozasok(const SzervizRekordLista& rekordok, size_t hivatkozas[8]) {
+    size_t utolsoBit[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    unsigned char talalt = 0;
+    for (size_t i = rekordok.size(); i > 0 && talalt != FigyelmeztetesiSzabaly::BARMELY; i--) {
+        unsigned char b = FigyelmeztetesiSzabaly::tipusBit(rekordok[i - 1].tipus);
+        if (b == 0 || (talalt & b)) continue;
+        talalt |= b;
+        utolsoBit[b] = i;
+    }
+
+    for (unsigned char m = 0; m < 8; m++) {
+        size_t h = utolsoBit[m & FigyelmeztetesiSzabaly::JAVITAS];
+        if (utolsoBit[m & FigyelmeztetesiSzabaly::KARBANTARTAS] > h) h = utolsoBit[m & FigyelmeztetesiSzabaly::KARBANTARTAS];
+        if (utolsoBit[m & FigyelmeztetesiSzabaly::VIZSGA] > h) h = utolsoBit[m & FigyelmeztetesiSzabaly::VIZSGA];
+        hivatkozas[m] = h;
+    }
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// A program eredeti ket szabalya: barmely muvelet utan 2 ev, illetve 10000 km.
+/// @return - Az alapertelmezett szabalykeszlet
+FigyelmeztetesiSzabalyok FigyelmeztetesiSzabalyok::alapertelmezett() {
+    FigyelmeztetesiSzabalyok sz;
+    sz.hozzaad(FigyelmeztetesiSzabaly("muszaki vizsgaja lejart", "vizsga", FigyelmeztetesiSzabaly::BARMELY,
+        EmlekeztetoMotor::VIZSGA_ERVENYESSEG_NAP, FigyelmeztetesiSzabaly::NINCS));
+    sz.hozzaad(FigyelmeztetesiSzabaly("szervizelesre esedekes", "szerviz", FigyelmeztetesiSzabaly::BARMELY,
+        FigyelmeztetesiSzabaly::NINCS, EmlekeztetoMotor::SZERVIZ_INTERVALLUM_KM));
+    return sz;
+}
+
+/// Szabaly felvetele; a szabaly azonnal a predikatumtablaba fordul (kuszobonkent egy sor).
+/// @param sz - A szabaly
+/// @return - A szabaly sorszama
+size_t FigyelmeztetesiSzabalyok::hozzaad(const FigyelmeztetesiSzabaly& sz) {
+    unsigned char maszk = sz.tipusMaszk & FigyelmeztetesiSzabaly::BARMELY;
+    if (maszk == 0)
+        throw std::invalid_argument("A szabaly egyetlen muvelettipusra sem vonatkozik!");
+    if (sz.napKuszob < 0 && sz.kmKuszob < 0)
+        throw std::invalid_argument("A szabalynak legalabb egy kuszobe kell legyen!");
+
+    size_t id = szabalyok.size();
+    szabalyok.push_back(sz);
+    if (sz.napKuszob >= 0) {
+        sorMaszk.push_back(maszk);
+        sorKm.push_back(0);
+        sorKuszob.push_back(sz.napKuszob);
+        sorSzabaly.push_back(static_cast<uint32_t>(id));
+    }
+    if (sz.kmKuszob >= 0) {
+        sorMaszk.push_back(maszk);
+        sorKm.push_back(1);
+        sorKuszob.push_back(sz.kmKuszob);
+        sorSzabaly.push_back(static_cast<uint32_t>(id));
+    }
+    return id;
+}
+
+/// Az osszes szabaly torlese.
+void FigyelmeztetesiSzabalyok::torol() {
+    szabalyok.clear();
+    sorMaszk.clear();
+    sorKm.clear();
+    sorKuszob.clear();
+    sorSzabaly.clear();
+}
+
+/// Az auto kiertekelese az osszes szabalyra, egy menetben.
+/// Eloszor visszafele megkeresi a tipusonkenti utolso muveletet, es mind a 8 lehetseges tipusmaszkra
+/// kiszamolja a viszonyitasi muveletet es az azota eltelt napokat/km-t. A tabla sorai ezutan egy-egy
+/// tablazatbeli kikeresest es osszehasonlitast jelentenek.
+/// @param a - Az auto
+/// @param ma - A referencia datum
+/// @param ki - A teljesult sorok (a vegere fuz, a tabla soraival azonos sorrendben)
+void FigyelmeztetesiSzabalyok::kiertekel(const Auto& a, const Datum& ma, Vector<Talalat>& ki) const {
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    if (rekordok.empty() || sorKuszob.empty()) return;
+
+    // Maszkonkent a viszonyitasi muvelet (a maszk tipusai kozul a legkesobbi) es az azota eltelt ido/km
+    size_t hivatkozas[8];
+    hivatkozasok(rekordok, hivatkozas);
+    int32_t eltelt[2][8];
+    for (unsigned char m = 0; m < 8; m++) {
+        const size_t h = hivatkozas[m];
+        const SzervizRekord& r = rekordok[h == 0 ? 0 : h - 1];
+        eltelt[0][m] = ma.getNapSorszam() - r.idopont.getNapSorszam();
+        eltelt[1][m] = a.getKmOra() - r.akt_kmOra;
+    }
+
+    const size_t n = sorKuszob.size();
+    for (size_t j = 0; j < n; j++) {
+        unsigned char m = sorMaszk[j];
+        int32_t e = eltelt[static_cast<int>(sorKm[j])][m];
+        if (hivatkozas[m] == 0 || e <= sorKuszob[j]) continue;
+
+        Talalat t;
+        t.szabaly = sorSzabaly[j];
+        t.mertek = sorKm[j] ? FigyelmeztetesMertek::Km : FigyelmeztetesMertek::Nap;
+        t.eltelt = e;
+        t.tullepes = e - sorKuszob[j];
+        t.rekord = hivatkozas[m] - 1;
+        ki.push_back(t);
+    }
+}
+
+/// Az auto kovetkezo esedekessege az osszes szabaly szerint.
+/// A kiertekel feltetele (eltelt > kuszob) a viszonyitasi muvelethez kepest kuszob + 1 nap, illetve km
+/// mulva teljesul eloszor; soronkent ezt szamolja ki, es a nap, illetve km sorok minimumat adja vissza.
+/// @param a - Az auto
+/// @param nap - Ide kerul az esedekesseg napsorszama (NINCS_NAP, ha nincs ilyen sor)
+/// @param km - Ide kerul az esedekes km ora allas (NINCS_KM, ha nincs ilyen sor)
+/// @return - true, ha legalabb az egyik esedekesseg letezik
+bool FigyelmeztetesiSzabalyok::esedekesseg(const Auto& a, int32_t& nap, int& km) const {
+    nap = NINCS_NAP;
+    km = NINCS_KM;
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    if (rekordok.empty() || sorKuszob.empty()) return false;
+
+    size_t hivatkozas[8];
+    hivatkozasok(rekordok, hivatkozas);
+
+    const size_t n = sorKuszob.size();
+    for (size_t j = 0; j < n; j++) {
+        const size_t h = hivatkozas[sorMaszk[j]];
+        if (h == 0) continue;
+
+        const SzervizRekord& r = rekordok[h - 1];
+        if (sorKm[j]) {
+            long long e = static_cast<long long>(r.akt_kmOra) + sorKuszob[j] + 1;
+            if (e < km) km = static_cast<int>(e);
+        }
+        else {
+            long long e = static_cast<long long>(r.idopont.getNapSorszam()) + sorKuszob[j] + 1;
+            if (e < nap) nap = static_cast<int32_t>(e);
+        }
+    }
+    return nap != NINCS_NAP || km != NINCS_KM;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+*   \file KimenetiPuffer.cpp
+*   A nagy blokkokban iro kimeneti puffer megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "KimenetiPuffer.h"
+
+/// Konstruktor.
+/// @param c - A celfolyam
+/// @param meret - A tar merete bajtban
+KimenetiPuffer::KimenetiPuffer(std::ostream& c, size_t meret)
+    : std::streambuf(), cel(c), tar(meret == 0 ? 1 : meret), kimenet(this), irasok(0) {
+    setp(tar.data(), tar.data() + tar.size());
+}
+
+/// Destruktor, a maradekot atadja a celfolyamnak.
+KimenetiPuffer::~KimenetiPuffer() {
+    atad();
+}
+
+/// A tar tartalmanak atadasa a celfolyamnak egyetlen irassal.
+/// @return - false, ha a celfolyam hibat jelzett
+bool KimenetiPuffer::atad() {
+    const std::streamsize n = pptr() - pbase();
+    if (n > 0) {
+        cel.write(pbase(), n);
+        irasok++;
+        setp(tar.data(), tar.data() + tar.size());
+    }
+    return static_cast<bool>(cel);
+}
+
+/// Megtelt tar: atadas, majd a karakter elhelyezese.
+/// @param c - A karakter (vagy eof)
+/// @return - A karakter, vagy eof hiba eseten
+KimenetiPuffer::int_type KimenetiPuffer::overflow(int_type c) {
+    if (!atad()) return traits_type::eof();
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+/// Tobb karakter irasa.
+/// @param s - A karakterek
+/// @param n - A karakterek szama
+/// @return - A kiirt karakterek szama
+std::streamsize KimenetiPuffer::xsputn(const char* s, std::streamsize n) {
+    const std::streamsize hely = epptr() - pptr();
+    if (n <= hely) {
+        traits_type::copy(pptr(), s, static_cast<size_t>(n));
+        pbump(static_cast<int>(n));
+        return n;
+    }
+    if (!atad()) return 0;
+    if (static_cast<size_t>(n) >= tar.size()) {
+        cel.write(s, n);
+        irasok++;
+        return cel ? n : 0;
+    }
+    traits_type::copy(pptr(), s, static_cast<size_t>(n));
+    pbump(static_cast<int>(n));
+    return n;
+}
+
+/// A tar atadasa es a celfolyam uritese.
+/// @return - 0, vagy -1 hiba eseten
+int KimenetiPuffer::sync() {
+    if (!atad()) return -1;
+    cel.flush();
+    return cel ? 0 : -1;
+}
+
+/// A tar atadasa a celfolyamnak es a celfolyam uritese.
+void KimenetiPuffer::kiurit() {
+    kimenet.flush();
+}
\ No newline at end of file
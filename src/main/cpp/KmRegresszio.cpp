@@ -0,0 +1,72 @@
+/**
+*   \file KmRegresszio.cpp
+*   A KmRegresszio tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "KmRegresszio.h"
+
+/// Alapertelmezett konstruktor (ures regresszio).
+KmRegresszio::KmRegresszio() : n(0), x0(0), y0(0), sx(0), sy(0), sxy(0), sxx(0) {}
+
+/// Egy pont hozzaadasa.
+/// Ures regresszioban a pont lesz a viszonyitasi pont; amig van pont, ez nem valtozik,
+/// igy az elvetel ugyanazokat az elteres-szorzatokat vonja ki, amelyeket a hozzaadas hozzaadott.
+/// @param nap - A szerviz napsorszama
+/// @param km - A km ora allas a szervizkor
+void KmRegresszio::hozzaad(int32_t nap, int km) {
+    if (n == 0) {
+        x0 = nap;
+        y0 = km;
+    }
+    const long long dx = static_cast<long long>(nap) - x0;
+    const long long dy = static_cast<long long>(km) - y0;
+    n++;
+    sx += dx;
+    sy += dy;
+    sxy += dx * dy;
+    sxx += dx * dx;
+}
+
+/// Egy korabban hozzaadott pont elvetele.
+/// @param nap - A szerviz napsorszama
+/// @param km - A km ora allas a szervizkor
+void KmRegresszio::elvesz(int32_t nap, int km) {
+    const long long dx = static_cast<long long>(nap) - x0;
+    const long long dy = static_cast<long long>(km) - y0;
+    n--;
+    sx -= dx;
+    sy -= dy;
+    sxy -= dx * dy;
+    sxx -= dx * dx;
+}
+
+/// Az osszes pont torlese.
+void KmRegresszio::torol() {
+    n = sx = sy = sxy = sxx = 0;
+    x0 = 0;
+    y0 = 0;
+}
+
+/// Van-e eleg adat a becslesehez (legalabb ket kulonbozo napon vett pont).
+/// n*Sxx - Sx^2 pontosan akkor pozitiv, ha a napsorszamok nem mind egyenloek. A szorzatok
+/// tulcsordulhatnanak, ezert a kulonbseg n-nel osztott alakjat (Sxx - Sx*Sx/n) kepezzuk lebegopontosan;
+/// azonos napok eseten ez pontosan nulla, mert Sx es Sxx ekkor n*d es n*d*d.
+/// @return - true, ha a meredekseg ertelmezett
+bool KmRegresszio::ervenyes() const {
+    return n >= 2 && static_cast<double>(sxx) - static_cast<double>(sx) * (static_cast<double>(sx) / static_cast<double>(n)) > 0.0;
+}
+
+/// A becsult napi futasteljesitmeny (a regresszios egyenes meredeksege).
+/// Az osszegek pontos egeszek; a kovariancia es a szorasnegyzet n-nel osztott alakja lebegopontos,
+/// igy az n-nel szorzott osszegek sem csordulnak tul.
+/// @return - km/nap, vagy 0, ha a regresszio nem ervenyes
+double KmRegresszio::napiKm() const {
+    if (!ervenyes()) return 0.0;
+    const double atlagX = static_cast<double>(sx) / static_cast<double>(n);
+    const double atlagY = static_cast<double>(sy) / static_cast<double>(n);
+    return (static_cast<double>(sxy) - static_cast<double>(sx) * atlagY) / (static_cast<double>(sxx) - static_cast<double>(sx) * atlagX);
+}
\ No newline at end of file
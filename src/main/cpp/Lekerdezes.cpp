@@ -0,0 +1,536 @@
+/**
+*   \file Lekerdezes.cpp
+*   A lekerdezonyelv forditojanak es vegrehajtojanak megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <stdexcept>
+#include <sstream>
+#include <cctype>
+#include <climits>
+#include <algorithm>
+
+#include "Lekerdezes.h"
+#include "SzervizNyilvantartoRendszer.h"
+#include "SzervizEsemenyTar.h"
+#include "SzervizRekord.h"
+#include "Auto.h"
+#include "Ugyfel.h"
+#include "Datum.h"
+
+/*-------------------------------------------
+                 Mezotabla
+-------------------------------------------*/
+/// A mezok sorszamai a mezotablaban.
+enum MezoSorszam {
+    M_RENDSZAM, M_MARKA, M_TIPUS, M_KMORA, M_UZEMBE, M_TULAJDONOS,
+    M_LAST_SZERVIZ, M_LAST_JAVITAS, M_LAST_KARBANTARTAS, M_LAST_VIZSGA, M_A_SZERVIZEK, M_A_KOLTES,
+    M_NEV, M_TELEFON, M_EMAIL, M_AUTOK, M_U_SZERVIZEK, M_U_KOLTES, M_LAST_LATOGATAS,
+    M_MEZOK_SZAMA
+};
+
+/// Egy lekerdezheto mezo leirasa.
+struct MezoLeiras {
+    const char* nev;            ///< A mezo neve a nyelvben (kisbetuvel)
+    LekerdezesCel cel;          ///< Melyik tombre vonatkozik
+    Lekerdezes::Tipus tipus;    ///< Az ertek tipusa
+    bool oszlopos;              ///< A szerviztortenetbol szarmazik (az esemenytar oszlopaibol szamolodik)
+    bool osszesitobol;          ///< Az ugyfelosszesitobol szarmazik
+};
+
+static const MezoLeiras MEZOK[M_MEZOK_SZAMA] = {
+    { "rendszam",          LekerdezesCel::Auto,   Lekerdezes::Tipus::Szoveg, false, false },
+    { "marka",             LekerdezesCel::Auto,   Lekerdezes::Tipus::Szoveg, false, false },
+    { "tipus",             LekerdezesCel::Auto,   Lekerdezes::Tipus::Szoveg, false, false },
+    { "kmora",             LekerdezesCel::Auto,   Lekerdezes::Tipus::Egesz,  false, false },
+    { "uzembe",            LekerdezesCel::Auto,   Lekerdezes::Tipus::Datum,  false, false },
+    { "tulajdonos",        LekerdezesCel::Auto,   Lekerdezes::Tipus::Szoveg, false, false },
+    { "last_szerviz",      LekerdezesCel::Auto,   Lekerdezes::Tipus::Datum,  true,  false },
+    { "last_javitas",      LekerdezesCel::Auto,   Lekerdezes::Tipus::Datum,  true,  false },
+    { "last_karbantartas", LekerdezesCel::Auto,   Lekerdezes::Tipus::Datum,  true,  false },
+    { "last_vizsga",       LekerdezesCel::Auto,   Lekerdezes::Tipus::Datum,  true,  false },
+    { "szervizek",         LekerdezesCel::Auto,   Lekerdezes::Tipus::Egesz,  true,  false },
+    { "koltes",            LekerdezesCel::Auto,   Lekerdezes::Tipus::Egesz,  true,  false },
+    { "nev",               LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Szoveg, false, false },
+    { "telefon",           LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Szoveg, false, false },
+    { "email",             LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Szoveg, false, false },
+    { "autok",             LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Egesz,  false, true  },
+    { "szervizek",         LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Egesz,  false, true  },
+    { "koltes",            LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Egesz,  false, true  },
+    { "last_latogatas",    LekerdezesCel::Ugyfel, Lekerdezes::Tipus::Datum,  false, true  },
+};
+
+/// Jelzi, hogy a datum mezonek nincs erteke.
+static const int32_t NINCS_DATUM = INT32_MIN;
+
+
+
+/*-------------------------------------------
+                 Lexikai elemzo
+-------------------------------------------*/
+/// Hibauzenet a pozicioval egyutt.
+/// A fuggveny static kulcsszoval van ellatva, mert csak a jelenlegi forditasi egysegen belul hasznaljuk.
+/// @param uzenet - A hiba leirasa
+/// @param poz - A hiba helye (0-tol szamozva)
+static void hiba(const std::string& uzenet, size_t poz) {
+    std::ostringstream os;
+    os << "Hibas szuro: " << uzenet << " (" << poz + 1 << ". karakter)";
+    throw std::invalid_argument(os.str());
+}
+
+/// Atlepi a szokozoket.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (tovabblep)
+static void szokozAtlep(const std::string& s, size_t& poz) {
+    while (poz < s.size() && std::isspace(static_cast<unsigned char>(s[poz]))) poz++;
+}
+
+/// Azonosito (betu, szamjegy, '_') karakter-e.
+/// @param c - A karakter
+/// @return - true, ha azonositoban allhat
+static bool azonositoKarakter(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+/// Beolvas egy azonositot kisbetusitve (a pozicio nem lep tovabb, ha nincs azonosito).
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio
+/// @param vege - Az azonosito utani pozicio
+/// @return - Az azonosito kisbetuvel, vagy ures szoveg
+static std::string azonosito(const std::string& s, size_t poz, size_t& vege) {
+    szokozAtlep(s, poz);
+    vege = poz;
+    if (poz >= s.size() || !std::isalpha(static_cast<unsigned char>(s[poz]))) return "";
+    std::string ki;
+    while (vege < s.size() && azonositoKarakter(s[vege]))
+        ki += static_cast<char>(std::tolower(static_cast<unsigned char>(s[vege++])));
+    return ki;
+}
+
+/// Ha a kovetkezo szo a megadott kulcsszo, atlepi.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (egyezes eseten tovabblep)
+/// @param kulcsszo - A kulcsszo kisbetuvel
+/// @return - true, ha a kulcsszo kovetkezett
+static bool kulcsszo(const std::string& s, size_t& poz, const char* kulcsszo) {
+    size_t vege;
+    if (azonosito(s, poz, vege) != kulcsszo) return false;
+    poz = vege;
+    return true;
+}
+
+
+
+/*-------------------------------------------
+                  Forditas
+-------------------------------------------*/
+/// Uj logikai csomopont felvetele.
+/// @param f - A csomopont fajtaja
+/// @param bal - Bal (vagy egyetlen) gyermek
+/// @param jobb - Jobb gyermek
+/// @param poz - Az elemzes aktualis pozicioja (a hibauzenethez)
+/// @return - Az uj csomopont indexe
+/// @throws std::invalid_argument - ha a fa magassaga meghaladna a MAX_MAGASSAG-ot
+size_t Lekerdezes::uj(Csomopont::Fajta f, size_t bal, size_t jobb, size_t poz) {
+    Csomopont c;
+    c.fajta = f;
+    c.bal = bal;
+    c.jobb = jobb;
+    c.magassag = 1 + std::max(csomopontok[bal].magassag, csomopontok[jobb].magassag);
+    if (c.magassag > MAX_MAGASSAG) hiba("tul hosszu vagy tul melyen egymasba agyazott szuro", poz);
+    csomopontok.push_back(c);
+    return csomopontok.size() - 1;
+}
+
+/// "or" lanc elemzese.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (tovabblep)
+/// @return - A letrehozott csomopont indexe
+size_t Lekerdezes::vagyElemez(const std::string& s, size_t& poz) {
+    size_t bal = esElemez(s, poz);
+    while (kulcsszo(s, poz, "or"))
+        bal = uj(Csomopont::Vagy, bal, esElemez(s, poz), poz);
+    return bal;
+}
+
+/// "and" lanc elemzese.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (tovabblep)
+/// @return - A letrehozott csomopont indexe
+size_t Lekerdezes::esElemez(const std::string& s, size_t& poz) {
+    size_t bal = nemElemez(s, poz);
+    while (kulcsszo(s, poz, "and"))
+        bal = uj(Csomopont::Es, bal, nemElemez(s, poz), poz);
+    return bal;
+}
+
+/// Tagadas, zarojelezett kifejezes vagy feltetel elemzese.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (tovabblep)
+/// @return - A letrehozott csomopont indexe
+size_t Lekerdezes::nemElemez(const std::string& s, size_t& poz) {
+    if (kulcsszo(s, poz, "not")) {
+        if (++agyazas > MAX_AGYAZAS) hiba("tul melyen egymasba agyazott szuro", poz);
+        size_t c = nemElemez(s, poz);
+        agyazas--;
+        return uj(Csomopont::Nem, c, c, poz);
+    }
+    szokozAtlep(s, poz);
+    if (poz < s.size() && s[poz] == '(') {
+        if (++agyazas > MAX_AGYAZAS) hiba("tul melyen egymasba agyazott szuro", poz);
+        poz++;
+        size_t c = vagyElemez(s, poz);
+        szokozAtlep(s, poz);
+        if (poz >= s.size() || s[poz] != ')') hiba("hianyzo ')'", poz);
+        poz++;
+        agyazas--;
+        return c;
+    }
+    return feltetelElemez(s, poz);
+}
+
+/// Egy "mezo relacio ertek" feltetel elemzese es tipusellenorzese.
+/// @param s - A kifejezes
+/// @param poz - Az aktualis pozicio (tovabblep)
+/// @return - A letrehozott csomopont indexe
+size_t Lekerdezes::feltetelElemez(const std::string& s, size_t& poz) {
+    Csomopont c;
+
+    // Mezo
+    size_t vege;
+    std::string nev = azonosito(s, poz, vege);
+    szokozAtlep(s, poz);
+    if (nev.empty()) hiba("mezonev szukseges", poz);
+    size_t m = 0;
+    while (m < M_MEZOK_SZAMA && (MEZOK[m].cel != cel || nev != MEZOK[m].nev)) m++;
+    if (m == M_MEZOK_SZAMA) hiba("ismeretlen mezo: " + nev, poz);
+    c.mezo = m;
+    poz = vege;
+
+    // Relacio
+    szokozAtlep(s, poz);
+    size_t relPoz = poz;
+    char c0 = poz < s.size() ? s[poz] : '\0';
+    char c1 = poz + 1 < s.size() ? s[poz + 1] : '\0';
+    if (c0 == '!' && c1 == '=') { c.relacio = Relacio::NemEgyenlo; poz += 2; }
+    else if (c0 == '<' && c1 == '=') { c.relacio = Relacio::KisebbEgyenlo; poz += 2; }
+    else if (c0 == '>' && c1 == '=') { c.relacio = Relacio::NagyobbEgyenlo; poz += 2; }
+    else if (c0 == '=') { c.relacio = Relacio::Egyenlo; poz++; }
+    else if (c0 == '<') { c.relacio = Relacio::Kisebb; poz++; }
+    else if (c0 == '>') { c.relacio = Relacio::Nagyobb; poz++; }
+    else if (c0 == '~') { c.relacio = Relacio::Tartalmaz; poz++; }
+    else hiba("relacio szukseges (=, !=, <, <=, >, >=, ~)", poz);
+
+    // Ertek, a mezo tipusanak megfeleloen
+    szokozAtlep(s, poz);
+    size_t ertekPoz = poz;
+    Tipus t = MEZOK[m].tipus;
+    if (c.relacio == Relacio::Tartalmaz && t != Tipus::Szoveg)
+        hiba("a '~' csak szoveges mezore hasznalhato", relPoz);
+
+    if (t == Tipus::Szoveg) {
+        if (poz >= s.size() || s[poz] != '"') hiba("idezojeles szoveg szukseges", ertekPoz);
+        size_t zaro = s.find('"', poz + 1);
+        if (zaro == std::string::npos) hiba("lezaratlan szoveg", ertekPoz);
+        c.szoveg = s.substr(poz + 1, zaro - poz - 1);
+        poz = zaro + 1;
+    }
+    else {
+        size_t v = poz;
+        if (v < s.size() && s[v] == '-' && t == Tipus::Egesz) v++;
+        while (v < s.size() && (std::isdigit(static_cast<unsigned char>(s[v])) || s[v] == '.')) v++;
+        if (v == poz) hiba(t == Tipus::Datum ? "datum szukseges (EEEE.HH.NN)" : "egesz szam szukseges", ertekPoz);
+
+        if (t == Tipus::Datum) {
+            Datum d;
+            if (!Datum::parseMezo(s.data() + poz, v - poz, d))
+                hiba("hibas datum (EEEE.HH.NN)", ertekPoz);
+            c.szam = d.getNapSorszam();
+        }
+        else {
+            std::istringstream is(s.substr(poz, v - poz));
+            if (!(is >> c.szam) || !is.eof()) hiba("hibas egesz szam", ertekPoz);
+        }
+        poz = v;
+    }
+
+    oszloposKell = oszloposKell || MEZOK[m].oszlopos;
+    c.fajta = Csomopont::Feltetel;
+    csomopontok.push_back(c);
+    return csomopontok.size() - 1;
+}
+
+/// A legfelso szintu "and" tagok osszegyujtese.
+/// @param cs - A csomopont indexe
+void Lekerdezes::tagokGyujtese(size_t cs) {
+    if (csomopontok[cs].fajta == Csomopont::Es) {
+        tagokGyujtese(csomopontok[cs].bal);
+        tagokGyujtese(csomopontok[cs].jobb);
+    }
+    else {
+        szurok.push_back(cs);
+    }
+}
+
+/// A csomopont kiertekelesenek becsult koltsege (a szurolanc rendezesehez).
+/// Az egesz es datum osszehasonlitas a legolcsobb, a szoveges egyezes dragabb, a tartalmazas es az
+/// ugyfelosszesito kikeresese (hasitas) a legdragabb.
+/// @param cs - A csomopont indexe
+/// @return - Relativ koltseg
+unsigned Lekerdezes::koltseg(size_t cs) const {
+    const Csomopont& c = csomopontok[cs];
+    switch (c.fajta) {
+    case Csomopont::Es:
+    case Csomopont::Vagy:
+        return koltseg(c.bal) + koltseg(c.jobb);
+    case Csomopont::Nem:
+        return koltseg(c.bal);
+    case Csomopont::Feltetel:
+        break;
+    }
+    const MezoLeiras& m = MEZOK[c.mezo];
+    unsigned k = m.tipus == Tipus::Szoveg ? 2 : 1;
+    if (c.relacio == Relacio::Tartalmaz) k += 2;
+    if (m.osszesitobol || c.mezo == M_TULAJDONOS) k += 3;
+    return k;
+}
+
+/// A hozzaferesi mod kivalasztasa a tagok kozul.
+/// A rendszam/nev szerinti egyezes legfeljebb egy jeloltet ad, a tulajdonos szerinti az ugyfel autoit;
+/// a valasztott tagot a jeloltek mar garantaljak, ezert kikerul a szurolancbol.
+void Lekerdezes::hozzaferesValasztas() {
+    size_t valasztott = szurok.size();
+    for (size_t i = 0; i < szurok.size(); i++) {
+        const Csomopont& c = csomopontok[szurok[i]];
+        if (c.fajta != Csomopont::Feltetel || c.relacio != Relacio::Egyenlo) continue;
+        if (c.mezo == M_RENDSZAM || c.mezo == M_NEV) {
+            hozzaferes = c.mezo == M_RENDSZAM ? LekerdezesHozzaferes::Rendszam : LekerdezesHozzaferes::Nev;
+            valasztott = i;
+            break;
+        }
+        if (c.mezo == M_TULAJDONOS && hozzaferes == LekerdezesHozzaferes::Teljes) {
+            hozzaferes = LekerdezesHozzaferes::Tulajdonos;
+            valasztott = i;
+        }
+    }
+    if (valasztott == szurok.size()) return;
+    kulcs = csomopontok[szurok[valasztott]].szoveg;
+    szurok.erase(szurok.begin() + valasztott);
+}
+
+
+
+/*-------------------------------------------
+        Konstruktorok es destruktor
+-------------------------------------------*/
+/// Konstruktor. A kifejezest azonnal leforditja.
+/// @param kifejezes - A szuro kifejezes
+/// @param cel - Autokra vagy ugyfelekre vonatkozik
+/// @throws - std::invalid_argument Szintaktikai hiba, ismeretlen mezo vagy tipuselteres eseten
+Lekerdezes::Lekerdezes(const std::string& kifejezes, LekerdezesCel cel)
+    : cel(cel), csomopontok(), szurok(), hozzaferes(LekerdezesHozzaferes::Teljes), kulcs(""), oszloposKell(false), agyazas(0) {
+    size_t poz = 0;
+    size_t gyoker = vagyElemez(kifejezes, poz);
+    szokozAtlep(kifejezes, poz);
+    if (poz != kifejezes.size()) hiba("varatlan folytatas", poz);
+
+    tagokGyujtese(gyoker);
+    // Stabil beszuro rendezes koltseg szerint (a tagok szama kicsi)
+    for (size_t i = 1; i < szurok.size(); i++) {
+        size_t x = szurok[i];
+        size_t j = i;
+        for (; j > 0 && koltseg(szurok[j - 1]) > koltseg(x); j--)
+            szurok[j] = szurok[j - 1];
+        szurok[j] = x;
+    }
+    hozzaferesValasztas();
+}
+
+
+
+/*-------------------------------------------
+                Kiertekeles
+-------------------------------------------*/
+/// A vegrehajtas kozbeni adatok: a szerviztortenetbol szarmazo, autonkenti oszlopok.
+struct Lekerdezes::Kornyezet {
+    const SzervizNyilvantartoRendszer& db;
+    Vector<int32_t> utolso[4];      ///< Autonkent az utolso muvelet napja: barmely, J, K, V (NINCS_DATUM, ha nincs)
+    Vector<long long> darab;        ///< Autonkent a muveletek szama
+    Vector<long long> koltes;       ///< Autonkent a muveletek aranak osszege
+
+    explicit Kornyezet(const SzervizNyilvantartoRendszer& db) : db(db) {}
+
+    /// Az oszlopok kitoltese egyetlen menetben az esemenytarbol.
+    void kitolt() {
+        const size_t n = db.getAutok().size();
+        for (int t = 0; t < 4; t++) {
+            utolso[t].reserve(n);
+            for (size_t i = 0; i < n; i++) utolso[t].push_back(NINCS_DATUM);
+        }
+        darab.reserve(n);
+        koltes.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            darab.push_back(0);
+            koltes.push_back(0);
+        }
+
+        const SzervizEsemenyTar& tar = db.getEsemenyTar();
+        const uint32_t* hely = tar.getHelyek();
+        const uint32_t* helyAuto = tar.getHelyAutok();
+        const char* tip = tar.getTipusok();
+        const int32_t* d = tar.getDatumok();
+        const int32_t* ar = tar.getArak();
+        for (size_t i = 0; i < tar.meret(); i++) {
+            const uint32_t a = helyAuto[hely[i]];
+            const int t = tip[i] == 'J' ? 1 : tip[i] == 'K' ? 2 : 3;
+            if (d[i] > utolso[0][a]) utolso[0][a] = d[i];
+            if (d[i] > utolso[t][a]) utolso[t][a] = d[i];
+            darab[a]++;
+            koltes[a] += ar[i];
+        }
+    }
+};
+
+/// Az osszehasonlitas eredmenyenek (-1, 0, 1) vetese a relaciora.
+/// @param r - A relacio
+/// @param c - Az osszehasonlitas eredmenye
+/// @return - true, ha a relacio teljesul
+static bool teljesul(Lekerdezes::Relacio r, int c) {
+    switch (r) {
+    case Lekerdezes::Relacio::Egyenlo: return c == 0;
+    case Lekerdezes::Relacio::NemEgyenlo: return c != 0;
+    case Lekerdezes::Relacio::Kisebb: return c < 0;
+    case Lekerdezes::Relacio::KisebbEgyenlo: return c <= 0;
+    case Lekerdezes::Relacio::Nagyobb: return c > 0;
+    case Lekerdezes::Relacio::NagyobbEgyenlo: return c >= 0;
+    case Lekerdezes::Relacio::Tartalmaz: return false;
+    }
+    return false;
+}
+
+/// Egy csomopont kiertekelese egy elemre.
+/// @param cs - A csomopont indexe
+/// @param elem - Az auto vagy ugyfel indexe
+/// @param k - A vegrehajtasi kornyezet
+/// @return - true, ha az elem megfelel
+bool Lekerdezes::kiertekel(size_t cs, size_t elem, const Kornyezet& k) const {
+    const Csomopont& c = csomopontok[cs];
+    switch (c.fajta) {
+    case Csomopont::Es: return kiertekel(c.bal, elem, k) && kiertekel(c.jobb, elem, k);
+    case Csomopont::Vagy: return kiertekel(c.bal, elem, k) || kiertekel(c.jobb, elem, k);
+    case Csomopont::Nem: return !kiertekel(c.bal, elem, k);
+    case Csomopont::Feltetel: break;
+    }
+
+    const std::string* szoveg = nullptr;
+    long long szam = 0;
+    if (cel == LekerdezesCel::Auto) {
+        const Auto& a = k.db.getAutok()[elem];
+        switch (c.mezo) {
+        case M_RENDSZAM: szoveg = &a.getRendszam(); break;
+        case M_MARKA: szoveg = &a.getMarka(); break;
+        case M_TIPUS: szoveg = &a.getTipus(); break;
+        case M_KMORA: szam = a.getKmOra(); break;
+        case M_UZEMBE: szam = a.getUzembeHelyezes().getNapSorszam(); break;
+        case M_TULAJDONOS:
+            if (a.getTulajdonos() == nullptr) return false;
+            szoveg = &a.getTulajdonos()->getNev();
+            break;
+        case M_LAST_SZERVIZ: szam = k.utolso[0][elem]; break;
+        case M_LAST_JAVITAS: szam = k.utolso[1][elem]; break;
+        case M_LAST_KARBANTARTAS: szam = k.utolso[2][elem]; break;
+        case M_LAST_VIZSGA: szam = k.utolso[3][elem]; break;
+        case M_A_SZERVIZEK: szam = k.darab[elem]; break;
+        case M_A_KOLTES: szam = k.koltes[elem]; break;
+        default: return false;
+        }
+    }
+    else {
+        const Ugyfel& u = k.db.getUgyfelek()[elem];
+        switch (c.mezo) {
+        case M_NEV: szoveg = &u.getNev(); break;
+        case M_TELEFON: szoveg = &u.getTelefonszam(); break;
+        case M_EMAIL: szoveg = &u.getEmail(); break;
+        case M_AUTOK: szam = static_cast<long long>(k.db.getUgyfelOsszesito(u.getNev()).autokSzama); break;
+        case M_U_SZERVIZEK: szam = static_cast<long long>(k.db.getUgyfelOsszesito(u.getNev()).muveletekSzama); break;
+        case M_U_KOLTES: szam = k.db.getUgyfelOsszesito(u.getNev()).koltes; break;
+        case M_LAST_LATOGATAS: {
+            const UgyfelOsszesito& o = k.db.getUgyfelOsszesito(u.getNev());
+            szam = o.muveletekSzama == 0 ? NINCS_DATUM : o.utolsoLatogatas.getNapSorszam();
+            break;
+        }
+        default: return false;
+        }
+    }
+
+    if (szoveg != nullptr) {
+        if (c.relacio == Relacio::Tartalmaz)
+            return szoveg->find(c.szoveg) != std::string::npos;
+        int e = szoveg->compare(c.szoveg);
+        return teljesul(c.relacio, e < 0 ? -1 : e > 0 ? 1 : 0);
+    }
+    if (MEZOK[c.mezo].tipus == Tipus::Datum && szam == NINCS_DATUM)
+        return false;
+    return teljesul(c.relacio, szam < c.szam ? -1 : szam > c.szam ? 1 : 0);
+}
+
+/// Az elem megfelel-e a szurolanc minden tagjanak (az elso hamis tagnal megall).
+/// @param elem - Az auto vagy ugyfel indexe
+/// @param k - A vegrehajtasi kornyezet
+/// @return - true, ha minden tag teljesul
+bool Lekerdezes::megfelel(size_t elem, const Kornyezet& k) const {
+    for (size_t i = 0; i < szurok.size(); i++)
+        if (!kiertekel(szurok[i], elem, k))
+            return false;
+    return true;
+}
+
+
+
+/*-------------------------------------------
+                Lekerdezesek
+-------------------------------------------*/
+/// A lekerdezes vegrehajtasa.
+/// Eloszor a hozzaferesi mod szerint eloallnak a jeloltek (kulcs szerinti egyezesnel az adatbazis
+/// indexeibol, bejaras nelkul), majd mindegyiken lefut a szurolanc.
+/// @param db - Az adatbazis
+/// @return - A talalatok indexei a getAutok(), illetve getUgyfelek() tombben, novekvo sorrendben
+Vector<size_t> Lekerdezes::futtat(const SzervizNyilvantartoRendszer& db) const {
+    Kornyezet k(db);
+    if (oszloposKell)
+        k.kitolt();
+
+    Vector<size_t> ki;
+    const Vector<Auto>& autok = db.getAutok();
+    const Vector<Ugyfel>& ugyfelek = db.getUgyfelek();
+    switch (hozzaferes) {
+    case LekerdezesHozzaferes::Rendszam: {
+        const size_t i = db.autoSorszam(kulcs);
+        if (i < autok.size() && megfelel(i, k)) ki.push_back(i);
+        break;
+    }
+    case LekerdezesHozzaferes::Nev: {
+        const size_t i = db.ugyfelSorszam(kulcs);
+        if (i < ugyfelek.size() && megfelel(i, k)) ki.push_back(i);
+        break;
+    }
+    case LekerdezesHozzaferes::Tulajdonos: {
+        const std::vector<size_t>& jeloltek = db.tulajdonosAutoSorszamai(kulcs);
+        for (size_t j = 0; j < jeloltek.size(); j++)
+            if (megfelel(jeloltek[j], k))
+                ki.push_back(jeloltek[j]);
+        break;
+    }
+    case LekerdezesHozzaferes::Teljes: {
+        const size_t n = cel == LekerdezesCel::Auto ? autok.size() : ugyfelek.size();
+        for (size_t i = 0; i < n; i++)
+            if (megfelel(i, k))
+                ki.push_back(i);
+        break;
+    }
+    }
+    return ki;
+}
\ No newline at end of file
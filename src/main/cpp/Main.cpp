@@ -3,10 +3,46 @@
  *  Ez a fajl az autoszerviz nyilvantarto rendszer belepesi pontja.
  */
 
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <iostream>
+
 #include "Applikacio.h"
+#include "SzalKeszlet.h"
+
+/// A parancssori kapcsolok leirasa.
+static int hasznalat(const char* program) {
+    std::cerr << "Hasznalat: " << program << " [--threads <n>] [--server <unix:ut | cim:port> [--journal <fajl>] | --batch <fajl | ->]" << std::endl;
+    return 2;
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     Applikacio app;
+    // Kapcsolok: --threads <n> (a kozos szalkeszlet merete, 0: ahany hardverszal),
+    // szerver mod: --server unix:/tmp/szerviz.sock | --server 127.0.0.1:7070 [--journal naplo.txt],
+    // kotegelt mod: --batch parancsok.txt | --batch - (standard bemenet)
+    std::string szerverCim, naploFajl, kotegForras;
+    for (int i = 1; i < argc; i++) {
+        const bool vanErtek = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && vanErtek) {
+            char* veg = nullptr;
+            const unsigned long n = std::strtoul(argv[++i], &veg, 10);
+            if (*argv[i] == '\0' || *veg != '\0' || n > 1024) return hasznalat(argv[0]);
+            SzalKeszlet::beallitAlapertelmezettSzalszam(n);
+        }
+        else if (std::strcmp(argv[i], "--server") == 0 && vanErtek) szerverCim = argv[++i];
+        else if (std::strcmp(argv[i], "--journal") == 0 && vanErtek) naploFajl = argv[++i];
+        else if (std::strcmp(argv[i], "--batch") == 0 && vanErtek) kotegForras = argv[++i];
+        else return hasznalat(argv[0]);
+    }
+    if (!naploFajl.empty() && szerverCim.empty()) return hasznalat(argv[0]);
+    if (!kotegForras.empty() && !szerverCim.empty()) return hasznalat(argv[0]);
+    if (!kotegForras.empty())
+        return app.koteg(kotegForras) ? 0 : 1;
+    if (!szerverCim.empty())
+        return app.szerver(szerverCim, naploFajl) ? 0 : 1;
+
     if (app.applikacio()) {
         return 0; // korrekt kilps
     }
@@ -15,6 +15,8 @@
 #include <limits>   // numeric_limits
 #include <cstdio>   // getchar()
 #include <iomanip>
+#include <stdexcept>
+#include <functional>
 
 #include "MainSegedFuggvenyek.h"
 #include "SzervizNyilvantartoRendszer.h"
@@ -24,6 +26,8 @@
 #include "Karbantartas.h"
 #include "Javitas.h"
 #include "Teszt.h"
+#include "Lekerdezes.h"
+#include "KimenetiPuffer.h"
 
 /*-------------------------------------------
              Menu rendszerhez
@@ -109,11 +113,7 @@ void MainSegedFuggvenyei::varakozasTorol() {
 /// @param rendszam - A vizsgalt rendszam.
 /// @return - true, ha a formatum helyes, false, ha helytelen.
 bool MainSegedFuggvenyei::helyesRendszamFormatum(const std::string& rendszam) {
-    if (rendszam.length() != 6)
-        return false;
-
-    return isupper(rendszam[0]) && isupper(rendszam[1]) && isupper(rendszam[2]) &&
-        isdigit(rendszam[3]) && isdigit(rendszam[4]) && isdigit(rendszam[5]);
+    return SzervizNyilvantartoRendszer::helyesRendszam(rendszam);
 }
 
 /// Ellenorzi, hogy a megadott fajl letezik-e.
@@ -135,7 +135,7 @@ Datum MainSegedFuggvenyei::bekerDatum() {
         std::cout << "\tAdd meg a datumot (ev honap nap): ";
         std::cin >> ev >> ho >> nap;
 
-        if (ev >= 1000 && ev <= 3000 && ho >= 1 && ho <= 12 && nap >= 1 && nap <= 31) {
+        if (std::cin && ev >= 1000 && ev <= 3000 && Datum::ervenyes(ev, ho, nap)) {
             break;
         }
         else {
@@ -205,16 +205,49 @@ void MainSegedFuggvenyei::fajlMuveletFuttato(MuveletAllapot(MainSegedFuggvenyei:
 /*-------------------------------------------
             1. menuponthoz
 -------------------------------------------*/
+static const size_t LISTA_LAPMERET = 100;   ///< Egy lapon ennyi auto vagy ugyfel jelenik meg
+
+/// Lista lapozott kiirasa. Egy lap egy KimenetiPuffer-be keszul, es egy blokkban kerul a terminalra;
+/// ha tobb lap van, a kovetkezo Enterre jon, egy sorszam megadasa oda ugrik, a 'q' pedig kilep.
+/// @param osszes - Az elemek szama
+/// @param lap - (folyam, tol, db) -> a kovetkezo kurzor; kiirja a [tol, tol + db) elemeket
+static void lapozottListazas(size_t osszes, const std::function<size_t(std::ostream&, size_t, size_t)>& lap) {
+    KimenetiPuffer puffer(std::cout);
+    size_t kurzor = 0;
+    while (kurzor < osszes) {
+        kurzor = lap(puffer.folyam(), kurzor, LISTA_LAPMERET);
+        if (kurzor >= osszes) break;
+        puffer.folyam() << "\t--- " << kurzor << " / " << osszes
+            << " --- Enter: kovetkezo lap, sorszam: ugras, 'q': vissza --- ";
+        puffer.kiurit();
+
+        std::string valasz;
+        if (!std::getline(std::cin, valasz) || valasz == "q") break;
+        char* veg = nullptr;
+        const unsigned long sorszam = std::strtoul(valasz.c_str(), &veg, 10);
+        if (!valasz.empty() && *veg == '\0' && sorszam >= 1)
+            kurzor = sorszam - 1 < osszes ? static_cast<size_t>(sorszam - 1) : osszes - 1;
+    }
+    puffer.kiurit();
+}
+
 /// Listazza az ugyfeleket vagy az autokat a megadott adatbazisbol.
+/// A cel utan szuro kifejezes is megadhato, pl. auto marka = "Toyota" and kmOra > 200000 (lasd Lekerdezes.h).
 /// @param aDB - A szerviz nyilvantarto rendszer, amely tartalmazza az ugyfeleket es autokat.
 /// @return - true, ha a kiiras sikeres volt, false, ha a felhasznalo kilepett.
 MuveletAllapot MainSegedFuggvenyei::kiListazo(SzervizNyilvantartoRendszer& aDB) {
-    std::string mitKerj;
+    const SzervizNyilvantartoRendszer& cDB = aDB;   // csak olvas: a nem konstans getterek elavultta tennek a szarmaztatott adatokat
+    std::string bemenet;
     while (true) {
         toroloMajdCim();
 
-        std::cout << "\tAdd meg a ki listazando adatbazist ('ugyfel', 'auto' vagy 'exit' a kilepeshez): ";
-        std::getline(std::cin, mitKerj);
+        std::cout << "\tAdd meg a ki listazando adatbazist ('ugyfel', 'auto' vagy 'exit' a kilepeshez),\n"
+            << "\tszureshez a cel utan egy feltetelt (pl. auto marka = \"Toyota\" and kmOra > 200000): ";
+        std::getline(std::cin, bemenet);
+
+        size_t szokoz = bemenet.find(' ');
+        std::string mitKerj = bemenet.substr(0, szokoz);
+        std::string szuro = szokoz == std::string::npos ? "" : bemenet.substr(szokoz + 1);
 
         if (mitKerj == "exit")
             return MuveletAllapot::Kilepes;
@@ -225,26 +258,54 @@ MuveletAllapot MainSegedFuggvenyei::kiListazo(SzervizNyilvantartoRendszer& aDB)
             continue;
         }
 
+        if (szuro.find_first_not_of(' ') != std::string::npos) {
+            try {
+                Lekerdezes l(szuro, mitKerj == "auto" ? LekerdezesCel::Auto : LekerdezesCel::Ugyfel);
+                Vector<size_t> talalatok = l.futtat(aDB);
+                std::cout << "\n\t--- Szurt " << (mitKerj == "auto" ? "autok" : "ugyfelek") << " (" << talalatok.size() << " talalat) ---\n";
+                const bool autok = mitKerj == "auto";
+                lapozottListazas(talalatok.size(), [&](std::ostream& os, size_t tol, size_t db) {
+                    const size_t ig = db < talalatok.size() - tol ? tol + db : talalatok.size();
+                    for (size_t i = tol; i < ig; i++) {
+                        if (autok)
+                            cDB.getAutok()[talalatok[i]].kiir(os);
+                        else
+                            cDB.getUgyfelek()[talalatok[i]].kiir(os);
+                    }
+                    return ig;
+                });
+            }
+            catch (const std::invalid_argument& e) {
+                std::cout << "\n\t" << e.what();
+                varakozasEnterre("\n\tNyomj Entert a folytatashoz...");
+                continue;
+            }
+            varakozasTorol();
+            return MuveletAllapot::Siker;
+        }
+
         if (mitKerj == "ugyfel") {
             std::cout << "\n\t--- Ugyfelek adatai ---\n";
-            if (aDB.getUgyfelek().empty()) {
+            if (cDB.getUgyfelek().empty()) {
                 std::cout << "\tNincsenek ugyfelek a rendszerben!\n";
                 varakozasTorol();
                 return MuveletAllapot::Siker;
             }
-            for (const auto& ugyfel : aDB.getUgyfelek())
-                std::cout << ugyfel;
+            lapozottListazas(cDB.getUgyfelek().size(), [&aDB](std::ostream& os, size_t tol, size_t db) {
+                return aDB.listazUgyfelek(os, tol, db);
+            });
             varakozasTorol();
         }
         else if (mitKerj == "auto") {
             std::cout << "\n\t--- Autok adatai ---\n";
-            if (aDB.getAutok().empty()) {
+            if (cDB.getAutok().empty()) {
                 std::cout << "\tNincsenek autok a rendszerben!\n";
                 varakozasTorol();
                 return MuveletAllapot::Siker;
             }
-            for (const auto& autok : aDB.getAutok())
-                std::cout << autok;
+            lapozottListazas(cDB.getAutok().size(), [&aDB](std::ostream& os, size_t tol, size_t db) {
+                return aDB.listazAutok(os, tol, db);
+            });
             varakozasTorol();
         }
         return MuveletAllapot::Siker;
@@ -416,7 +477,8 @@ MuveletAllapot MainSegedFuggvenyei::ugyfelAutoFrissit(SzervizNyilvantartoRendsze
                 break;
             }
 
-            Auto a = aDB.keresAuto(rendszam);
+            const SzervizNyilvantartoRendszer& cDB = aDB;   // a masolatot a frissitAuto irja vissza
+            Auto a = cDB.keresAuto(rendszam);
 
             int km;
             while (true) {
@@ -424,9 +486,10 @@ MuveletAllapot MainSegedFuggvenyei::ugyfelAutoFrissit(SzervizNyilvantartoRendsze
                 std::cout << "\tAdd meg az uj kilometerora allast: ";
                 std::cin >> km;
 
-                if (a.getSzervizMuveletek().back()->getAktKmOra() >= km) {
+                const SzervizRekordLista& muveletek = a.getSzervizRekordok();
+                if (!muveletek.empty() && muveletek.back().akt_kmOra >= km) {
                     std::cout << "\n\tNem lehet kisebb a km ora allasa mint az ami a legutolso szerviznel lett rogzitve!";
-                    std::cout << "\n\tLegutolso szerviz km ora allasa: " << a.getSzervizMuveletek().back()->getAktKmOra() << std::endl;
+                    std::cout << "\n\tLegutolso szerviz km ora allasa: " << muveletek.back().akt_kmOra << std::endl;
                     varakozasEnterre("\n\tNyomj Entert a folytatashoz...");
                     continue;
                 }
@@ -529,6 +592,17 @@ MuveletAllapot MainSegedFuggvenyei::ugyfelKereses(SzervizNyilvantartoRendszer& a
         std::cout << "\t--- Ugyfel adatai ---\n";
         std::cout << ugyfelRef;
 
+        const UgyfelOsszesito& osszesito = aDB.getUgyfelOsszesito(nev);
+        std::cout << "\t--- Osszesites ---\n"
+            << "\tAutok szama: " << osszesito.autokSzama << "\n"
+            << "\tSzervizmuveletek szama: " << osszesito.muveletekSzama << "\n"
+            << "\tOsszes koltes: " << osszesito.koltes << " Ft\n"
+            << "\tUtolso latogatas: ";
+        if (osszesito.muveletekSzama > 0)
+            std::cout << osszesito.utolsoLatogatas << "\n";
+        else
+            std::cout << "nincs\n";
+
         varakozasTorol();
         return MuveletAllapot::Siker;
     }
@@ -563,7 +637,8 @@ MuveletAllapot MainSegedFuggvenyei::autoKereses(SzervizNyilvantartoRendszer& aDB
         }
 
         toroloMajdCim();
-        const Auto& autoRef = aDB.keresAuto(rendszam);
+        const SzervizNyilvantartoRendszer& cDB = aDB;
+        const Auto& autoRef = cDB.keresAuto(rendszam);
         std::cout << "\t--- Auto adatai ---\n";
         std::cout << autoRef;
 
@@ -604,7 +679,7 @@ MuveletAllapot MainSegedFuggvenyei::ujSzervizMuvelet(SzervizNyilvantartoRendszer
         }
 
         std::string rendszam;
-        Auto* talaltAuto = nullptr;
+        const Auto* talaltAuto = nullptr;
         while (true) {
             rendszam = sorBeker("\tAdd meg az auto rendszamat (pelda: 'ABC123'): ");
 
@@ -620,7 +695,8 @@ MuveletAllapot MainSegedFuggvenyei::ujSzervizMuvelet(SzervizNyilvantartoRendszer
                 return MuveletAllapot::Hiba;
             }
 
-            talaltAuto = &aDB.keresAuto(rendszam);  // pointerknt troljuk
+            const SzervizNyilvantartoRendszer& cDB = aDB;   // csak olvassuk, a rogzites a rendszeren at tortenik
+            talaltAuto = &cDB.keresAuto(rendszam);  // pointerknt troljuk
             break;
         }
 
@@ -638,36 +714,35 @@ MuveletAllapot MainSegedFuggvenyei::ujSzervizMuvelet(SzervizNyilvantartoRendszer
             std::cout << "\tAdd meg az aktualis km ora allast: ";
             std::cin >> km;
 
-            const auto& muveletek = talaltAuto->getSzervizMuveletek();
-            if (!muveletek.empty() && muveletek.back()->getAktKmOra() > km) {
+            const SzervizRekordLista& muveletek = talaltAuto->getSzervizRekordok();
+            if (!muveletek.empty() && muveletek.back().akt_kmOra > km) {
                 std::cout << "\n\tNem lehet kisebb a km ora allasa mint az ami a legutolso szerviznel lett rogzitve!";
-                std::cout << "\n\tLegutolso szerviz km ora allasa: " << muveletek.back()->getAktKmOra() << std::endl;
+                std::cout << "\n\tLegutolso szerviz km ora allasa: " << muveletek.back().akt_kmOra << std::endl;
                 varakozasEnterre("\n\tNyomj Entert a folytatashoz...");
                 continue;
             }
 
-            talaltAuto->setKmOra(km);
+            aDB.frissitKmOra(rendszam, km);
             break;
         }
 
-        VegzettMuvelet* ujSzervizMuvelet;
+        SzervizRekord ujSzervizMuvelet;
         if (milyenSzerviz == "vizsga") {
             bool siker;
             toroloMajdCim();
             std::cout << "\tSikeres vizsga? (1 - Igen, 0 - Nem): ";
             std::cin >> siker;
 
-            ujSzervizMuvelet = new Vizsga(muveletLeirasa, datum, ar, km, siker);
+            ujSzervizMuvelet = SzervizRekord(MuveletTipus::Vizsga, muveletLeirasa, datum, ar, km, siker);
         }
         else if (milyenSzerviz == "karbantartas") {
-            ujSzervizMuvelet = new Karbantartas(muveletLeirasa, datum, ar, km);
+            ujSzervizMuvelet = SzervizRekord(MuveletTipus::Karbantartas, muveletLeirasa, datum, ar, km);
         }
         else {
-            ujSzervizMuvelet = new Javitas(muveletLeirasa, datum, ar, km);
+            ujSzervizMuvelet = SzervizRekord(MuveletTipus::Javitas, muveletLeirasa, datum, ar, km);
         }
 
-        aDB.rogzitesVegzettMuvelet(rendszam, *ujSzervizMuvelet);
-        delete ujSzervizMuvelet;
+        aDB.rogzitesVegzettMuvelet(rendszam, ujSzervizMuvelet);
         return MuveletAllapot::Siker;
     }
     return MuveletAllapot::Hiba;
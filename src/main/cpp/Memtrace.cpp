@@ -24,6 +24,9 @@ typo:       2019.
 
 #define FROM_MEMTRACE_CPP
 #include "memtrace.h"
+#ifdef __cplusplus
+#include <mutex>
+#endif
 
 #define FMALLOC 0
 #define FCALLOC 1
@@ -180,6 +183,16 @@ static void die(const char* msg, void* p, size_t size, call_t* a, call_t* d) {
 }
 
 static void initialize();
+
+/* tobbszalu hasznalathoz: a nyilvantartast (registry, szamlalo) egyszerre csak egy szal modosithatja */
+#ifdef __cplusplus
+static std::mutex registry_mutex;
+#define REGISTRY_LOCK std::unique_lock<std::mutex> registry_lock(registry_mutex)
+#define REGISTRY_UNLOCK registry_lock.unlock()
+#else
+#define REGISTRY_LOCK
+#define REGISTRY_UNLOCK
+#endif
 END_NAMESPACE
 
 /*******************************************************************/
@@ -212,6 +225,7 @@ static void print_registry_item(registry_item* p) {
 int mem_check(void) {
 	initialize();
 	if (dying) return  2;    /* cimzesi hiba */
+	REGISTRY_LOCK;
 
 	if (registry.next) {
 		/*szivarog*/
@@ -249,6 +263,7 @@ int allocated_blocks() { return allocated_blks; }
 
 static BOOL register_memory(void* p, size_t size, call_t call) {
 	initialize();
+	REGISTRY_LOCK;
 	allocated_blks++;
 #ifdef MEMTRACE_TO_FILE
 	fprintf(trace_file, "%p\t%d\t%s%s", PU(p), (int)size, pretty[call.f], call.par_txt ? call.par_txt : "?");
@@ -281,6 +296,7 @@ static registry_item* find_registry_item(void* p) {
 
 static void unregister_memory(void* p, call_t call) {
 	initialize();
+	REGISTRY_LOCK;
 #ifdef MEMTRACE_TO_FILE
 	fprintf(trace_file, "%p\t%d\t%s%s", PU(p), -1, pretty[call.f], call.par_txt ? call.par_txt : "?");
 	if (call.f <= 3) fprintf(trace_file, ")");
@@ -296,6 +312,7 @@ static void unregister_memory(void* p, call_t call) {
 			n->next = r->next;
 			if (COMP(r->call.f, call.f)) {
 				int chk = chk_canary(r->p, r->size);
+				if (chk != 0) REGISTRY_UNLOCK; /* a kilepeskori felszabaditasok ne akadjanak el */
 				if (chk < 0)
 					die("Blokk elott serult a memoria:", r->p, r->size, &r->call, &call);
 				if (chk > 0)
@@ -311,10 +328,12 @@ static void unregister_memory(void* p, call_t call) {
 			}
 			else {
 				/*hibas felszabaditas*/
+				REGISTRY_UNLOCK;
 				die("Hibas felszabaditas:", r->p, r->size, &r->call, &call);
 			}
 		}
 		else {
+			REGISTRY_UNLOCK;
 			die("Nem letezo, vagy mar felszabaditott adat felszabaditasa:", p, 0, NULL, &call);
 		}
 	} /*C-blokk*/
@@ -387,8 +406,11 @@ void* traced_realloc(void* old, size_t size, const char* par_txt, int line, cons
 	initialize();
 
 #ifdef MEMTRACE_TO_MEMORY
-	n = find_registry_item(P(old));
-	if (n) oldsize = n->next->size;
+	{/*C-blokk*/
+		REGISTRY_LOCK;
+		n = find_registry_item(P(old));
+		if (n) oldsize = n->next->size;
+	}/*C-blokk*/
 	p = canary_malloc(size, random_byte);
 #else
 	p = realloc(old, size);
@@ -431,8 +453,9 @@ void _set_new_handler(std::new_handler h) {
 	_new_handler = h;
 }
 
-static call_t delete_call;
-static BOOL delete_called;
+/* a delete makro ket lepesben (set_delete_call, majd delete) dolgozik, ezert szalankent kulon tarolando */
+static thread_local call_t delete_call;
+static thread_local BOOL delete_called;
 
 void set_delete_call(int line, const char* file) {
 	initialize();
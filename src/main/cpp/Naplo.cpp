@@ -0,0 +1,77 @@
+/**
+*   \file Naplo.cpp
+*   A modosito parancsok hozzafuzo naplojanak megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <stdexcept>
+#include <iterator>
+
+#include "Naplo.h"
+#include "ParancsVegrehajto.h"
+
+/// Konstruktor. Megnyitja (szukseg eseten letrehozza) a naplofajlt hozzafuzesre.
+/// @param f - A naplofajl neve
+/// @param ufl - Az indulo ugyfelfajl
+/// @param auo - Az indulo autofajl
+Naplo::Naplo(const std::string& f, const std::string& ufl, const std::string& auo)
+    : fajl(f.c_str(), std::ios::out | std::ios::app | std::ios::binary), fajlNev(f), irasok(0) {
+    if (!fajl) throw std::runtime_error("A naplofajl nem nyithato meg: " + f);
+    alapFajlok[0] = ufl;
+    alapFajlok[1] = auo;
+}
+
+/// Az indulo fajlok kozul melyik a megadott.
+/// @param f - A fajl neve
+/// @return - 0 az ugyfelfajlnal, 1 az autofajlnal, -1 egyebkent
+int Naplo::alapFajl(const std::string& f) const {
+    for (int i = 0; i < 2; i++)
+        if (!alapFajlok[i].empty() && alapFajlok[i] == f) return i;
+    return -1;
+}
+
+/// A naplo kiuritese (ellenorzopont).
+void Naplo::csonkit() {
+    fajl.close();
+    fajl.open(fajlNev.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!fajl) throw std::runtime_error("A naplofajl nem nyithato meg: " + fajlNev);
+}
+
+/// Parancssorok hozzafuzese egyetlen irassal.
+/// @param sorok - Egy vagy tobb '\n'-nel lezart parancssor
+void Naplo::ir(const std::string& sorok) {
+    if (sorok.empty()) return;
+    fajl.write(sorok.data(), static_cast<std::streamsize>(sorok.size()));
+    fajl.flush();
+    if (!fajl) throw std::runtime_error("Sikertelen iras a naplofajlba: " + fajlNev);
+    irasok++;
+}
+
+/// A naplo visszajatszasa.
+/// @param f - A naplofajl neve
+/// @param pv - A vegrehajto, amely a parancsokat futtatja
+/// @return - A visszajatszott sorok szama
+size_t Naplo::visszajatszas(const std::string& f, ParancsVegrehajto& pv) {
+    std::ifstream be(f.c_str(), std::ios::in | std::ios::binary);
+    if (!be) return 0;
+    std::string adat((std::istreambuf_iterator<char>(be)), std::istreambuf_iterator<char>());
+    // Egy felbeszakadt utolso iras lezaratlan sorat nem jatsszuk vissza
+    adat.erase(adat.rfind('\n') + 1);
+
+    size_t sorok = 0;
+    for (size_t i = 0; i < adat.size(); i++)
+        if (adat[i] == '\n') sorok++;
+    // A valaszokra nincs szukseg: korlatozott meretu darabokban dolgozzuk fel es eldobjuk oket
+    std::string valasz;
+    size_t poz = 0;
+    while (poz < adat.size()) {
+        valasz.clear();
+        const size_t n = pv.feldolgoz(adat.data() + poz, adat.size() - poz, valasz, 1 << 20);
+        if (n == 0) break;
+        poz += n;
+    }
+    return sorok;
+}
\ No newline at end of file
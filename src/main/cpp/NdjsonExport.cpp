@@ -0,0 +1,267 @@
+/**
+*   \file NdjsonExport.cpp
+*   A folyamos NDJSON export megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "NdjsonExport.h"
+#include "SzervizNyilvantartoRendszer.h"
+
+/// Az escape-elt karakter legnagyobb hossza ("\u001f").
+static const size_t MAX_ESCAPE = 6;
+
+/// A muvelettipus neve a JSON kimenetben.
+/// @param t - A muvelet tipusa
+/// @return - "javitas", "karbantartas" vagy "vizsga"
+static const char* tipusNev(MuveletTipus t) {
+    switch (t) {
+        case MuveletTipus::Karbantartas: return "karbantartas";
+        case MuveletTipus::Vizsga:       return "vizsga";
+        default:                         return "javitas";
+    }
+}
+
+/*-------------------------------------------
+        Konstruktor es destruktor
+-------------------------------------------*/
+/// Konstruktor.
+/// @param c - A celfolyam
+/// @param meret - A tar merete bajtban
+NdjsonExport::NdjsonExport(std::ostream& c, size_t meret)
+    : cel(c), tar(meret < MIN_MERET ? MIN_MERET : meret), poz(tar.data()), veg(tar.data() + tar.size()),
+      ugyfelek(0), autok(0), szervizek(0) {}
+
+/// Destruktor, a maradekot atadja a celfolyamnak.
+NdjsonExport::~NdjsonExport() {
+    try { atad(); }
+    catch (const std::exception&) {}
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// A tar tartalmanak atadasa a celfolyamnak egyetlen irassal.
+/// @throws std::runtime_error - ha a celfolyam hibat jelzett
+void NdjsonExport::atad() {
+    const std::streamsize n = poz - tar.data();
+    poz = tar.data();
+    if (n > 0) cel.write(tar.data(), n);
+    if (!cel) throw std::runtime_error("Az export irasa sikertelen!");
+}
+
+/// Rovid, escape-elest nem igenylo szoveg irasa.
+/// @param s - A szoveg
+/// @param n - A hossza
+void NdjsonExport::nyers(const char* s, size_t n) {
+    hely(n);
+    std::memcpy(poz, s, n);
+    poz += n;
+}
+
+/// Szoveg irasa JSON szovegkent, idezojelek kozott, escape-elve.
+/// Ha a legrosszabb esetben (minden karakter escape-elve) is elfer, karakterenkent nincs helyellenorzes.
+/// @param s - A szoveg
+void NdjsonExport::szoveg(const std::string& s) {
+    static const char hex[] = "0123456789abcdef";
+    const size_t n = s.size();
+    const bool elfer = n <= (tar.size() - 2) / MAX_ESCAPE;
+    hely(elfer ? n * MAX_ESCAPE + 2 : MAX_ESCAPE);
+    *poz++ = '"';
+    for (size_t i = 0; i < n; i++) {
+        if (!elfer) hely(MAX_ESCAPE);
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            *poz++ = static_cast<char>(c);
+            continue;
+        }
+        *poz++ = '\\';
+        switch (c) {
+            case '"':  *poz++ = '"'; break;
+            case '\\': *poz++ = '\\'; break;
+            case '\n': *poz++ = 'n'; break;
+            case '\r': *poz++ = 'r'; break;
+            case '\t': *poz++ = 't'; break;
+            default:
+                poz[0] = 'u'; poz[1] = '0'; poz[2] = '0';
+                poz[3] = hex[c >> 4]; poz[4] = hex[c & 0xf];
+                poz += 5;
+        }
+    }
+    hely(1);
+    *poz++ = '"';
+}
+
+/// Egesz szam irasa.
+/// @param x - A szam
+void NdjsonExport::szam(long long x) {
+    char buf[24];
+    size_t i = sizeof(buf);
+    const bool negativ = x < 0;
+    unsigned long long u = negativ ? 0ULL - static_cast<unsigned long long>(x) : static_cast<unsigned long long>(x);
+    do {
+        buf[--i] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (negativ) buf[--i] = '-';
+    nyers(buf + i, sizeof(buf) - i);
+}
+
+/// Datum irasa "EEEE-HH-NN" JSON szovegkent.
+/// @param d - A datum
+void NdjsonExport::datum(const Datum& d) {
+    hely(Datum::MAX_SZOVEG_HOSSZ + 2);
+    *poz++ = '"';
+    const size_t n = d.formatToBuffer(poz);
+    poz[n - 3] = '-';       // "EEEE.HH.NN" -> "EEEE-HH-NN"
+    poz[n - 6] = '-';
+    poz += n;
+    *poz++ = '"';
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// Egy ugyfel soranak kiirasa.
+/// @param u - Az ugyfel
+void NdjsonExport::ugyfel(const Ugyfel& u) {
+    static const char k1[] = "{\"rekord\":\"ugyfel\",\"nev\":";
+    static const char k2[] = ",\"telefonszam\":";
+    static const char k3[] = ",\"email\":";
+    nyers(k1, sizeof(k1) - 1);
+    szoveg(u.getNev());
+    nyers(k2, sizeof(k2) - 1);
+    szoveg(u.getTelefonszam());
+    nyers(k3, sizeof(k3) - 1);
+    szoveg(u.getEmail());
+    nyers("}\n", 2);
+    ugyfelek++;
+}
+
+/// Egy auto soranak kiirasa (a szervizmuveletei nelkul).
+/// @param a - Az auto
+void NdjsonExport::autoSor(const Auto& a) {
+    static const char k1[] = "{\"rekord\":\"auto\",\"rendszam\":";
+    static const char k2[] = ",\"marka\":";
+    static const char k3[] = ",\"tipus\":";
+    static const char k4[] = ",\"kmOra\":";
+    static const char k5[] = ",\"uzembeHelyezes\":";
+    static const char k6[] = ",\"tulajdonos\":";
+    nyers(k1, sizeof(k1) - 1);
+    szoveg(a.getRendszam());
+    nyers(k2, sizeof(k2) - 1);
+    szoveg(a.getMarka());
+    nyers(k3, sizeof(k3) - 1);
+    szoveg(a.getTipus());
+    nyers(k4, sizeof(k4) - 1);
+    szam(a.getKmOra());
+    nyers(k5, sizeof(k5) - 1);
+    datum(a.getUzembeHelyezes());
+    nyers(k6, sizeof(k6) - 1);
+    if (a.getTulajdonos() != nullptr)
+        szoveg(a.getTulajdonos()->getNev());
+    else
+        nyers("null", 4);
+    nyers("}\n", 2);
+    autok++;
+}
+
+/// Egy szervizmuvelet soranak kiirasa.
+/// @param rendszam - Az auto rendszama
+/// @param r - A muvelet rekordja
+void NdjsonExport::szerviz(const std::string& rendszam, const SzervizRekord& r) {
+    static const char k1[] = "{\"rekord\":\"szerviz\",\"rendszam\":";
+    static const char k2[] = ",\"muveletTipus\":\"";
+    static const char k3[] = "\",\"muvelet\":";
+    static const char k4[] = ",\"datum\":";
+    static const char k5[] = ",\"ar\":";
+    static const char k6[] = ",\"kmOra\":";
+    static const char k7[] = ",\"sikeres\":";
+    nyers(k1, sizeof(k1) - 1);
+    szoveg(rendszam);
+    nyers(k2, sizeof(k2) - 1);
+    const char* t = tipusNev(r.tipus);
+    nyers(t, std::strlen(t));
+    nyers(k3, sizeof(k3) - 1);
+    szoveg(r.muvelet);
+    nyers(k4, sizeof(k4) - 1);
+    datum(r.idopont);
+    nyers(k5, sizeof(k5) - 1);
+    szam(r.ar);
+    nyers(k6, sizeof(k6) - 1);
+    szam(r.akt_kmOra);
+    if (r.tipus == MuveletTipus::Vizsga) {
+        nyers(k7, sizeof(k7) - 1);
+        if (r.sikeres) nyers("true", 4);
+        else nyers("false", 5);
+    }
+    nyers("}\n", 2);
+    szervizek++;
+}
+
+/// Az egesz rendszer exportja.
+/// @param db - A rendszer
+void NdjsonExport::adatbazis(const SzervizNyilvantartoRendszer& db) {
+    const Vector<Ugyfel>& u = db.getUgyfelek();
+    for (size_t i = 0; i < u.size(); i++)
+        ugyfel(u[i]);
+    const Vector<Auto>& a = db.getAutok();
+    for (size_t i = 0; i < a.size(); i++) {
+        autoSor(a[i]);
+        const SzervizRekordLista& l = a[i].getSzervizRekordok();
+        for (size_t j = 0; j < l.size(); j++)
+            szerviz(a[i].getRendszam(), l[j]);
+    }
+}
+
+/// Szurt export.
+/// @param db - A rendszer
+/// @param szuro - A szuro kifejezes
+/// @param c - Autokra vagy ugyfelekre vonatkozik
+void NdjsonExport::adatbazis(const SzervizNyilvantartoRendszer& db, const std::string& szuro, LekerdezesCel c) {
+    const Vector<size_t> talalatok = Lekerdezes(szuro, c).futtat(db);
+    const Vector<Ugyfel>& u = db.getUgyfelek();
+    const Vector<Auto>& a = db.getAutok();
+
+    // A kiirando ugyfelek: a talalatok, illetve a talalt autok tulajdonosai
+    std::unordered_set<const Ugyfel*> ugyfelHalmaz;
+    for (size_t i = 0; i < talalatok.size(); i++)
+        ugyfelHalmaz.insert(c == LekerdezesCel::Ugyfel ? &u[talalatok[i]] : a[talalatok[i]].getTulajdonos());
+    for (size_t i = 0; i < u.size(); i++)
+        if (ugyfelHalmaz.count(&u[i]) != 0) ugyfel(u[i]);
+
+    // A kiirando autok: a talalatok, illetve a talalt ugyfelek autoi
+    size_t t = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        bool kell;
+        if (c == LekerdezesCel::Auto) {
+            kell = t < talalatok.size() && talalatok[t] == i;
+            if (kell) t++;
+        }
+        else
+            kell = ugyfelHalmaz.count(a[i].getTulajdonos()) != 0;
+        if (!kell) continue;
+        autoSor(a[i]);
+        const SzervizRekordLista& l = a[i].getSzervizRekordok();
+        for (size_t j = 0; j < l.size(); j++)
+            szerviz(a[i].getRendszam(), l[j]);
+    }
+}
+
+/// A tar atadasa es a celfolyam uritese.
+/// @throws std::runtime_error - ha a celfolyam hibat jelzett
+void NdjsonExport::kiurit() {
+    atad();
+    cel.flush();
+    if (!cel) throw std::runtime_error("Az export irasa sikertelen!");
+}
\ No newline at end of file
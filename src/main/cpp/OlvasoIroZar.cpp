@@ -0,0 +1,88 @@
+/**
+*   \file OlvasoIroZar.cpp
+*   Az olvaso-iro zar es a savozott olvasoszamlalo megvalositasa.
+*
+*   A belepesek es a jelzesek alapertelmezett (szekvencialisan konzisztens) atomi muveletek: az olvaso a sajat
+*   savjanak novelese utan nezi meg az iro jelzeset, az iro a jelzes utan nezi a savokat, igy a ketto
+*   kozul legalabb az egyik mindig latja a masikat.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <thread>
+
+#include "OlvasoIroZar.h"
+
+/*-------------------------------------------
+              OlvasoSzamlalo
+-------------------------------------------*/
+/// A hivo szal savjanak sorszama (szalankent egyszer osztodik ki, korbeforgo modon).
+/// @return - 0 <= sav < SAVOK
+size_t OlvasoSzamlalo::sajatSav() {
+    static std::atomic<size_t> kovetkezo(0);
+    static thread_local size_t sav = kovetkezo.fetch_add(1, std::memory_order_relaxed) % SAVOK;
+    return sav;
+}
+
+/// Megvarja, amig a korszak minden savja legalabb egyszer nullanak latszik.
+/// @param k - A korszak
+void OlvasoSzamlalo::korszakKiurulesereVar(unsigned k) const {
+    for (size_t i = 0; i < SAVOK; i++)
+        while (savok[i].db[k].load() != 0)
+            std::this_thread::yield();
+}
+
+/// Megvarja, amig minden sav mindket korszakban legalabb egyszer nullanak latszik.
+void OlvasoSzamlalo::kiurulesreVar() const {
+    korszakKiurulesereVar(0);
+    korszakKiurulesereVar(1);
+}
+
+/// Turelmi ido: korszakvaltas es a regi korszak kiurulese, ketszer.
+/// Az elso valtas elott belepett olvaso vagy az elso, vagy (ha a korszak kiolvasasa utan kesleltetodott)
+/// a masodik varakozasban szerepel; ha a novelese mindkettonel kesobbi, mar az iro uj allapotat latja.
+void OlvasoSzamlalo::turelmiIdo() {
+    for (int i = 0; i < 2; i++) {
+        const unsigned regi = korszak.load();
+        korszak.store(regi ^ 1u);
+        korszakKiurulesereVar(regi);
+    }
+}
+
+
+
+/*-------------------------------------------
+               OlvasoIroZar
+-------------------------------------------*/
+/// Megosztott (olvasasi) zarolas. Ha iro var vagy dolgozik, a hivo blokkolodik.
+/// A gyors ut egyetlen atomi noveles a sajat savon; a zar (mutex) csak iro jelenleteben kell.
+void OlvasoIroZar::olvasoZarol() {
+    while (true) {
+        const unsigned k = olvasok.belep();
+        if (!iroVar.load())
+            return;
+        olvasok.kilep(k);
+
+        std::unique_lock<std::mutex> z(jelzesZar);
+        iroTavozott.wait(z, [this] { return !iroVar.load(); });
+    }
+}
+
+/// Kizarolagos (irasi) zarolas: megvarja a bent levo olvasokat, az ujakat feltartja.
+void OlvasoIroZar::iroZarol() {
+    irokZar.lock();
+    iroVar.store(true);
+    olvasok.kiurulesreVar();
+}
+
+/// A kizarolagos zar elengedese, a varakozo olvasok felebresztese.
+void OlvasoIroZar::iroElenged() {
+    {
+        std::lock_guard<std::mutex> z(jelzesZar);
+        iroVar.store(false);
+    }
+    iroTavozott.notify_all();
+    irokZar.unlock();
+}
\ No newline at end of file
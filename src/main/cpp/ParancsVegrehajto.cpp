@@ -0,0 +1,632 @@
+/**
+*   \file ParancsVegrehajto.cpp
+*   A soralapu parancsok ertelmezesenek es vegrehajtasanak megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <fstream>
+#include <vector>
+
+#include "ParancsVegrehajto.h"
+#include "Naplo.h"
+#include "SzervizNyilvantartoRendszer.h"
+#include "Lekerdezes.h"
+#include "NdjsonExport.h"
+
+typedef ParancsVegrehajto::Mezo Mezo;
+
+/*-------------------------------------------
+        Mezok ertelmezese es valasz irasa
+-------------------------------------------*/
+/// A mezo szovegkent.
+static std::string szoveg(const Mezo& m) {
+    return std::string(m.p, m.n);
+}
+
+/// Egyezik-e a mezo a megadott szoveggel.
+static bool egyenlo(const Mezo& m, const char* s) {
+    const size_t n = std::strlen(s);
+    return m.n == n && std::memcmp(m.p, s, n) == 0;
+}
+
+/// Nemnegativ egesz szam ertelmezese.
+/// @param m - A mezo
+/// @param nev - A mezo neve a hibauzenethez
+/// @return - A szam
+/// @throws std::invalid_argument - ha a mezo nem nemnegativ egesz, vagy nem fer el int-ben
+static int egesz(const Mezo& m, const char* nev) {
+    if (m.n == 0 || m.n > 9) throw std::invalid_argument(std::string("Hibas ") + nev + ": " + szoveg(m));
+    int x = 0;
+    for (size_t i = 0; i < m.n; i++) {
+        const unsigned d = static_cast<unsigned>(m.p[i] - '0');
+        if (d > 9) throw std::invalid_argument(std::string("Hibas ") + nev + ": " + szoveg(m));
+        x = x * 10 + static_cast<int>(d);
+    }
+    return x;
+}
+
+/// Datum ertelmezese (EEEE.HH.NN).
+/// @param m - A mezo
+/// @return - A datum
+/// @throws std::invalid_argument - ha a mezo nem ervenyes datum
+static Datum datum(const Mezo& m) {
+    Datum d;
+    if (m.n > Datum::MAX_SZOVEG_HOSSZ || !Datum::parseMezo(m.p, m.n, d))
+        throw std::invalid_argument("Hibas datum: " + szoveg(m));
+    return d;
+}
+
+/// A mentesi formatumba irhato szovegmezo (lasd SzervizNyilvantartoRendszer::helyesSzoveg).
+/// @param m - A mezo
+/// @param nev - A mezo neve a hibauzenethez
+/// @param uresLehet - Lehet-e ures a mezo
+/// @return - A mezo szovegkent
+/// @throws std::invalid_argument - ha a mezo mezohatarolo jelet tartalmaz, vagy tiltottan ures
+static std::string menthetoSzoveg(const Mezo& m, const char* nev, bool uresLehet = true) {
+    std::string s = szoveg(m);
+    if ((!uresLehet && s.empty()) || !SzervizNyilvantartoRendszer::helyesSzoveg(s))
+        throw std::invalid_argument(std::string("Hibas ") + nev + ": " + s);
+    return s;
+}
+
+/// Egesz szam hozzafuzese (atmeneti string nelkul).
+static void szamHozzafuz(std::string& ki, long long x) {
+    char buf[24];
+    size_t i = sizeof(buf);
+    const bool negativ = x < 0;
+    unsigned long long u = negativ ? 0ULL - static_cast<unsigned long long>(x) : static_cast<unsigned long long>(x);
+    do {
+        buf[--i] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (negativ) buf[--i] = '-';
+    ki.append(buf + i, sizeof(buf) - i);
+}
+
+/// Datum hozzafuzese EEEE.HH.NN formatumban.
+static void datumHozzafuz(std::string& ki, const Datum& d) {
+    char buf[Datum::MAX_SZOVEG_HOSSZ];
+    ki.append(buf, d.formatToBuffer(buf));
+}
+
+/// A valasz elso sora: "OK <n>".
+static void ok(std::string& ki, size_t n) {
+    ki += "OK ";
+    szamHozzafuz(ki, static_cast<long long>(n));
+    ki += '\n';
+}
+
+/// Az auto keresese rendszam alapjan (konstans, a szarmaztatott adatokat nem erinti).
+/// @throws std::runtime_error - ha nincs ilyen auto
+static const Auto& autoKeres(const SzervizNyilvantartoRendszer& db, const Mezo& r) {
+    const Vector<Auto>& autok = db.getAutok();
+    for (size_t i = 0; i < autok.size(); i++) {
+        const std::string& rendszam = autok[i].getRendszam();
+        if (rendszam.size() == r.n && std::memcmp(rendszam.data(), r.p, r.n) == 0)
+            return autok[i];
+    }
+    throw std::runtime_error("Nincs ilyen rendszamu auto!");
+}
+
+
+
+/*-------------------------------------------
+            Parancskezelok
+-------------------------------------------*/
+/// ping
+static void ping(SzervizNyilvantartoRendszer&, const Mezo*, size_t, std::string& ki, std::string*) {
+    ok(ki, 0);
+}
+
+/// ugyfel_uj <nev> <telefon> <email>
+static void ugyfelUj(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    if (!db.ujUgyfel(Ugyfel(menthetoSzoveg(m[1], "nev", false), menthetoSzoveg(m[2], "telefonszam"), szoveg(m[3]))))
+        throw std::runtime_error("Mar letezik ilyen nevu ugyfel!");
+    ok(ki, 0);
+}
+
+/// ugyfel_frissit <nev> <telefon> <email>
+static void ugyfelFrissit(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    if (!db.frissitUgyfel(Ugyfel(szoveg(m[1]), menthetoSzoveg(m[2], "telefonszam"), szoveg(m[3]))))
+        throw std::runtime_error("Nincs ilyen nevu ugyfel!");
+    ok(ki, 0);
+}
+
+/// ugyfel_torol <nev>
+static void ugyfelTorol(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    if (!db.torolUgyfel(szoveg(m[1])))
+        throw std::runtime_error("Nincs ilyen nevu ugyfel!");
+    ok(ki, 0);
+}
+
+/// ugyfel <nev>
+static void ugyfelLekerdez(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    const SzervizNyilvantartoRendszer& cdb = db;
+    const std::string nev = szoveg(m[1]);
+    const Vector<Ugyfel>& ugyfelek = cdb.getUgyfelek();
+    for (size_t i = 0; i < ugyfelek.size(); i++) {
+        if (ugyfelek[i].getNev() != nev) continue;
+        const UgyfelOsszesito& o = cdb.getUgyfelOsszesito(nev);
+        ok(ki, 1);
+        ki += nev; ki += '\t';
+        ki += ugyfelek[i].getTelefonszam(); ki += '\t';
+        ki += ugyfelek[i].getEmail(); ki += '\t';
+        szamHozzafuz(ki, static_cast<long long>(o.autokSzama)); ki += '\t';
+        szamHozzafuz(ki, static_cast<long long>(o.muveletekSzama)); ki += '\t';
+        szamHozzafuz(ki, o.koltes); ki += '\t';
+        if (o.muveletekSzama > 0) datumHozzafuz(ki, o.utolsoLatogatas);
+        else ki += '-';
+        ki += '\n';
+        return;
+    }
+    throw std::runtime_error("Nincs ilyen nevu ugyfel!");
+}
+
+/// auto_uj <rendszam> <marka> <tipus> <km> <uzembe helyezes> <tulajdonos>
+static void autoUj(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    const std::string rendszam = szoveg(m[1]);
+    if (!SzervizNyilvantartoRendszer::helyesRendszam(rendszam))
+        throw std::invalid_argument("Hibas rendszam: " + rendszam);
+    const std::string marka = menthetoSzoveg(m[2], "marka");
+    const std::string tipus = menthetoSzoveg(m[3], "tipus");
+    const int km = egesz(m[4], "km");
+    const Datum uzembe = datum(m[5]);
+    Ugyfel& tulajdonos = db.keresUgyfel(szoveg(m[6]));
+    if (!db.ujAuto(Auto(rendszam, marka, tipus, km, uzembe, SzervizRekordLista(), &tulajdonos)))
+        throw std::runtime_error("Mar letezik ilyen rendszamu auto!");
+    ok(ki, 0);
+}
+
+/// km <rendszam> <km>
+static void kmFrissit(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    const int km = egesz(m[2], "km");
+    const Auto& a = autoKeres(db, m[1]);
+    if (km < a.getKmOra())
+        throw std::invalid_argument("A km ora allasa nem csokkenhet!");
+    db.frissitKmOra(a.getRendszam(), km);
+    ok(ki, 0);
+}
+
+/// auto_torol <rendszam>
+static void autoTorol(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    if (!db.torolAuto(szoveg(m[1])))
+        throw std::runtime_error("Nincs ilyen rendszamu auto!");
+    ok(ki, 0);
+}
+
+/// auto <rendszam>
+static void autoLekerdez(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    const Auto& a = autoKeres(db, m[1]);
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    ok(ki, 1 + rekordok.size());
+    ki += a.getRendszam(); ki += '\t';
+    ki += a.getMarka(); ki += '\t';
+    ki += a.getTipus(); ki += '\t';
+    szamHozzafuz(ki, a.getKmOra()); ki += '\t';
+    datumHozzafuz(ki, a.getUzembeHelyezes()); ki += '\t';
+    if (a.getTulajdonos() != nullptr) ki += a.getTulajdonos()->getNev();
+    ki += '\n';
+    for (size_t i = 0; i < rekordok.size(); i++) {
+        const SzervizRekord& r = rekordok[i];
+        ki += static_cast<char>(r.tipus); ki += '\t';
+        datumHozzafuz(ki, r.idopont); ki += '\t';
+        ki += r.muvelet; ki += '\t';
+        szamHozzafuz(ki, r.ar); ki += '\t';
+        szamHozzafuz(ki, r.akt_kmOra); ki += '\t';
+        ki += r.sikeres ? '1' : '0';
+        ki += '\n';
+    }
+}
+
+/// szerviz <rendszam> <J|K|V> <datum> <leiras> <ar> <km> [sikeres]
+static void szerviz(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t mezoDb, std::string& ki, std::string*) {
+    if (m[2].n != 1 || (m[2].p[0] != 'J' && m[2].p[0] != 'K' && m[2].p[0] != 'V'))
+        throw std::invalid_argument("Hibas muvelettipus: " + szoveg(m[2]));
+    const MuveletTipus tipus = static_cast<MuveletTipus>(m[2].p[0]);
+    const Datum d = datum(m[3]);
+    const std::string leiras = menthetoSzoveg(m[4], "leiras", false);
+    const int ar = egesz(m[5], "ar");
+    const int km = egesz(m[6], "km");
+    bool sikeres = false;
+    if (mezoDb > 7) {
+        if (!egyenlo(m[7], "0") && !egyenlo(m[7], "1"))
+            throw std::invalid_argument("Hibas sikeresseg: " + szoveg(m[7]));
+        sikeres = m[7].p[0] == '1';
+    }
+    if (!db.rogzitesVegzettMuvelet(szoveg(m[1]), SzervizRekord(tipus, leiras, d, ar, km, sikeres)))
+        throw std::runtime_error("Nincs ilyen rendszamu auto!");
+    ok(ki, 0);
+}
+
+/// szerviz_torol <rendszam> <datum>
+static void szervizTorol(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    if (!db.torolMuvelet(szoveg(m[1]), datum(m[2])))
+        throw std::runtime_error("Nincs ilyen auto, vagy nincs ilyen datumu muvelete!");
+    ok(ki, 0);
+}
+
+/// keres <auto|ugyfel> <szuro>
+static void keres(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    const bool autoCel = egyenlo(m[1], "auto");
+    if (!autoCel && !egyenlo(m[1], "ugyfel"))
+        throw std::invalid_argument("Ismeretlen cel: " + szoveg(m[1]));
+    const SzervizNyilvantartoRendszer& cdb = db;
+    Lekerdezes l(szoveg(m[2]), autoCel ? LekerdezesCel::Auto : LekerdezesCel::Ugyfel);
+    Vector<size_t> talalatok = l.futtat(cdb);
+    ok(ki, talalatok.size());
+    for (size_t i = 0; i < talalatok.size(); i++) {
+        ki += autoCel ? cdb.getAutok()[talalatok[i]].getRendszam() : cdb.getUgyfelek()[talalatok[i]].getNev();
+        ki += '\n';
+    }
+}
+
+/// figyelmeztetes [datum]
+static void figyelmeztetes(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t mezoDb, std::string& ki, std::string*) {
+    const SzervizNyilvantartoRendszer& cdb = db;
+    Vector<Figyelmeztetes> f = mezoDb > 1 ? cdb.flottaFigyelmeztetesek(datum(m[1])) : cdb.flottaFigyelmeztetesek();
+    const FigyelmeztetesiSzabalyok& szabalyok = cdb.getFigyelmeztetesiSzabalyok();
+    ok(ki, f.size());
+    for (size_t i = 0; i < f.size(); i++) {
+        ki += f[i].rendszam; ki += '\t';
+        ki += szabalyok[f[i].szabaly].uzenet; ki += '\t';
+        ki += static_cast<char>(f[i].mertek); ki += '\t';
+        szamHozzafuz(ki, f[i].tullepes);
+        ki += '\n';
+    }
+}
+
+/// mentes <fajl>
+static void mentes(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    static_cast<const SzervizNyilvantartoRendszer&>(db).mentesFajlba(szoveg(m[1]));
+    ok(ki, 0);
+}
+
+/// betoltes <fajl> (naplozas mellett nem hasznalhato: a visszajatszas a fajl akkori tartalmat olvasna)
+static void betoltes(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string*) {
+    db.betoltesFajlbol(szoveg(m[1]));
+    ok(ki, 0);
+}
+
+/// szerviz_import <csv fajl>
+/// Naplozaskor nem a fajl neve, hanem a rogzitett rekordok kerulnek a naploba szerviz sorokkent (autonkent
+/// a hozzafuzes sorrendjeben), es ha az auto km oraja nott, egy km sor; igy a visszajatszas a CSV nelkul is pontos.
+static void szervizImport(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t, std::string& ki, std::string* naplo) {
+    const SzervizNyilvantartoRendszer& cdb = db;
+    const Vector<Auto>& autok = cdb.getAutok();
+    std::vector<size_t> regiDb;
+    std::vector<int> regiKm;
+    if (naplo != nullptr) {
+        regiDb.resize(autok.size());
+        regiKm.resize(autok.size());
+        for (size_t i = 0; i < autok.size(); i++) {
+            regiDb[i] = autok[i].getSzervizRekordok().size();
+            regiKm[i] = autok[i].getKmOra();
+        }
+    }
+
+    const ImportEredmeny e = db.szervizImportCsv(szoveg(m[1]));
+
+    if (naplo != nullptr && e.rogzitett > 0) {
+        for (size_t i = 0; i < autok.size(); i++) {
+            const Auto& a = autok[i];
+            const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+            for (size_t j = regiDb[i]; j < rekordok.size(); j++) {
+                const SzervizRekord& r = rekordok[j];
+                *naplo += "szerviz\t"; *naplo += a.getRendszam(); *naplo += '\t';
+                *naplo += static_cast<char>(r.tipus); *naplo += '\t';
+                datumHozzafuz(*naplo, r.idopont); *naplo += '\t';
+                *naplo += r.muvelet; *naplo += '\t';
+                szamHozzafuz(*naplo, r.ar); *naplo += '\t';
+                szamHozzafuz(*naplo, r.akt_kmOra); *naplo += '\t';
+                *naplo += r.sikeres ? '1' : '0';
+                *naplo += '\n';
+            }
+            if (a.getKmOra() != regiKm[i]) {
+                *naplo += "km\t"; *naplo += a.getRendszam(); *naplo += '\t';
+                szamHozzafuz(*naplo, a.getKmOra());
+                *naplo += '\n';
+            }
+        }
+    }
+    ok(ki, 1 + e.hibak.size());
+    szamHozzafuz(ki, static_cast<long long>(e.rogzitett)); ki += '\t';
+    szamHozzafuz(ki, static_cast<long long>(e.hibak.size())); ki += '\n';
+    for (size_t i = 0; i < e.hibak.size(); i++) {
+        szamHozzafuz(ki, static_cast<long long>(e.hibak[i].sor)); ki += '\t';
+        ki += e.hibak[i].indok;
+        ki += '\n';
+    }
+}
+
+/// export <fajl> [<auto|ugyfel> <szuro>]
+static void exportNdjson(SzervizNyilvantartoRendszer& db, const Mezo* m, size_t mezoDb, std::string& ki, std::string*) {
+    if (mezoDb == 3) throw std::invalid_argument("A szurohoz cel es kifejezes is kell");
+    const bool autoCel = mezoDb < 4 || egyenlo(m[2], "auto");
+    if (!autoCel && !egyenlo(m[2], "ugyfel"))
+        throw std::invalid_argument("Ismeretlen cel: " + szoveg(m[2]));
+    std::ofstream f(szoveg(m[1]).c_str(), std::ios::binary | std::ios::trunc);
+    if (!f) throw std::runtime_error("A fajl nem nyithato meg: " + szoveg(m[1]));
+    NdjsonExport e(f);
+    if (mezoDb < 4)
+        e.adatbazis(db);
+    else
+        e.adatbazis(db, szoveg(m[3]), autoCel ? LekerdezesCel::Auto : LekerdezesCel::Ugyfel);
+    e.kiurit();
+    ok(ki, 1);
+    szamHozzafuz(ki, static_cast<long long>(e.getUgyfelek())); ki += '\t';
+    szamHozzafuz(ki, static_cast<long long>(e.getAutok())); ki += '\t';
+    szamHozzafuz(ki, static_cast<long long>(e.getSzervizek())); ki += '\n';
+}
+
+/// Hogyan kerul a parancs a naploba.
+enum class Naplozas {
+    Nincs,          ///< Nem modosit
+    Sor,            ///< A parancssor szo szerint
+    Hatas,          ///< A kezelo irja a hatasat a naplopufferbe (visszajatszhato parancssorokkent)
+    Tiltott,        ///< Naplozas mellett nem hasznalhato, mert a hatasa nem jatszhato vissza
+    Ellenorzopont   ///< Nem modosit, de az indulo fajlok mentese kiuritheti a naplot (lasd ellenorzopont())
+};
+
+/// Egy parancs leirasa: nev, a mezok megengedett szama (a parancs nevevel egyutt),
+/// a naplozas modja es a kezelo. A kezelo utolso parametere a naplopuffer (nullptr, ha nincs naplozas).
+struct Parancs {
+    const char* nev;
+    size_t minMezo;
+    size_t maxMezo;
+    Naplozas naplozas;
+    void (*kezelo)(SzervizNyilvantartoRendszer&, const Mezo*, size_t, std::string&, std::string*);
+};
+
+static const Parancs PARANCSOK[] = {
+    { "ping",           1, 1, Naplozas::Nincs,         ping },
+    { "ugyfel_uj",      4, 4, Naplozas::Sor,           ugyfelUj },
+    { "ugyfel_frissit", 4, 4, Naplozas::Sor,           ugyfelFrissit },
+    { "ugyfel_torol",   2, 2, Naplozas::Sor,           ugyfelTorol },
+    { "ugyfel",         2, 2, Naplozas::Nincs,         ugyfelLekerdez },
+    { "auto_uj",        7, 7, Naplozas::Sor,           autoUj },
+    { "km",             3, 3, Naplozas::Sor,           kmFrissit },
+    { "auto_torol",     2, 2, Naplozas::Sor,           autoTorol },
+    { "auto",           2, 2, Naplozas::Nincs,         autoLekerdez },
+    { "szerviz",        7, 8, Naplozas::Sor,           szerviz },
+    { "szerviz_torol",  3, 3, Naplozas::Sor,           szervizTorol },
+    { "keres",          3, 3, Naplozas::Nincs,         keres },
+    { "figyelmeztetes", 1, 2, Naplozas::Nincs,         figyelmeztetes },
+    { "mentes",         2, 2, Naplozas::Ellenorzopont, mentes },
+    { "betoltes",       2, 2, Naplozas::Tiltott,       betoltes },
+    { "szerviz_import", 2, 2, Naplozas::Hatas,         szervizImport },
+    { "export",         2, 4, Naplozas::Nincs,         exportNdjson },
+};
+
+static const char KOTEG_FEJLEC[] = "batch";   ///< A kotegfejlec parancsneve
+
+/// A kotegfejlec ("batch <n>") ertelmezese.
+/// @param sor - A fejlec sor
+/// @param hossz - A sor hossza ('\n' nelkul)
+/// @return - A koteg parancsainak szama
+/// @throws std::invalid_argument - ha a fejlec hibas, vagy a meret nincs 1 es MAX_KOTEG kozott
+static size_t kotegMeret(const char* sor, size_t hossz) {
+    if (hossz > 0 && sor[hossz - 1] == '\r') hossz--;
+    Mezo mezok[ParancsVegrehajto::MAX_MEZO + 1];
+    if (ParancsVegrehajto::feloszt(sor, hossz, mezok) != 2) throw std::invalid_argument("Hibas kotegfejlec");
+    const int n = egesz(mezok[1], "kotegmeret");
+    if (n < 1 || static_cast<size_t>(n) > ParancsVegrehajto::MAX_KOTEG)
+        throw std::invalid_argument("Hibas kotegmeret: " + szoveg(mezok[1]));
+    return static_cast<size_t>(n);
+}
+
+
+
+/*-------------------------------------------
+            ParancsVegrehajto
+-------------------------------------------*/
+/// A sor mezokre bontasa tabulatorok menten.
+/// @param sor - A sor elso karaktere
+/// @param hossz - A sor hossza ('\r' es '\n' nelkul)
+/// @param mezok - Legalabb MAX_MEZO + 1 elemu tomb
+/// @return - A mezok szama (MAX_MEZO + 1, ha tul sok)
+size_t ParancsVegrehajto::feloszt(const char* sor, size_t hossz, Mezo* mezok) {
+    size_t db = 0;
+    const char* p = sor;
+    const char* veg = sor + hossz;
+    while (db <= MAX_MEZO) {
+        const char* tab = static_cast<const char*>(std::memchr(p, '\t', static_cast<size_t>(veg - p)));
+        const char* mezoVeg = tab != nullptr ? tab : veg;
+        mezok[db].p = p;
+        mezok[db].n = static_cast<size_t>(mezoVeg - p);
+        db++;
+        if (tab == nullptr) break;
+        p = tab + 1;
+    }
+    return db;
+}
+
+/// Egy parancssor vegrehajtasa.
+/// @param sor - A sor elso karaktere
+/// @param hossz - A sor hossza
+/// @param ki - A valasz a vegere kerul
+/// @return - false, ha a valasz ERR, kulonben true
+bool ParancsVegrehajto::vegrehajt(const char* sor, size_t hossz, std::string& ki) {
+    const bool siker = egyVegrehajt(sor, hossz, ki);
+    if (!siker) hibak++;
+    naploKiir();
+    return siker;
+}
+
+/// A pufferben levo teljes keretek vegrehajtasa sorrendben, egyetlen naploirassal.
+/// @param adat - A beolvasott adatok eleje
+/// @param hossz - A beolvasott adatok hossza
+/// @param ki - A valaszok a vegere kerulnek
+/// @param kiKorlat - Ha ki merete ezt meghaladja, nem kezd uj keretbe
+/// @return - A feldolgozott bajtok szama
+size_t ParancsVegrehajto::feldolgoz(const char* adat, size_t hossz, std::string& ki, size_t kiKorlat) {
+    size_t poz = 0;
+    while (poz < hossz && ki.size() <= kiKorlat) {
+        const char* sor = adat + poz;
+        const char* sorVege = static_cast<const char*>(std::memchr(sor, '\n', hossz - poz));
+        if (sorVege == nullptr) break;
+        const size_t sorHossz = static_cast<size_t>(sorVege - sor);
+
+        // Kotegfejlec: "batch <n>"; a koteg csak akkor fut le, ha mind az n sora megerkezett
+        if (sorHossz > sizeof(KOTEG_FEJLEC) - 1 && std::memcmp(sor, KOTEG_FEJLEC, sizeof(KOTEG_FEJLEC) - 1) == 0
+            && sor[sizeof(KOTEG_FEJLEC) - 1] == '\t') {
+            size_t n;
+            try {
+                n = kotegMeret(sor, sorHossz);
+            }
+            catch (const std::exception& e) {
+                ki += "ERR ";
+                ki += e.what();
+                ki += '\n';
+                hibak++;
+                poz += sorHossz + 1;
+                continue;
+            }
+
+            const char* kotegEleje = sorVege + 1;
+            const char* p = kotegEleje;
+            const char* veg = adat + hossz;
+            size_t megvan = 0;
+            while (megvan < n) {
+                const char* v = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(veg - p)));
+                if (v == nullptr) break;
+                p = v + 1;
+                megvan++;
+            }
+            if (megvan < n) break;
+            kotegVegrehajt(kotegEleje, p, n, ki);
+            poz = static_cast<size_t>(p - adat);
+            continue;
+        }
+
+        if (!egyVegrehajt(sor, sorHossz, ki)) hibak++;
+        poz += sorHossz + 1;
+    }
+    naploKiir();
+    return poz;
+}
+
+/// Egy koteg vegrehajtasa.
+/// @param sorok - A koteg elso parancssora
+/// @param veg - A koteg utolso sora utani pozicio
+/// @param n - A parancsok szama (a hivo ellenorizte, hogy mind az n sor '\n'-nel lezart)
+/// @param ki - Az "OK <m>" keret a vegere kerul
+void ParancsVegrehajto::kotegVegrehajt(const char* sorok, const char* veg, size_t n, std::string& ki) {
+    kotegPuffer.clear();
+    const char* p = sorok;
+    for (size_t i = 0; i < n; i++) {
+        const char* sorVege = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(veg - p)));
+        size_t hossz = static_cast<size_t>(sorVege - p);
+        if (hossz > 0 && p[hossz - 1] == '\r') hossz--;
+        if (hossz == 0) {
+            kotegPuffer += "ERR Ures parancs\n";
+            hibak++;
+        }
+        else if (!egyVegrehajt(p, hossz, kotegPuffer)) {
+            hibak++;
+        }
+        p = sorVege + 1;
+    }
+
+    size_t valaszSorok = 0;
+    for (size_t i = 0; i < kotegPuffer.size(); i++)
+        if (kotegPuffer[i] == '\n') valaszSorok++;
+    ok(ki, valaszSorok);
+    ki += kotegPuffer;
+}
+
+/// Egy parancssor vegrehajtasa. A kezelok hibat kivetellel jeleznek, ebbol ERR valasz lesz;
+/// a sikeres modosito parancs a naploPuffer-be kerul.
+/// @param sor - A sor elso karaktere
+/// @param hossz - A sor hossza
+/// @param ki - A valasz a vegere kerul
+/// @return - false, ha a valasz ERR, kulonben true
+bool ParancsVegrehajto::egyVegrehajt(const char* sor, size_t hossz, std::string& ki) {
+    while (hossz > 0 && (sor[hossz - 1] == '\n' || sor[hossz - 1] == '\r'))
+        hossz--;
+    if (hossz == 0) return true;
+
+    Mezo mezok[MAX_MEZO + 1];
+    const size_t mezoDb = feloszt(sor, hossz, mezok);
+    if (egyenlo(mezok[0], KOTEG_FEJLEC)) {
+        ki += "ERR A kotegfejlec csak onallo keretkent kuldheto\n";
+        return false;
+    }
+
+    const size_t parancsokSzama = sizeof(PARANCSOK) / sizeof(PARANCSOK[0]);
+    for (size_t i = 0; i < parancsokSzama; i++) {
+        const Parancs& p = PARANCSOK[i];
+        if (!egyenlo(mezok[0], p.nev)) continue;
+
+        if (mezoDb < p.minMezo || mezoDb > p.maxMezo) {
+            ki += "ERR Hibas mezoszam: ";
+            ki += p.nev;
+            ki += '\n';
+            return false;
+        }
+        if (p.naplozas == Naplozas::Tiltott && naplo != nullptr) {
+            ki += "ERR Naplozas mellett nem hasznalhato: ";
+            ki += p.nev;
+            ki += '\n';
+            return false;
+        }
+        const size_t elotte = ki.size();
+        const size_t naploElotte = naploPuffer.size();
+        try {
+            p.kezelo(db, mezok, mezoDb, ki, p.naplozas == Naplozas::Hatas && naplo != nullptr ? &naploPuffer : nullptr);
+        }
+        catch (const std::exception& e) {
+            ki.resize(elotte);
+            naploPuffer.resize(naploElotte);
+            ki += "ERR ";
+            ki += e.what();
+            ki += '\n';
+            return false;
+        }
+        if (naplo == nullptr) return true;
+        if (p.naplozas == Naplozas::Sor) {
+            naploPuffer.append(sor, hossz);
+            naploPuffer += '\n';
+        }
+        if (p.naplozas == Naplozas::Sor || (p.naplozas == Naplozas::Hatas && naploPuffer.size() != naploElotte))
+            mentettAlapFajlok = 0;
+        else if (p.naplozas == Naplozas::Ellenorzopont)
+            ellenorzopont(szoveg(mezok[1]));
+        return true;
+    }
+
+    ki += "ERR Ismeretlen parancs: ";
+    ki += szoveg(mezok[0]);
+    ki += '\n';
+    return false;
+}
+
+/// Sikeres mentes utan: ha az utolso modositas ota mindket indulo fajl mentese megtortent, a naplozott
+/// parancsok mar benne vannak az alapallapotban, ezert a naplo (es a meg ki nem irt resze) kiurul.
+/// @param fajl - A mentett fajl neve
+void ParancsVegrehajto::ellenorzopont(const std::string& fajl) {
+    const int i = naplo->alapFajl(fajl);
+    if (i < 0) return;
+    mentettAlapFajlok |= 1u << i;
+    if (mentettAlapFajlok != 3u) return;
+    naploPuffer.clear();
+    naplo->csonkit();
+    mentettAlapFajlok = 0;
+}
+
+/// A naploPuffer kiirasa egyetlen irassal.
+void ParancsVegrehajto::naploKiir() {
+    if (naplo == nullptr || naploPuffer.empty()) return;
+    try {
+        naplo->ir(naploPuffer);
+    }
+    catch (...) {
+        naploPuffer.clear();
+        throw;
+    }
+    naploPuffer.clear();
+}
\ No newline at end of file
@@ -0,0 +1,371 @@
+/**
+*   \file ParticionaltNyilvantarto.cpp
+*   A szeletekre osztott nyilvantarto tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <mutex>
+
+#include "ParticionaltNyilvantarto.h"
+#include "SzalKeszlet.h"
+
+/// Az auto keresese a rendszer rendszamindexeben (csak olvasva: a szelet irasai utan az index friss).
+/// @param db - A rendszer
+/// @param r - A rendszam
+/// @return - Az auto, vagy nullptr, ha nem talalhato
+static const Auto* autoKeres(const SzervizNyilvantartoRendszer& db, const std::string& r) {
+    const size_t i = db.autoSorszam(r);
+    return i < db.getAutok().size() ? &db.getAutok()[i] : nullptr;
+}
+
+/// Az ugyfel keresese a rendszer ugyfelei kozott (csak olvasva).
+/// @param db - A rendszer
+/// @param n - Az ugyfel neve
+/// @return - Az ugyfel, vagy nullptr, ha nem talalhato
+static const Ugyfel* ugyfelKeres(const SzervizNyilvantartoRendszer& db, const std::string& n) {
+    const Vector<Ugyfel>& ugyfelek = db.getUgyfelek();
+    for (size_t i = 0; i < ugyfelek.size(); i++)
+        if (ugyfelek[i].getNev() == n) return &ugyfelek[i];
+    return nullptr;
+}
+
+/*-------------------------------------------
+        Konstruktor es destruktor
+-------------------------------------------*/
+/// Konstruktor (ures rendszer).
+/// @param szeletekSzama - A szeletek szama
+ParticionaltNyilvantarto::ParticionaltNyilvantarto(size_t szeletekSzama) : szeletek(), ugyfelTar(), ugyfelZar() {
+    if (szeletekSzama == 0) throw std::invalid_argument("A szeletek szama legalabb 1 kell legyen!");
+    // Az ures szeletek szarmaztatott adatai is frissek legyenek: az elso iras elotti olvasok se epitsenek
+    for (size_t i = 0; i < szeletekSzama; i++) {
+        szeletek.push_back(std::unique_ptr<Szelet>(new Szelet()));
+        szeletek.back()->db.szarmaztatottAdatokFrissitese();
+    }
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// Az osszes szelet zarolasa novekvo sorrendben, a fuggveny futtatasa, majd a zarak elengedese.
+/// Kivetel eseten is minden megszerzett zar elengedodik.
+/// @param kizarolagos - Irasi (true) vagy olvasasi (false) zarak
+/// @param f - A zarak alatt futo fuggveny
+void ParticionaltNyilvantarto::mindenSzeletZarral(bool kizarolagos, const std::function<void()>& f) const {
+    size_t zarolt = 0;
+    try {
+        for (; zarolt < szeletek.size(); zarolt++) {
+            if (kizarolagos) szeletek[zarolt]->zar.iroZarol();
+            else szeletek[zarolt]->zar.olvasoZarol();
+        }
+        f();
+    }
+    catch (...) {
+        while (zarolt > 0) {
+            zarolt--;
+            if (kizarolagos) szeletek[zarolt]->zar.iroElenged();
+            else szeletek[zarolt]->zar.olvasoElenged();
+        }
+        throw;
+    }
+    while (zarolt > 0) {
+        zarolt--;
+        if (kizarolagos) szeletek[zarolt]->zar.iroElenged();
+        else szeletek[zarolt]->zar.olvasoElenged();
+    }
+}
+
+
+
+/*-------------------------------------------
+        Lekerdezesek
+-------------------------------------------*/
+/// A rendszamhoz tartozo szelet sorszama.
+/// @param r - A rendszam
+/// @return - A szelet sorszama
+size_t ParticionaltNyilvantarto::szeletIndex(const std::string& r) const {
+    return std::hash<std::string>()(r) % szeletek.size();
+}
+
+/// Az autok szama (szeletenkent osszegezve).
+/// @return - size_t
+size_t ParticionaltNyilvantarto::autokSzama() const {
+    size_t n = 0;
+    for (size_t i = 0; i < szeletek.size(); i++) {
+        const Szelet& sz = *szeletek[i];   // konstans nezet: a nem konstans getAutok() elavultta tenne a szelet adatait
+        MegosztottZar z(sz.zar);
+        n += sz.db.getAutok().size();
+    }
+    return n;
+}
+
+/// Auto letezesenek ellenorzese (csak a sajat szeletet zarolja).
+/// @param r - A rendszam
+/// @return - true, ha az auto szerepel
+bool ParticionaltNyilvantarto::vanAuto(const std::string& r) const {
+    const Szelet& sz = szelet(r);
+    MegosztottZar z(sz.zar);
+    return sz.db.vanAuto(r);
+}
+
+/// Ugyfel letezesenek ellenorzese.
+/// @param n - Az ugyfel neve
+/// @return - true, ha az ugyfel szerepel
+bool ParticionaltNyilvantarto::vanUgyfel(const std::string& n) const {
+    MegosztottZar z(ugyfelZar);
+    return ugyfelTar.vanUgyfel(n);
+}
+
+/// Auto keresese rendszam alapjan (csak a sajat szeletet zarolja).
+/// @param r - A rendszam
+/// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+/// @param tulajdonos - Ha nem nullptr, ide kerul a tulajdonos masolata
+/// @return - true, ha az auto szerepel
+bool ParticionaltNyilvantarto::keresAuto(const std::string& r, Auto& ki, Ugyfel* tulajdonos) const {
+    const Szelet& sz = szelet(r);
+    MegosztottZar z(sz.zar);
+    const Auto* a = autoKeres(sz.db, r);
+    if (a == nullptr) return false;
+    ki = *a;
+    ki.setTulajdonos(nullptr);
+    if (tulajdonos != nullptr && a->getTulajdonos() != nullptr)
+        *tulajdonos = *a->getTulajdonos();
+    return true;
+}
+
+/// Ugyfel keresese nev alapjan.
+/// @param n - Az ugyfel neve
+/// @param ki - Az ugyfel masolata
+/// @return - true, ha az ugyfel szerepel
+bool ParticionaltNyilvantarto::keresUgyfel(const std::string& n, Ugyfel& ki) const {
+    MegosztottZar z(ugyfelZar);
+    const Ugyfel* u = ugyfelKeres(ugyfelTar, n);
+    if (u == nullptr) return false;
+    ki = *u;
+    return true;
+}
+
+/// Az auto szervizmuveleteinek kiirasa.
+/// @param os - A kimeneti adatfolyam
+/// @param r - A rendszam
+void ParticionaltNyilvantarto::lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const {
+    const Szelet& sz = szelet(r);
+    MegosztottZar z(sz.zar);
+    sz.db.lekeroVegzettMuvelet(os, r);
+}
+
+/// A flotta figyelmeztetesei: a szeletek parhuzamosan ertekelodnek ki, majd az eredmeny rendezodik.
+/// @param ma - A referencia datum
+/// @return - A figyelmeztetesek
+Vector<Figyelmeztetes> ParticionaltNyilvantarto::flottaFigyelmeztetesek(const Datum& ma) const {
+    Vector<Figyelmeztetes> eredmeny;
+    std::mutex eredmenyZar;
+
+    SzalKeszlet::alapertelmezett().parhuzamosFor(szeletek.size(), [&](size_t tol, size_t ig) {
+        for (size_t i = tol; i < ig; i++) {
+            Vector<Figyelmeztetes> helyi;
+            {
+                MegosztottZar z(szeletek[i]->zar);
+                helyi = szeletek[i]->db.flottaFigyelmeztetesek(ma);
+            }
+            if (helyi.empty()) continue;
+
+            std::lock_guard<std::mutex> z(eredmenyZar);
+            for (size_t j = 0; j < helyi.size(); j++)
+                eredmeny.push_back(helyi[j]);
+        }
+    }, 1);
+
+    std::sort(eredmeny.begin(), eredmeny.end());
+    return eredmeny;
+}
+
+/// Mentes fajlba.
+/// @param f - A celfajl neve
+void ParticionaltNyilvantarto::mentesFajlba(const std::string& f) const {
+    const bool ugyfelFajl = f.find("_ufl.txt") != std::string::npos;
+    const bool autoFajl = f.find("_auo.txt") != std::string::npos;
+    if (!ugyfelFajl && !autoFajl) throw std::invalid_argument("Ismeretlen fajlformatum! (mentesFajlba)");
+
+    std::ostringstream os;
+    if (ugyfelFajl) {
+        MegosztottZar z(ugyfelZar);
+        const Vector<Ugyfel>& ugyfelek = ugyfelTar.getUgyfelek();
+        for (size_t i = 0; i < ugyfelek.size(); i++)
+            SzervizNyilvantartoRendszer::mentesSor(os, ugyfelek[i]);
+    }
+    else {
+        mindenSzeletZarral(false, [&]() {
+            for (size_t i = 0; i < szeletek.size(); i++) {
+                const Vector<Auto>& autok = static_cast<const Szelet&>(*szeletek[i]).db.getAutok();
+                for (size_t j = 0; j < autok.size(); j++)
+                    SzervizNyilvantartoRendszer::mentesSor(os, autok[j]);
+            }
+        });
+    }
+
+    std::ofstream fp(f);
+    if (!fp.is_open()) throw std::runtime_error("Nem sikerult megnyitni a fajlt! (mentesFajlba)");
+    const std::string kimenet = os.str();
+    fp.write(kimenet.data(), static_cast<std::streamsize>(kimenet.size()));
+}
+
+
+
+/*-------------------------------------------
+        Modositasok
+-------------------------------------------*/
+/// Uj ugyfel felvetele (csak az ugyfeltarba; a szeletekbe az elso autojaval kerul masolat).
+/// @param u - Az ugyfel
+/// @return - false, ha mar letezik
+bool ParticionaltNyilvantarto::ujUgyfel(const Ugyfel& u) {
+    KizarolagosZar z(ugyfelZar);
+    return ugyfelTar.ujUgyfel(u);
+}
+
+/// Ugyfel adatainak frissitese az ugyfeltarban es a szeletekben levo masolataiban.
+/// @param u - Az ugyfel uj adatai
+/// @return - false, ha nem talalhato
+bool ParticionaltNyilvantarto::frissitUgyfel(const Ugyfel& u) {
+    KizarolagosZar z(ugyfelZar);
+    if (!ugyfelTar.frissitUgyfel(u)) return false;
+    for (size_t i = 0; i < szeletek.size(); i++) {
+        Szelet& sz = *szeletek[i];
+        KizarolagosZar zs(sz.zar);
+        if (sz.db.frissitUgyfel(u)) sz.db.szarmaztatottAdatokFrissitese();
+    }
+    return true;
+}
+
+/// Ugyfel es autoinak torlese az osszes szeletbol.
+/// Az ugyfeltar es minden szelet zarja alatt fut, igy egy olvaso sem latja az ugyfelet
+/// az egyik szeletbol mar torolve, a masikban meg meglevo autokkal.
+/// @param n - Az ugyfel neve
+/// @return - false, ha nem talalhato
+bool ParticionaltNyilvantarto::torolUgyfel(const std::string& n) {
+    KizarolagosZar z(ugyfelZar);
+    if (!ugyfelTar.vanUgyfel(n)) return false;
+    mindenSzeletZarral(true, [&]() {
+        for (size_t i = 0; i < szeletek.size(); i++) {
+            SzervizNyilvantartoRendszer& db = szeletek[i]->db;
+            if (db.torolUgyfel(n)) db.szarmaztatottAdatokFrissitese();
+        }
+        ugyfelTar.torolUgyfel(n);
+    });
+    return true;
+}
+
+/// Uj auto felvetele a sajat szeletebe; a tulajdonos masolata szukseg eseten a szeletbe kerul.
+/// Az ugyfeltar olvasasi zarja a felvetel vegeig tart, igy a tulajdonos kozben nem torolheto.
+/// @param a - Az auto
+/// @param tulajdonosNev - A tulajdonos neve
+/// @return - false, ha az auto mar letezik vagy a tulajdonos nem talalhato
+bool ParticionaltNyilvantarto::ujAuto(const Auto& a, const std::string& tulajdonosNev) {
+    MegosztottZar z(ugyfelZar);
+    const Ugyfel* tulajdonos = ugyfelKeres(ugyfelTar, tulajdonosNev);
+    if (tulajdonos == nullptr) return false;
+
+    Szelet& sz = szelet(a.getRendszam());
+    KizarolagosZar zs(sz.zar);
+    if (sz.db.vanAuto(a.getRendszam())) return false;
+    if (!sz.db.vanUgyfel(tulajdonosNev)) sz.db.ujUgyfel(*tulajdonos);
+    Auto uj(a);
+    uj.setTulajdonos(&sz.db.keresUgyfel(tulajdonosNev));
+    sz.db.ujAuto(uj);
+    sz.db.szarmaztatottAdatokFrissitese();
+    return true;
+}
+
+/// Km ora frissitese (csak a sajat szeletet zarolja).
+/// @param r - A rendszam
+/// @param k - Az uj km ora allas
+/// @return - false, ha az auto nem talalhato
+bool ParticionaltNyilvantarto::frissitKmOra(const std::string& r, int k) {
+    Szelet& sz = szelet(r);
+    KizarolagosZar z(sz.zar);
+    if (!sz.db.frissitKmOra(r, k)) return false;
+    sz.db.szarmaztatottAdatokFrissitese();
+    return true;
+}
+
+/// Szervizmuvelet rogzitese (csak a sajat szeletet zarolja).
+/// @param r - A rendszam
+/// @param m - A muvelet rekordja
+/// @return - false, ha az auto nem talalhato
+bool ParticionaltNyilvantarto::rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m) {
+    Szelet& sz = szelet(r);
+    KizarolagosZar z(sz.zar);
+    if (!sz.db.rogzitesVegzettMuvelet(r, m)) return false;
+    sz.db.szarmaztatottAdatokFrissitese();
+    return true;
+}
+
+/// Szervizmuvelet torlese datum alapjan (csak a sajat szeletet zarolja).
+/// @param r - A rendszam
+/// @param d - A muvelet datuma
+/// @return - false, ha az auto vagy a muvelet nem talalhato
+bool ParticionaltNyilvantarto::torolMuvelet(const std::string& r, const Datum& d) {
+    Szelet& sz = szelet(r);
+    KizarolagosZar z(sz.zar);
+    if (!sz.db.torolMuvelet(r, d)) return false;
+    sz.db.szarmaztatottAdatokFrissitese();
+    return true;
+}
+
+/// Auto torlese (csak a sajat szeletet zarolja; a tulajdonos masolata a szeletben marad).
+/// @param r - A rendszam
+/// @return - false, ha nem talalhato
+bool ParticionaltNyilvantarto::torolAuto(const std::string& r) {
+    Szelet& sz = szelet(r);
+    KizarolagosZar z(sz.zar);
+    if (!sz.db.torolAuto(r)) return false;
+    sz.db.szarmaztatottAdatokFrissitese();
+    return true;
+}
+
+/// Rendszeradatok betoltese fajlbol.
+/// A fajl egy ideiglenes rendszerbe toltodik (a zarakon kivul, a kozos szalkeszleten ertelmezve),
+/// majd a sorok az ugyfeltarba es a szeletekbe osztodnak szet.
+/// @param f - A fajl neve
+void ParticionaltNyilvantarto::betoltesFajlbol(const std::string& f) {
+    SzervizNyilvantartoRendszer beolvasott;
+    beolvasott.betoltesFajlbol(f);
+    const bool autoFajl = f.find("_auo.txt") != std::string::npos;
+
+    KizarolagosZar z(ugyfelZar);
+    mindenSzeletZarral(true, [&]() {
+        if (!autoFajl) {
+            const Vector<Ugyfel>& ugyfelek = beolvasott.getUgyfelek();
+            for (size_t i = 0; i < ugyfelek.size(); i++) {
+                if (!ugyfelTar.ujUgyfel(ugyfelek[i])) ugyfelTar.frissitUgyfel(ugyfelek[i]);
+                for (size_t j = 0; j < szeletek.size(); j++)
+                    szeletek[j]->db.frissitUgyfel(ugyfelek[i]);
+            }
+        }
+        else {
+            const Vector<Auto>& autok = beolvasott.getAutok();
+            for (size_t i = 0; i < autok.size(); i++) {
+                const Ugyfel& tulajdonos = *autok[i].getTulajdonos();
+                ugyfelTar.ujUgyfel(Ugyfel(tulajdonos.getNev(), "", ""));
+
+                SzervizNyilvantartoRendszer& db = szeletek[szeletIndex(autok[i].getRendszam())]->db;
+                if (db.vanAuto(autok[i].getRendszam())) continue;
+                if (!db.vanUgyfel(tulajdonos.getNev()))
+                    db.ujUgyfel(*ugyfelKeres(ugyfelTar, tulajdonos.getNev()));
+                Auto uj(autok[i]);
+                uj.setTulajdonos(&db.keresUgyfel(tulajdonos.getNev()));
+                db.ujAuto(uj);
+            }
+        }
+        for (size_t j = 0; j < szeletek.size(); j++)
+            szeletek[j]->db.szarmaztatottAdatokFrissitese();
+    });
+}
\ No newline at end of file
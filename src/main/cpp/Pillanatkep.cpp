@@ -0,0 +1,182 @@
+/**
+*   \file Pillanatkep.cpp
+*   A pillanatkep tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <fstream>
+#include <stdexcept>
+
+#include "Pillanatkep.h"
+#include "SzervizNyilvantartoRendszer.h"
+
+/*-------------------------------------------
+              AutoValtozat
+-------------------------------------------*/
+/// A masolando auto a kesz regresszioval: a masolat a tortenetet megosztja, es az olvasok mar nem irhatnak bele.
+/// @param a - Az auto
+/// @return - Ugyanaz az auto
+static const Auto& regresszioval(const Auto& a) {
+    a.getKmRegresszio();
+    return a;
+}
+
+/// Konstruktor.
+/// @param a - Az auto
+/// @param t - A tulajdonos valtozata
+AutoValtozat::AutoValtozat(const Auto& a, const std::shared_ptr<const Ugyfel>& t) : tulajdonos(t), autoAdat(regresszioval(a)) {
+    // A setTulajdonos nem konstans mutatot var, de a pillanatkep ugyfeleit soha nem modositjuk rajta keresztul
+    autoAdat.setTulajdonos(const_cast<Ugyfel*>(tulajdonos.get()));
+}
+
+
+
+/*-------------------------------------------
+            Letrehozas
+-------------------------------------------*/
+/// Pillanatkep a rendszer teljes tartalmabol (O(n)).
+/// @param db - A rendszer
+/// @param v - A valtozat sorszama
+/// @return - Az uj pillanatkep
+Pillanatkep Pillanatkep::felepit(const SzervizNyilvantartoRendszer& db, unsigned long v) {
+    const Vector<Ugyfel>& dbUgyfelek = db.getUgyfelek();
+    const Vector<Auto>& dbAutok = db.getAutok();
+
+    std::vector<PerzisztensVektor<Ugyfel>::ElemMutato> u;
+    u.reserve(dbUgyfelek.size());
+    for (size_t i = 0; i < dbUgyfelek.size(); i++)
+        u.push_back(std::shared_ptr<const Ugyfel>(new Ugyfel(dbUgyfelek[i])));
+
+    std::vector<PerzisztensVektor<AutoValtozat>::ElemMutato> a;
+    a.reserve(dbAutok.size());
+    for (size_t i = 0; i < dbAutok.size(); i++) {
+        // A tulajdonos indexe a mutato helyebol (lasd tulajdonosokAtkotese)
+        const Ugyfel* t = dbAutok[i].getTulajdonos();
+        std::shared_ptr<const Ugyfel> tv;
+        if (t != nullptr && t >= dbUgyfelek.begin() && t < dbUgyfelek.end())
+            tv = u[static_cast<size_t>(t - dbUgyfelek.begin())];
+        a.push_back(std::shared_ptr<const AutoValtozat>(new AutoValtozat(dbAutok[i], tv)));
+    }
+
+    Pillanatkep p;
+    p.ugyfelek = PerzisztensVektor<Ugyfel>::felepit(u);
+    p.autok = PerzisztensVektor<AutoValtozat>::felepit(a);
+    p.verzio = v;
+    return p;
+}
+
+
+
+/*-------------------------------------------
+        Kovetkezo valtozatok
+-------------------------------------------*/
+/// Uj ugyfel a vegen.
+/// @param u - Az ugyfel
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::ugyfelHozzafuz(const Ugyfel& u) const {
+    Pillanatkep p(*this);
+    p.ugyfelek = ugyfelek.hozzafuz(std::shared_ptr<const Ugyfel>(new Ugyfel(u)));
+    p.verzio++;
+    return p;
+}
+
+/// Az i. ugyfel csereje; az autoi az uj peldanyra mutatnak at (csak az o autoi masolodnak, kereses nelkul).
+/// @param i - Az ugyfel indexe
+/// @param u - Az ugyfel uj adatai
+/// @param autoi - Az ugyfel autoinak indexei (a rendszer tulajdonosindexebol)
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::ugyfelCsere(size_t i, const Ugyfel& u, const std::vector<size_t>& autoi) const {
+    Pillanatkep p(*this);
+    std::shared_ptr<const Ugyfel> uj(new Ugyfel(u));
+    p.ugyfelek = ugyfelek.csere(i, uj);
+    for (size_t k : autoi)
+        p.autok = p.autok.csere(k, std::shared_ptr<const AutoValtozat>(new AutoValtozat(autok[k].autoAdat, uj)));
+    p.verzio++;
+    return p;
+}
+
+/// Az i. ugyfel torlese az autoival egyutt (hatulrol, hogy a meg torlendo indexek ne csusszanak el).
+/// @param i - Az ugyfel indexe
+/// @param autoi - Az ugyfel autoinak indexei novekvo sorrendben (a torles elotti allapotban)
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::ugyfelTorol(size_t i, const std::vector<size_t>& autoi) const {
+    Pillanatkep p(*this);
+    for (size_t k = autoi.size(); k > 0; k--)
+        p.autok = p.autok.torol(autoi[k - 1]);
+    p.ugyfelek = ugyfelek.torol(i);
+    p.verzio++;
+    return p;
+}
+
+/// Uj auto a vegen.
+/// @param a - Az auto
+/// @param tulajdonosIndex - A tulajdonos indexe az ugyfelek kozott (ugyfelekSzama(), ha nincs)
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::autoHozzafuz(const Auto& a, size_t tulajdonosIndex) const {
+    Pillanatkep p(*this);
+    std::shared_ptr<const Ugyfel> t;
+    if (tulajdonosIndex < ugyfelek.size())
+        t = ugyfelek.mutato(tulajdonosIndex);
+    p.autok = autok.hozzafuz(std::shared_ptr<const AutoValtozat>(new AutoValtozat(a, t)));
+    p.verzio++;
+    return p;
+}
+
+/// Az i. auto csereje (a tulajdonos valtozatlan).
+/// @param i - Az auto indexe
+/// @param a - Az auto uj allapota
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::autoCsere(size_t i, const Auto& a) const {
+    Pillanatkep p(*this);
+    p.autok = autok.csere(i, std::shared_ptr<const AutoValtozat>(new AutoValtozat(a, autok[i].tulajdonos)));
+    p.verzio++;
+    return p;
+}
+
+/// Az i. auto torlese.
+/// @param i - Az auto indexe
+/// @return - A kovetkezo valtozat
+Pillanatkep Pillanatkep::autoTorol(size_t i) const {
+    Pillanatkep p(*this);
+    p.autok = autok.torol(i);
+    p.verzio++;
+    return p;
+}
+
+
+
+/*-------------------------------------------
+            Olvasas
+-------------------------------------------*/
+/// Az osszes auto kiirasa.
+/// @param os - A kimeneti adatfolyam
+void Pillanatkep::listazAutok(std::ostream& os) const {
+    autok.bejar([&os](const AutoValtozat& a) { os << a.autoAdat; });
+}
+
+/// Az osszes ugyfel kiirasa.
+/// @param os - A kimeneti adatfolyam
+void Pillanatkep::listazUgyfelek(std::ostream& os) const {
+    ugyfelek.bejar([&os](const Ugyfel& u) { os << u; });
+}
+
+/// Mentes fajlba, a SzervizNyilvantartoRendszer::mentesFajlba formatumaban.
+/// @param f - A celfajl neve ("_ufl.txt" vagy "_auo.txt")
+void Pillanatkep::mentesFajlba(const std::string& f) const {
+    std::ofstream fp(f);
+    if (!fp.is_open()) throw std::runtime_error("Nem sikerult megnyitni a fajlt! (mentesFajlba)");
+
+    bool ugyfelFajl = f.find("_ufl.txt") != std::string::npos;
+    bool autoFajl = f.find("_auo.txt") != std::string::npos;
+    if (!ugyfelFajl && !autoFajl) throw std::invalid_argument("Ismeretlen fajlformatum! (mentesFajlba)");
+
+    if (ugyfelFajl)
+        ugyfelek.bejar([&fp](const Ugyfel& u) { SzervizNyilvantartoRendszer::mentesSor(fp, u); });
+    else
+        autok.bejar([&fp](const AutoValtozat& a) { SzervizNyilvantartoRendszer::mentesSor(fp, a.autoAdat); });
+
+    fp.close();
+}
\ No newline at end of file
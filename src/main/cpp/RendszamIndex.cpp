@@ -0,0 +1,226 @@
+/**
+*   \file RendszamIndex.cpp
+*   A zarolas nelkul olvashato rendszam-index megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <functional>
+
+#include "RendszamIndex.h"
+
+/// Az olvasoszamlalo belepese es kilepese RAII modon (kivetel eseten is kilep, a belepeskori korszakban).
+class OlvasoBelepes {
+    OlvasoSzamlalo& sz;
+    const unsigned korszak;
+public:
+    explicit OlvasoBelepes(OlvasoSzamlalo& s) : sz(s), korszak(s.belep()) {}
+    ~OlvasoBelepes() { sz.kilep(korszak); }
+};
+
+/*-------------------------------------------
+        Bejegyzes es Tabla
+-------------------------------------------*/
+/// Pillanatkep egy autorol; a tulajdonos-mutato helyett a tulajdonos masolata kerul bele.
+/// @param a - Az auto
+RendszamIndex::Bejegyzes::Bejegyzes(const Auto& a)
+    : autoAdat(a), vanTulajdonos(a.getTulajdonos() != nullptr), tulajdonos(vanTulajdonos ? *a.getTulajdonos() : Ugyfel()) {
+    autoAdat.setTulajdonos(nullptr);
+}
+
+/// Ures tabla k hellyel.
+/// @param k - A helyek szama (2 hatvanya)
+RendszamIndex::Tabla::Tabla(size_t k) : kapacitas(k), helyek(new std::atomic<const Bejegyzes*>[k]), foglalt(0), elo(0) {
+    for (size_t i = 0; i < k; i++)
+        helyek[i].store(nullptr, std::memory_order_relaxed);
+}
+
+/// Destruktor. A bejegyzeseket nem szabaditja fel (azok a tablacsere utan is elnek).
+RendszamIndex::Tabla::~Tabla() {
+    delete[] helyek;
+}
+
+
+
+/*-------------------------------------------
+          Konstruktorok es destruktor
+-------------------------------------------*/
+/// Alapertelmezett konstruktor (ures index).
+RendszamIndex::RendszamIndex() : tabla(new Tabla(16)) {}
+
+/// Destruktor. Felszabaditja a tablat es a bejegyzeseket.
+RendszamIndex::~RendszamIndex() {
+    Tabla* t = tabla.load();
+    for (size_t i = 0; i < t->kapacitas; i++) {
+        const Bejegyzes* b = t->helyek[i].load();
+        if (b != nullptr && b != sirko())
+            delete b;
+    }
+    delete t;
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// A torolt helyet jelolo mutato (soha nem olvasodik ki).
+/// @return - Egy statikus objektum cime, amely egyetlen valodi bejegyzessel sem egyezik
+const RendszamIndex::Bejegyzes* RendszamIndex::sirko() {
+    static const char jel = 0;
+    return reinterpret_cast<const Bejegyzes*>(&jel);
+}
+
+/// A rendszam hasitokodja.
+/// @param r - A rendszam
+/// @return - size_t
+size_t RendszamIndex::hasit(const std::string& r) {
+    return std::hash<std::string>()(r);
+}
+
+/// Bejegyzes elhelyezese a tablaban (uj tabla feltoltesekor, olvasok nelkul).
+/// @param t - A tabla
+/// @param b - A bejegyzes
+void RendszamIndex::elhelyez(Tabla& t, const Bejegyzes* b) {
+    size_t i = hasit(b->autoAdat.getRendszam()) & (t.kapacitas - 1);
+    while (t.helyek[i].load(std::memory_order_relaxed) != nullptr)
+        i = (i + 1) & (t.kapacitas - 1);
+    t.helyek[i].store(b, std::memory_order_relaxed);
+    t.foglalt++;
+    t.elo++;
+}
+
+/// Uj tabla a meglevo bejegyzesekkel (a torolt helyek nelkul), majd csere es a regi tabla felszabaditasa.
+/// @param kapacitas - Az uj tabla merete (2 hatvanya, nagyobb az elo bejegyzesek ketszeresenel)
+void RendszamIndex::atmeretez(size_t kapacitas) {
+    Tabla* regi = tabla.load();
+    Tabla* uj = new Tabla(kapacitas);
+    for (size_t i = 0; i < regi->kapacitas; i++) {
+        const Bejegyzes* b = regi->helyek[i].load(std::memory_order_relaxed);
+        if (b != nullptr && b != sirko())
+            elhelyez(*uj, b);
+    }
+    tabla.store(uj);
+    turelmiIdo();
+    delete regi;
+}
+
+
+
+/*-------------------------------------------
+            Olvasas (zarolas nelkul)
+-------------------------------------------*/
+/// Auto keresese rendszam alapjan.
+/// @param r - A rendszam
+/// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+/// @param tulajdonos - Ha nem nullptr es az autonak van tulajdonosa, ide kerul a masolata
+/// @return - true, ha az auto szerepel az indexben
+bool RendszamIndex::keres(const std::string& r, Auto& ki, Ugyfel* tulajdonos) const {
+    OlvasoBelepes belepes(olvasok);
+    const Tabla* t = tabla.load();
+    for (size_t i = hasit(r) & (t->kapacitas - 1);; i = (i + 1) & (t->kapacitas - 1)) {
+        const Bejegyzes* b = t->helyek[i].load();
+        if (b == nullptr) return false;
+        if (b == sirko() || b->autoAdat.getRendszam() != r) continue;
+        ki = b->autoAdat;
+        if (tulajdonos != nullptr && b->vanTulajdonos)
+            *tulajdonos = b->tulajdonos;
+        return true;
+    }
+}
+
+/// Szerepel-e a rendszam az indexben.
+/// @param r - A rendszam
+/// @return - true, ha szerepel
+bool RendszamIndex::tartalmaz(const std::string& r) const {
+    OlvasoBelepes belepes(olvasok);
+    const Tabla* t = tabla.load();
+    for (size_t i = hasit(r) & (t->kapacitas - 1);; i = (i + 1) & (t->kapacitas - 1)) {
+        const Bejegyzes* b = t->helyek[i].load();
+        if (b == nullptr) return false;
+        if (b != sirko() && b->autoAdat.getRendszam() == r) return true;
+    }
+}
+
+
+
+/*-------------------------------------------
+            Iras (egyszerre egy szalbol)
+-------------------------------------------*/
+/// Auto felvetele vagy a meglevo bejegyzes csereje.
+/// A lecserelt bejegyzes a turelmi ido utan szabadul fel.
+/// @param a - Az auto (a tulajdonosa is masolodik)
+void RendszamIndex::beallit(const Auto& a) {
+    Tabla* t = tabla.load();
+    if ((t->foglalt + 1) * 2 > t->kapacitas) {
+        size_t k = 16;
+        while (k < (t->elo + 1) * 4) k *= 2;
+        atmeretez(k);
+        t = tabla.load();
+    }
+
+    const Bejegyzes* uj = new Bejegyzes(a);
+    const size_t maszk = t->kapacitas - 1;
+    size_t szabad = t->kapacitas;
+    for (size_t i = hasit(a.getRendszam()) & maszk;; i = (i + 1) & maszk) {
+        const Bejegyzes* b = t->helyek[i].load(std::memory_order_relaxed);
+        if (b == sirko()) {
+            if (szabad == t->kapacitas) szabad = i;
+            continue;
+        }
+        if (b == nullptr) {
+            if (szabad == t->kapacitas) {
+                szabad = i;
+                t->foglalt++;
+            }
+            t->helyek[szabad].store(uj);
+            t->elo++;
+            return;
+        }
+        if (b->autoAdat.getRendszam() == a.getRendszam()) {
+            t->helyek[i].store(uj);
+            turelmiIdo();
+            delete b;
+            return;
+        }
+    }
+}
+
+/// Auto eltavolitasa. A hely torolt jelolest kap, a bejegyzes a turelmi ido utan szabadul fel.
+/// @param r - A rendszam
+void RendszamIndex::torol(const std::string& r) {
+    Tabla* t = tabla.load();
+    const size_t maszk = t->kapacitas - 1;
+    for (size_t i = hasit(r) & maszk;; i = (i + 1) & maszk) {
+        const Bejegyzes* b = t->helyek[i].load(std::memory_order_relaxed);
+        if (b == nullptr) return;
+        if (b == sirko() || b->autoAdat.getRendszam() != r) continue;
+        t->helyek[i].store(sirko());
+        t->elo--;
+        turelmiIdo();
+        delete b;
+        return;
+    }
+}
+
+/// Az index teljes ujraepitese: uj tabla az uj bejegyzesekkel, csere, majd a regiek felszabaditasa.
+/// @param autok - Az autok
+void RendszamIndex::ujraepit(const Vector<Auto>& autok) {
+    size_t k = 16;
+    while (k < autok.size() * 4) k *= 2;
+    Tabla* uj = new Tabla(k);
+    for (size_t i = 0; i < autok.size(); i++)
+        elhelyez(*uj, new Bejegyzes(autok[i]));
+
+    Tabla* regi = tabla.load();
+    tabla.store(uj);
+    turelmiIdo();
+    for (size_t i = 0; i < regi->kapacitas; i++) {
+        const Bejegyzes* b = regi->helyek[i].load(std::memory_order_relaxed);
+        if (b != nullptr && b != sirko())
+            delete b;
+    }
+    delete regi;
+}
\ No newline at end of file
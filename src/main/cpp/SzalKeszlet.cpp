@@ -0,0 +1,227 @@
+/**
+*   \file SzalKeszlet.cpp
+*   A SzalKeszlet tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <cstdlib>
+#include <exception>
+
+#include "SzalKeszlet.h"
+
+/// A hivo szal keszlete es sorszama (munkaszalon; mas szalon nullptr).
+static thread_local const SzalKeszlet* aktualisKeszlet = nullptr;
+static thread_local size_t aktualisIndex = 0;
+
+/// A kozos keszlet beallitott szalszama (0: nincs beallitva) es hogy letrejott-e mar.
+static std::atomic<size_t> alapertelmezettSzalszam(0);
+static std::atomic<bool> alapertelmezettLetrejott(false);
+
+/*-------------------------------------------
+        Konstruktor es destruktor
+-------------------------------------------*/
+/// Konstruktor, elinditja a munkaszalakat.
+/// @param szalakSzama - A munkaszalak szama (0 eseten a hardver altal tamogatott szalak szama)
+SzalKeszlet::SzalKeszlet(size_t szalakSzama) : fuggo(0), leall(false) {
+    if (szalakSzama == 0) szalakSzama = std::thread::hardware_concurrency();
+    if (szalakSzama == 0) szalakSzama = 1;
+    for (size_t i = 0; i <= szalakSzama; i++)
+        sorok.push_back(std::unique_ptr<Sor>(new Sor()));
+    szalak.reserve(szalakSzama);
+    for (size_t i = 0; i < szalakSzama; i++)
+        szalak.push_back(std::thread(&SzalKeszlet::munkaszal, this, i));
+}
+
+/// Destruktor, megvarja a folyamatban levo feladatokat es leallitja a szalakat.
+SzalKeszlet::~SzalKeszlet() {
+    {
+        std::lock_guard<std::mutex> z(alvoZar);
+        leall = true;
+    }
+    jelzes.notify_all();
+    for (size_t i = 0; i < szalak.size(); i++)
+        szalak[i].join();
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// A hivo szal sajat soranak indexe.
+/// @return - A munkaszal sorszama, vagy a kulso sor indexe
+size_t SzalKeszlet::sajatSor() const {
+    return aktualisKeszlet == this ? aktualisIndex : szalak.size();
+}
+
+/// Feladat elhelyezese: munkaszalrol a sajat sor vegere, mas szalrol a kulso hivasok soraba.
+/// @param feladat - A feladat
+void SzalKeszlet::betesz(std::function<void()> feladat) {
+    Sor& s = *sorok[sajatSor()];
+    {
+        std::lock_guard<std::mutex> z(s.zar);
+        s.feladatok.push_back(std::function<void()>());
+        s.feladatok.back().swap(feladat);
+        fuggo.fetch_add(1);     // a sor zarja alatt, igy a kivetel utani csokkentes nem elozheti meg
+    }
+    // A zar atvetele utan nem veszhet el az ebresztes: a varakozo a zar alatt nezi meg a fuggo erteket
+    { std::lock_guard<std::mutex> z(alvoZar); }
+    jelzes.notify_one();
+}
+
+/// Egy feladat kivetele: a sajat sor vegerol, a kulso sorbol, vegul mas szal sorarol lopva.
+/// @param feladat - Ide kerul a kivett feladat
+/// @return - true, ha sikerult feladatot kivenni
+bool SzalKeszlet::kivesz(std::function<void()>& feladat) {
+    if (fuggo.load() == 0) return false;
+
+    const size_t sajat = sajatSor();
+    const size_t kulso = szalak.size();
+    if (sajat != kulso) {
+        Sor& s = *sorok[sajat];
+        std::lock_guard<std::mutex> z(s.zar);
+        if (!s.feladatok.empty()) {
+            feladat.swap(s.feladatok.back());
+            s.feladatok.pop_back();
+            fuggo.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // A kulso sor, majd a tobbi szal sora, a sajat utani szaltol korbe (igy a lopasok szetszorodnak)
+    for (size_t k = 0; k <= kulso; k++) {
+        const size_t i = k == 0 ? kulso : (sajat + k) % kulso;
+        if (i == sajat) continue;
+        Sor& s = *sorok[i];
+        std::lock_guard<std::mutex> z(s.zar);
+        if (!s.feladatok.empty()) {
+            feladat.swap(s.feladatok.front());
+            s.feladatok.pop_front();
+            fuggo.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/// A darabok szama egy n meretu tartomanyhoz.
+/// A szalak szamanal tobb darab kell, hogy az egyenetlen darabokat a lopas kiegyenlitse.
+/// @param n - A tartomany merete
+/// @param minDarab - A legkisebb darabmeret
+/// @return - A darabok szama (legalabb 1)
+size_t SzalKeszlet::darabokSzama(size_t n, size_t minDarab) const {
+    if (minDarab == 0) minDarab = 1;
+    size_t darabok = (n + minDarab - 1) / minDarab;
+    const size_t legfeljebb = 4 * (szalak.size() + 1);
+    if (darabok > legfeljebb) darabok = legfeljebb;
+    return darabok == 0 ? 1 : darabok;
+}
+
+/// A munkaszalak ciklusa: feladatok kivetele, lopasa es vegrehajtasa a leallitasig.
+/// @param index - A szal sorszama (a sajat sor indexe)
+void SzalKeszlet::munkaszal(size_t index) {
+    aktualisKeszlet = this;
+    aktualisIndex = index;
+    std::function<void()> feladat;
+    for (;;) {
+        if (kivesz(feladat)) {
+            feladat();
+            feladat = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> z(alvoZar);
+        while (!leall && fuggo.load() == 0) jelzes.wait(z);
+        if (leall && fuggo.load() == 0) return;
+    }
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// A [0, n) tartomany parhuzamos feldolgozasa osszefuggo darabokban.
+/// @param n - A tartomany merete
+/// @param f - A darabot feldolgozo fuggveny
+/// @param minDarab - Ennel kisebb darabokra nem bontja a tartomanyt
+void SzalKeszlet::parhuzamosFor(size_t n, const std::function<void(size_t, size_t)>& f, size_t minDarab) {
+    if (n == 0) return;
+    const size_t darabok = darabokSzama(n, minDarab);
+    if (darabok <= 1) {
+        f(0, n);
+        return;
+    }
+
+    std::atomic<size_t> hatralevo(darabok - 1);    // a hivo szal sajat darabjan kivul
+    std::exception_ptr hiba;                        // az elso elkapott kivetel (a hibaZar vedi)
+    std::mutex hibaZar;
+
+    // Forditott sorrendben kerulnek a sorba, igy a sajat sorbol (a vegerol) kivett darabok sorrendben jonnek
+    for (size_t d = darabok - 1; d >= 1; d--) {
+        const size_t tol = n * d / darabok;
+        const size_t ig = n * (d + 1) / darabok;
+        betesz([this, &f, &hatralevo, &hiba, &hibaZar, tol, ig]() {
+            try { f(tol, ig); }
+            catch (...) {
+                std::lock_guard<std::mutex> z(hibaZar);
+                if (!hiba) hiba = std::current_exception();
+            }
+            if (hatralevo.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> z(alvoZar);
+                jelzes.notify_all();
+            }
+        });
+    }
+
+    std::exception_ptr sajatHiba;
+    try { f(0, n / darabok); }
+    catch (...) { sajatHiba = std::current_exception(); }
+
+    // Varakozas kozben a hivo szal is vesz ki (vagy lop) feladatot, akar mas hivasokeit is
+    std::function<void()> feladat;
+    while (hatralevo.load() > 0) {
+        if (kivesz(feladat)) {
+            feladat();
+            feladat = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> z(alvoZar);
+        while (hatralevo.load() > 0 && fuggo.load() == 0) jelzes.wait(z);
+    }
+
+    if (!sajatHiba) {
+        std::lock_guard<std::mutex> z(hibaZar);
+        sajatHiba = hiba;
+    }
+    if (sajatHiba) std::rethrow_exception(sajatHiba);
+}
+
+/// A program kozos szalkeszlete (elso hasznalatkor jon letre).
+/// @return - A keszlet referenciaja
+SzalKeszlet& SzalKeszlet::alapertelmezett() {
+    struct Letrehozo {
+        static size_t szalszam() {
+            alapertelmezettLetrejott.store(true);
+            size_t n = alapertelmezettSzalszam.load();
+            if (n == 0) {
+                const char* k = std::getenv("SZERVIZ_SZALAK");
+                if (k != nullptr) n = static_cast<size_t>(std::strtoul(k, nullptr, 10));
+            }
+            return n;
+        }
+    };
+    static SzalKeszlet keszlet(Letrehozo::szalszam());
+    return keszlet;
+}
+
+/// A kozos keszlet szalszamanak beallitasa indulaskor.
+/// @param szalakSzama - A munkaszalak szama (0: a hardver altal tamogatott szalak szama)
+/// @return - false, ha a kozos keszlet mar letrejott
+bool SzalKeszlet::beallitAlapertelmezettSzalszam(size_t szalakSzama) {
+    if (alapertelmezettLetrejott.load()) return false;
+    alapertelmezettSzalszam.store(szalakSzama);
+    return true;
+}
\ No newline at end of file
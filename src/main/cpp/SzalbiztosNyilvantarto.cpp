@@ -0,0 +1,308 @@
+/**
+*   \file SzalbiztosNyilvantarto.cpp
+*   A szalbiztos burkolo osztaly tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "SzalbiztosNyilvantarto.h"
+
+/*-------------------------------------------
+          Konstruktorok
+-------------------------------------------*/
+/// Alapertelmezett konstruktor (ures rendszer).
+SzalbiztosNyilvantarto::SzalbiztosNyilvantarto() : db(), zar(), rendszamIndex(), aktualis(new Pillanatkep()) {
+    irasUtan();
+}
+
+/// Konstruktor egy meglevo rendszer masolatabol.
+/// @param kezdo - A kiindulo rendszer
+SzalbiztosNyilvantarto::SzalbiztosNyilvantarto(const SzervizNyilvantartoRendszer& kezdo) : db(kezdo), zar(), rendszamIndex(), aktualis() {
+    irasUtan();
+    rendszamIndex.ujraepit(allapot().getAutok());
+    aktualis.reset(new Pillanatkep(Pillanatkep::felepit(allapot(), 0)));
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// Az auto indexe a rendszerben.
+/// @param r - A rendszam
+/// @return - Az index, vagy az autok szama, ha nem talalhato
+size_t SzalbiztosNyilvantarto::autoSorszam(const std::string& r) const {
+    return db.autoSorszam(r); // az irasUtan() utan a rendszer rendszamindexe friss, igy csak olvas
+}
+
+/// Az ugyfel indexe a rendszerben.
+/// @param n - Az ugyfel neve
+/// @return - Az index, vagy az ugyfelek szama, ha nem talalhato
+size_t SzalbiztosNyilvantarto::ugyfelSorszam(const std::string& n) const {
+    return db.ugyfelSorszam(n); // az irasUtan() utan a rendszer nevindexe friss, igy csak olvas
+}
+
+/// Az auto bejegyzesenek frissitese (vagy torlese) az indexben es a kovetkezo pillanatkepben
+/// a rendszer aktualis allapota alapjan.
+/// @param r - A rendszam
+void SzalbiztosNyilvantarto::indexFrissit(const std::string& r) {
+    const size_t i = autoSorszam(r);
+    const Vector<Auto>& autok = allapot().getAutok();
+    if (i == autok.size()) {
+        rendszamIndex.torol(r);
+        return;
+    }
+    const Auto& a = autok[i];
+    a.getKmRegresszio(); // a bejegyzes a tortenetet megosztja: az olvasok mar kesz regressziot kapjanak
+    rendszamIndex.beallit(a);
+    kozzetesz(aktualis->autoCsere(i, a));
+}
+
+/// Uj valtozat kozzetetele; a regit az utolso olvasoja szabaditja fel.
+/// @param p - A kovetkezo valtozat
+void SzalbiztosNyilvantarto::kozzetesz(const Pillanatkep& p) {
+    std::atomic_store(&aktualis, std::shared_ptr<const Pillanatkep>(new Pillanatkep(p)));
+}
+
+/// Iras utani teendok: a szarmaztatott strukturak frissitese.
+void SzalbiztosNyilvantarto::irasUtan() {
+    db.szarmaztatottAdatokFrissitese();
+}
+
+
+
+/*-------------------------------------------
+        Lekerdezesek
+-------------------------------------------*/
+/// Auto letezesenek ellenorzese (zarolas nelkul, az indexbol).
+/// @param r - A rendszam
+/// @return - true, ha az auto szerepel
+bool SzalbiztosNyilvantarto::vanAuto(const std::string& r) const {
+    return rendszamIndex.tartalmaz(r);
+}
+
+/// Ugyfel letezesenek ellenorzese.
+/// @param n - Az ugyfel neve
+/// @return - true, ha az ugyfel szerepel
+bool SzalbiztosNyilvantarto::vanUgyfel(const std::string& n) const {
+    MegosztottZar z(zar);
+    return db.vanUgyfel(n);
+}
+
+/// Auto keresese rendszam alapjan (zarolas nelkul, az indexbol).
+/// @param r - A rendszam
+/// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+/// @param tulajdonos - Ha nem nullptr es az autonak van tulajdonosa, ide kerul a masolata
+/// @return - true, ha az auto szerepel
+bool SzalbiztosNyilvantarto::keresAuto(const std::string& r, Auto& ki, Ugyfel* tulajdonos) const {
+    return rendszamIndex.keres(r, ki, tulajdonos);
+}
+
+/// Ugyfel keresese nev alapjan.
+/// @param n - Az ugyfel neve
+/// @param ki - Az ugyfel masolata
+/// @return - true, ha az ugyfel szerepel
+bool SzalbiztosNyilvantarto::keresUgyfel(const std::string& n, Ugyfel& ki) const {
+    MegosztottZar z(zar);
+    const Vector<Ugyfel>& ugyfelek = db.getUgyfelek();
+    for (size_t i = 0; i < ugyfelek.size(); i++) {
+        if (ugyfelek[i].getNev() == n) {
+            ki = ugyfelek[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Az auto szervizmuveleteinek kiirasa.
+/// @param os - A kimeneti adatfolyam
+/// @param r - A rendszam
+void SzalbiztosNyilvantarto::lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const {
+    MegosztottZar z(zar);
+    db.lekeroVegzettMuvelet(os, r);
+}
+
+/// A legutobb kozzetett pillanatkep (O(1), zarolas nelkul).
+/// @return - A pillanatkep
+std::shared_ptr<const Pillanatkep> SzalbiztosNyilvantarto::pillanatkep() const {
+    return std::atomic_load(&aktualis);
+}
+
+/// Az osszes auto kiirasa (pillanatkepbol, zarolas nelkul).
+/// @param os - A kimeneti adatfolyam
+void SzalbiztosNyilvantarto::listazAutok(std::ostream& os) const {
+    pillanatkep()->listazAutok(os);
+}
+
+/// Az osszes ugyfel kiirasa (pillanatkepbol, zarolas nelkul).
+/// @param os - A kimeneti adatfolyam
+void SzalbiztosNyilvantarto::listazUgyfelek(std::ostream& os) const {
+    pillanatkep()->listazUgyfelek(os);
+}
+
+/// A flotta figyelmeztetesei.
+/// @param ma - A referencia datum
+/// @return - A figyelmeztetesek
+Vector<Figyelmeztetes> SzalbiztosNyilvantarto::flottaFigyelmeztetesek(const Datum& ma) const {
+    MegosztottZar z(zar);
+    return db.flottaFigyelmeztetesek(ma);
+}
+
+/// Mentes fajlba (pillanatkepbol, zarolas nelkul).
+/// @param f - A celfajl neve
+void SzalbiztosNyilvantarto::mentesFajlba(const std::string& f) const {
+    pillanatkep()->mentesFajlba(f);
+}
+
+/// Tetszoleges lekerdezes a megosztott zar alatt.
+/// @param f - A lekerdezes
+void SzalbiztosNyilvantarto::olvas(const std::function<void(const SzervizNyilvantartoRendszer&)>& f) const {
+    MegosztottZar z(zar);
+    f(db);
+}
+
+
+
+/*-------------------------------------------
+        Modositasok
+-------------------------------------------*/
+/// Uj ugyfel felvetele.
+/// @param u - Az ugyfel
+/// @return - false, ha mar letezik
+bool SzalbiztosNyilvantarto::ujUgyfel(const Ugyfel& u) {
+    KizarolagosZar z(zar);
+    // Az ugyfelek tombje athelyezodhet, de az index a tulajdonosok masolatat tartja, igy nem kell frissiteni
+    if (!db.ujUgyfel(u)) return false;
+    irasUtan();
+    kozzetesz(aktualis->ugyfelHozzafuz(allapot().getUgyfelek().back()));
+    return true;
+}
+
+/// Uj auto felvetele; a tulajdonost a zar alatt, nev szerint koti be.
+/// @param a - Az auto (a tulajdonos-mutatoja figyelmen kivul marad)
+/// @param tulajdonosNev - A tulajdonos neve
+/// @return - false, ha az auto mar letezik vagy a tulajdonos nem talalhato
+bool SzalbiztosNyilvantarto::ujAuto(const Auto& a, const std::string& tulajdonosNev) {
+    KizarolagosZar z(zar);
+    if (!db.vanUgyfel(tulajdonosNev)) return false;
+    Auto uj(a);
+    uj.setTulajdonos(&db.keresUgyfel(tulajdonosNev));
+    if (!db.ujAuto(uj)) return false;
+    irasUtan();
+    const Auto& beszurt = allapot().getAutok().back();
+    rendszamIndex.beallit(beszurt);
+    kozzetesz(aktualis->autoHozzafuz(beszurt, ugyfelSorszam(tulajdonosNev)));
+    return true;
+}
+
+/// Ugyfel adatainak frissitese; az ugyfel autoinak bejegyzesei a tulajdonos uj adataival frissulnek.
+/// @param u - Az ugyfel uj adatai (nev szerint azonositva)
+/// @return - false, ha nem talalhato
+bool SzalbiztosNyilvantarto::frissitUgyfel(const Ugyfel& u) {
+    KizarolagosZar z(zar);
+    if (!db.frissitUgyfel(u)) return false;
+    irasUtan();
+    const Vector<Auto>& autok = allapot().getAutok();
+    const std::vector<size_t>& autoi = allapot().tulajdonosAutoSorszamai(u.getNev());
+    for (size_t k : autoi)
+        rendszamIndex.beallit(autok[k]);
+    const size_t i = ugyfelSorszam(u.getNev());
+    kozzetesz(aktualis->ugyfelCsere(i, allapot().getUgyfelek()[i], autoi));
+    return true;
+}
+
+/// Km ora frissitese.
+/// @param r - A rendszam
+/// @param k - Az uj km ora allas
+/// @return - false, ha az auto nem talalhato
+bool SzalbiztosNyilvantarto::frissitKmOra(const std::string& r, int k) {
+    KizarolagosZar z(zar);
+    if (!db.frissitKmOra(r, k)) return false;
+    irasUtan();
+    indexFrissit(r);
+    return true;
+}
+
+/// Szervizmuvelet rogzitese.
+/// @param r - A rendszam
+/// @param m - A muvelet rekordja
+/// @return - false, ha az auto nem talalhato
+bool SzalbiztosNyilvantarto::rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m) {
+    KizarolagosZar z(zar);
+    if (!db.rogzitesVegzettMuvelet(r, m)) return false;
+    irasUtan();
+    indexFrissit(r);
+    return true;
+}
+
+/// Szervizmuvelet torlese datum alapjan.
+/// @param r - A rendszam
+/// @param d - A muvelet datuma
+/// @return - false, ha az auto vagy a muvelet nem talalhato
+bool SzalbiztosNyilvantarto::torolMuvelet(const std::string& r, const Datum& d) {
+    KizarolagosZar z(zar);
+    if (!db.torolMuvelet(r, d)) return false;
+    irasUtan();
+    indexFrissit(r);
+    return true;
+}
+
+/// Auto torlese.
+/// @param r - A rendszam
+/// @return - false, ha nem talalhato
+bool SzalbiztosNyilvantarto::torolAuto(const std::string& r) {
+    KizarolagosZar z(zar);
+    const size_t i = autoSorszam(r);
+    if (!db.torolAuto(r)) return false;
+    irasUtan();
+    rendszamIndex.torol(r);
+    kozzetesz(aktualis->autoTorol(i));
+    return true;
+}
+
+/// Ugyfel (es autoi) torlese; az indexbol es a pillanatkepbol csak az o autoi kerulnek ki.
+/// @param n - Az ugyfel neve
+/// @return - false, ha nem talalhato
+bool SzalbiztosNyilvantarto::torolUgyfel(const std::string& n) {
+    KizarolagosZar z(zar);
+    const size_t i = ugyfelSorszam(n);
+    // A torles elotti indexek es rendszamok (a torles utan mar nem kerdezhetok le)
+    const std::vector<size_t> autoi = allapot().tulajdonosAutoSorszamai(n);
+    std::vector<std::string> rendszamok;
+    rendszamok.reserve(autoi.size());
+    for (size_t k : autoi)
+        rendszamok.push_back(allapot().getAutok()[k].getRendszam());
+    if (!db.torolUgyfel(n)) return false;
+    irasUtan();
+    for (const std::string& r : rendszamok)
+        rendszamIndex.torol(r);
+    kozzetesz(aktualis->ugyfelTorol(i, autoi));
+    return true;
+}
+
+/// Rendszeradatok betoltese fajlbol; az index teljesen ujraepul.
+/// Kivetel eseten is ujraepul, mert a betoltes felbeszakadva is modosithatta a rendszert.
+/// @param f - A fajl neve
+void SzalbiztosNyilvantarto::betoltesFajlbol(const std::string& f) {
+    ir([&f](SzervizNyilvantartoRendszer& d) { d.betoltesFajlbol(f); });
+}
+
+/// Tetszoleges modositas a kizarolagos zar alatt; utana az index es a pillanatkep teljesen ujraepul.
+/// @param f - A modositas
+void SzalbiztosNyilvantarto::ir(const std::function<void(SzervizNyilvantartoRendszer&)>& f) {
+    KizarolagosZar z(zar);
+    try {
+        f(db);
+    }
+    catch (...) {
+        irasUtan();
+        rendszamIndex.ujraepit(allapot().getAutok());
+        kozzetesz(Pillanatkep::felepit(allapot(), aktualis->getVerzio() + 1));
+        throw;
+    }
+    irasUtan();
+    rendszamIndex.ujraepit(allapot().getAutok());
+    kozzetesz(Pillanatkep::felepit(allapot(), aktualis->getVerzio() + 1));
+}
\ No newline at end of file
@@ -0,0 +1,331 @@
+/**
+*   \file Szerver.cpp
+*   A helyi socket szerver es esemenyhurkanak megvalositasa.
+*/
+
+#ifdef __linux__
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "Szerver.h"
+
+/// Rendszerhiba kivetelkent, az errno szovegevel.
+/// @param mit - A sikertelen muvelet leirasa
+static std::runtime_error rendszerHiba(const std::string& mit) {
+    return std::runtime_error(mit + ": " + std::strerror(errno));
+}
+
+/*-------------------------------------------
+        Konstruktor es destruktor
+-------------------------------------------*/
+/// Konstruktor. Letrehozza az epoll peldanyt es a leallito eventfd-t.
+/// @param db - A kiszolgalt rendszer
+/// @param naplo - A modosito parancsok naploja (nullptr: nincs naplozas)
+Szerver::Szerver(SzervizNyilvantartoRendszer& db, Naplo* naplo)
+    : vegrehajto(db), figyeloFd(-1), epollFd(-1), ebresztoFd(-1), unixUt(), port(0), kapcsolatok(), fut(true) {
+    vegrehajto.setNaplo(naplo);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) throw rendszerHiba("epoll_create1");
+
+    ebresztoFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ebresztoFd < 0) {
+        close(epollFd);
+        throw rendszerHiba("eventfd");
+    }
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = ebresztoFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ebresztoFd, &ev) < 0) {
+        close(ebresztoFd);
+        close(epollFd);
+        throw rendszerHiba("epoll_ctl");
+    }
+}
+
+/// Destruktor. Lezarja a kapcsolatokat es a socketeket, torli a Unix socket fajlt.
+Szerver::~Szerver() {
+    for (std::unordered_map<int, Kapcsolat>::iterator it = kapcsolatok.begin(); it != kapcsolatok.end(); ++it)
+        close(it->first);
+    if (figyeloFd >= 0) close(figyeloFd);
+    if (!unixUt.empty()) unlink(unixUt.c_str());
+    close(ebresztoFd);
+    close(epollFd);
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// Figyeles inditasa a megadott cimen.
+/// @param cim - "unix:<ut>", vagy "<helyi IPv4 cim vagy localhost>:<port>"
+void Szerver::figyel(const std::string& cim) {
+    if (figyeloFd >= 0) throw std::runtime_error("A szerver mar figyel! (figyel)");
+
+    int fd;
+    if (cim.compare(0, 5, "unix:") == 0) {
+        const std::string ut = cim.substr(5);
+        sockaddr_un cimUn;
+        std::memset(&cimUn, 0, sizeof(cimUn));
+        if (ut.empty() || ut.size() >= sizeof(cimUn.sun_path))
+            throw std::invalid_argument("Hibas Unix socket utvonal: " + ut);
+        cimUn.sun_family = AF_UNIX;
+        std::memcpy(cimUn.sun_path, ut.c_str(), ut.size() + 1);
+
+        // Egy korabbi futas bent maradt socket fajlja (mas fajlt nem torlunk)
+        struct stat st;
+        if (lstat(ut.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+            unlink(ut.c_str());
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) throw rendszerHiba("socket");
+        if (bind(fd, reinterpret_cast<sockaddr*>(&cimUn), sizeof(cimUn)) < 0) {
+            std::runtime_error e = rendszerHiba("bind " + ut);
+            close(fd);
+            throw e;
+        }
+        unixUt = ut;
+    }
+    else {
+        const size_t kettospont = cim.rfind(':');
+        if (kettospont == std::string::npos)
+            throw std::invalid_argument("Hibas cim (unix:<ut> vagy <cim>:<port>): " + cim);
+        std::string gep = cim.substr(0, kettospont);
+        const std::string portSzoveg = cim.substr(kettospont + 1);
+        char* veg = nullptr;
+        const long p = std::strtol(portSzoveg.c_str(), &veg, 10);
+        if (portSzoveg.empty() || *veg != '\0' || p < 0 || p > 65535)
+            throw std::invalid_argument("Hibas port: " + portSzoveg);
+        if (gep == "localhost") gep = "127.0.0.1";
+
+        sockaddr_in cimIn;
+        std::memset(&cimIn, 0, sizeof(cimIn));
+        cimIn.sin_family = AF_INET;
+        cimIn.sin_port = htons(static_cast<uint16_t>(p));
+        if (inet_pton(AF_INET, gep.c_str(), &cimIn.sin_addr) != 1)
+            throw std::invalid_argument("Hibas IPv4 cim: " + gep);
+        if ((ntohl(cimIn.sin_addr.s_addr) >> 24) != 127)
+            throw std::invalid_argument("A szerver csak helyi (127.x.x.x) cimre kothet: " + gep);
+
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) throw rendszerHiba("socket");
+        const int igen = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &igen, sizeof(igen));
+        socklen_t hossz = sizeof(cimIn);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&cimIn), sizeof(cimIn)) < 0
+            || getsockname(fd, reinterpret_cast<sockaddr*>(&cimIn), &hossz) < 0) {
+            std::runtime_error e = rendszerHiba("bind " + cim);
+            close(fd);
+            throw e;
+        }
+        port = ntohs(cimIn.sin_port);
+    }
+
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (listen(fd, SOMAXCONN) < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        std::runtime_error e = rendszerHiba("listen");
+        close(fd);
+        throw e;
+    }
+    figyeloFd = fd;
+}
+
+/// Az esemenyhurok futtatasa a leallit() hivasig.
+void Szerver::futtat() {
+    if (figyeloFd < 0) throw std::runtime_error("A szerver meg nem figyel! (futtat)");
+
+    epoll_event esemenyek[64];
+    while (fut.load()) {
+        const int n = epoll_wait(epollFd, esemenyek, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw rendszerHiba("epoll_wait");
+        }
+        for (int i = 0; i < n; i++) {
+            const int fd = esemenyek[i].data.fd;
+            if (fd == ebresztoFd) {
+                uint64_t jelzes;
+                while (read(ebresztoFd, &jelzes, sizeof(jelzes)) > 0) {}
+                continue;
+            }
+            if (fd == figyeloFd) {
+                elfogad();
+                continue;
+            }
+            std::unordered_map<int, Kapcsolat>::iterator it = kapcsolatok.find(fd);
+            if (it != kapcsolatok.end() && !kiszolgal(fd, it->second, esemenyek[i].events))
+                lezar(fd);
+        }
+    }
+}
+
+/// Leallitas kerese (az eventfd irasa async-signal-safe).
+void Szerver::leallit() {
+    fut.store(false);
+    const uint64_t egy = 1;
+    ssize_t n = write(ebresztoFd, &egy, sizeof(egy));
+    (void)n;
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// Az osszes varakozo kapcsolat elfogadasa.
+void Szerver::elfogad() {
+    for (;;) {
+        const int fd = accept4(figyeloFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN: nincs tobb; egyeb hiba (pl. EMFILE): a kovetkezo esemenynel ujra probaljuk
+        }
+        if (unixUt.empty()) {
+            const int igen = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &igen, sizeof(igen));
+        }
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            continue;
+        }
+        kapcsolatok[fd].maszk = EPOLLIN;
+    }
+}
+
+/// Egy kapcsolat esemenyeinek kiszolgalasa.
+/// @param fd - A kapcsolat leiroja
+/// @param k - A kapcsolat allapota
+/// @param esemenyek - Az epoll altal jelzett esemenyek
+/// @return - false, ha a kapcsolatot le kell zarni
+bool Szerver::kiszolgal(int fd, Kapcsolat& k, unsigned esemenyek) {
+    if (esemenyek & EPOLLIN) {
+        if (!beolvas(fd, k)) return false;
+    }
+    else if ((esemenyek & (EPOLLERR | EPOLLHUP)) && !(esemenyek & EPOLLOUT)) {
+        return false;
+    }
+
+    // Vegrehajtas es kuldes felvaltva, amig van vegrehajthato keret es a kliens fogadja a valaszokat
+    for (;;) {
+        const size_t elotte = k.be.size();
+        if (!feldolgoz(k) || !kuld(fd, k)) return false;
+        if (k.kiPoz < k.ki.size() || k.be.size() == elotte) break;
+    }
+
+    if (k.lezarando && k.kiPoz == k.ki.size())
+        return false;
+    return figyelesBeallit(fd, k);
+}
+
+/// Beolvasas, amig van adat (vagy amig a kimeneti puffer meg nem telik).
+/// @param fd - A kapcsolat leiroja
+/// @param k - A kapcsolat allapota
+/// @return - false, ha olvasasi hiba tortent
+bool Szerver::beolvas(int fd, Kapcsolat& k) {
+    char puffer[64 * 1024];
+    while (k.ki.size() - k.kiPoz <= MAX_KIMENET && k.be.size() <= MAX_BEMENET) {
+        const ssize_t n = read(fd, puffer, sizeof(puffer));
+        if (n > 0) {
+            k.be.append(puffer, static_cast<size_t>(n));
+            if (static_cast<size_t>(n) < sizeof(puffer)) break;
+            continue;
+        }
+        if (n == 0) {
+            // A kliens befejezte a kuldest: az utolso, lezaratlan sort is vegrehajtjuk
+            k.lezarando = true;
+            if (!k.be.empty() && k.be[k.be.size() - 1] != '\n') k.be += '\n';
+            break;
+        }
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    return true;
+}
+
+/// A beolvasott teljes keretek (sorok es kotegek) vegrehajtasa (amig a kimeneti puffer meg nem telik).
+/// @param k - A kapcsolat allapota
+/// @return - false, ha egy sor vagy egy befejezetlen koteg tul hosszu
+bool Szerver::feldolgoz(Kapcsolat& k) {
+    k.be.erase(0, vegrehajto.feldolgoz(k.be.data(), k.be.size(), k.ki, k.kiPoz + MAX_KIMENET));
+    if (k.be.size() > MAX_BEMENET) return false;
+    return k.be.size() <= MAX_SOR || k.be.find('\n') != std::string::npos;
+}
+
+/// A varakozo valaszok kuldese, amig a socket fogadja.
+/// @param fd - A kapcsolat leiroja
+/// @param k - A kapcsolat allapota
+/// @return - false, ha kuldesi hiba tortent
+bool Szerver::kuld(int fd, Kapcsolat& k) {
+    while (k.kiPoz < k.ki.size()) {
+        const ssize_t n = send(fd, k.ki.data() + k.kiPoz, k.ki.size() - k.kiPoz, MSG_NOSIGNAL);
+        if (n > 0) {
+            k.kiPoz += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    if (k.kiPoz == k.ki.size()) {
+        k.ki.clear();
+        k.kiPoz = 0;
+    }
+    return true;
+}
+
+/// A figyelt esemenyek igazitasa az allapothoz.
+/// @param fd - A kapcsolat leiroja
+/// @param k - A kapcsolat allapota
+/// @return - false, ha az epoll_ctl hibat adott
+bool Szerver::figyelesBeallit(int fd, Kapcsolat& k) {
+    const size_t fuggo = k.ki.size() - k.kiPoz;
+    unsigned maszk = 0;
+    if (!k.lezarando && fuggo <= MAX_KIMENET) maszk |= EPOLLIN;
+    if (fuggo > 0) maszk |= EPOLLOUT;
+    if (maszk == k.maszk) return true;
+
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = maszk;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) < 0) return false;
+    k.maszk = maszk;
+    return true;
+}
+
+/// A kapcsolat lezarasa es eltavolitasa.
+/// @param fd - A kapcsolat leiroja
+void Szerver::lezar(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    kapcsolatok.erase(fd);
+}
+
+#endif // __linux__
\ No newline at end of file
@@ -0,0 +1,401 @@
+/**
+*   \file SzervizEsemenyTar.cpp
+*   A SzervizEsemenyTar tagfuggvenyeinek megvalositasa.
+*
+*   Az osszesito ciklusok elagazas nelkuli, a tombokon egyszer vegighalado formaban vannak irva,
+*   hogy a fordito vektorizalhassa oket.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "SzervizEsemenyTar.h"
+#include "TopK.hpp"
+#include "Auto.h"
+
+const uint32_t SzervizEsemenyTar::NINCS_AUTO;
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// Egy esemeny hozzafuzese a tar vegere.
+/// @param hely - Az auto helye
+/// @param r - A szervizrekord (az auto tortenetenek vegere kerul)
+void SzervizEsemenyTar::esemenyHozzafuz(uint32_t hely, const SzervizRekord& r) {
+    std::vector<uint32_t>& lista = helyEsemenyei[hely];
+    helyek.push_back(hely);
+    rekordIdk.push_back(static_cast<uint32_t>(lista.size()));
+    tipusok.push_back(static_cast<char>(r.tipus));
+    datumok.push_back(r.idopont.getNapSorszam());
+    arak.push_back(r.ar);
+    kmek.push_back(r.akt_kmOra);
+    sikeresek.push_back(r.sikeres ? 1 : 0);
+    lista.push_back(static_cast<uint32_t>(helyek.size() - 1));
+}
+
+/// Egy esemeny eltavolitasa: a helyere az utolso esemeny kerul, aminek a hivatkozasa atallitodik.
+/// A torolt esemeny hivatkozasat a hely esemenylistajabol a hivo veszi ki.
+/// @param e - Az esemeny indexe
+void SzervizEsemenyTar::esemenyEltavolit(uint32_t e) {
+    const uint32_t utolso = static_cast<uint32_t>(meret() - 1);
+    if (e != utolso) {
+        helyek[e] = helyek[utolso];
+        rekordIdk[e] = rekordIdk[utolso];
+        tipusok[e] = tipusok[utolso];
+        datumok[e] = datumok[utolso];
+        arak[e] = arak[utolso];
+        kmek[e] = kmek[utolso];
+        sikeresek[e] = sikeresek[utolso];
+        helyEsemenyei[helyek[e]][rekordIdk[e]] = e;
+    }
+    helyek.pop_back();
+    rekordIdk.pop_back();
+    tipusok.pop_back();
+    datumok.pop_back();
+    arak.pop_back();
+    kmek.pop_back();
+    sikeresek.pop_back();
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// Az osszes oszlop uritese.
+void SzervizEsemenyTar::torol() {
+    helyek.clear();
+    rekordIdk.clear();
+    tipusok.clear();
+    datumok.clear();
+    arak.clear();
+    kmek.clear();
+    sikeresek.clear();
+    helyEsemenyei.clear();
+    helyAutok.clear();
+    autoHelyek.clear();
+    szabadHelyek.clear();
+}
+
+/// Ujraepiti a tarat az autok szerviztorteneteibol (az i. auto az i. helyre kerul).
+/// @param autok - A rendszer autoi
+void SzervizEsemenyTar::ujraepit(const Vector<Auto>& autok) {
+    torol();
+
+    size_t db = 0;
+    for (size_t i = 0; i < autok.size(); i++)
+        db += autok[i].getSzervizRekordok().size();
+
+    helyek.reserve(db);
+    rekordIdk.reserve(db);
+    tipusok.reserve(db);
+    datumok.reserve(db);
+    arak.reserve(db);
+    kmek.reserve(db);
+    sikeresek.reserve(db);
+    helyEsemenyei.reserve(autok.size());
+    helyAutok.reserve(autok.size());
+    autoHelyek.reserve(autok.size());
+
+    for (size_t i = 0; i < autok.size(); i++)
+        autoHozzafuz(autok[i]);
+}
+
+/// Uj auto felvetele (az autok tombjenek vegere kerult): helyet kap, a tortenete a tar vegere kerul.
+/// Torolt auto helye ujrahasznosul, kulonben uj hely nyilik.
+/// @param a - Az auto
+void SzervizEsemenyTar::autoHozzafuz(const Auto& a) {
+    uint32_t hely;
+    if (!szabadHelyek.empty()) {
+        hely = szabadHelyek.back();
+        szabadHelyek.pop_back();
+    }
+    else {
+        hely = static_cast<uint32_t>(helyAutok.size());
+        helyAutok.push_back(NINCS_AUTO);
+        helyEsemenyei.push_back(std::vector<uint32_t>());
+    }
+    helyAutok[hely] = static_cast<uint32_t>(autoHelyek.size());
+    autoHelyek.push_back(hely);
+
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    helyEsemenyei[hely].reserve(rekordok.size());
+    for (size_t j = 0; j < rekordok.size(); j++)
+        esemenyHozzafuz(hely, rekordok[j]);
+}
+
+/// Egy rekord hozzafuzese barmely auto tortenetenek vegere. O(1).
+/// @param autoId - Az auto sorszama
+/// @param r - A szervizrekord
+void SzervizEsemenyTar::hozzafuz(uint32_t autoId, const SzervizRekord& r) {
+    esemenyHozzafuz(autoHelyek[autoId], r);
+}
+
+/// Egy rekord torlese az auto tortenetebol; a mogotte levo rekordok sorszama eggyel csokken.
+/// @param autoId - Az auto sorszama
+/// @param rekord - A rekord sorszama az auto torteneteben
+void SzervizEsemenyTar::rekordTorol(uint32_t autoId, size_t rekord) {
+    std::vector<uint32_t>& lista = helyEsemenyei[autoHelyek[autoId]];
+    if (rekord >= lista.size()) return;
+    const uint32_t e = lista[rekord];
+    lista.erase(lista.begin() + static_cast<std::ptrdiff_t>(rekord));
+    for (size_t j = rekord; j < lista.size(); j++)
+        rekordIdk[lista[j]]--;
+    esemenyEltavolit(e);
+}
+
+/// Az auto teljes tortenetenek lecserelese (a helye megmarad).
+/// @param autoId - Az auto sorszama
+/// @param a - Az auto uj allapota
+void SzervizEsemenyTar::autoCsere(uint32_t autoId, const Auto& a) {
+    const uint32_t hely = autoHelyek[autoId];
+    std::vector<uint32_t>& lista = helyEsemenyei[hely];
+    // Hatulrol: az athelyezett esemeny, ha ehhez az autohoz tartozik, meg a listaban marado elemre mutat
+    while (!lista.empty()) {
+        const uint32_t e = lista.back();
+        lista.pop_back();
+        esemenyEltavolit(e);
+    }
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    for (size_t j = 0; j < rekordok.size(); j++)
+        esemenyHozzafuz(hely, rekordok[j]);
+}
+
+/// Auto torlese (az autok tombjebol is torlodott, a mogotte levok eggyel elore csusztak).
+/// @param autoId - Az auto sorszama
+void SzervizEsemenyTar::autoTorol(uint32_t autoId) {
+    const uint32_t hely = autoHelyek[autoId];
+    std::vector<uint32_t>& lista = helyEsemenyei[hely];
+    while (!lista.empty()) {
+        const uint32_t e = lista.back();
+        lista.pop_back();
+        esemenyEltavolit(e);
+    }
+    std::vector<uint32_t>().swap(lista);
+    helyAutok[hely] = NINCS_AUTO;
+    szabadHelyek.push_back(hely);
+    autoHelyek.erase(autoHelyek.begin() + autoId);
+    for (size_t h = 0; h < helyAutok.size(); h++)
+        if (helyAutok[h] != NINCS_AUTO && helyAutok[h] > autoId)
+            helyAutok[h]--;
+}
+
+
+
+/*-------------------------------------------
+              Osszesitesek
+-------------------------------------------*/
+/// Az osszes koltes a [tol, ig) idoszakban.
+/// @param tol - Az idoszak eleje (benne van)
+/// @param ig - Az idoszak vege (nincs benne)
+/// @return - Az arak osszege (64 bites)
+long long SzervizEsemenyTar::koltesIdoszakban(const Datum& tol, const Datum& ig) const {
+    const int32_t* d = datumok.begin();
+    const int32_t* a = arak.begin();
+    const int32_t also = tol.getNapSorszam();
+    const int32_t felso = ig.getNapSorszam();
+    const size_t n = meret();
+
+    long long osszeg = 0;
+    for (size_t i = 0; i < n; i++)
+        osszeg += (d[i] >= also && d[i] < felso) ? a[i] : 0;
+    return osszeg;
+}
+
+/// Az osszes koltes egy adott evben.
+/// @param ev - Az ev
+/// @return - Az arak osszege (64 bites)
+long long SzervizEsemenyTar::koltesEvben(int ev) const {
+    return koltesIdoszakban(Datum(ev, 1, 1), Datum(ev + 1, 1, 1));
+}
+
+/// Evenkenti koltes egy evtartomanyra.
+/// Az evhatarokat napsorszamkent egyszer szamolja ki, utana evenkent egy szuro-osszegzo ciklus fut.
+/// @param elsoEv - Az elso ev
+/// @param evekSzama - Az evek szama
+/// @param ki - Legalabb evekSzama elemu tomb, ki[i] az (elsoEv + i). ev koltese lesz
+void SzervizEsemenyTar::koltesEvente(int elsoEv, int evekSzama, long long* ki) const {
+    for (int i = 0; i < evekSzama; i++)
+        ki[i] = koltesEvben(elsoEv + i);
+}
+
+/// Atlagos km ket egymast koveto szerviz kozott ugyanannal az autonal.
+/// Egy auto szomszedos szervizeinek km kulonbsegei az utolso es az elso szerviz kulonbsegeve
+/// osszegzodnek, igy autonkent eleg a tortenet ket szelso esemenyet nezni (n rekordbol n - 1 koz).
+/// @return - Az atlag, vagy 0, ha egyik autonak sincs legalabb ket szervize
+double SzervizEsemenyTar::atlagKmSzervizekKozott() const {
+    const int32_t* km = kmek.begin();
+
+    long long osszeg = 0;
+    long long parok = 0;
+    for (size_t h = 0; h < helyEsemenyei.size(); h++) {
+        const std::vector<uint32_t>& lista = helyEsemenyei[h];
+        if (lista.size() < 2) continue;
+        osszeg += static_cast<long long>(km[lista.back()]) - km[lista.front()];
+        parok += static_cast<long long>(lista.size() - 1);
+    }
+    return parok == 0 ? 0.0 : static_cast<double>(osszeg) / parok;
+}
+
+/// A sikertelen vizsgak szama.
+/// @return - size_t
+size_t SzervizEsemenyTar::sikertelenVizsgakSzama() const {
+    const char* t = tipusok.begin();
+    const char* s = sikeresek.begin();
+    const size_t n = meret();
+
+    size_t db = 0;
+    for (size_t i = 0; i < n; i++)
+        db += (t[i] == static_cast<char>(MuveletTipus::Vizsga)) & (s[i] == 0);
+    return db;
+}
+
+/// Egy szamtomb feltoltese n darab nullaval (gyujtotombok elokeszitesehez).
+/// A fuggveny static kulcsszoval van ellatva, mert csak a jelenlegi forditasi egysegen (fajlban) belul hasznaljuk, igy nem szukseges kivulrol elerhetove tenni.
+/// @param v - A tomb (a meglevo elemek torlodnek)
+/// @param n - Az elemek szama
+template <typename T>
+static void nullakkal(Vector<T>& v, size_t n) {
+    v.clear();
+    v.reserve(n);
+    for (size_t i = 0; i < n; i++) v.push_back(0);
+}
+
+/// Bevetel osszesitese honap, tipus es autocsoport szerint, egyetlen menetben, 64 bites gyujtokkel.
+/// A datumokbol egy nap -> honap keresotabla keszul (a datumtartomany honaphatarai alapjan), igy a fo
+/// ciklusban nincs naptarszamitas: minden esemenyre harom tablazatbeli hely kap egy osszeadast.
+/// @param autoCsoport - Autonkent a csoport sorszama (az auto sorszamaval indexelve, < csoportokSzama)
+/// @param csoportokSzama - A csoportok szama
+/// @param ki - Az eredmeny (felulirja)
+void SzervizEsemenyTar::bevetelOsszesites(const uint32_t* autoCsoport, size_t csoportokSzama, BevetelOsszesites& ki) const {
+    ki = BevetelOsszesites();
+    const char* tipusNevek[3] = { "J", "K", "V" };
+    for (size_t t = 0; t < 3; t++) {
+        ki.tipusok.push_back(BevetelCsoport());
+        ki.tipusok.back().kulcs = tipusNevek[t];
+    }
+    ki.csoportok.reserve(csoportokSzama);
+    for (size_t c = 0; c < csoportokSzama; c++) ki.csoportok.push_back(BevetelCsoport());
+
+    const size_t n = meret();
+    if (n == 0) return;
+    const uint32_t* hely = helyek.begin();
+    const uint32_t* helyAuto = helyAutok.begin();
+    const char* tip = tipusok.begin();
+    const int32_t* d = datumok.begin();
+    const int32_t* ar = arak.begin();
+
+    // A datumtartomany es a teljes osszeg (elagazas nelkuli, vektorizalhato)
+    int32_t minNap = d[0], maxNap = d[0];
+    long long osszeg = 0;
+    for (size_t i = 0; i < n; i++) {
+        minNap = d[i] < minNap ? d[i] : minNap;
+        maxNap = d[i] > maxNap ? d[i] : maxNap;
+        osszeg += ar[i];
+    }
+    ki.osszeg = osszeg;
+    ki.darab = static_cast<long long>(n);
+
+    // Nap -> honap sorszam keresotabla a [minNap, maxNap] tartomanyra
+    const Datum elso = Datum::fromNapSorszam(minNap);
+    int ev = elso.getEv(), ho = elso.getHo();
+    const int elsoEv = ev, elsoHo = ho;
+    Vector<uint32_t> honapTabla;
+    nullakkal(honapTabla, static_cast<size_t>(maxNap - minNap) + 1);
+    uint32_t honap = 0;
+    for (int32_t nap = minNap; nap <= maxNap; honap++) {
+        if (++ho > 12) { ho = 1; ev++; }
+        int32_t kovetkezo = Datum(ev, ho, 1).getNapSorszam();
+        if (kovetkezo > maxNap + 1) kovetkezo = maxNap + 1;
+        for (; nap < kovetkezo; nap++) honapTabla[static_cast<size_t>(nap - minNap)] = honap;
+    }
+    Vector<long long> honapOsszeg, honapDarab;
+    nullakkal(honapOsszeg, honap);
+    nullakkal(honapDarab, honap);
+
+    // Tipus -> index (az ismeretlen tipusok a 3. helyre kerulnek, amit nem adunk vissza)
+    unsigned char tipusIndex[256];
+    for (int c = 0; c < 256; c++) tipusIndex[c] = 3;
+    tipusIndex[static_cast<unsigned char>('J')] = 0;
+    tipusIndex[static_cast<unsigned char>('K')] = 1;
+    tipusIndex[static_cast<unsigned char>('V')] = 2;
+    long long tipusOsszeg[4] = { 0, 0, 0, 0 };
+    long long tipusDarab[4] = { 0, 0, 0, 0 };
+
+    Vector<long long> csoportOsszeg, csoportDarab;
+    nullakkal(csoportOsszeg, csoportokSzama);
+    nullakkal(csoportDarab, csoportokSzama);
+    long long* hO = honapOsszeg.begin();
+    long long* hD = honapDarab.begin();
+    long long* cO = csoportOsszeg.begin();
+    long long* cD = csoportDarab.begin();
+    const uint32_t* hT = honapTabla.begin();
+
+    // Az egyetlen csoportosito menet
+    for (size_t i = 0; i < n; i++) {
+        const long long a = ar[i];
+        const uint32_t h = hT[d[i] - minNap];
+        const unsigned char t = tipusIndex[static_cast<unsigned char>(tip[i])];
+        const uint32_t c = autoCsoport[helyAuto[hely[i]]];
+        hO[h] += a; hD[h]++;
+        tipusOsszeg[t] += a; tipusDarab[t]++;
+        cO[c] += a; cD[c]++;
+    }
+
+    for (size_t t = 0; t < 3; t++) {
+        ki.tipusok[t].osszeg = tipusOsszeg[t];
+        ki.tipusok[t].darab = tipusDarab[t];
+    }
+    for (size_t c = 0; c < csoportokSzama; c++) {
+        ki.csoportok[c].osszeg = cO[c];
+        ki.csoportok[c].darab = cD[c];
+    }
+    ev = elsoEv;
+    ho = elsoHo;
+    for (uint32_t h = 0; h < honap; h++) {
+        if (hD[h] > 0) {
+            char kulcs[16];
+            char* p = kulcs + Datum(ev, ho, 1).formatToBuffer(kulcs) - 3;     // "EEEE.HH.01" -> "EEEE.HH"
+            ki.honapok.push_back(BevetelCsoport());
+            ki.honapok.back().kulcs.assign(kulcs, p);
+            ki.honapok.back().osszeg = hO[h];
+            ki.honapok.back().darab = hD[h];
+        }
+        if (++ho > 12) { ho = 1; ev++; }
+    }
+}
+
+/// Az esemenyek rendezese a legdragabbak keresesehez: (ar, index) parokon az olcsobb,
+/// egyenlo arnal a kesobbi esemeny a rosszabb.
+struct ArSzerintRosszabb {
+    bool operator()(const std::pair<int32_t, size_t>& a, const std::pair<int32_t, size_t>& b) const {
+        return a.first != b.first ? a.first < b.first : a.second > b.second;
+    }
+};
+
+/// A k legdragabb esemeny a [tol, ig) idoszakban, korlatos kupaccal (O(n log k) ido, O(k) memoria).
+/// @param k - A keresett esemenyek szama
+/// @param tipus - Csak ilyen tipusu esemenyek ('J', 'K', 'V'), vagy 0 eseten barmely
+/// @param tol - Az idoszak eleje (benne van)
+/// @param ig - Az idoszak vege (nincs benne)
+/// @param ki - Az esemenyek indexei ar szerint csokkenoen, egyenlo arnal a korabbi index elol (felulirja)
+void SzervizEsemenyTar::legdragabbak(size_t k, char tipus, const Datum& tol, const Datum& ig, Vector<size_t>& ki) const {
+    const char* t = tipusok.begin();
+    const int32_t* d = datumok.begin();
+    const int32_t* a = arak.begin();
+    const int32_t also = tol.getNapSorszam();
+    const int32_t felso = ig.getNapSorszam();
+    const size_t n = meret();
+
+    TopK<std::pair<int32_t, size_t>, ArSzerintRosszabb> legjobbak(k);
+    for (size_t i = 0; i < n; i++) {
+        if (d[i] < also || d[i] >= felso || (tipus != 0 && t[i] != tipus)) continue;
+        legjobbak.ajanl(std::make_pair(a[i], i));
+    }
+
+    Vector<std::pair<int32_t, size_t> > rendezett = legjobbak.eredmeny();
+    ki.clear();
+    for (size_t i = 0; i < rendezett.size(); i++)
+        ki.push_back(rendezett[i].second);
+}
\ No newline at end of file
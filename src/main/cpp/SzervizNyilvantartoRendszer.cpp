@@ -10,6 +10,18 @@
 #include <fstream>
 #include <sstream>
 #include <cctype>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <cstdio>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "SzervizNyilvantartoRendszer.h"
 #include "Auto.h"
@@ -18,29 +30,38 @@
 #include "Vizsga.h"
 #include "Karbantartas.h"
 #include "Javitas.h"
+#include "SzervizRekord.h"
+#include "SzervizEsemenyTar.h"
+#include "SzervizTortenet.h"
+#include "EmlekeztetoMotor.h"
+#include "SzalKeszlet.h"
+#include "FigyelmeztetesiSzabalyok.h"
+#include "UgyfelOsszesitok.h"
+#include "TopK.hpp"
 
 /*-------------------------------------------
 		Konstruktorok es destruktor
 -------------------------------------------*/
 /// Alapertelmezett konstruktor.
 /// ures vektort hoz letre, elore lefoglalt kapacitassal.
-SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer() : autok(), ugyfelek() {}
+SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer() : autok(), ugyfelek(), autoIndexekFriss(false), ugyfelIndexekFriss(false), esemenyTarFriss(false), emlekeztetoFriss(false), ugyfelOsszesitokFriss(false), szabalyok(FigyelmeztetesiSzabalyok::alapertelmezett()) {}
 
 /// Parameteres konstruktor
 /// @param a - Az auto peldany
 /// @param u - Az ugyfel peldany
-SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer(const Auto& a, const Ugyfel& u) {
+SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer(const Auto& a, const Ugyfel& u) : autoIndexekFriss(false), ugyfelIndexekFriss(false), esemenyTarFriss(false), emlekeztetoFriss(false), ugyfelOsszesitokFriss(false), szabalyok(FigyelmeztetesiSzabalyok::alapertelmezett()) {
 	autok.push_back(a);
 	ugyfelek.push_back(u);
 }
 
 /// Masolo konstruktor.
 /// @param v - Masolando SzervizNyilvantartoRendszer peldany
-SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer(const SzervizNyilvantartoRendszer& v) {
+SzervizNyilvantartoRendszer::SzervizNyilvantartoRendszer(const SzervizNyilvantartoRendszer& v) : autoIndexekFriss(false), ugyfelIndexekFriss(false), esemenyTarFriss(false), emlekeztetoFriss(false), ugyfelOsszesitokFriss(false), szabalyok(v.szabalyok) {
 	for (size_t i = 0; i < v.autok.size(); i++)
 		autok.push_back(v.autok.at(i));
 	for (size_t i = 0; i < v.ugyfelek.size(); i++)
 		ugyfelek.push_back(v.ugyfelek.at(i));
+	tulajdonosokAtkotese(v.ugyfelek.begin(), v.ugyfelek.size(), v.ugyfelek.size()); // a masolat a sajat ugyfeleire mutasson
 }
 
 /// Destruktor.
@@ -49,12 +70,108 @@ SzervizNyilvantartoRendszer::~SzervizNyilvantartoRendszer() = default;
 
 
 
+/*-------------------------------------------
+			Belso segedfuggvenyek
+-------------------------------------------*/
+/// Az autokbol szarmaztatott segedstrukturak (rendszamindex, esemenytar, emlekezteto, ugyfelosszesitok) ervenytelenitese.
+/// A kovetkezo lekereskor egyszer, teljesen ujraepulnek.
+void SzervizNyilvantartoRendszer::szarmaztatottAdatokElavultak() const {
+	autoIndexekFriss = false;
+	ugyfelIndexekFriss = false;
+	esemenyTarFriss = false;
+	emlekeztetoFriss = false;
+	ugyfelOsszesitokFriss = false;
+}
+
+/// A rendszamindex ujraepitese az autok tombjebol (azonos rendszamnal az elso auto szamit).
+void SzervizNyilvantartoRendszer::autoIndexekUjraepitese() const {
+	autoIndexek.clear();
+	autoIndexek.reserve(autok.size());
+	for (size_t i = 0; i < autok.size(); i++)
+		autoIndexek.emplace(autok[i].getRendszam(), i);
+	autoIndexekFriss = true;
+}
+
+/// Az autok torlese utan a rendszamindex ertekeinek atszamozasa (a torolt rendszamokat a hivo veszi ki).
+/// Az ertekeken halad vegig, igy egyetlen rendszamot sem kell ujra hashelni.
+/// @param torolt - A torolt autok korabbi indexei novekvo sorrendben
+void SzervizNyilvantartoRendszer::autoIndexekAtszamozasa(const std::vector<size_t>& torolt) {
+	for (auto& a : autoIndexek)
+		if (a.second > torolt[0])
+			a.second -= static_cast<size_t>(std::lower_bound(torolt.begin(), torolt.end(), a.second) - torolt.begin());
+}
+
+/// A nevindex es a tulajdonosindex ujraepitese (azonos nevnel az elso ugyfel szamit).
+void SzervizNyilvantartoRendszer::ugyfelIndexekUjraepitese() const {
+	ugyfelIndexek.clear();
+	ugyfelIndexek.reserve(ugyfelek.size());
+	for (size_t i = 0; i < ugyfelek.size(); i++)
+		ugyfelIndexek.emplace(ugyfelek[i].getNev(), i);
+	tulajdonosAutoi.clear();
+	for (size_t i = 0; i < autok.size(); i++)
+		if (autok[i].getTulajdonos() != nullptr)
+			tulajdonosAutoi[autok[i].getTulajdonos()->getNev()].push_back(i);
+	ugyfelIndexekFriss = true;
+}
+
+/// Egy auto torlese utan a tulajdonosindex atszamozasa.
+/// A listak rendezettek, ezert listankent csak a torolt auto utani indexek csokkennek.
+/// @param torolt - A torolt auto korabbi indexe
+/// @param tulajdonos - A torolt auto tulajdonosanak neve (ures, ha nem volt tulajdonosa)
+void SzervizNyilvantartoRendszer::tulajdonosAutoiAtszamozasa(size_t torolt, const std::string& tulajdonos) {
+	if (!tulajdonos.empty()) {
+		std::vector<size_t>& sajat = tulajdonosAutoi[tulajdonos];
+		std::vector<size_t>::iterator it = std::lower_bound(sajat.begin(), sajat.end(), torolt);
+		if (it != sajat.end() && *it == torolt)
+			sajat.erase(it);
+		if (sajat.empty())
+			tulajdonosAutoi.erase(tulajdonos);
+	}
+	for (auto& t : tulajdonosAutoi)
+		for (std::vector<size_t>::iterator it = std::upper_bound(t.second.begin(), t.second.end(), torolt); it != t.second.end(); ++it)
+			--*it;
+}
+
+/// Ugyfel hozzafuzese az ugyfelek tombjehez; ha a tomb athelyezodik, az autok tulajdonos-mutatoit atallitja.
+/// @param u - Az uj ugyfel
+/// @return - A tombben levo ugyfel referenciaja
+Ugyfel& SzervizNyilvantartoRendszer::ugyfelHozzafuz(const Ugyfel& u) {
+	const Ugyfel* regiAlap = ugyfelek.begin();
+	size_t regiMeret = ugyfelek.size();
+	ugyfelek.push_back(u);
+	if (ugyfelek.begin() != regiAlap)
+		tulajdonosokAtkotese(regiAlap, regiMeret, regiMeret);
+	if (ugyfelIndexekFriss)
+		ugyfelIndexek.emplace(u.getNev(), regiMeret);
+	return ugyfelek.back();
+}
+
+/// Az autok tulajdonos-mutatoinak atallitasa, miutan az ugyfelek tombje athelyezodott vagy elemet torolt.
+/// A mutatokat csak cimkent hasonlitjuk ossze (a regi tombot mar nem olvassuk).
+/// @param regiAlap - Az ugyfelek tombjenek korabbi kezdocime
+/// @param regiMeret - Az ugyfelek korabbi szama
+/// @param torolt - A torolt ugyfel indexe (regiMeret, ha nem tortent torles)
+void SzervizNyilvantartoRendszer::tulajdonosokAtkotese(const Ugyfel* regiAlap, size_t regiMeret, size_t torolt) {
+	const uintptr_t alap = reinterpret_cast<uintptr_t>(regiAlap);
+	const uintptr_t veg = alap + regiMeret * sizeof(Ugyfel);
+	for (size_t i = 0; i < autok.size(); i++) {
+		const uintptr_t p = reinterpret_cast<uintptr_t>(autok[i].getTulajdonos());
+		if (p < alap || p >= veg) continue;
+		size_t idx = (p - alap) / sizeof(Ugyfel);
+		if (idx == torolt) autok[i].setTulajdonos(nullptr);
+		else autok[i].setTulajdonos(&ugyfelek[idx > torolt ? idx - 1 : idx]);
+	}
+}
+
+
+
 /*-------------------------------------------
 				Getter
 -------------------------------------------*/
 /// Visszaadja az osszes auto objektumot.
 /// @return - Egy Vector<Auto> peldany, amely az osszes jelenleg nyilvantartott autot tartalmazza.
 Vector<Auto>& SzervizNyilvantartoRendszer::getAutok() {
+	szarmaztatottAdatokElavultak(); // a hivo modosithatja az autokat
 	return autok;
 }
 
@@ -67,6 +184,7 @@ const Vector<Auto>& SzervizNyilvantartoRendszer::getAutok() const {
 /// Visszaadja az osszes ugyfel objektumot.
 /// @return - Egy Vector<Ugyfel> peldany, amely az osszes jelenleg nyilvantartott ugyfelet tartalmazza.
 Vector<Ugyfel>& SzervizNyilvantartoRendszer::getUgyfelek() {
+	ugyfelIndexekFriss = false; // a hivo atnevezheti az ugyfeleket
 	return ugyfelek;
 }
 
@@ -76,6 +194,58 @@ const Vector<Ugyfel>& SzervizNyilvantartoRendszer::getUgyfelek() const {
 	return ugyfelek;
 }
 
+/// Visszaadja a flotta szervizesemenyeit oszlopos formaban, szukseg eseten ujraepitve.
+/// @return - Az aktualis esemenytar.
+const SzervizEsemenyTar& SzervizNyilvantartoRendszer::getEsemenyTar() const {
+	if (!esemenyTarFriss) {
+		esemenyTar.ujraepit(autok);
+		esemenyTarFriss = true;
+	}
+	return esemenyTar;
+}
+
+/// Visszaadja a flotta emlekezteto motorjat, szukseg eseten ujraepitve.
+/// @return - Az aktualis emlekezteto motor.
+const EmlekeztetoMotor& SzervizNyilvantartoRendszer::getEmlekezteto() const {
+	if (!emlekeztetoFriss) {
+		emlekezteto.ujraepit(autok, szabalyok);
+		emlekeztetoFriss = true;
+	}
+	return emlekezteto;
+}
+
+/// Visszaadja egy ugyfel osszesitett adatait, szukseg eseten ujraepitve.
+/// @param n - Az ugyfel neve.
+/// @return - Az osszesito (ismeretlen ugyfelre csupa nulla).
+const UgyfelOsszesito& SzervizNyilvantartoRendszer::getUgyfelOsszesito(const std::string& n) const {
+	if (!ugyfelOsszesitokFriss) {
+		ugyfelOsszesitok.ujraepit(autok);
+		ugyfelOsszesitokFriss = true;
+	}
+	return ugyfelOsszesitok.lekerdez(n);
+}
+
+/// Az elavult szarmaztatott strukturak (esemenytar, emlekezteto, ugyfelosszesitok) azonnali ujraepitese.
+/// A friss strukturakat nem erinti, igy egymas utani hivasai olcsok.
+void SzervizNyilvantartoRendszer::szarmaztatottAdatokFrissitese() const {
+	if (!autoIndexekFriss)
+		autoIndexekUjraepitese();
+	if (!ugyfelIndexekFriss)
+		ugyfelIndexekUjraepitese();
+	getEsemenyTar();
+	getEmlekezteto();
+	if (!ugyfelOsszesitokFriss) {
+		ugyfelOsszesitok.ujraepit(autok);
+		ugyfelOsszesitokFriss = true;
+	}
+}
+
+/// Visszaadja a figyelmeztetesek szabalyait.
+/// @return - A szabalykeszlet.
+const FigyelmeztetesiSzabalyok& SzervizNyilvantartoRendszer::getFigyelmeztetesiSzabalyok() const {
+	return szabalyok;
+}
+
 
 
 /*-------------------------------------------
@@ -87,6 +257,15 @@ const Vector<Ugyfel>& SzervizNyilvantartoRendszer::getUgyfelek() const {
 bool SzervizNyilvantartoRendszer::ujAuto(const Auto& a) {
 	if (!vanAuto(a.getRendszam())) {
 		autok.push_back(a);
+		autoIndexek.emplace(a.getRendszam(), autok.size() - 1);
+		if (ugyfelIndexekFriss && a.getTulajdonos() != nullptr)
+			tulajdonosAutoi[a.getTulajdonos()->getNev()].push_back(autok.size() - 1);
+		if (esemenyTarFriss)
+			esemenyTar.autoHozzafuz(a);
+		if (emlekeztetoFriss)
+			emlekezteto.frissit(a, szabalyok);
+		if (ugyfelOsszesitokFriss)
+			ugyfelOsszesitok.autoHozzaad(a);
 		return true;
 	}
 	return false;
@@ -98,7 +277,7 @@ bool SzervizNyilvantartoRendszer::ujAuto(const Auto& a) {
 /// @return - True, ha az ugyfel sikeresen hozzaadva, false, ha mar letezik.
 bool SzervizNyilvantartoRendszer::ujUgyfel(const Ugyfel& u) {
 	if (!vanUgyfel(u.getNev())) {
-		ugyfelek.push_back(u);
+		ugyfelHozzafuz(u);
 		return true;
 	}
 	return false;
@@ -114,13 +293,59 @@ bool SzervizNyilvantartoRendszer::ujUgyfel(const Ugyfel& u) {
 /// @param a - Az auto uj adatai.
 /// @return - True, ha az auto sikeresen frissitve lett, false, ha nem talalhato.
 bool SzervizNyilvantartoRendszer::frissitAuto(const Auto& a) {
-	for (auto& autoRef : autok) {
-		if (autoRef.getRendszam() == a.getRendszam()) {
-			autoRef = a;
-			return true;
+	const size_t i = autoSorszam(a.getRendszam());
+	if (i == autok.size())
+		return false;
+	Auto& autoRef = autok[i];
+	if (ugyfelIndexekFriss && autoRef.getTulajdonos() != a.getTulajdonos()) {
+		// Tulajdonosvaltas: az auto indexe atkerul az uj tulajdonos rendezett listajaba
+		if (autoRef.getTulajdonos() != nullptr) {
+			const std::string& regiNev = autoRef.getTulajdonos()->getNev();
+			std::vector<size_t>& regi = tulajdonosAutoi[regiNev];
+			std::vector<size_t>::iterator it = std::lower_bound(regi.begin(), regi.end(), i);
+			if (it != regi.end() && *it == i)
+				regi.erase(it);
+			if (regi.empty())
+				tulajdonosAutoi.erase(regiNev);
+		}
+		if (a.getTulajdonos() != nullptr) {
+			std::vector<size_t>& uj = tulajdonosAutoi[a.getTulajdonos()->getNev()];
+			uj.insert(std::lower_bound(uj.begin(), uj.end(), i), i);
 		}
 	}
-	return false;
+	if (ugyfelOsszesitokFriss)
+		ugyfelOsszesitok.autoElvesz(autoRef);
+	autoRef = a;
+	if (ugyfelOsszesitokFriss)
+		ugyfelOsszesitok.autoHozzaad(autoRef);
+	if (esemenyTarFriss)
+		esemenyTar.autoCsere(static_cast<uint32_t>(i), autoRef);
+	if (emlekeztetoFriss)
+		emlekezteto.frissit(autoRef, szabalyok);
+	return true;
+}
+
+/// A figyelmeztetesek szabalyainak lecserelese.
+/// Az emlekezteto kulcsai a szabalyokbol szamolodnak, ezert a friss motor azonnal ujraepul.
+/// @param sz - Az uj szabalykeszlet.
+void SzervizNyilvantartoRendszer::setFigyelmeztetesiSzabalyok(const FigyelmeztetesiSzabalyok& sz) {
+	szabalyok = sz;
+	if (emlekeztetoFriss)
+		emlekezteto.ujraepit(autok, szabalyok);
+}
+
+/// Egy auto kilometerora allasanak frissitese (csak novelni lehet, lasd Auto::setKmOra).
+/// @param r - Az auto rendszama.
+/// @param k - Az uj km ora allas.
+/// @return - True, ha az auto megtalalhato, false egyebkent.
+bool SzervizNyilvantartoRendszer::frissitKmOra(const std::string& r, int k) {
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		return false;
+	autok[i].setKmOra(k);
+	if (emlekeztetoFriss)
+		emlekezteto.frissit(autok[i], szabalyok);
+	return true;
 }
 
 /// Egy ugyfel adatainak frissitese a rendszeren belul.
@@ -128,13 +353,11 @@ bool SzervizNyilvantartoRendszer::frissitAuto(const Auto& a) {
 /// @param u - Az ugyfel uj adatai.
 /// @return - True, ha az ugyfel sikeresen frissitve lett, false, ha nem talalhato.
 bool SzervizNyilvantartoRendszer::frissitUgyfel(const Ugyfel& u) {
-	for (auto& ugyfelRef : ugyfelek) {
-		if (ugyfelRef.getNev() == u.getNev()) {
-			ugyfelRef = u;
-			return true;
-		}
-	}
-	return false;
+	const size_t i = ugyfelSorszam(u.getNev());
+	if (i == ugyfelek.size())
+		return false;
+	ugyfelek[i] = u;
+	return true;
 }
 
 
@@ -146,44 +369,82 @@ bool SzervizNyilvantartoRendszer::frissitUgyfel(const Ugyfel& u) {
 /// @param r - A torlendo auto rendszama.
 /// @return - True, ha az auto torolve lett, false, ha nem talalhato.
 bool SzervizNyilvantartoRendszer::torolAuto(const std::string& r) {
-	for (auto it = autok.begin(); it != autok.end(); it++) {
-		if (it->getRendszam() == r) {
-			autok.erase(it);
-			return true;
-		}
-	}
-	return false;
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		return false;
+	if (ugyfelOsszesitokFriss)
+		ugyfelOsszesitok.autoElvesz(autok[i]);
+	if (esemenyTarFriss)
+		esemenyTar.autoTorol(static_cast<uint32_t>(i));
+	if (ugyfelIndexekFriss)
+		tulajdonosAutoiAtszamozasa(i, autok[i].getTulajdonos() == nullptr ? std::string() : autok[i].getTulajdonos()->getNev());
+	autok.erase(autok.begin() + i);
+	autoIndexek.erase(r);
+	autoIndexekAtszamozasa(std::vector<size_t>(1, i));
+	if (emlekeztetoFriss)
+		emlekezteto.torol(r);
+	return true;
 }
 
 /// Egy ugyfel torlese nev alapjan.
 /// @param n - A torlendo ugyfel neve.
 /// @return - True, ha az ugyfel torolve lett, false, ha nem talalhato.
 bool SzervizNyilvantartoRendszer::torolUgyfel(const std::string& n) {
-	bool torolve = false;
-
-	// Toroljuk az ugyfelhez tartozo autokat
-	for (auto jt = autok.begin(); jt != autok.end(); ) {
-		if (jt->getTulajdonos()->getNev() == n) {
-			jt = autok.erase(jt);
-			torolve = true;
-		}
-		else {
-			++jt;
-		}
+	const size_t torolt = ugyfelSorszam(n); // a nevindex es a tulajdonosindex ezutan friss
+	if (torolt == ugyfelek.size())
+		return false;
+
+	// Az ugyfel autoi a tulajdonosindexbol (novekvo sorrendben), kereses nelkul
+	std::vector<size_t> autoi;
+	std::unordered_map<std::string, std::vector<size_t> >::iterator ta = tulajdonosAutoi.find(n);
+	if (ta != tulajdonosAutoi.end()) {
+		autoi.swap(ta->second);
+		tulajdonosAutoi.erase(ta);
 	}
 
-	// Toroljuk az ugyfelet
-	for (auto it = ugyfelek.begin(); it != ugyfelek.end(); ) {
-		if (it->getNev() == n) {
-			it = ugyfelek.erase(it);
-			torolve = true;
+	if (!autoi.empty()) {
+		if (!autoIndexekFriss)
+			autoIndexekUjraepitese();
+		for (size_t k = autoi.size(); k > 0; k--) {
+			const Auto& a = autok[autoi[k - 1]];
+			if (emlekeztetoFriss)
+				emlekezteto.torol(a.getRendszam());
+			if (esemenyTarFriss)
+				esemenyTar.autoTorol(static_cast<uint32_t>(autoi[k - 1])); // hatulrol, hogy a tobbi index ne csusszon el
+			autoIndexek.erase(a.getRendszam());
 		}
-		else {
-			it++;
+
+		// Az autok tombje egyetlen menetben tomorul (nem autonkent csuszik)
+		size_t cel = autoi[0];
+		for (size_t i = autoi[0], k = 0; i < autok.size(); i++) {
+			if (k < autoi.size() && autoi[k] == i)
+				k++;
+			else
+				autok[cel++] = autok[i];
 		}
+		while (autok.size() > cel)
+			autok.pop_back();
+		autoIndexekAtszamozasa(autoi);
+
+		// A tobbi tulajdonos autoinak indexe annyival csokken, ahany torolt auto elottuk allt
+		for (auto& t : tulajdonosAutoi)
+			for (size_t& k : t.second)
+				k -= static_cast<size_t>(std::lower_bound(autoi.begin(), autoi.end(), k) - autoi.begin());
 	}
 
-	return torolve;
+	// Toroljuk az ugyfelet (a mogotte levo ugyfelek eggyel elore csusznak, az autoik mutatoival egyutt)
+	const size_t regiMeret = ugyfelek.size();
+	ugyfelek.erase(ugyfelek.begin() + torolt);
+	tulajdonosokAtkotese(ugyfelek.begin(), regiMeret, torolt);
+	ugyfelIndexek.erase(n);
+	for (auto& u : ugyfelIndexek)
+		if (u.second > torolt)
+			u.second--;
+
+	if (ugyfelOsszesitokFriss)
+		ugyfelOsszesitok.ugyfelTorol(n);
+
+	return true;
 }
 
 /// Egy adott rendszamu autohoz tartozo szervizmuvelet torlese a megadott datum alapjan.
@@ -191,19 +452,41 @@ bool SzervizNyilvantartoRendszer::torolUgyfel(const std::string& n) {
 /// @param d - A torlendo muvelet datuma.
 /// @return - True, ha a muvelet sikeresen torolve lett, false, ha az auto vagy a megadott datumu muvelet nem talalhato.
 bool SzervizNyilvantartoRendszer::torolMuvelet(const std::string& r, const Datum& d) {
-	for (auto& autoObj : autok) {
-		if (autoObj.getRendszam() == r) {
-			auto& muveletek = autoObj.getSzervizMuveletek();
-			for (size_t i = 0; i < muveletek.size(); ++i) {
-				if (muveletek[i]->getDatum() == d) {
-					autoObj.torolVegzettSzerviz(i);
-					return true;
-				}
-			}
-			return false; // Az auto letezik, de nincs ilyen datumu muvelet
+	const size_t k = autoSorszam(r);
+	if (k == autok.size())
+		return false; // Nincs ilyen rendszamu auto
+	Auto& autoObj = autok[k];
+	const SzervizRekordLista& muveletek = autoObj.getSzervizRekordok();
+	for (size_t i = 0; i < muveletek.size(); ++i) {
+		if (muveletek[i].idopont == d) {
+			if (ugyfelOsszesitokFriss && autoObj.getTulajdonos())
+				ugyfelOsszesitok.rekordElvesz(autoObj.getTulajdonos()->getNev(), muveletek[i]);
+			autoObj.torolVegzettSzerviz(i);
+			if (esemenyTarFriss)
+				esemenyTar.rekordTorol(static_cast<uint32_t>(k), i);
+			if (emlekeztetoFriss)
+				emlekezteto.frissit(autoObj, szabalyok);
+			return true;
 		}
 	}
-	return false; // Nincs ilyen rendszamu auto
+	return false; // Az auto letezik, de nincs ilyen datumu muvelet
+}
+
+/// Az adatbazis teljes uritese: torli az osszes autot es ugyfelet, es kiuriti a szarmaztatott strukturakat.
+void SzervizNyilvantartoRendszer::torolMindent() {
+	autok.clear();
+	ugyfelek.clear();
+	autoIndexek.clear();
+	autoIndexekFriss = true;
+	ugyfelIndexek.clear();
+	tulajdonosAutoi.clear();
+	ugyfelIndexekFriss = true;
+	esemenyTar.torol();
+	esemenyTarFriss = true;
+	emlekezteto.torol();
+	emlekeztetoFriss = true;
+	ugyfelOsszesitok.torol();
+	ugyfelOsszesitokFriss = true;
 }
 
 
@@ -216,12 +499,22 @@ bool SzervizNyilvantartoRendszer::torolMuvelet(const std::string& r, const Datum
 /// @return - Az auto referenciaja, ha megtalalta.
 /// @throw - Hibat dob ha nem talalt meg a kerest rendszamu autot
 Auto& SzervizNyilvantartoRendszer::keresAuto(const std::string& r) {
-	for (auto it = autok.begin(); it != autok.end(); it++) {
-		if (it->getRendszam() == r) {
-			return *it;
-		}
-	}
-	throw std::runtime_error("Nincs ilyen rendszamu auto!");
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		throw std::runtime_error("Nincs ilyen rendszamu auto!");
+	szarmaztatottAdatokElavultak(); // a hivo modosithatja az autot
+	return autok[i];
+}
+
+/// Auto keresese rendszam alapjan (const valtozat).
+/// @param r - A keresett auto rendszama (teljes egyezes).
+/// @return - Az auto konstans referenciaja, ha megtalalta.
+/// @throw - Hibat dob ha nem talalt meg a kerest rendszamu autot
+const Auto& SzervizNyilvantartoRendszer::keresAuto(const std::string& r) const {
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		throw std::runtime_error("Nincs ilyen rendszamu auto!");
+	return autok[i];
 }
 
 /// ugyfel keresese nev alapjan.
@@ -229,32 +522,55 @@ Auto& SzervizNyilvantartoRendszer::keresAuto(const std::string& r) {
 /// @return - Az ugyfel referenciaja, ha megtalalta.
 /// @throw - Hibat dob ha nem talalt meg a kerest nevu embert
 Ugyfel& SzervizNyilvantartoRendszer::keresUgyfel(const std::string& n) {
-	for (auto it = ugyfelek.begin(); it != ugyfelek.end(); it++) {
-		if (it->getNev() == n) {
-			return *it;
-		}
-	}
-	throw std::runtime_error("Nincs ilyen nevu ugyfel!");
+	const size_t i = ugyfelSorszam(n);
+	if (i == ugyfelek.size())
+		throw std::runtime_error("Nincs ilyen nevu ugyfel!");
+	return ugyfelek[i];
 }
 
 /// Auto letezesenek ellenorzese nev alapjan.
 /// @param r - A keresett auto rendszama (teljes egyezes).
 /// @return - True, ha az auto megtalalhato a rendszerben, false egyebkent.
 bool SzervizNyilvantartoRendszer::vanAuto(const std::string& r) const {
-	for (const auto& a : autok)
-		if (a.getRendszam() == r)
-			return true;
-	return false;
+	return autoSorszam(r) < autok.size();
+}
+
+/// Az auto indexe az autok tombjeben, a rendszamindexbol.
+/// @param r - A keresett auto rendszama (teljes egyezes).
+/// @return - Az index, vagy az autok szama, ha nem talalhato.
+size_t SzervizNyilvantartoRendszer::autoSorszam(const std::string& r) const {
+	if (!autoIndexekFriss)
+		autoIndexekUjraepitese();
+	std::unordered_map<std::string, size_t>::const_iterator it = autoIndexek.find(r);
+	return it == autoIndexek.end() ? autok.size() : it->second;
 }
 
 /// ugyfel letezesenek ellenorzese nev alapjan.
 /// @param n - A keresett ugyfel neve (teljes egyezes).
 /// @return - True, ha az ugyfel megtalalhato a rendszerben, false egyebkent.
 bool SzervizNyilvantartoRendszer::vanUgyfel(const std::string& n) const {
-	for (const auto& u : ugyfelek)
-		if (u.getNev() == n)
-			return true;
-	return false;
+	return ugyfelSorszam(n) < ugyfelek.size();
+}
+
+/// Az ugyfel indexe az ugyfelek tombjeben, a nevindexbol.
+/// @param n - A keresett ugyfel neve (teljes egyezes).
+/// @return - Az index, vagy az ugyfelek szama, ha nem talalhato.
+size_t SzervizNyilvantartoRendszer::ugyfelSorszam(const std::string& n) const {
+	if (!ugyfelIndexekFriss)
+		ugyfelIndexekUjraepitese();
+	std::unordered_map<std::string, size_t>::const_iterator it = ugyfelIndexek.find(n);
+	return it == ugyfelIndexek.end() ? ugyfelek.size() : it->second;
+}
+
+/// Az ugyfel autoinak indexei az autok tombjeben, a tulajdonosindexbol.
+/// @param n - A tulajdonos neve (teljes egyezes).
+/// @return - Az indexek novekvo sorrendben (ismeretlen vagy auto nelkuli ugyfelre ures).
+const std::vector<size_t>& SzervizNyilvantartoRendszer::tulajdonosAutoSorszamai(const std::string& n) const {
+	static const std::vector<size_t> ures;
+	if (!ugyfelIndexekFriss)
+		ugyfelIndexekUjraepitese();
+	std::unordered_map<std::string, std::vector<size_t> >::const_iterator it = tulajdonosAutoi.find(n);
+	return it == tulajdonosAutoi.end() ? ures : it->second;
 }
 
 
@@ -267,65 +583,224 @@ bool SzervizNyilvantartoRendszer::vanUgyfel(const std::string& n) const {
 /// @param m - A vegzett szervizmuvelet.
 /// @return - True, ha a muvelet sikeresen rogzitve lett, false, ha az auto nem talalhato.
 bool SzervizNyilvantartoRendszer::rogzitesVegzettMuvelet(const std::string& r, const VegzettMuvelet& m) {
-	for (auto& autoObj : autok) {
-		if (autoObj.getRendszam() == r) {
-			VegzettMuvelet* ujMuvelet = m.clone();
-			autoObj.addVegzettSzerviz(ujMuvelet);
-			return true;
-		}
-	}
-	return false;
+	return rogzitesVegzettMuvelet(r, m.toRekord());
+}
+
+/// Egy vegzett szervizmuvelet rogzitese adott autohoz, rekord formaban.
+/// @param r - Az auto rendszama.
+/// @param m - A vegzett szervizmuvelet rekordja.
+/// @return - True, ha a muvelet sikeresen rogzitve lett, false, ha az auto nem talalhato.
+bool SzervizNyilvantartoRendszer::rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m) {
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		return false;
+	autok[i].addVegzettSzerviz(m);
+	if (esemenyTarFriss)
+		esemenyTar.hozzafuz(static_cast<uint32_t>(i), m);
+	if (emlekeztetoFriss)
+		emlekezteto.frissit(autok[i], szabalyok);
+	if (ugyfelOsszesitokFriss && autok[i].getTulajdonos())
+		ugyfelOsszesitok.rekordHozzaad(autok[i].getTulajdonos()->getNev(), m);
+	return true;
 }
 
 /// Lekerdezi az adott autohoz tartozo szervizmuveleteket.u
 /// @param os - A kimeneti adatfolyam.
 /// @param r - Az auto rendszama.
 void SzervizNyilvantartoRendszer::lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const {
-	for (const auto& autoObj : autok) {
-		if (autoObj.getRendszam() == r) {
-			const auto& muveletek = autoObj.getSzervizMuveletek();
-			for (const auto& muvelet : muveletek) {
-				muvelet->kiir(os);
-			}
-			return;
-		}
-	}
+	const size_t i = autoSorszam(r);
+	if (i == autok.size())
+		return;
+	for (const auto& muvelet : autok[i].getSzervizRekordok())
+		muvelet.kiir(os);
 }
 
-/// Figyelmezteteseket general az auto allapota alapjan.
+/// Az autok egy lapjanak kiirasa (offset/limit kurzor).
 /// @param os - A kimeneti adatfolyam.
-/// @param a - Az auto peldany.
-void SzervizNyilvantartoRendszer::figyelmeztetesek(std::ostream& os, const Auto& a) const {
-	int hanyDBHiba = 0; // Hiba szamlalo
-	for (const auto& autoObj : autok) {
-		if (autoObj == a) {
-			const auto& muveletek = autoObj.getSzervizMuveletek();
-			if (muveletek.empty()) {
-				os << "\tA " << a.getRendszam() << " rendszamu autohoz nincsenek rogzitett szervizmuveletek!" << std::endl;
-				return;
-			}
+/// @param tol - Az elso kiirando auto indexe.
+/// @param db - Legfeljebb ennyi auto kerul kiirasra.
+/// @return - A kovetkezo lap kurzora; az autok szama, ha nincs tobb auto.
+size_t SzervizNyilvantartoRendszer::listazAutok(std::ostream& os, size_t tol, size_t db) const {
+	const size_t ig = tol >= autok.size() || db >= autok.size() - tol ? autok.size() : tol + db;
+	for (size_t i = tol; i < ig; i++)
+		autok[i].kiir(os);
+	return ig;
+}
+
+/// Az ugyfelek egy lapjanak kiirasa (offset/limit kurzor).
+/// @param os - A kimeneti adatfolyam.
+/// @param tol - Az elso kiirando ugyfel indexe.
+/// @param db - Legfeljebb ennyi ugyfel kerul kiirasra.
+/// @return - A kovetkezo lap kurzora; az ugyfelek szama, ha nincs tobb ugyfel.
+size_t SzervizNyilvantartoRendszer::listazUgyfelek(std::ostream& os, size_t tol, size_t db) const {
+	const size_t ig = tol >= ugyfelek.size() || db >= ugyfelek.size() - tol ? ugyfelek.size() : tol + db;
+	for (size_t i = tol; i < ig; i++)
+		ugyfelek[i].kiir(os);
+	return ig;
+}
 
-			// Az utolso szervizmuvelet:
-			VegzettMuvelet* utolso = muveletek.back();
+/// Figyelmezteteseket general az auto allapota alapjan, a rendszer szabalyai szerint.
+/// Az alapertelmezett szabalyok: az utolso szerviz ota eltelt tobb mint 2 ev, illetve tobb mint 10000 km.
+/// @param os - A kimeneti adatfolyam.
+/// @param a - Az auto peldany.
+/// @param ma - A referencia datum, amelyhez az eltelt idot merjuk.
+void SzervizNyilvantartoRendszer::figyelmeztetesek(std::ostream& os, const Auto& a, const Datum& ma) const {
+	const SzervizRekordLista& muveletek = a.getSzervizRekordok();
+	if (muveletek.empty()) {
+		os << "\tA " << a.getRendszam() << " rendszamu autohoz nincsenek rogzitett szervizmuveletek!" << std::endl;
+		return;
+	}
 
-			// Datum alapu figyelmeztetes
-			if (utolso->getDatum().elteltNap(Datum(2025, 4, 14)) > (365 * 2)) { // Tobb mint 2 eve
-				os << "\tA " << a.getRendszam() << " rendszamu auto muszaki vizsgaja lejart! (Utolso vizsga: " << utolso->getDatum() << ")" << std::endl;
-				hanyDBHiba++;
-			}
+	Vector<FigyelmeztetesiSzabalyok::Talalat> talalatok;
+	szabalyok.kiertekel(a, ma, talalatok);
+	for (size_t i = 0; i < talalatok.size(); i++) {
+		const FigyelmeztetesiSzabalyok::Talalat& t = talalatok[i];
+		const FigyelmeztetesiSzabaly& sz = szabalyok[t.szabaly];
+		os << "\tA " << a.getRendszam() << " rendszamu auto " << sz.uzenet << "! (Utolso " << sz.hivatkozas;
+		if (t.mertek == FigyelmeztetesMertek::Nap)
+			os << ": " << muveletek[t.rekord].idopont << ")" << std::endl;
+		else
+			os << " ota " << t.eltelt << " km telt el)" << std::endl;
+	}
 
-			// Km alapu figyelmeztetes
-			int elteltKm = autoObj.getKmOra() - utolso->getAktKmOra();
-			if (elteltKm > 10000) {
-				os << "\tA " << a.getRendszam() << " rendszamu auto szervizelesre esedekes! (Utolso szerviz ota " << elteltKm << " km telt el)" << std::endl;
-				hanyDBHiba++;
-			}
+	if (talalatok.empty()) {
+		os << "\tNincsenek figyelmeztetesek!" << std::endl;
+	}
+}
 
-			if (hanyDBHiba == 0) {
-				os << "\tNincsenek figyelmeztetesek!" << std::endl;
-			}
+/// Az osszes auto figyelmezteteseinek kiertekelese a szalkeszleten, autonkent parhuzamosan.
+/// Minden darab sajat listaba gyujt, a listak a darab vegen egyetlen zarolassal kerulnek az eredmenybe.
+/// @param ma - A referencia datum, amelyhez az eltelt idot merjuk.
+/// @param keszlet - A kiertekelest vegzo szalkeszlet.
+/// @return - A figyelmeztetesek rendszam, azon belul szabaly szerint rendezve.
+Vector<Figyelmeztetes> SzervizNyilvantartoRendszer::flottaFigyelmeztetesek(const Datum& ma, SzalKeszlet& keszlet) const {
+	Vector<Figyelmeztetes> eredmeny;
+	std::mutex eredmenyZar;
+
+	keszlet.parhuzamosFor(autok.size(), [&](size_t tol, size_t ig) {
+		Vector<Figyelmeztetes> helyi;
+		Vector<FigyelmeztetesiSzabalyok::Talalat> talalatok;
+		for (size_t i = tol; i < ig; i++) {
+			talalatok.clear();
+			szabalyok.kiertekel(autok[i], ma, talalatok);
+			for (size_t j = 0; j < talalatok.size(); j++)
+				helyi.push_back(Figyelmeztetes(autok[i].getRendszam(), talalatok[j].szabaly, talalatok[j].mertek, talalatok[j].tullepes));
 		}
+		if (helyi.empty()) return;
+
+		std::lock_guard<std::mutex> z(eredmenyZar);
+		for (size_t i = 0; i < helyi.size(); i++)
+			eredmeny.push_back(helyi[i]);
+	});
+
+	std::sort(eredmeny.begin(), eredmeny.end());
+	return eredmeny;
+}
+
+/// Bevetel osszesitese honaponkent, muvelettipusonkent (J/K/V) es markankent, egyetlen menetben.
+/// A markak nev szerinti sorszamot kapnak, az esemenytar pedig autonkent ezt a sorszamot hasznalja csoportkent.
+/// @return - Az osszesites; a markak nev szerint rendezve, a kulcs a marka neve.
+BevetelOsszesites SzervizNyilvantartoRendszer::bevetelOsszesites() const {
+	std::map<std::string, uint32_t> markaIndex;
+	for (size_t i = 0; i < autok.size(); i++)
+		markaIndex[autok[i].getMarka()] = 0;
+	uint32_t sorszam = 0;
+	for (std::map<std::string, uint32_t>::iterator it = markaIndex.begin(); it != markaIndex.end(); ++it)
+		it->second = sorszam++;
+
+	Vector<uint32_t> autoMarka;
+	autoMarka.reserve(autok.size());
+	for (size_t i = 0; i < autok.size(); i++)
+		autoMarka.push_back(markaIndex[autok[i].getMarka()]);
+
+	BevetelOsszesites ki;
+	getEsemenyTar().bevetelOsszesites(autoMarka.begin(), markaIndex.size(), ki);
+	for (std::map<std::string, uint32_t>::const_iterator it = markaIndex.begin(); it != markaIndex.end(); ++it)
+		ki.csoportok[it->second].kulcs = it->first;
+	return ki;
+}
+
+/// Proaktiv utemezes: mely autok erik el a kovetkezo km alapu szervizhatart a megadott datumig.
+/// A hatar a szabalykeszlet km kuszobeibol szamolodik; km kuszobu szabaly nelkul az auto kimarad,
+/// ahogy az eleg adattal nem rendelkezo (ket kulonbozo napon vett rekord nelkuli) autok is.
+/// @param ig - Az utolso figyelembe vett nap (bezarolag).
+/// @return - A becslesek a becsult datum, azon belul rendszam szerint rendezve.
+Vector<SzervizBecsles> SzervizNyilvantartoRendszer::becsultSzervizek(const Datum& ig) const {
+	Vector<SzervizBecsles> eredmeny;
+	const int32_t igNap = ig.getNapSorszam();
+	for (size_t i = 0; i < autok.size(); i++) {
+		SzervizBecsles b;
+		int32_t esedekesNap;
+		if (!szabalyok.esedekesseg(autok[i], esedekesNap, b.esedekesKm) || b.esedekesKm == FigyelmeztetesiSzabalyok::NINCS_KM)
+			continue;
+		if (!autok[i].becsultDatumKmOraig(b.esedekesKm, b.becsultDatum) || b.becsultDatum.getNapSorszam() > igNap)
+			continue;
+		b.rendszam = autok[i].getRendszam();
+		b.napiKm = autok[i].becsultNapiKm();
+		eredmeny.push_back(b);
 	}
+
+	std::sort(eredmeny.begin(), eredmeny.end(), [](const SzervizBecsles& a, const SzervizBecsles& b) {
+		int32_t an = a.becsultDatum.getNapSorszam(), bn = b.becsultDatum.getNapSorszam();
+		return an != bn ? an < bn : a.rendszam < b.rendszam;
+	});
+	return eredmeny;
+}
+
+/// Az adott ev k legdragabb szervizmuvelete (alapertelmezes szerint javitasa), korlatos kupaccal.
+/// A kivalasztas az esemenytar oszlopain fut; csak a k talalat rekordja masolodik ki.
+/// @param k - A keresett muveletek szama.
+/// @param ev - Az ev.
+/// @param t - A muvelet tipusa.
+/// @return - A muveletek ar szerint csokkenoen.
+Vector<RekordTalalat> SzervizNyilvantartoRendszer::legdragabbMuveletek(size_t k, int ev, MuveletTipus t) const {
+	const SzervizEsemenyTar& tar = getEsemenyTar();
+	Vector<size_t> esemenyek;
+	tar.legdragabbak(k, static_cast<char>(t), Datum(ev, 1, 1), Datum(ev + 1, 1, 1), esemenyek);
+
+	Vector<RekordTalalat> eredmeny;
+	for (size_t i = 0; i < esemenyek.size(); i++) {
+		const Auto& a = autok[tar.autoIndex(esemenyek[i])];
+		eredmeny.push_back(RekordTalalat(a.getRendszam(), a.getSzervizRekordok()[tar.autonBeluliIndex(esemenyek[i])]));
+	}
+	return eredmeny;
+}
+
+/// A k legtobb km-t futott auto. O(n log k).
+/// @param k - A keresett autok szama.
+/// @return - (rendszam, km ora) parok km szerint csokkenoen, egyenloseg eseten rendszam szerint.
+Vector<RangsorTalalat> SzervizNyilvantartoRendszer::legtobbKmAutok(size_t k) const {
+	TopK<RangsorTalalat, RangsorTalalat::Rosszabb> legjobbak(k);
+	for (size_t i = 0; i < autok.size(); i++)
+		legjobbak.ajanl(RangsorTalalat(autok[i].getRendszam(), autok[i].getKmOra()));
+	return legjobbak.eredmeny();
+}
+
+/// A k ugyfel, akiknek az autoin a legtobb sikertelen muszaki vizsga tortent.
+/// Egy menetben autonkent megszamolja a sikertelen vizsgakat az esemenytar oszlopain, majd
+/// tulajdonosonkent osszegzi, es a korlatos kupac csak az ugyfeleken fut vegig.
+/// @param k - A keresett ugyfelek szama.
+/// @return - (nev, sikertelen vizsgak szama) parok csokkenoen, egyenloseg eseten nev szerint.
+Vector<RangsorTalalat> SzervizNyilvantartoRendszer::legtobbSikertelenVizsgaUgyfelek(size_t k) const {
+	const SzervizEsemenyTar& tar = getEsemenyTar();
+	const uint32_t* hely = tar.getHelyek();
+	const uint32_t* helyAuto = tar.getHelyAutok();
+	const char* t = tar.getTipusok();
+	const char* s = tar.getSikeresek();
+	const char vizsga = static_cast<char>(MuveletTipus::Vizsga);
+
+	std::unordered_map<const Ugyfel*, long long> ugyfelenkent;
+	for (size_t i = 0; i < tar.meret(); i++) {
+		if (t[i] != vizsga || s[i] != 0) continue;
+		const Ugyfel* u = autok[helyAuto[hely[i]]].getTulajdonos();
+		if (u != nullptr)
+			ugyfelenkent[u]++;
+	}
+
+	TopK<RangsorTalalat, RangsorTalalat::Rosszabb> legjobbak(k);
+	for (std::unordered_map<const Ugyfel*, long long>::const_iterator it = ugyfelenkent.begin(); it != ugyfelenkent.end(); ++it)
+		legjobbak.ajanl(RangsorTalalat(it->first->getNev(), it->second));
+	return legjobbak.eredmeny();
 }
 
 
@@ -359,7 +834,170 @@ static std::string reverse_trim(const std::string& str) {
 	return result;
 }
 
+/// Egesz szam beolvasasa egy [p, veg) karaktertartomanybol (elojel es vezeto szokozok megengedettek).
+/// A fuggveny static kulcsszoval van ellatva, mert csak a jelenlegi forditasi egysegen (fajlban) belul hasznaljuk, igy nem szukseges kivulrol elerhetove tenni.
+/// @param p - A tartomany eleje
+/// @param veg - A tartomany vege
+/// @param ki - Ide kerul a beolvasott ertek
+/// @return - True, ha a tartomany ervenyes egesz szamot tartalmaz
+static bool egeszOlvas(const char* p, const char* veg, int& ki) {
+	while (p < veg && (*p == ' ' || *p == '\t')) p++;
+	bool negativ = p < veg && *p == '-';
+	if (p < veg && (*p == '-' || *p == '+')) p++;
+	if (p == veg) return false;
+
+	long long ertek = 0;
+	for (; p < veg && *p >= '0' && *p <= '9'; p++) {
+		ertek = ertek * 10 + (*p - '0');
+		if (ertek > 2147483648LL) return false;
+	}
+	while (p < veg && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+	if (p != veg) return false;
+	if (negativ) ertek = -ertek;
+	if (ertek > 2147483647LL) return false;
+	ki = static_cast<int>(ertek);
+	return true;
+}
+
+/// Egy szervizmuvelet ("tipus:leiras,datum,ar,kmora[,extra]") ertelmezese es hozzafuzese a listahoz.
+/// A rekord kozvetlenul a lista vegen jon letre, a leiras az egyetlen masolt szoveg.
+/// Ismeretlen tipusu muveletet figyelmen kivul hagy.
+/// @param p - A muvelet szovegenek eleje
+/// @param veg - A muvelet szovegenek vege
+/// @param lista - A cel szervizlista
+/// @throws - std::runtime_error Ha a muvelet formatuma hibas
+static void muveletOlvas(const char* p, const char* veg, SzervizRekordLista& lista) {
+	if (veg - p < 2) throw std::runtime_error("Hibas szervizmuvelet formatum! (betoltesFajlbol)");
+
+	MuveletTipus tipus;
+	switch (p[0]) {
+	case 'J': tipus = MuveletTipus::Javitas; break;
+	case 'K': tipus = MuveletTipus::Karbantartas; break;
+	case 'V': tipus = MuveletTipus::Vizsga; break;
+	default: return;
+	}
+
+	// A mezok hatarai: leiras, datum, ar, km, es vizsga eseten az extra (a sor vegeig)
+	const char* mezo[5] = { p + 2, veg, veg, veg, veg };
+	const char* mezoVeg[5] = { veg, veg, veg, veg, veg };
+	int db = 1;
+	for (const char* c = mezo[0]; c < veg && db < 5; c++) {
+		if (*c == ',') {
+			mezoVeg[db - 1] = c;
+			mezo[db++] = c + 1;
+		}
+	}
+	if (db < 4) throw std::runtime_error("Hibas szervizmuvelet formatum! (betoltesFajlbol)");
+
+	Datum datum;
+	int ar = 0, km = 0;
+	if (!Datum::parseMezo(mezo[1], mezoVeg[1] - mezo[1], datum))
+		throw std::runtime_error("Hibas datum formatum! (betoltesFajlbol)");
+	if (!egeszOlvas(mezo[2], mezoVeg[2], ar) || !egeszOlvas(mezo[3], mezoVeg[3], km))
+		throw std::runtime_error("Hibas szam formatum! (betoltesFajlbol)");
+
+	lista.push_back(SzervizRekord());
+	SzervizRekord& rekord = lista.back();
+	rekord.muvelet.assign(mezo[0], mezoVeg[0]);
+	rekord.idopont = datum;
+	rekord.ar = ar;
+	rekord.akt_kmOra = km;
+	rekord.tipus = tipus;
+	rekord.sikeres = tipus == MuveletTipus::Vizsga && db == 5
+		&& std::string(mezo[4], veg) == "sikeres";
+}
+
+/// A kozos szalkeszletet csak ennyi sor vagy auto felett erdemes bevonni; kevesebbnel a hivo szalon fut.
+static const size_t PARHUZAMOS_KUSZOB = 512;
+
+/// Egy [0, n) tartomany feldolgozasa: kis n eseten a hivo szalon (a kozos keszlet letre sem jon),
+/// kulonben a kozos szalkeszleten.
+/// @param n - A tartomany merete.
+/// @param f - A darabot feldolgozo fuggveny (tol, ig).
+static void tartomanyFeldolgozas(size_t n, const std::function<void(size_t, size_t)>& f) {
+	if (n < PARHUZAMOS_KUSZOB) f(0, n);
+	else SzalKeszlet::alapertelmezett().parhuzamosFor(n, f, PARHUZAMOS_KUSZOB / 4);
+}
+
+/// Egy ugyfelsor ertelmezett mezoi.
+struct UgyfelSor {
+	std::string nev, telefon, email;
+};
+
+/// Egy autosor ertelmezett mezoi; a tulajdonos meg csak a neve.
+struct AutoSor {
+	std::string rendszam, marka, tipus, tulajNev;
+	int kmOra;
+	Datum uzembeHelyezes;
+	SzervizTortenet szervizTortenet;
+
+	AutoSor() : kmOra(0) {}
+};
+
+/// Egy ugyfelsor ("nev-telefon-email") ertelmezese. Csak a sajat kimenetet irja, ezert parhuzamosan hivhato.
+/// @param sor - A sor.
+/// @param ki - Az ertelmezett mezok.
+static void ugyfelSorOlvas(const std::string& sor, UgyfelSor& ki) {
+	std::istringstream iss(sor);
+	std::getline(iss, ki.nev, '-');
+	std::getline(iss, ki.telefon, '-');
+	std::getline(iss, ki.email);
+
+	ki.nev = trim(ki.nev);
+	ki.telefon = trim(ki.telefon);
+}
+
+/// Egy autosor ("rendszam-marka-tipus-km-datum-muveletek-tulajdonos") ertelmezese.
+/// Csak a sajat kimenetet irja, ezert parhuzamosan hivhato.
+/// @param sor - A sor.
+/// @param ki - Az ertelmezett mezok.
+/// @throws - std::runtime_error Ha a sor formatuma hibas
+static void autoSorOlvas(const std::string& sor, AutoSor& ki) {
+	std::string markaStr, tipusStr, kmOraStr, datumStr, muveletekStr, tulajNevStr;
+	std::istringstream iss(sor);
+	std::getline(iss, ki.rendszam, '-');
+	std::getline(iss, markaStr, '-');
+	std::getline(iss, tipusStr, '-');
+	std::getline(iss, kmOraStr, '-');
+	std::getline(iss, datumStr, '-');
+
+	std::string muveletekTulajStr;
+	std::getline(iss, muveletekTulajStr);
+
+	// Az utolso '-' jel alapjan vagjuk kette: muveletekStr - tulajNev
+	size_t utolsoKotojelHelye = muveletekTulajStr.rfind('-');
+	if (utolsoKotojelHelye == std::string::npos)
+		throw std::runtime_error("Hibas sorformatum, nem talalhato tulajdonos neve! (betoltesFajlbol)");
+
+	muveletekStr = muveletekTulajStr.substr(0, utolsoKotojelHelye);
+	tulajNevStr = muveletekTulajStr.substr(utolsoKotojelHelye + 1);
+
+	// Azokat a mezoket, ahol alulvonas("_") karaktert hasznaltunk szokoz helyett, visszaalakitjuk szokozokke(" ") a megjelenes egysegesitese erdekeben.
+	ki.marka = trim(markaStr);
+	ki.tipus = trim(tipusStr);
+	muveletekStr = trim(muveletekStr);
+	ki.tulajNev = trim(tulajNevStr);
+	ki.kmOra = std::stoi(kmOraStr);
+	ki.uzembeHelyezes = Datum::parseFromString(datumStr);
+
+	if (muveletekStr != "nincs") {
+		// A muveleteket helyben, a sor puffereben ertelmezzuk (nincs muveletenkenti substr es stringstream)
+		size_t kezdet = 0;
+		while (kezdet < muveletekStr.size()) {
+			size_t veg = muveletekStr.find(';', kezdet);
+			if (veg == std::string::npos) veg = muveletekStr.size();
+			if (veg > kezdet)
+				muveletOlvas(muveletekStr.data() + kezdet, muveletekStr.data() + veg, ki.szervizTortenet.modosit());
+			kezdet = veg + 1;
+		}
+		ki.szervizTortenet.kmRegresszio(); // a regresszio most szamolodik, nem az elso (esetleg parhuzamos) olvasaskor
+	}
+}
+
 /// Rendszeradatok betoltese fajlbol.
+/// A sorok ertelmezese nagy fajlnal a kozos szalkeszleten, parhuzamosan tortenik; a rendszerbe
+/// illesztes (ugyfelek osszevonasa, tulajdonosok hozzarendelese) utana, fajlsorrendben.
+/// Hibas sor eseten a fajlbol semmi sem kerul be.
 /// @param f - A forrasfajl neve.
 void SzervizNyilvantartoRendszer::betoltesFajlbol(const std::string& f) {
 	std::ifstream fp(f);
@@ -373,183 +1011,382 @@ void SzervizNyilvantartoRendszer::betoltesFajlbol(const std::string& f) {
 	bool autoFajl = f.find("_auo.txt") != std::string::npos;
 	if (!ugyfelFajl && !autoFajl) throw std::invalid_argument("Ismeretlen fajlformatum! (betoltesFajlbol)");
 
+	std::vector<std::string> sorok;
 	std::string sor;
 	/* --- std::getline() ---
 	   - Sor beolvasasa szovegbol (akar fajlbol, akar mas streambol).
 	   - Megadott elvalaszto karakterig olvas('\n' az alapertelmezett), de lehet mast is adni
 	*/
 	while (std::getline(fp, sor)) {
-		if (sor.empty()) continue;
-
-		if (ugyfelFajl) {
-			std::istringstream iss(sor);
-			std::string nevStr, telStr, emailStr;
-
-			std::getline(iss, nevStr, '-');
-			std::getline(iss, telStr, '-');
-			std::getline(iss, emailStr);
-
-			nevStr = trim(nevStr);
-			telStr = trim(telStr);
+		if (!sor.empty()) sorok.push_back(sor);
+	}
+	fp.close();
 
-			if (vanUgyfel(nevStr)) {
+	if (ugyfelFajl) {
+		std::vector<UgyfelSor> ertelmezett(sorok.size());
+		tartomanyFeldolgozas(sorok.size(), [&](size_t tol, size_t ig) {
+			for (size_t i = tol; i < ig; i++) ugyfelSorOlvas(sorok[i], ertelmezett[i]);
+		});
+
+		for (size_t i = 0; i < ertelmezett.size(); i++) {
+			const UgyfelSor& u = ertelmezett[i];
+			if (vanUgyfel(u.nev)) {
 				// Frissitjuk az ugyfel adatait
-				Ugyfel& letezoUgyfel = keresUgyfel(nevStr);
-				letezoUgyfel.setTel(telStr);
-				letezoUgyfel.setEmail(emailStr);
+				Ugyfel& letezoUgyfel = keresUgyfel(u.nev);
+				letezoUgyfel.setTel(u.telefon);
+				letezoUgyfel.setEmail(u.email);
 			}
 			else {
 				// uj ugyfel hozzaadasa
-				ugyfelek.push_back(Ugyfel(nevStr, telStr, emailStr));
+				ugyfelHozzafuz(Ugyfel(u.nev, u.telefon, u.email));
 			}
 		}
-		else if (autoFajl) {
-			std::string rendszamStr, markaStr, tipusStr, kmOraStr, datumStr, muveletekStr, tulajNevStr;
-			std::istringstream iss(sor);
-			std::getline(iss, rendszamStr, '-');
-			std::getline(iss, markaStr, '-');
-			std::getline(iss, tipusStr, '-');
-			std::getline(iss, kmOraStr, '-');
-			std::getline(iss, datumStr, '-');
-
-			std::string muveletekTulajStr;
-			std::getline(iss, muveletekTulajStr);
-
-			// Az utolso '-' jel alapjan vagjuk kette: muveletekStr - tulajNev
-			size_t utolsoKotojelHelye = muveletekTulajStr.rfind('-');
-			if (utolsoKotojelHelye == std::string::npos)
-				throw std::runtime_error("Hibas sorformatum, nem talalhato tulajdonos neve! (betoltesFajlbol)");
-
-			muveletekStr = muveletekTulajStr.substr(0, utolsoKotojelHelye);
-			tulajNevStr = muveletekTulajStr.substr(utolsoKotojelHelye + 1);
-
-			// Azokat a mezoket, ahol alulvonas("_") karaktert hasznaltunk szokoz helyett, visszaalakitjuk szokozokke(" ") a megjelenes egysegesitese erdekeben.
-			markaStr = trim(markaStr);
-			tipusStr = trim(tipusStr);
-			muveletekStr = trim(muveletekStr);
-			tulajNevStr = trim(tulajNevStr);
-			int kmOra = std::stoi(kmOraStr);
-			Datum uzembeHelyezes = Datum::parseFromString(datumStr);
-
-			Vector<VegzettMuvelet*> szervizLista;
-			if (muveletekStr != "nincs") {
-				std::stringstream muveletTempStream(muveletekStr);
-				std::string muveletElem;
-
-				while (std::getline(muveletTempStream, muveletElem, ';')) {
-					muveletElem = trim(muveletElem);
-					if (muveletElem.empty()) continue;
-
-					char tipus = muveletElem[0];
-					std::string extraStr; // deklaraljuk itt, de erteket csak akkor adunk, ha kell
-					std::string leirasStr, datumStr, arStr, kmStr;
-
-					std::string tartalomStr = muveletElem.substr(2);
-					std::stringstream adatSS(tartalomStr);
-					std::getline(adatSS, leirasStr, ',');
-					std::getline(adatSS, datumStr, ',');
-					std::getline(adatSS, arStr, ',');
-					std::getline(adatSS, kmStr, ',');
-
-					if (tipus == 'V') {
-						std::getline(adatSS, extraStr); // csak akkor olvassuk be, ha van ilyen mezo
-					}
-
-					leirasStr = trim(leirasStr);
-					extraStr = trim(extraStr);
-					Datum datum = Datum::parseFromString(datumStr);
-					int ar = std::stoi(arStr);
-					int km = std::stoi(kmStr);
-
-					if (tipus == 'J') {
-						szervizLista.push_back(new Javitas(leirasStr, datum, ar, km));
-					}
-					else if (tipus == 'K') {
-						szervizLista.push_back(new Karbantartas(leirasStr, datum, ar, km));
-					}
-					else if (tipus == 'V') {
-						bool sikeresE = extraStr == "sikeres";
-						szervizLista.push_back(new Vizsga(leirasStr, datum, ar, km, sikeresE));
-					}
+	}
+	else if (autoFajl) {
+		std::vector<AutoSor> ertelmezett(sorok.size());
+		tartomanyFeldolgozas(sorok.size(), [&](size_t tol, size_t ig) {
+			for (size_t i = tol; i < ig; i++) autoSorOlvas(sorok[i], ertelmezett[i]);
+		});
+
+		// Sok uj auto eseten olcsobb a szarmaztatott adatokat egyszer, a kovetkezo lekereskor ujraepiteni
+		szarmaztatottAdatokElavultak();
+		for (size_t i = 0; i < ertelmezett.size(); i++) {
+			const AutoSor& a = ertelmezett[i];
+			// A tortenet az Auto-ba masolaskor es a push_back-nel is csak megosztodik, nem masolodik
+			if (vanUgyfel(a.tulajNev)) {
+				Ugyfel& tulajStr = keresUgyfel(a.tulajNev);
+				autok.push_back(Auto(a.rendszam, a.marka, a.tipus, a.kmOra, a.uzembeHelyezes, a.szervizTortenet, &tulajStr));
+			}
+			else {
+				// tulajdonos meg nincs, letrehozas + beszuras
+				Ugyfel& ujTulaj = ugyfelHozzafuz(Ugyfel(a.tulajNev, "", ""));
+				autok.push_back(Auto(a.rendszam, a.marka, a.tipus, a.kmOra, a.uzembeHelyezes, a.szervizTortenet, &ujTulaj));
+			}
+		}
+		ugyfelIndexekFriss = false; // a tulajdonosok keresese kozben ujraepult, de az uj autok meg nincsenek benne
+	}
+}
+
+/// Az adatbazis ujratoltese: torolMindent(), majd az ugyfel- es az autofajl betoltese.
+/// @param ufl - Az ugyfelfajl neve ("_ufl.txt").
+/// @param auo - Az autofajl neve ("_auo.txt").
+void SzervizNyilvantartoRendszer::ujratoltes(const std::string& ufl, const std::string& auo) {
+	torolMindent();
+	betoltesFajlbol(ufl);
+	betoltesFajlbol(auo);
+}
+
+/// Egy szerviz CSV sor ertelmezett mezoi; hibas sor eseten a hiba nem ures.
+struct SzervizCsvSor {
+	std::string rendszam;
+	SzervizRekord rekord;
+	std::string hiba;
+};
+
+/// Egy CSV sor mezokre bontasa vesszok menten. Az idezojelek koze tett mezoben vesszo is allhat,
+/// a "" egy idezojelet jelent. A mezok eleji es vegi szokozok elmaradnak.
+/// @param sor - A sor.
+/// @param mezok - A mezok (a korabbi tartalom torlodik).
+/// @return - false, ha egy idezojel nincs lezarva
+static bool csvFelosztas(const std::string& sor, std::vector<std::string>& mezok) {
+	mezok.clear();
+	size_t i = 0;
+	for (;;) {
+		while (i < sor.size() && sor[i] == ' ') i++;
+		std::string mezo;
+		if (i < sor.size() && sor[i] == '"') {
+			for (i++; ; i++) {
+				if (i == sor.size()) return false;
+				if (sor[i] == '"') {
+					if (i + 1 < sor.size() && sor[i + 1] == '"') i++;
+					else break;
 				}
+				mezo += sor[i];
 			}
+			i++;
+			while (i < sor.size() && sor[i] != ',') i++;
+		}
+		else {
+			const size_t kezdet = i;
+			while (i < sor.size() && sor[i] != ',') i++;
+			size_t veg = i;
+			while (veg > kezdet && sor[veg - 1] == ' ') veg--;
+			mezo.assign(sor, kezdet, veg - kezdet);
+		}
+		mezok.push_back(mezo);
+		if (i == sor.size()) return true;
+		i++;
+	}
+}
 
-			if (vanUgyfel(tulajNevStr)) {
-				Ugyfel& tulajStr = keresUgyfel(tulajNevStr);
-				autok.push_back(Auto(rendszamStr, markaStr, tipusStr, kmOra, uzembeHelyezes, szervizLista, &tulajStr));
+/// Egy szerviz CSV sor ("rendszam,tipus,datum,leiras,ar,km[,sikeres]") ertelmezese es ellenorzese.
+/// Csak a sajat kimenetet irja, ezert parhuzamosan hivhato.
+/// @param sor - A sor.
+/// @param ki - Az ertelmezett mezok, vagy a hiba oka.
+static void szervizCsvSorOlvas(const std::string& sor, SzervizCsvSor& ki) {
+	std::vector<std::string> mezok;
+	if (!csvFelosztas(sor, mezok)) {
+		ki.hiba = "Lezaratlan idezojel";
+		return;
+	}
+	if (mezok.size() < 6 || mezok.size() > 7) {
+		ki.hiba = "Hibas mezoszam";
+		return;
+	}
+	ki.rendszam = mezok[0];
+	if (!SzervizNyilvantartoRendszer::helyesRendszam(ki.rendszam)) {
+		ki.hiba = "Hibas rendszam: " + mezok[0];
+		return;
+	}
+	const std::string& t = mezok[1];
+	if (t.size() != 1 || (t[0] != 'J' && t[0] != 'K' && t[0] != 'V')) {
+		ki.hiba = "Hibas muvelettipus: " + t;
+		return;
+	}
+	// A rogzitett hosszu EEEE.HH.NN alak, letezo naptari nappal (a parseMezo a 2024.02.30-at is elutasitja)
+	Datum d;
+	if (mezok[2].size() != Datum::SZOVEG_HOSSZ || !Datum::parseMezo(mezok[2].data(), mezok[2].size(), d)) {
+		ki.hiba = "Hibas datum: " + mezok[2];
+		return;
+	}
+	// A leiras a mentesi formatum mezohatarolo jeleit (lasd helyesSzoveg), a parancsnaploban a tabulatort sem tartalmazhatja
+	const std::string& leiras = mezok[3];
+	if (leiras.empty() || !SzervizNyilvantartoRendszer::helyesSzoveg(leiras) || leiras.find('\t') != std::string::npos) {
+		ki.hiba = "Hibas leiras: " + leiras;
+		return;
+	}
+	int ar = 0, km = 0;
+	if (!egeszOlvas(mezok[4].data(), mezok[4].data() + mezok[4].size(), ar) || ar < 0) {
+		ki.hiba = "Hibas ar: " + mezok[4];
+		return;
+	}
+	if (!egeszOlvas(mezok[5].data(), mezok[5].data() + mezok[5].size(), km) || km < 0) {
+		ki.hiba = "Hibas km: " + mezok[5];
+		return;
+	}
+	bool sikeres = false;
+	if (mezok.size() == 7) {
+		if (mezok[6] != "0" && mezok[6] != "1" && !mezok[6].empty()) {
+			ki.hiba = "Hibas sikeresseg: " + mezok[6];
+			return;
+		}
+		sikeres = mezok[6] == "1";
+	}
+	ki.rekord = SzervizRekord(static_cast<MuveletTipus>(t[0]), leiras, d, ar, km, sikeres);
+}
+
+/// Szervizrekordok tomeges importja CSV fajlbol.
+/// @param f - A CSV fajl neve.
+/// @return - A rogzitett rekordok szama es az elutasitott sorok.
+ImportEredmeny SzervizNyilvantartoRendszer::szervizImportCsv(const std::string& f) {
+	std::ifstream fp(f);
+	if (!fp.is_open()) throw std::runtime_error("Nem sikerult megnyitni a fajlt! (szervizImportCsv)");
+	return szervizImportCsv(fp);
+}
+
+/// Szervizrekordok tomeges importja CSV adatfolyambol.
+/// Harom menet: ertelmezes es soronkenti ellenorzes (parhuzamosan), a rendszamok feloldasa egyetlen
+/// hasitotablaval, vegul autonkent datum szerint rendezve a km ora monotonitas ellenorzese es a hozzafuzes.
+/// @param be - A bemenet.
+/// @return - A rogzitett rekordok szama es az elutasitott sorok.
+ImportEredmeny SzervizNyilvantartoRendszer::szervizImportCsv(std::istream& be) {
+	std::vector<std::string> sorok;
+	std::vector<size_t> sorszamok;
+	std::string sor;
+	for (size_t n = 1; std::getline(be, sor); n++) {
+		if (!sor.empty() && sor[sor.size() - 1] == '\r') sor.erase(sor.size() - 1);
+		if (sor.empty() || (n == 1 && sor.compare(0, 8, "rendszam") == 0)) continue;
+		sorok.push_back(sor);
+		sorszamok.push_back(n);
+	}
+
+	std::vector<SzervizCsvSor> ertelmezett(sorok.size());
+	tartomanyFeldolgozas(sorok.size(), [&](size_t tol, size_t ig) {
+		for (size_t i = tol; i < ig; i++) szervizCsvSorOlvas(sorok[i], ertelmezett[i]);
+	});
+
+	// Az ervenyes sorok autonkent, azon belul datum, azon belul fajlsorrend szerint
+	std::vector<size_t> autoSzam(ertelmezett.size(), 0);
+	std::vector<size_t> sorrend;
+	sorrend.reserve(ertelmezett.size());
+	for (size_t i = 0; i < ertelmezett.size(); i++) {
+		if (!ertelmezett[i].hiba.empty()) continue;
+		autoSzam[i] = autoSorszam(ertelmezett[i].rendszam);
+		if (autoSzam[i] == autok.size()) {
+			ertelmezett[i].hiba = "Nincs ilyen rendszamu auto: " + ertelmezett[i].rendszam;
+			continue;
+		}
+		sorrend.push_back(i);
+	}
+	std::sort(sorrend.begin(), sorrend.end(), [&](size_t x, size_t y) {
+		if (autoSzam[x] != autoSzam[y]) return autoSzam[x] < autoSzam[y];
+		const int32_t dx = ertelmezett[x].rekord.idopont.getNapSorszam();
+		const int32_t dy = ertelmezett[y].rekord.idopont.getNapSorszam();
+		if (dx != dy) return dx < dy;
+		return x < y;
+	});
+
+	ImportEredmeny eredmeny;
+	for (size_t k = 0; k < sorrend.size(); ) {
+		Auto& a = autok[autoSzam[sorrend[k]]];
+		const SzervizRekordLista& regi = a.getSzervizRekordok();
+		int32_t elozoNap = regi.empty() ? INT32_MIN : regi[regi.size() - 1].idopont.getNapSorszam();
+		int elozoKm = regi.empty() ? 0 : regi[regi.size() - 1].akt_kmOra;
+		int kmOra = a.getKmOra();
+		const size_t aktualis = autoSzam[sorrend[k]];
+		for (; k < sorrend.size() && autoSzam[sorrend[k]] == aktualis; k++) {
+			SzervizCsvSor& s = ertelmezett[sorrend[k]];
+			if (s.rekord.idopont.getNapSorszam() < elozoNap) {
+				s.hiba = "A datum korabbi, mint az auto utolso szervize";
+				continue;
 			}
-			else {
-				// tulajdonos meg nincs, letrehozas + beszuras
-				ugyfelek.push_back(Ugyfel(tulajNevStr, "", ""));
-				Ugyfel& ujTulaj = ugyfelek.back();
-				autok.push_back(Auto(rendszamStr, markaStr, tipusStr, kmOra, uzembeHelyezes, szervizLista, &ujTulaj));
+			if (s.rekord.akt_kmOra < elozoKm) {
+				s.hiba = "A km ora allasa nem csokkenhet: " + std::to_string(s.rekord.akt_kmOra) + " < " + std::to_string(elozoKm);
+				continue;
 			}
+			a.addVegzettSzerviz(s.rekord);
+			elozoNap = s.rekord.idopont.getNapSorszam();
+			elozoKm = s.rekord.akt_kmOra;
+			if (elozoKm > kmOra) kmOra = elozoKm;
+			eredmeny.rogzitett++;
 		}
+		if (kmOra != a.getKmOra()) a.setKmOra(kmOra);
 	}
-	fp.close();
+
+	// Az esemenytar, az emlekezteto es az ugyfelosszesitok a kovetkezo lekereskor egyszer epulnek ujra
+	if (eredmeny.rogzitett > 0) szarmaztatottAdatokElavultak();
+
+	for (size_t i = 0; i < ertelmezett.size(); i++)
+		if (!ertelmezett[i].hiba.empty())
+			eredmeny.hibak.push_back(ImportHiba(sorszamok[i], ertelmezett[i].hiba));
+	return eredmeny;
+}
+
+/// Ellenorzi a rendszam formatumat (harom nagybetu, majd harom szamjegy).
+/// @param r - A rendszam.
+/// @return - true, ha a formatum helyes.
+bool SzervizNyilvantartoRendszer::helyesRendszam(const std::string& r) {
+	if (r.length() != 6)
+		return false;
+	return isupper(static_cast<unsigned char>(r[0])) && isupper(static_cast<unsigned char>(r[1])) && isupper(static_cast<unsigned char>(r[2])) &&
+		isdigit(static_cast<unsigned char>(r[3])) && isdigit(static_cast<unsigned char>(r[4])) && isdigit(static_cast<unsigned char>(r[5]));
+}
+
+/// Ellenorzi, hogy a szoveg beirhato-e a mentesi formatum egy mezojebe.
+/// @param s - A szoveg.
+/// @return - true, ha nem tartalmaz mezohatarolo jelet.
+bool SzervizNyilvantartoRendszer::helyesSzoveg(const std::string& s) {
+	// '-': a sor mezoi, ';': a muveletek, ':' es ',': a muvelet mezoi; a '_' a szokozt jelenti (trim/reverse_trim)
+	return s.find_first_of("-,;:_\r\n") == std::string::npos;
+}
+
+/// A megirt ideiglenes fajl lemezre kenyszeritese, majd atnevezese a celfajlra.
+/// Az atnevezes atomi: osszeomlaskor a celfajl vagy a regi, vagy az uj tartalmat tartalmazza.
+/// @param ideiglenes - A megirt (lezart) ideiglenes fajl neve.
+/// @param cel - A celfajl neve.
+/// @throws std::runtime_error - Ha a lemezre iras vagy az atnevezes nem sikerult.
+static void tartosAtnevezes(const std::string& ideiglenes, const std::string& cel) {
+#ifdef __linux__
+	int fd = ::open(ideiglenes.c_str(), O_RDONLY);
+	bool ok = fd >= 0 && ::fsync(fd) == 0;
+	if (fd >= 0) ::close(fd);
+	if (!ok) {
+		std::remove(ideiglenes.c_str());
+		throw std::runtime_error("Nem sikerult lemezre irni a fajlt! (mentesFajlba)");
+	}
+#endif
+#ifdef _WIN32
+	std::remove(cel.c_str()); // Windowson a rename nem irja felul a letezo fajlt
+#endif
+	if (std::rename(ideiglenes.c_str(), cel.c_str()) != 0) {
+		std::remove(ideiglenes.c_str());
+		throw std::runtime_error("Nem sikerult atnevezni a fajlt! (mentesFajlba)");
+	}
+#ifdef __linux__
+	// A konyvtarbejegyzes (az atnevezes) is keruljon lemezre
+	const size_t per = cel.rfind('/');
+	const std::string konyvtar = per == std::string::npos ? "." : (per == 0 ? "/" : cel.substr(0, per));
+	int dfd = ::open(konyvtar.c_str(), O_RDONLY | O_DIRECTORY);
+	if (dfd >= 0) {
+		::fsync(dfd);
+		::close(dfd);
+	}
+#endif
 }
 
 /// Az aktualis rendszeradatok mentese fajlba.
+/// Az adatok egy ideiglenes fajlba (f + ".tmp") irodnak, ami lemezre kenyszerites utan atomi atnevezessel
+/// valtja a celfajlt; hiba eseten a celfajl korabbi tartalma megmarad.
 /// @param f - A celfajl neve.
 void SzervizNyilvantartoRendszer::mentesFajlba(const std::string& f) const {
-	std::ofstream fp(f);
-	if (!fp.is_open()) throw std::runtime_error("Nem sikerult megnyitni a fajlt! (mentesFajlba)");
-
 	bool ugyfelFajl = f.find("_ufl.txt") != std::string::npos;
 	bool autoFajl = f.find("_auo.txt") != std::string::npos;
 	if (!ugyfelFajl && !autoFajl) throw std::invalid_argument("Ismeretlen fajlformatum! (mentesFajlba)");
 
+	const std::string ideiglenes = f + ".tmp";
+	std::ofstream fp(ideiglenes);
+	if (!fp.is_open()) throw std::runtime_error("Nem sikerult megnyitni a fajlt! (mentesFajlba)");
+
 	if (ugyfelFajl) {
-		for (const auto& ugyfelObj : ugyfelek) {
-			fp << reverse_trim(ugyfelObj.getNev()) << "-"
-				<< reverse_trim(ugyfelObj.getTelefonszam()) << "-"
-				<< ugyfelObj.getEmail() << '\n';
-		}
+		for (const auto& ugyfelObj : ugyfelek)
+			mentesSor(fp, ugyfelObj);
 	}
 	else if (autoFajl) {
-		for (const auto& autoObj : autok) {
-			fp << autoObj.getRendszam() << "-"
-				<< reverse_trim(autoObj.getMarka()) << "-"
-				<< reverse_trim(autoObj.getTipus()) << "-"
-				<< autoObj.getKmOra() << "-"
-				<< autoObj.getUzembeHelyezes().toString() << "-";
-
-			const Vector<VegzettMuvelet*> muveletek = autoObj.getSzervizMuveletek();
-			if (muveletek.empty()) {
-				fp << "nincs";
-			}
-			else {
-				for (size_t i = 0; i < muveletek.size(); i++) {
-					const VegzettMuvelet* m = muveletek[i];
-					std::string tipusBetu;
-
-					if (dynamic_cast<const Javitas*>(m)) tipusBetu = "J";
-					else if (dynamic_cast<const Karbantartas*>(m)) tipusBetu = "K";
-					else if (dynamic_cast<const Vizsga*>(m)) tipusBetu = "V";
-					else throw std::runtime_error("Ismeretlen muvelet tipus a mentesFajlba fuggvenyben! (mentesFajlba)");
-
-					fp << tipusBetu << ":"
-						<< reverse_trim(m->getMuvelet()) << ","
-						<< m->getDatum().toString() << ","
-						<< m->getAr() << ","
-						<< m->getAktKmOra();
-
-					if (const auto* vizsga = dynamic_cast<const Vizsga*>(m)) {
-						fp << "," << (vizsga->getSikeres() ? "sikeres" : "sikertelen");
-					}
-
-					if (i < muveletek.size() - 1) fp << ";";
-				}
-			}
+		// Az autok sorai darabonkent, a kozos szalkeszleten keszulnek el, es darabsorrendben, egyben irodnak ki
+		const std::function<std::string(size_t, size_t)> darab = [this](size_t tol, size_t ig) {
+			std::ostringstream os;
+			for (size_t i = tol; i < ig; i++)
+				mentesSor(os, autok[i]);
+			return os.str();
+		};
+		const std::string kimenet = autok.size() < PARHUZAMOS_KUSZOB ? darab(0, autok.size())
+			: SzalKeszlet::alapertelmezett().parhuzamosRedukcio(autok.size(), std::string(), darab,
+				[](std::string eddig, const std::string& kov) { eddig += kov; return eddig; }, PARHUZAMOS_KUSZOB / 4);
+		fp.write(kimenet.data(), static_cast<std::streamsize>(kimenet.size()));
+	}
 
-			// Tulajdonos ellenorzes
-			if (autoObj.getTulajdonos() == nullptr) {
-				throw std::runtime_error("Auto tulajdonosa nullptr! Hibas adatstruktura. (mentesFajlba)");
-			}
+	fp.close();
+	if (fp.fail()) {
+		std::remove(ideiglenes.c_str());
+		throw std::runtime_error("Nem sikerult irni a fajlt! (mentesFajlba)");
+	}
+	tartosAtnevezes(ideiglenes, f);
+}
+
+/// Egy ugyfel sora a mentesi formatumban (az ugyfelfajlba).
+/// @param os - A kimeneti adatfolyam.
+/// @param u - Az ugyfel.
+void SzervizNyilvantartoRendszer::mentesSor(std::ostream& os, const Ugyfel& u) {
+	os << reverse_trim(u.getNev()) << "-"
+		<< reverse_trim(u.getTelefonszam()) << "-"
+		<< u.getEmail() << '\n';
+}
 
-			fp << "-" << reverse_trim(autoObj.getTulajdonos()->getNev()) << '\n';
+/// Egy auto sora a mentesi formatumban (az autofajlba).
+/// @param os - A kimeneti adatfolyam.
+/// @param a - Az auto (a tulajdonosa nem lehet nullptr).
+void SzervizNyilvantartoRendszer::mentesSor(std::ostream& os, const Auto& a) {
+	os << a.getRendszam() << "-"
+		<< reverse_trim(a.getMarka()) << "-"
+		<< reverse_trim(a.getTipus()) << "-"
+		<< a.getKmOra() << "-"
+		<< a.getUzembeHelyezes() << "-";
+
+	const SzervizRekordLista& muveletek = a.getSzervizRekordok();
+	if (muveletek.empty()) {
+		os << "nincs";
+	}
+	else {
+		for (size_t i = 0; i < muveletek.size(); i++) {
+			muveletek[i].mentes(os);
+			if (i < muveletek.size() - 1) os << ";";
 		}
 	}
 
-	fp.close();
+	// Tulajdonos ellenorzes
+	if (a.getTulajdonos() == nullptr) {
+		throw std::runtime_error("Auto tulajdonosa nullptr! Hibas adatstruktura. (mentesFajlba)");
+	}
+
+	os << "-" << reverse_trim(a.getTulajdonos()->getNev()) << '\n';
 }
\ No newline at end of file
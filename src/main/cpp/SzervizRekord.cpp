@@ -0,0 +1,82 @@
+/**
+*   \file SzervizRekord.cpp
+*   A SzervizRekord tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "SzervizRekord.h"
+#include "VegzettMuvelet.h"
+#include "Javitas.h"
+#include "Karbantartas.h"
+#include "Vizsga.h"
+
+/// Kiirja a rekordot ugyanabban a formaban, mint a megfelelo VegzettMuvelet leszarmazott.
+/// @param os - A kimeneti stream
+void SzervizRekord::kiir(std::ostream& os) const {
+    switch (tipus) {
+    case MuveletTipus::Javitas:
+        os << "\tJavitas: ";
+        break;
+    case MuveletTipus::Karbantartas:
+        os << "\tKarbantartas: ";
+        break;
+    case MuveletTipus::Vizsga:
+        os << "\tVizsga: ";
+        break;
+    }
+
+    os << muvelet
+        << ", Datum: " << idopont
+        << ", Ar: " << ar << " Ft";
+    if (tipus == MuveletTipus::Vizsga)
+        os << ", Sikeres: " << (sikeres ? "igen" : "nem");
+    os << ", Akt. km: " << akt_kmOra
+        << '\n';
+}
+
+/// Letrehozza a rekordnak megfelelo polimorf objektumot (kompatibilitasi felulet).
+/// @return - Uj, dinamikusan foglalt Javitas, Karbantartas vagy Vizsga peldany; a hivo szabaditja fel.
+VegzettMuvelet* SzervizRekord::toVegzettMuvelet() const {
+    switch (tipus) {
+    case MuveletTipus::Karbantartas:
+        return new Karbantartas(muvelet, idopont, ar, akt_kmOra);
+    case MuveletTipus::Vizsga:
+        return new Vizsga(muvelet, idopont, ar, akt_kmOra, sikeres);
+    case MuveletTipus::Javitas:
+    default:
+        return new Javitas(muvelet, idopont, ar, akt_kmOra);
+    }
+}
+
+/// A rekord kiirasa a mentesi fajlformatumban ("tipus:leiras,datum,ar,kmora[,extra]").
+/// @param os - A kimeneti stream
+void SzervizRekord::mentes(std::ostream& os) const {
+    alapMezokMentese(os, tipus, muvelet, idopont, ar, akt_kmOra);
+    if (tipus == MuveletTipus::Vizsga)
+        vizsgaEredmenyMentese(os, sikeres);
+}
+
+/// A minden muvelettipusnal kozos mezok kiirasa ("tipus:leiras,datum,ar,kmora").
+/// A leirasban a szokozok alahuzaskent kerulnek a fajlba.
+/// @param os - A kimeneti stream
+/// @param t - A muvelet tipusa
+/// @param m - Muvelet neve
+/// @param d - Muvelet idopontja
+/// @param a - Muvelet ara
+/// @param k - Aktualis km ora allas
+void SzervizRekord::alapMezokMentese(std::ostream& os, MuveletTipus t, const std::string& m, const Datum& d, int a, int k) {
+    os << static_cast<char>(t) << ':';
+    for (char c : m)
+        os.put(c == ' ' ? '_' : c);
+    os << ',' << d << ',' << a << ',' << k;
+}
+
+/// A vizsga eredmenyenek kiirasa extra mezokent (",sikeres" vagy ",sikertelen").
+/// @param os - A kimeneti stream
+/// @param s - A vizsga sikeressege
+void SzervizRekord::vizsgaEredmenyMentese(std::ostream& os, bool s) {
+    os << (s ? ",sikeres" : ",sikertelen");
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/**
+*   \file SzervizTortenet.cpp
+*   A SzervizTortenet tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <stdexcept>
+
+#include "SzervizTortenet.h"
+
+/*-------------------------------------------
+        Konstruktorok es destruktor
+-------------------------------------------*/
+/// Alapertelmezett konstruktor. Ures tortenet, foglalas nelkul.
+SzervizTortenet::SzervizTortenet() : blokk(nullptr) {}
+
+/// Konstruktor egy meglevo rekordlistabol (a lista egyszer masolodik).
+/// @param l - A rekordok listaja
+SzervizTortenet::SzervizTortenet(const SzervizRekordLista& l) : blokk(l.empty() ? nullptr : new Blokk(l)) {}
+
+/// Masolo konstruktor. O(1), a blokk megosztva marad.
+/// @param t - Masolando tortenet
+SzervizTortenet::SzervizTortenet(const SzervizTortenet& t) : blokk(t.blokk) {
+    if (blokk != nullptr)
+        blokk->hivatkozasok.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Destruktor.
+SzervizTortenet::~SzervizTortenet() {
+    elenged();
+}
+
+
+
+/*-------------------------------------------
+            Belso segedfuggvenyek
+-------------------------------------------*/
+/// Elengedi a blokkot; az utolso hivatkozo felszabaditja.
+void SzervizTortenet::elenged() {
+    if (blokk != nullptr && blokk->hivatkozasok.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete blokk;
+    blokk = nullptr;
+}
+
+/// Biztositja, hogy a blokk csak ehhez a leirohoz tartozzon (szukseg eseten lemasolja).
+/// @return - A sajat, modosithato blokk
+SzervizTortenet::Blokk* SzervizTortenet::sajatBlokk() {
+    if (blokk == nullptr) {
+        blokk = new Blokk();
+    }
+    else if (blokk->hivatkozasok.load(std::memory_order_acquire) > 1) {
+        Blokk* masolat = new Blokk(blokk->rekordok);
+        elenged();
+        blokk = masolat;
+    }
+    return blokk;
+}
+
+
+
+/*-------------------------------------------
+                Operatorok
+-------------------------------------------*/
+/// Ertekado operator. O(1), a blokk megosztva marad.
+/// @param t - Masolando tortenet
+/// @return - Az aktualis objektum referenciaja
+SzervizTortenet& SzervizTortenet::operator=(const SzervizTortenet& t) {
+    if (blokk != t.blokk) {
+        if (t.blokk != nullptr)
+            t.blokk->hivatkozasok.fetch_add(1, std::memory_order_relaxed);
+        elenged();
+        blokk = t.blokk;
+    }
+    return *this;
+}
+
+
+
+/*-------------------------------------------
+              Lekerdezesek
+-------------------------------------------*/
+/// A rekordok listaja (csak olvasasra).
+/// Ures tortenetnel egy kozos, ures lista referenciajat adja.
+/// @return - A rekordlista konstans referenciaja
+const SzervizRekordLista& SzervizTortenet::lista() const {
+    static const SzervizRekordLista ures;
+    return blokk == nullptr ? ures : blokk->rekordok;
+}
+
+/// A rekordok km ora allasainak regresszioja (O(1), a modosit() utani elso hivaskor O(n)).
+/// @return - A regresszio konstans referenciaja
+const KmRegresszio& SzervizTortenet::kmRegresszio() const {
+    static const KmRegresszio ures;
+    if (blokk == nullptr) return ures;
+    if (!blokk->regresszioFriss) {
+        blokk->regresszio.torol();
+        for (size_t i = 0; i < blokk->rekordok.size(); i++)
+            blokk->regresszio.hozzaad(blokk->rekordok[i].idopont.getNapSorszam(), blokk->rekordok[i].akt_kmOra);
+        blokk->regresszioFriss = true;
+    }
+    return blokk->regresszio;
+}
+
+
+
+/*-------------------------------------------
+            Modosito muveletek
+-------------------------------------------*/
+/// Rekord hozzafuzese a vegere (megosztott tortenetnel elotte lemasolja a listat).
+/// @param r - A hozzaadando rekord
+void SzervizTortenet::push_back(const SzervizRekord& r) {
+    Blokk* b = sajatBlokk();
+    b->rekordok.push_back(r);
+    if (b->regresszioFriss)
+        b->regresszio.hozzaad(r.idopont.getNapSorszam(), r.akt_kmOra);
+}
+
+/// Rekord torlese index alapjan (megosztott tortenetnel elotte lemasolja a listat).
+/// @param idx - A torlendo rekord indexe
+/// @throws - std::out_of_range Ha az index ervenytelen
+void SzervizTortenet::erase(size_t idx) {
+    if (idx >= size()) throw std::out_of_range("Ervenytelen index! (SzervizTortenet::erase)");
+    Blokk* b = sajatBlokk();
+    if (b->regresszioFriss)
+        b->regresszio.elvesz(b->rekordok[idx].idopont.getNapSorszam(), b->rekordok[idx].akt_kmOra);
+    b->rekordok.erase(b->rekordok.begin() + idx);
+}
+
+/// Modosithato hozzaferes a rekordlistahoz (megosztott tortenetnel elotte lemasolja).
+/// A regressziot elavultnak jeloli, mert a hivo tetszolegesen atirhatja a listat.
+/// @return - A sajat rekordlista referenciaja
+SzervizRekordLista& SzervizTortenet::modosit() {
+    Blokk* b = sajatBlokk();
+    b->regresszioFriss = false;
+    return b->rekordok;
+}
+
+/// Az osszes rekord torlese.
+void SzervizTortenet::clear() {
+    elenged();
+}
\ No newline at end of file
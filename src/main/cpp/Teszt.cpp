@@ -12,6 +12,23 @@
 #include "Javitas.h"
 #include "Karbantartas.h"
 #include "Vizsga.h"
+#include "SzalKeszlet.h"
+#include "TopK.hpp"
+#include "Lekerdezes.h"
+#include "SzalbiztosNyilvantarto.h"
+#include "ParancsVegrehajto.h"
+#include "Naplo.h"
+#include "Szerver.h"
+#include "ParticionaltNyilvantarto.h"
+#include "KimenetiPuffer.h"
+#include "NdjsonExport.h"
+
+#ifdef __linux__
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 /// Ellenorzi, hogy a megadott fajl letezik-e.
 /// @param f - A vizsgalt fajl neve (eleresi utvonal is lehet).
@@ -179,6 +196,1530 @@ void tesztek() {
         EXPECT_TRUE(dynamic_cast<Vizsga*>(muvek[1]) != nullptr || dynamic_cast<Karbantartas*>(muvek[1]) != nullptr);
     } END
 
+    TEST(Datum, NapSorszamEsNaptar) {
+        EXPECT_EQ(Datum(1970, 1, 1).getNapSorszam(), 0);
+        EXPECT_EQ(Datum(2024, 2, 28).elteltNap(Datum(2024, 3, 1)), 2);   // szokoev
+        EXPECT_EQ(Datum(2023, 2, 28).elteltNap(Datum(2023, 3, 1)), 1);
+        EXPECT_EQ(Datum(2000, 1, 1).elteltNap(Datum(2001, 1, 1)), 366); // 400-zal oszthato szazados ev
+        EXPECT_EQ(Datum(1900, 1, 1).elteltNap(Datum(1901, 1, 1)), 365); // nem szokoev
+        EXPECT_EQ(Datum(2025, 4, 14).elteltNap(Datum(2023, 4, 14)), -731);
+
+        Datum d(2024, 2, 29);
+        EXPECT_EQ(d.getEv(), 2024);
+        EXPECT_EQ(d.getHo(), 2);
+        EXPECT_EQ(d.getNap(), 29);
+        EXPECT_TRUE(Datum::fromNapSorszam(d.getNapSorszam()) == d);
+        EXPECT_EQ(Datum::parseFromString(d.toString()).getNapSorszam(), d.getNapSorszam());
+
+        EXPECT_TRUE(Datum(2024, 12, 31) < Datum(2025, 1, 1));
+        EXPECT_TRUE(Datum(2025, 1, 1) >= Datum(2025, 1, 1));
+        EXPECT_TRUE(Datum(2025, 1, 2) != Datum(2025, 1, 1));
+        EXPECT_EQ(fromSizetToUnsigned(sizeof(Datum)), 4u);
+
+        // Nem letezo naptari nap nem fordul at egy masik datumra
+        EXPECT_TRUE(Datum::ervenyes(2024, 2, 29));
+        EXPECT_TRUE(Datum::ervenyes(2000, 2, 29));
+        EXPECT_FALSE(Datum::ervenyes(1900, 2, 29));
+        EXPECT_FALSE(Datum::ervenyes(2023, 4, 31));
+        EXPECT_FALSE(Datum::ervenyes(2024, 13, 1));
+        EXPECT_FALSE(Datum::ervenyes(2024, 1, 0));
+        EXPECT_THROW(Datum(2023, 2, 29), const std::invalid_argument&);
+        EXPECT_THROW(d.setDatum(2024, 0, 10), const std::invalid_argument&);
+        EXPECT_TRUE(d == Datum(2024, 2, 29));
+    } END
+
+    TEST(Datum, GyorsErtelmezesEsFormazas) {
+        Datum d;
+        EXPECT_TRUE(Datum::parseBuffer("2025.02.15,40000", 16, d) != 0);
+        EXPECT_TRUE(d == Datum(2025, 2, 15));
+        EXPECT_TRUE(Datum::parseBuffer("2025.4.1", 8, d) != 0);
+        EXPECT_TRUE(d == Datum(2025, 4, 1));
+        EXPECT_FALSE(Datum::parseBuffer("2025-04-01", 10, d) != 0);
+        EXPECT_FALSE(Datum::parseBuffer("2025.04", 7, d) != 0);
+        EXPECT_FALSE(Datum::parseBuffer("2024.02.30", 10, d) != 0);
+        EXPECT_FALSE(Datum::parseBuffer("2024.13.45", 10, d) != 0);
+        EXPECT_FALSE(Datum::parseBuffer("2023.2.29", 9, d) != 0);
+        EXPECT_TRUE(d == Datum(2025, 4, 1));
+        EXPECT_THROW(Datum::parseFromString("hibas"), const std::runtime_error&);
+
+        char buf[Datum::MAX_SZOVEG_HOSSZ];
+        EXPECT_EQ(fromSizetToUnsigned(Datum(987, 3, 9).formatToBuffer(buf)), 10u);
+        EXPECT_EQ(std::string(buf, Datum::SZOVEG_HOSSZ), "0987.03.09");
+        std::ostringstream oss;
+        oss << Datum(2024, 12, 31);
+        EXPECT_EQ(oss.str(), "2024.12.31");
+
+        // Elotag: az ertelmezett hossz; teljes mezo: a datum utan csak szokoz allhat
+        EXPECT_EQ(fromSizetToUnsigned(Datum::parseBuffer(" 2021.1.1x", 10, d)), 9u);
+        EXPECT_FALSE(Datum::parseMezo("2021.1.1x", 9, d));
+        EXPECT_FALSE(Datum::parseMezo("2021.02.3a", 10, d));
+        EXPECT_FALSE(Datum::parseMezo("2021.02.03.5", 12, d));
+        EXPECT_TRUE(d == Datum(2021, 1, 1));
+        EXPECT_TRUE(Datum::parseMezo(" 2022.01.05 ", 12, d));
+        EXPECT_TRUE(d == Datum(2022, 1, 5));
+        EXPECT_THROW(Datum::parseFromString("2021.02.3a"), const std::runtime_error&);
+    } END
+
+    TEST(SzervizRekord, ErtekSzerintiTortenet) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Olah Rita", "+36 30 222 1111", "olah.rita@gmail.com"));
+        aDB.ujAuto(Auto("REK001", "Skoda", "Octavia", 90000, Datum(2019, 4, 4), SzervizRekordLista(), &aDB.keresUgyfel("Olah Rita")));
+
+        EXPECT_TRUE(aDB.rogzitesVegzettMuvelet("REK001", Vizsga("Muszaki vizsga", Datum(2025, 1, 10), 30000, 91000, false)));
+        EXPECT_TRUE(aDB.rogzitesVegzettMuvelet("REK001", SzervizRekord(MuveletTipus::Javitas, "Kuplung", Datum(2025, 2, 1), 120000, 92000)));
+
+        const SzervizRekordLista& rekordok = aDB.keresAuto("REK001").getSzervizRekordok();
+        EXPECT_EQ(fromSizetToUnsigned(rekordok.size()), 2u);
+        EXPECT_TRUE(rekordok[0].tipus == MuveletTipus::Vizsga);
+        EXPECT_FALSE(rekordok[0].sikeres);
+        EXPECT_TRUE(rekordok[1].tipus == MuveletTipus::Javitas);
+
+        // A masolat fuggetlen az eredetitol
+        Auto masolat = aDB.keresAuto("REK001");
+        aDB.keresAuto("REK001").torolVegzettSzerviz(0);
+        EXPECT_EQ(fromSizetToUnsigned(masolat.getSzervizRekordok().size()), 2u);
+        EXPECT_EQ(masolat.getSzervizRekordok()[1].muvelet, "Kuplung");
+
+        // Kompatibilitasi felulet: a rekordbol a megfelelo leszarmazott jon letre
+        const Vector<VegzettMuvelet*>& muveletek = masolat.getSzervizMuveletek();
+        EXPECT_TRUE(dynamic_cast<Vizsga*>(muveletek[0]) != nullptr);
+        EXPECT_TRUE(dynamic_cast<Javitas*>(muveletek[1]) != nullptr);
+    } END
+
+    TEST(SzervizNyilvantartoRendszer, TorolMindentEsUjratoltes) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Pal Bence", "+36 20 111 2222", "pal.bence@gmail.com"));
+        aDB.ujAuto(Auto("TRL001", "Opel", "Astra", 150000, Datum(2015, 6, 1), SzervizRekordLista(), &aDB.keresUgyfel("Pal Bence")));
+        aDB.rogzitesVegzettMuvelet("TRL001", SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 3, 1), 25000, 140000));
+        EXPECT_EQ(aDB.getUgyfelOsszesito("Pal Bence").koltes, 25000LL);
+
+        aDB.torolMindent();
+        EXPECT_TRUE(aDB.szarmaztatottAdatokFrissek());
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelOsszesito("Pal Bence").autokSzama), 0u);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getAutok().size()), 0u);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelek().size()), 0u);
+
+        // Ujratoltes ures adatbazisba
+        aDB.ujratoltes("init_ugyfel_ufl.txt", "init_auto_auo.txt");
+        EXPECT_TRUE(aDB.vanAuto("ABC123"));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.keresAuto("ABC123").getSzervizRekordok().size()), 2u);
+        EXPECT_FALSE(aDB.keresAuto("ABC123").getSzervizRekordok()[0].sikeres);
+    } END
+
+    TEST(SzervizEsemenyTar, FlottaszintuOsszesitesek) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Toth Anna", "+36 30 123 4567", "toth.anna@gmail.com"));
+        Ugyfel* tulaj = &aDB.keresUgyfel("Toth Anna");
+
+        SzervizRekordLista elso;
+        elso.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2023, 5, 1), 20000, 100000));
+        elso.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 2, 1), 30000, 110000, false));
+        aDB.ujAuto(Auto("SOA001", "Toyota", "Corolla", 115000, Datum(2015, 1, 1), elso, tulaj));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getEsemenyTar().meret()), 2u);
+
+        // Uj auto es barmely autohoz rogzitett muvelet helyben bovul
+        aDB.ujAuto(Auto("SOA002", "Mazda", "3", 50000, Datum(2020, 1, 1), SzervizRekordLista(), tulaj));
+        aDB.rogzitesVegzettMuvelet("SOA002", SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2024, 6, 1), 80000, 40000));
+        aDB.rogzitesVegzettMuvelet("SOA002", SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 12, 31), 30000, 48000, true));
+
+        const SzervizEsemenyTar& tar = aDB.getEsemenyTar();
+        EXPECT_EQ(fromSizetToUnsigned(tar.meret()), 4u);
+        EXPECT_EQ(tar.koltesEvben(2023), 20000LL);
+        EXPECT_EQ(tar.koltesEvben(2024), 140000LL);
+        EXPECT_EQ(tar.koltesEvben(2025), 0LL);
+        long long evente[3];
+        tar.koltesEvente(2023, 3, evente);
+        EXPECT_EQ(evente[1], 140000LL);
+        EXPECT_EQ(fromSizetToUnsigned(tar.sikertelenVizsgakSzama()), 1u);
+        EXPECT_DOUBLE_EQ(tar.atlagKmSzervizekKozott(), 9000.0); // (10000 + 8000) / 2
+
+        // Torles is helyben: a muvelet esemenye helyere az utolso lep, az auto helye felszabadul
+        aDB.torolMuvelet("SOA001", Datum(2024, 2, 1));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getEsemenyTar().sikertelenVizsgakSzama()), 0u);
+        aDB.torolAuto("SOA001");
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getEsemenyTar().meret()), 2u);
+        EXPECT_EQ(aDB.getEsemenyTar().autoIndex(0), 0u);
+        EXPECT_DOUBLE_EQ(aDB.getEsemenyTar().atlagKmSzervizekKozott(), 8000.0);
+
+        // Vegyes modositasok utan a helyben frissitett tar egyezik a teljesen ujraepitettel
+        aDB.szarmaztatottAdatokFrissitese();
+        for (int i = 0; i < 6; i++) {
+            std::string rsz = "SOB00" + std::to_string(i);
+            aDB.ujAuto(Auto(rsz, i % 2 ? "Opel" : "Ford", "X", 1000, Datum(2018, 1, 1), SzervizRekordLista(), tulaj));
+        }
+        for (int k = 0; k < 40; k++) {
+            std::string rsz = "SOB00" + std::to_string(k * 7 % 6);
+            aDB.rogzitesVegzettMuvelet(rsz, SzervizRekord(k % 3 ? MuveletTipus::Karbantartas : MuveletTipus::Vizsga, "Teszt",
+                Datum(2020, 1, 1 + k % 28), 1000 + k, 2000 + 100 * k, k % 2 == 0));
+        }
+        aDB.torolMuvelet("SOB001", Datum(2020, 1, 2));
+        aDB.torolMuvelet("SOB003", Datum(2020, 1, 4));
+        aDB.torolAuto("SOB002");
+        aDB.torolAuto("SOA002");
+        aDB.ujAuto(Auto("SOC001", "Kia", "Ceed", 0, Datum(2021, 1, 1), SzervizRekordLista(), tulaj));
+        aDB.rogzitesVegzettMuvelet("SOB000", SzervizRekord(MuveletTipus::Javitas, "Kesz", Datum(2022, 1, 1), 5, 90000));
+        aDB.rogzitesVegzettMuvelet("SOC001", SzervizRekord(MuveletTipus::Javitas, "Kesz", Datum(2022, 1, 1), 7, 100));
+        EXPECT_TRUE(aDB.szarmaztatottAdatokFrissek());
+        const SzervizEsemenyTar& helyben = aDB.getEsemenyTar();
+        SzervizNyilvantartoRendszer masolat(aDB);
+        const SzervizEsemenyTar& ujraepitett = masolat.getEsemenyTar();
+        EXPECT_EQ(fromSizetToUnsigned(helyben.meret()), fromSizetToUnsigned(ujraepitett.meret()));
+        EXPECT_EQ(helyben.koltesEvben(2020), ujraepitett.koltesEvben(2020));
+        EXPECT_EQ(fromSizetToUnsigned(helyben.sikertelenVizsgakSzama()), fromSizetToUnsigned(ujraepitett.sikertelenVizsgakSzama()));
+        EXPECT_DOUBLE_EQ(helyben.atlagKmSzervizekKozott(), ujraepitett.atlagKmSzervizekKozott());
+        EXPECT_EQ(aDB.bevetelOsszesites().csoportok[1].osszeg, masolat.bevetelOsszesites().csoportok[1].osszeg);
+        const Vector<Auto>& autok = static_cast<const SzervizNyilvantartoRendszer&>(aDB).getAutok();
+        bool elter = false;
+        for (size_t e = 0; e < helyben.meret(); e++) {
+            const SzervizRekord& rek = autok[helyben.autoIndex(e)].getSzervizRekordok()[helyben.autonBeluliIndex(e)];
+            if (rek.ar != helyben.getArak()[e] || rek.akt_kmOra != helyben.getKmek()[e] || rek.idopont.getNapSorszam() != helyben.getDatumok()[e])
+                elter = true;
+        }
+        for (size_t i = 0; i < autok.size(); i++)
+            if (aDB.autoSorszam(autok[i].getRendszam()) != i) elter = true;
+        EXPECT_FALSE(elter);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.autoSorszam("SOB002")), fromSizetToUnsigned(autok.size()));
+    } END
+
+    TEST(VegzettMuvelet, TipusEsMentesRTTINelkul) {
+        Javitas j("Kuplung csere", Datum(2024, 3, 5), 150000, 210000);
+        Karbantartas k("Olajcsere", Datum(2024, 4, 1), 25000, 212000);
+        Vizsga v("Muszaki vizsga", Datum(2024, 5, 2), 30000, 213000, false);
+        const VegzettMuvelet* muveletek[] = { &j, &k, &v };
+
+        EXPECT_TRUE(muveletek[0]->getTipus() == MuveletTipus::Javitas);
+        EXPECT_TRUE(muveletek[1]->getTipus() == MuveletTipus::Karbantartas);
+        EXPECT_TRUE(muveletek[2]->getTipus() == MuveletTipus::Vizsga);
+
+        std::ostringstream oss;
+        muveletek[0]->mentes(oss);
+        EXPECT_EQ(oss.str(), "J:Kuplung_csere,2024.03.05,150000,210000");
+        oss.str("");
+        muveletek[2]->mentes(oss);
+        EXPECT_EQ(oss.str(), "V:Muszaki_vizsga,2024.05.02,30000,213000,sikertelen");
+
+        // A polimorf objektum es a rekord ugyanazt a sort irja
+        for (size_t i = 0; i < 3; i++) {
+            std::ostringstream a, b;
+            muveletek[i]->mentes(a);
+            muveletek[i]->toRekord().mentes(b);
+            EXPECT_EQ(a.str(), b.str());
+        }
+    } END
+
+    TEST(SzervizTortenet, MegosztottMasolasEsIraskoriMasolas) {
+        Ugyfel tulaj("Kiss Lilla", "+36 70 555 1234", "kiss.lilla@gmail.com");
+        SzervizRekordLista rekordok;
+        rekordok.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 1, 10), 25000, 80000));
+        rekordok.push_back(SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2024, 6, 20), 60000, 90000));
+        Auto eredeti("COW001", "Honda", "Civic", 95000, Datum(2018, 3, 3), rekordok, &tulaj);
+
+        // A masolat ugyanazt a listat latja, nincs kulon masolat
+        Auto masolat(eredeti);
+        EXPECT_TRUE(eredeti.getSzervizTortenet().megosztott());
+        EXPECT_TRUE(&masolat.getSzervizRekordok() == &eredeti.getSzervizRekordok());
+
+        // Modositaskor a modosito fel kap sajat listat, a masik valtozatlan marad
+        masolat.addVegzettSzerviz(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2025, 1, 5), 30000, 95000, true));
+        EXPECT_FALSE(eredeti.getSzervizTortenet().megosztott());
+        EXPECT_EQ(fromSizetToUnsigned(eredeti.getSzervizRekordok().size()), 2u);
+        EXPECT_EQ(fromSizetToUnsigned(masolat.getSzervizRekordok().size()), 3u);
+
+        Auto ertekadott;
+        EXPECT_TRUE(ertekadott.getSzervizTortenet().empty());
+        ertekadott = eredeti;
+        ertekadott.torolVegzettSzerviz(0);
+        EXPECT_EQ(eredeti.getSzervizRekordok()[0].muvelet, "Olajcsere");
+        EXPECT_EQ(ertekadott.getSzervizRekordok()[0].muvelet, "Fekcsere");
+
+        // Az adatbazis masolata sem masolja a torteneteket
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(tulaj);
+        aDB.ujAuto(eredeti);
+        SzervizNyilvantartoRendszer dbMasolat(aDB);
+        EXPECT_TRUE(&dbMasolat.getAutok()[0].getSzervizRekordok() == &aDB.getAutok()[0].getSzervizRekordok());
+        dbMasolat.torolMuvelet("COW001", Datum(2024, 1, 10));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.keresAuto("COW001").getSzervizRekordok().size()), 2u);
+    } END
+
+    TEST(EmlekeztetoMotor, EsedekesAutokDatumEsKmSzerint) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Nagy Zoltan", "+36 20 999 8888", "nagy.zoltan@gmail.com"));
+        Ugyfel* tulaj = &aDB.keresUgyfel("Nagy Zoltan");
+        const int32_t napok[] = { 100, 400, 700, 50, 900, 300 };
+        for (int i = 0; i < 6; i++) {
+            SzervizRekordLista l;
+            l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum::fromNapSorszam(19000 + napok[i]), 20000, 50000 + i * 1000));
+            aDB.ujAuto(Auto(std::string("EMK00") + static_cast<char>('0' + i), "Ford", "Focus", 55000 + i * 1000, Datum(2015, 1, 1), l, tulaj));
+        }
+        aDB.ujAuto(Auto("EMK099", "Ford", "Ka", 1000, Datum(2020, 1, 1), SzervizRekordLista(), tulaj));
+
+        const EmlekeztetoMotor& motor = aDB.getEmlekezteto();
+        EXPECT_EQ(fromSizetToUnsigned(motor.meret()), 6u); // szerviz nelkuli auto nem szerepel
+
+        // Esedekes: utolso szerviz + 731 nap <= referencia datum, esedekesseg szerint rendezve
+        Vector<Esedekesseg> ki;
+        motor.esedekesekDatumig(Datum::fromNapSorszam(19000 + 400 + 731), ki);
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 4u);
+        EXPECT_EQ(ki[0].rendszam, "EMK003");
+        EXPECT_EQ(ki[3].rendszam, "EMK001");
+
+        // Uj szerviz: az auto kikerul az esedekesek kozul
+        aDB.rogzitesVegzettMuvelet("EMK003", SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum::fromNapSorszam(19000 + 1000), 30000, 60000, true));
+        ki.clear();
+        aDB.getEmlekezteto().esedekesekDatumig(Datum::fromNapSorszam(19000 + 400 + 731), ki);
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 3u);
+        EXPECT_EQ(ki[0].rendszam, "EMK000");
+
+        // Km alapu: az utolso szerviz ota > 10000 km
+        ki.clear();
+        aDB.getEmlekezteto().esedekesekKmAlapjan(0, ki);
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 0u);
+        aDB.frissitKmOra("EMK005", 70000);
+        aDB.getEmlekezteto().esedekesekKmAlapjan(0, ki);
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 1u);
+        EXPECT_EQ(ki[0].rendszam, "EMK005");
+        ki.clear();
+        aDB.getEmlekezteto().esedekesekKmAlapjan(5001, ki); // 5001 km-en belul esedekesek is
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 5u);
+        EXPECT_EQ(ki[0].rendszam, "EMK005");
+
+        // Torles utan nem szerepel, es a helyben frissitett motor megegyezik egy ujraepitettel
+        aDB.torolAuto("EMK000");
+        ki.clear();
+        aDB.getEmlekezteto().esedekesekDatumig(Datum::fromNapSorszam(30000), ki);
+        EmlekeztetoMotor ujraepitett;
+        ujraepitett.ujraepit(aDB.getAutok(), aDB.getFigyelmeztetesiSzabalyok());
+        Vector<Esedekesseg> ki2;
+        ujraepitett.esedekesekDatumig(Datum::fromNapSorszam(30000), ki2);
+        EXPECT_EQ(fromSizetToUnsigned(ki.size()), 5u);
+        EXPECT_EQ(fromSizetToUnsigned(ki2.size()), 5u);
+        for (size_t i = 0; i < ki.size() && i < ki2.size(); i++)
+            EXPECT_EQ(ki[i].rendszam, ki2[i].rendszam);
+
+        // A referencia datum parameter: ugyanarra az autora mas-mas datummal
+        std::ostringstream korai, kesoi;
+        aDB.figyelmeztetesek(korai, aDB.keresAuto("EMK001"), Datum::fromNapSorszam(19000 + 400 + 730));
+        aDB.figyelmeztetesek(kesoi, aDB.keresAuto("EMK001"), Datum::fromNapSorszam(19000 + 400 + 731));
+        EXPECT_EQ(korai.str(), "\tNincsenek figyelmeztetesek!\n");
+        EXPECT_TRUE(kesoi.str().find("lejart") != std::string::npos);
+    } END
+
+    TEST(SzalKeszlet, ParhuzamosFlottaFigyelmeztetesek) {
+        SzalKeszlet keszlet(4);
+        EXPECT_EQ(fromSizetToUnsigned(keszlet.szalakSzama()), 4u);
+
+        // Minden index pontosan egyszer kerul feldolgozasra
+        Vector<int> jelolt;
+        for (int i = 0; i < 1000; i++) jelolt.push_back(0);
+        keszlet.parhuzamosFor(jelolt.size(), [&](size_t tol, size_t ig) {
+            for (size_t i = tol; i < ig; i++) jelolt[i]++;
+        }, 16);
+        int hibas = 0;
+        for (size_t i = 0; i < jelolt.size(); i++) if (jelolt[i] != 1) hibas++;
+        EXPECT_EQ(hibas, 0);
+        EXPECT_THROW(keszlet.parhuzamosFor(100, [](size_t tol, size_t) { if (tol > 0) throw std::runtime_error("hiba"); }, 10), const std::runtime_error&);
+
+        // A parhuzamos kiertekeles ugyanazt adja, mint az autonkenti szabalyok, rendezve
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Kis Anna", "+36 30 111 2222", "kis.anna@gmail.com"));
+        Ugyfel* tulaj = &aDB.keresUgyfel("Kis Anna");
+        const Datum ma = Datum::fromNapSorszam(20000);
+        for (int i = 299; i >= 0; i--) {
+            SzervizRekordLista l;
+            if (i % 7 != 0)
+                l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum::fromNapSorszam(20000 - (i * 37) % 1500), 20000, 50000));
+            std::ostringstream r;
+            r << "PAR" << std::setw(3) << std::setfill('0') << i;
+            aDB.ujAuto(Auto(r.str(), "Opel", "Astra", 50000 + (i * 131) % 20000, Datum(2015, 1, 1), l, tulaj));
+        }
+        Vector<Figyelmeztetes> f = aDB.flottaFigyelmeztetesek(ma, keszlet);
+
+        size_t vart = 0;
+        for (size_t i = 0; i < aDB.getAutok().size(); i++) {
+            std::ostringstream os;
+            aDB.figyelmeztetesek(os, aDB.getAutok()[i], ma);
+            if (os.str().find("lejart") != std::string::npos) vart++;
+            if (os.str().find("esedekes") != std::string::npos) vart++;
+        }
+        EXPECT_EQ(fromSizetToUnsigned(f.size()), fromSizetToUnsigned(vart));
+        int rendezetlen = 0;
+        for (size_t i = 1; i < f.size(); i++) if (f[i] < f[i - 1]) rendezetlen++;
+        EXPECT_EQ(rendezetlen, 0);
+
+        // PAR040: 1480 napja volt szerviz, 5240 km-rel ezelott
+        for (size_t i = 0; i < f.size(); i++) {
+            if (f[i].rendszam != "PAR040") continue;
+            EXPECT_TRUE(f[i].mertek == FigyelmeztetesMertek::Nap);
+            EXPECT_EQ(f[i].tullepes, 1480 - EmlekeztetoMotor::VIZSGA_ERVENYESSEG_NAP);
+        }
+    } END
+
+    TEST(FigyelmeztetesiSzabalyok, TipusSzerintiSzabalyok) {
+        // Az alapertelmezett keszlet ket sorra fordul, hibas szabaly nem veheto fel
+        FigyelmeztetesiSzabalyok alap = FigyelmeztetesiSzabalyok::alapertelmezett();
+        EXPECT_EQ(fromSizetToUnsigned(alap.sorokSzama()), 2u);
+        FigyelmeztetesiSzabalyok sz;
+        EXPECT_THROW(sz.hozzaad(FigyelmeztetesiSzabaly("ures", "semmi", 0, 10, 10)), const std::invalid_argument&);
+        EXPECT_THROW(sz.hozzaad(FigyelmeztetesiSzabaly("kuszob nelkul", "semmi", FigyelmeztetesiSzabaly::BARMELY, FigyelmeztetesiSzabaly::NINCS, FigyelmeztetesiSzabaly::NINCS)), const std::invalid_argument&);
+
+        // Tipus szerinti szabalyok: vizsga 2 evente, olajcsere (karbantartas) 15000 km-enkent vagy evente
+        sz.hozzaad(FigyelmeztetesiSzabaly("muszaki vizsgaja lejart", "vizsga", FigyelmeztetesiSzabaly::VIZSGA, 730, FigyelmeztetesiSzabaly::NINCS));
+        sz.hozzaad(FigyelmeztetesiSzabaly("olajcserere esedekes", "karbantartas", FigyelmeztetesiSzabaly::KARBANTARTAS, 365, 15000));
+        EXPECT_EQ(fromSizetToUnsigned(sz.sorokSzama()), 3u);
+
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Toth Eva", "+36 70 555 6666", "toth.eva@gmail.com"));
+        SzervizRekordLista l;
+        l.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum::fromNapSorszam(19000), 30000, 40000, true));
+        l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum::fromNapSorszam(19500), 20000, 45000));
+        l.push_back(SzervizRekord(MuveletTipus::Javitas, "Fektarcsa", Datum::fromNapSorszam(19900), 50000, 62000));
+        aDB.ujAuto(Auto("SZB001", "Skoda", "Fabia", 62000, Datum(2015, 1, 1), l, &aDB.keresUgyfel("Toth Eva")));
+        const Datum ma = Datum::fromNapSorszam(19950);
+
+        // Az eredeti szabalyok szerint a friss javitas miatt nincs figyelmeztetes
+        std::ostringstream regi;
+        aDB.figyelmeztetesek(regi, aDB.keresAuto("SZB001"), ma);
+        EXPECT_EQ(regi.str(), "\tNincsenek figyelmeztetesek!\n");
+
+        Vector<Esedekesseg> es;
+        aDB.getEmlekezteto().esedekesekDatumig(ma, es);
+        EXPECT_EQ(fromSizetToUnsigned(es.size()), 0u);
+
+        // A tipus szerinti szabalyok a javitast nem tekintik vizsganak, olajcserenek
+        aDB.setFigyelmeztetesiSzabalyok(sz);
+        Vector<Figyelmeztetes> f = aDB.flottaFigyelmeztetesek(ma);
+        EXPECT_EQ(fromSizetToUnsigned(f.size()), 3u);
+        EXPECT_EQ(fromSizetToUnsigned(f[0].szabaly), 0u);
+        EXPECT_EQ(f[0].tullepes, 950 - 730);
+        EXPECT_TRUE(f[1].szabaly == 1 && f[1].mertek == FigyelmeztetesMertek::Nap);
+        EXPECT_EQ(f[1].tullepes, 450 - 365);
+        EXPECT_TRUE(f[2].szabaly == 1 && f[2].mertek == FigyelmeztetesMertek::Km);
+        EXPECT_EQ(f[2].tullepes, 17000 - 15000);
+
+        std::ostringstream uj;
+        aDB.figyelmeztetesek(uj, aDB.keresAuto("SZB001"), ma);
+        EXPECT_TRUE(uj.str().find("olajcserere esedekes! (Utolso karbantartas ota 17000 km telt el)") != std::string::npos);
+
+        // Az emlekezteto a csere utan ugyanazokbol a szabalyokbol szamol: vizsga + 731 nap, olajcsere + 15001 km
+        aDB.getEmlekezteto().esedekesekDatumig(ma, es);
+        EXPECT_EQ(fromSizetToUnsigned(es.size()), 1u);
+        EXPECT_EQ(es[0].esedekesDatum.getNapSorszam(), 19000 + 731);
+        EXPECT_EQ(es[0].esedekesKm, 60001);
+        es.clear();
+        aDB.getEmlekezteto().esedekesekKmAlapjan(0, es);
+        EXPECT_EQ(fromSizetToUnsigned(es.size()), 1u);
+
+        // Km kuszob nelkuli szabalykeszletnel nincs km alapu esedekesseg, es becsles sem
+        FigyelmeztetesiSzabalyok csakVizsga;
+        csakVizsga.hozzaad(FigyelmeztetesiSzabaly("muszaki vizsgaja lejart", "vizsga", FigyelmeztetesiSzabaly::VIZSGA, 730, FigyelmeztetesiSzabaly::NINCS));
+        aDB.setFigyelmeztetesiSzabalyok(csakVizsga);
+        es.clear();
+        aDB.getEmlekezteto().esedekesekKmAlapjan(1000000, es);
+        EXPECT_EQ(fromSizetToUnsigned(es.size()), 0u);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.becsultSzervizek(Datum::fromNapSorszam(30000)).size()), 0u);
+        aDB.getEmlekezteto().esedekesekDatumig(ma, es);
+        EXPECT_EQ(fromSizetToUnsigned(es.size()), 1u);
+    } END
+
+    TEST(BevetelOsszesites, HonapTipusEsMarkaSzerint) {
+        SzervizNyilvantartoRendszer aDB;
+        EXPECT_EQ(aDB.bevetelOsszesites().darab, 0LL);
+        aDB.ujUgyfel(Ugyfel("Szabo Peter", "+36 20 444 5555", "szabo.peter@gmail.com"));
+        Ugyfel* tulaj = &aDB.keresUgyfel("Szabo Peter");
+
+        SzervizRekordLista l1, l2, l3;
+        l1.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2023, 12, 31), 20000, 100000));
+        l1.push_back(SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2024, 1, 1), 80000, 101000));
+        l2.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 1, 31), 30000, 50000, true));
+        l2.push_back(SzervizRekord(MuveletTipus::Javitas, "Kuplung", Datum(2024, 3, 15), 2000000000, 52000));
+        l3.push_back(SzervizRekord(MuveletTipus::Javitas, "Kuplung", Datum(2024, 3, 1), 2000000000, 90000));
+        aDB.ujAuto(Auto("BEV001", "Toyota", "Yaris", 101000, Datum(2015, 1, 1), l1, tulaj));
+        aDB.ujAuto(Auto("BEV002", "Audi", "A4", 52000, Datum(2018, 1, 1), l2, tulaj));
+        aDB.ujAuto(Auto("BEV003", "Toyota", "Corolla", 90000, Datum(2019, 1, 1), l3, tulaj));
+
+        BevetelOsszesites o = aDB.bevetelOsszesites();
+        EXPECT_EQ(o.darab, 5LL);
+        EXPECT_EQ(o.osszeg, 4000130000LL); // 32 bites osszegnel tulcsordulna
+
+        // Honapok: csak a nem ures honapok, idorendben (2024.02 kimarad)
+        EXPECT_EQ(fromSizetToUnsigned(o.honapok.size()), 3u);
+        EXPECT_EQ(o.honapok[0].kulcs, "2023.12");
+        EXPECT_EQ(o.honapok[1].kulcs, "2024.01");
+        EXPECT_EQ(o.honapok[1].osszeg, 110000LL);
+        EXPECT_EQ(o.honapok[1].darab, 2LL);
+        EXPECT_EQ(o.honapok[2].kulcs, "2024.03");
+        EXPECT_DOUBLE_EQ(o.honapok[2].atlag(), 2000000000.0);
+
+        // Tipusok: J, K, V sorrendben
+        EXPECT_EQ(o.tipusok[0].kulcs, "J");
+        EXPECT_EQ(o.tipusok[0].darab, 3LL);
+        EXPECT_EQ(o.tipusok[1].osszeg, 20000LL);
+        EXPECT_EQ(o.tipusok[2].osszeg, 30000LL);
+
+        // Markak nev szerint rendezve
+        EXPECT_EQ(fromSizetToUnsigned(o.csoportok.size()), 2u);
+        EXPECT_EQ(o.csoportok[0].kulcs, "Audi");
+        EXPECT_EQ(o.csoportok[0].osszeg, 2000030000LL);
+        EXPECT_EQ(o.csoportok[1].kulcs, "Toyota");
+        EXPECT_EQ(o.csoportok[1].darab, 3LL);
+        EXPECT_DOUBLE_EQ(o.csoportok[1].atlag(), 2000100000.0 / 3);
+    } END
+
+    TEST(UgyfelOsszesito, NovekmenyesKoltesAutoszamLatogatas) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Kovacs Bela", "+36 30 222 3333", "kovacs.bela@gmail.com"));
+        aDB.ujUgyfel(Ugyfel("Varga Reka", "+36 20 777 8888", "varga.reka@gmail.com"));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelOsszesito("Kovacs Bela").autokSzama), 0u);
+
+        SzervizRekordLista l;
+        l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 3, 1), 25000, 60000));
+        aDB.ujAuto(Auto("AGG001", "Opel", "Corsa", 61000, Datum(2016, 1, 1), l, &aDB.keresUgyfel("Kovacs Bela")));
+        aDB.ujAuto(Auto("AGG002", "Fiat", "Punto", 90000, Datum(2012, 1, 1), SzervizRekordLista(), &aDB.keresUgyfel("Kovacs Bela")));
+        aDB.ujAuto(Auto("AGG003", "Seat", "Ibiza", 30000, Datum(2019, 1, 1), SzervizRekordLista(), &aDB.keresUgyfel("Varga Reka")));
+        aDB.rogzitesVegzettMuvelet("AGG002", SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2024, 9, 10), 60000, 91000));
+        aDB.rogzitesVegzettMuvelet("AGG003", SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 5, 5), 30000, 31000, true));
+
+        const UgyfelOsszesito& kb = aDB.getUgyfelOsszesito("Kovacs Bela");
+        EXPECT_EQ(fromSizetToUnsigned(kb.autokSzama), 2u);
+        EXPECT_EQ(fromSizetToUnsigned(kb.muveletekSzama), 2u);
+        EXPECT_EQ(kb.koltes, 85000LL);
+        EXPECT_TRUE(kb.utolsoLatogatas == Datum(2024, 9, 10));
+
+        // A konstans keresesek nem teszik elavultta az osszesitoket, a modosithato referenciat adok igen
+        aDB.szarmaztatottAdatokFrissitese();
+        const SzervizNyilvantartoRendszer& cDB = aDB;
+        EXPECT_EQ(cDB.keresAuto("AGG002").getSzervizRekordok().back().ar, 60000);
+        EXPECT_EQ(fromSizetToUnsigned(cDB.getAutok().size()), 3u);
+        EXPECT_TRUE(aDB.szarmaztatottAdatokFrissek());
+        aDB.keresAuto("AGG002");
+        EXPECT_FALSE(aDB.szarmaztatottAdatokFrissek());
+
+        // A legutolso muvelet torlese utan az elozo latogatas lesz az utolso
+        aDB.torolMuvelet("AGG002", Datum(2024, 9, 10));
+        EXPECT_EQ(aDB.getUgyfelOsszesito("Kovacs Bela").koltes, 25000LL);
+        EXPECT_TRUE(aDB.getUgyfelOsszesito("Kovacs Bela").utolsoLatogatas == Datum(2024, 3, 1));
+        aDB.torolAuto("AGG001");
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelOsszesito("Kovacs Bela").autokSzama), 1u);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelOsszesito("Kovacs Bela").muveletekSzama), 0u);
+
+        // Sok uj ugyfel utan (a tomb athelyezodik) es egy ugyfel torlese utan is jo tulajdonosra mutatnak az autok
+        for (int i = 0; i < 150; i++) {
+            std::ostringstream nev;
+            nev << "Ugyfel " << i;
+            aDB.ujUgyfel(Ugyfel(nev.str(), "", ""));
+        }
+        aDB.torolUgyfel("Kovacs Bela");
+        EXPECT_EQ(aDB.keresAuto("AGG003").getTulajdonos()->getNev(), "Varga Reka");
+        EXPECT_FALSE(aDB.vanAuto("AGG002"));
+        EXPECT_EQ(fromSizetToUnsigned(aDB.getUgyfelOsszesito("Kovacs Bela").autokSzama), 0u);
+        EXPECT_EQ(aDB.getUgyfelOsszesito("Varga Reka").koltes, 30000LL);
+
+        // Az adatbazis masolata a sajat ugyfeleire mutat
+        SzervizNyilvantartoRendszer masolat(aDB);
+        EXPECT_TRUE(masolat.keresAuto("AGG003").getTulajdonos() == &masolat.keresUgyfel("Varga Reka"));
+    } END
+
+    TEST(KmRegresszio, NovekmenyesNapiKmEsBecsultDatum) {
+        // Pontosan 50 km/nap: 2024.01.01, +100 nap, +200 nap
+        SzervizRekordLista l;
+        l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 1, 1), 20000, 10000));
+        l.push_back(SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum::fromNapSorszam(Datum(2024, 1, 1).getNapSorszam() + 100), 40000, 15000));
+        Auto a("REG001", "Skoda", "Octavia", 20000, Datum(2015, 1, 1), l, nullptr);
+        EXPECT_TRUE(a.getKmRegresszio().ervenyes());
+        EXPECT_DOUBLE_EQ(a.becsultNapiKm(), 50.0);
+
+        int32_t utolsoNap = Datum(2024, 1, 1).getNapSorszam() + 200;
+        a.addVegzettSzerviz(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum::fromNapSorszam(utolsoNap), 30000, 20000, true));
+        EXPECT_EQ(a.getKmRegresszio().darab(), 3LL);
+        EXPECT_DOUBLE_EQ(a.becsultNapiKm(), 50.0);
+
+        Datum d;
+        EXPECT_TRUE(a.becsultDatumKmOraig(30001, d));
+        EXPECT_EQ(d.getNapSorszam(), utolsoNap + 201);
+
+        // A masolat osztozik a tortenetben; a masolat modositasa az eredetit nem erinti
+        Auto b(a);
+        b.torolVegzettSzerviz(2);
+        b.torolVegzettSzerviz(1);
+        EXPECT_FALSE(b.getKmRegresszio().ervenyes());
+        EXPECT_FALSE(b.becsultDatumKmOraig(30001, d));
+        EXPECT_DOUBLE_EQ(a.becsultNapiKm(), 50.0);
+
+        // Flottaszintu becsles: csak a datumig esedekes, eleg adattal rendelkezo autok
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujAuto(a);
+        aDB.ujAuto(b);
+        EXPECT_EQ(fromSizetToUnsigned(aDB.becsultSzervizek(Datum::fromNapSorszam(utolsoNap + 200)).size()), 0u);
+        Vector<SzervizBecsles> becslesek = aDB.becsultSzervizek(Datum::fromNapSorszam(utolsoNap + 201));
+        EXPECT_EQ(fromSizetToUnsigned(becslesek.size()), 1u);
+        EXPECT_EQ(becslesek[0].rendszam, "REG001");
+        EXPECT_EQ(becslesek[0].esedekesKm, 30001);
+
+        // Nagy napsorszamok es km allasok: a nyers n*Sxy mar tulcsordulna, az elteresekbol szamolt nem
+        KmRegresszio r;
+        const int32_t nap0 = Datum(9000, 1, 1).getNapSorszam();
+        for (int i = 0; i < 20000; i++)
+            r.hozzaad(nap0 + i, 1000000000 + 100 * i);
+        EXPECT_DOUBLE_EQ(r.napiKm(), 100.0);
+        r.elvesz(nap0, 1000000000);
+        EXPECT_EQ(r.darab(), 19999LL);
+        EXPECT_DOUBLE_EQ(r.napiKm(), 100.0);
+
+        // A viszonyitasi pont elvetele utan az azonos napi pontokbol nincs meredekseg
+        KmRegresszio q;
+        q.hozzaad(5, 10);
+        q.hozzaad(9, 20);
+        q.hozzaad(9, 30);
+        q.elvesz(5, 10);
+        EXPECT_FALSE(q.ervenyes());
+        q.hozzaad(12, 60);
+        EXPECT_TRUE(q.ervenyes());
+    } END
+
+    TEST(TopK, LegdragabbJavitasokKmEsSikertelenVizsgak) {
+        // A sablon: a 3 legnagyobb szam, a tobbi kiesik
+        TopK<int> h(3);
+        int szamok[] = { 5, 1, 9, 7, 3, 9, 2 };
+        for (size_t i = 0; i < sizeof(szamok) / sizeof(szamok[0]); i++)
+            h.ajanl(szamok[i]);
+        Vector<int> legjobb = h.eredmeny();
+        EXPECT_EQ(fromSizetToUnsigned(legjobb.size()), 3u);
+        EXPECT_EQ(legjobb[0], 9);
+        EXPECT_EQ(legjobb[1], 9);
+        EXPECT_EQ(legjobb[2], 7);
+
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Kiss Anna", "", ""));
+        aDB.ujUgyfel(Ugyfel("Nagy Peter", "", ""));
+        SzervizRekordLista l1, l2, l3;
+        l1.push_back(SzervizRekord(MuveletTipus::Javitas, "Motorcsere", Datum(2024, 2, 1), 900000, 150000));
+        l1.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 3, 1), 30000, 151000, false));
+        l1.push_back(SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2025, 1, 5), 950000, 160000));
+        l2.push_back(SzervizRekord(MuveletTipus::Javitas, "Kuplungcsere", Datum(2024, 6, 1), 300000, 80000));
+        l2.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 7, 1), 990000, 81000));
+        l2.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 8, 1), 30000, 82000, false));
+        l3.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 8, 1), 30000, 20000, false));
+        l3.push_back(SzervizRekord(MuveletTipus::Javitas, "Izzocsere", Datum(2024, 9, 1), 5000, 21000));
+        aDB.ujAuto(Auto("TOP001", "Audi", "A4", 160000, Datum(2010, 1, 1), l1, &aDB.keresUgyfel("Kiss Anna")));
+        aDB.ujAuto(Auto("TOP002", "Ford", "Focus", 82000, Datum(2015, 1, 1), l2, &aDB.keresUgyfel("Nagy Peter")));
+        aDB.ujAuto(Auto("TOP003", "Kia", "Ceed", 21000, Datum(2020, 1, 1), l3, &aDB.keresUgyfel("Nagy Peter")));
+
+        Vector<RekordTalalat> javitasok = aDB.legdragabbMuveletek(2, 2024);
+        EXPECT_EQ(fromSizetToUnsigned(javitasok.size()), 2u);
+        EXPECT_EQ(javitasok[0].rendszam, "TOP001");
+        EXPECT_EQ(javitasok[0].rekord.muvelet, "Motorcsere");
+        EXPECT_EQ(javitasok[1].rekord.muvelet, "Kuplungcsere");
+
+        Vector<RangsorTalalat> kmek = aDB.legtobbKmAutok(2);
+        EXPECT_EQ(fromSizetToUnsigned(kmek.size()), 2u);
+        EXPECT_EQ(kmek[0].kulcs, "TOP001");
+        EXPECT_EQ(kmek[1].kulcs, "TOP002");
+
+        Vector<RangsorTalalat> vizsgak = aDB.legtobbSikertelenVizsgaUgyfelek(5);
+        EXPECT_EQ(fromSizetToUnsigned(vizsgak.size()), 2u);
+        EXPECT_EQ(vizsgak[0].kulcs, "Nagy Peter");
+        EXPECT_EQ(vizsgak[0].ertek, 2LL);
+        EXPECT_EQ(vizsgak[1].kulcs, "Kiss Anna");
+    } END
+
+    TEST(Lekerdezes, SzuroNyelvIndexEsOszloposMezok) {
+        SzervizNyilvantartoRendszer aDB;
+        aDB.ujUgyfel(Ugyfel("Toth Gabor", "+36 30 111 2222", "toth.gabor@gmail.com"));
+        aDB.ujUgyfel(Ugyfel("Fekete Lili", "+36 70 333 4444", "fekete.lili@gmail.com"));
+        SzervizRekordLista l1, l2;
+        l1.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2023, 5, 1), 30000, 210000, true));
+        l2.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki vizsga", Datum(2024, 6, 1), 30000, 250000, true));
+        aDB.ujAuto(Auto("QRY001", "Toyota", "Corolla", 215000, Datum(2008, 1, 1), l1, &aDB.keresUgyfel("Toth Gabor")));
+        aDB.ujAuto(Auto("QRY002", "Toyota", "Yaris", 255000, Datum(2009, 1, 1), l2, &aDB.keresUgyfel("Toth Gabor")));
+        aDB.ujAuto(Auto("QRY003", "Toyota", "Auris", 90000, Datum(2018, 1, 1), SzervizRekordLista(), &aDB.keresUgyfel("Fekete Lili")));
+        aDB.ujAuto(Auto("QRY004", "Honda", "Civic", 300000, Datum(2005, 1, 1), SzervizRekordLista(), &aDB.keresUgyfel("Fekete Lili")));
+
+        // A pelda: a vizsga nelkuli auto (QRY004) datumfeltetele hamis
+        Lekerdezes l("marka = \"Toyota\" and kmOra > 200000 and last_vizsga < 2024.01.01", LekerdezesCel::Auto);
+        EXPECT_TRUE(l.getHozzaferes() == LekerdezesHozzaferes::Teljes);
+        EXPECT_EQ(fromSizetToUnsigned(l.szurokSzama()), 3u);
+        Vector<size_t> t = l.futtat(aDB);
+        EXPECT_EQ(fromSizetToUnsigned(t.size()), 1u);
+        EXPECT_EQ(aDB.getAutok()[t[0]].getRendszam(), "QRY001");
+
+        // Kulcs szerinti hozzaferes: a rendszam/tulajdonos tag a jelolteket adja, nem a szurolancot
+        Lekerdezes r("kmOra > 1 AND rendszam = \"QRY002\"", LekerdezesCel::Auto);
+        EXPECT_TRUE(r.getHozzaferes() == LekerdezesHozzaferes::Rendszam);
+        EXPECT_EQ(fromSizetToUnsigned(r.szurokSzama()), 1u);
+        EXPECT_EQ(fromSizetToUnsigned(r.futtat(aDB).size()), 1u);
+        Lekerdezes tu("tulajdonos = \"Fekete Lili\" and (tipus ~ \"ivi\" or not kmOra >= 50000)", LekerdezesCel::Auto);
+        EXPECT_TRUE(tu.getHozzaferes() == LekerdezesHozzaferes::Tulajdonos);
+        t = tu.futtat(aDB);
+        EXPECT_EQ(fromSizetToUnsigned(t.size()), 1u);
+        EXPECT_EQ(aDB.getAutok()[t[0]].getRendszam(), "QRY004");
+        Lekerdezes nv("nev = \"Fekete Lili\"", LekerdezesCel::Ugyfel);
+        EXPECT_TRUE(nv.getHozzaferes() == LekerdezesHozzaferes::Nev);
+        t = nv.futtat(aDB);
+        EXPECT_TRUE(t.size() == 1 && t[0] == aDB.ugyfelSorszam("Fekete Lili"));
+
+        // Ugyfelek az osszesitobol
+        t = Lekerdezes("autok >= 2 and koltes > 50000", LekerdezesCel::Ugyfel).futtat(aDB);
+        EXPECT_EQ(fromSizetToUnsigned(t.size()), 1u);
+        EXPECT_EQ(aDB.getUgyfelek()[t[0]].getNev(), "Toth Gabor");
+
+        // A tulajdonosindex helyben kovetkezik a tulajdonosvaltast, a torlest es az uj autot
+        Lekerdezes tg("tulajdonos = \"Toth Gabor\"", LekerdezesCel::Auto);
+        Auto atadott = aDB.keresAuto("QRY003");
+        atadott.setTulajdonos(&aDB.keresUgyfel("Toth Gabor"));
+        aDB.szarmaztatottAdatokFrissitese();
+        EXPECT_TRUE(aDB.frissitAuto(atadott));
+        EXPECT_TRUE(aDB.szarmaztatottAdatokFrissek());
+        EXPECT_EQ(fromSizetToUnsigned(tg.futtat(aDB).size()), 3u);
+        EXPECT_TRUE(aDB.torolAuto("QRY001"));
+        aDB.ujAuto(Auto("QRY005", "Opel", "Corsa", 1000, Datum(2020, 1, 1), SzervizRekordLista(), &aDB.keresUgyfel("Toth Gabor")));
+        EXPECT_TRUE(aDB.szarmaztatottAdatokFrissek());
+        t = tg.futtat(aDB);
+        EXPECT_EQ(fromSizetToUnsigned(t.size()), 3u);
+        for (size_t i = 0; i < t.size(); i++)
+            EXPECT_EQ(aDB.getAutok()[t[i]].getTulajdonos()->getNev(), "Toth Gabor");
+        EXPECT_EQ(aDB.getAutok()[t[2]].getRendszam(), "QRY005");
+        EXPECT_EQ(fromSizetToUnsigned(aDB.tulajdonosAutoSorszamai("Fekete Lili").size()), 1u);
+        EXPECT_TRUE(aDB.tulajdonosAutoSorszamai("Nincs Ilyen").empty());
+
+        // Forditasi hibak
+        EXPECT_THROW(Lekerdezes("kmOra > \"sok\"", LekerdezesCel::Auto), const std::invalid_argument&);
+        EXPECT_THROW(Lekerdezes("szin = \"piros\"", LekerdezesCel::Auto), const std::invalid_argument&);
+        EXPECT_THROW(Lekerdezes("(marka = \"Opel\"", LekerdezesCel::Auto), const std::invalid_argument&);
+        EXPECT_THROW(Lekerdezes("nev = \"X\" nev", LekerdezesCel::Ugyfel), const std::invalid_argument&);
+
+        // Az egymasba agyazas es a lancok hossza korlatos (kulonben a rekurzio kimeritene a vermet)
+        const size_t n = Lekerdezes::MAX_AGYAZAS;
+        EXPECT_EQ(fromSizetToUnsigned(Lekerdezes(std::string(n, '(') + "kmOra > 1" + std::string(n, ')'), LekerdezesCel::Auto).szurokSzama()), 1u);
+        EXPECT_THROW(Lekerdezes(std::string(n + 1, '(') + "kmOra > 1" + std::string(n + 1, ')'), LekerdezesCel::Auto), const std::invalid_argument&);
+        EXPECT_THROW(Lekerdezes(std::string(200000, '('), LekerdezesCel::Auto), const std::invalid_argument&);
+        std::string tagadas, lanc = "kmOra > 1";
+        for (size_t i = 0; i <= n; i++) tagadas += "not ";
+        for (size_t i = 0; i < Lekerdezes::MAX_MAGASSAG; i++) lanc += " or kmOra > 1";
+        EXPECT_THROW(Lekerdezes(tagadas + "kmOra > 1", LekerdezesCel::Auto), const std::invalid_argument&);
+        EXPECT_THROW(Lekerdezes(lanc, LekerdezesCel::Auto), const std::invalid_argument&);
+    } END
+
+    TEST(SzalbiztosNyilvantarto, ParhuzamosOlvasokEsIro) {
+        SzalbiztosNyilvantarto sz;
+        sz.ujUgyfel(Ugyfel("Kovacs Anna", "+36 30 555 6666", "kovacs.anna@gmail.com"));
+        EXPECT_TRUE(sz.ujAuto(Auto("THR001", "Skoda", "Octavia", 100000, Datum(2015, 1, 1), SzervizRekordLista(), nullptr), "Kovacs Anna"));
+        EXPECT_FALSE(sz.ujAuto(Auto("THR002", "Skoda", "Fabia", 1000, Datum(2020, 1, 1), SzervizRekordLista(), nullptr), "Nincs Ilyen"));
+
+        // Olvasok (zarolas nelkul es megosztott zarral) egy iroval parhuzamosan: a km ora soha nem csokkenhet,
+        // a tulajdonos masolata mindig ervenyes, a szervizszam es a km ora egyutt valtozik
+        std::atomic<bool> stop(false), hiba(false);
+        std::atomic<long> olvasasok(0);
+        std::vector<std::thread> olvasok;
+        for (int t = 0; t < 4; t++) {
+            olvasok.push_back(std::thread([&sz, &stop, &hiba, &olvasasok, t]() {
+                int utolso = 0;
+                while (!stop.load()) {
+                    Auto a;
+                    Ugyfel u;
+                    if (!sz.keresAuto("THR001", a, &u) || a.getKmOra() < utolso || u.getNev() != "Kovacs Anna"
+                        || a.getTulajdonos() != nullptr || a.getSzervizRekordok().size() != static_cast<size_t>((a.getKmOra() - 100000) / 100))
+                        hiba = true;
+                    utolso = a.getKmOra();
+                    if (t % 2 == 1)
+                        sz.olvas([&hiba](const SzervizNyilvantartoRendszer& d) {
+                            if (d.getAutok().size() < 1 || !d.vanUgyfel("Kovacs Anna")) hiba = true;
+                        });
+                    olvasasok++;
+                }
+            }));
+        }
+        for (int i = 1; i <= 200; i++) {
+            // A ket modositas egy kizarolagos zar alatt tortenik, hogy az olvasok egyszerre lassak oket
+            sz.ir([i](SzervizNyilvantartoRendszer& d) {
+                d.frissitKmOra("THR001", 100000 + i * 100);
+                d.rogzitesVegzettMuvelet("THR001", SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2000 + i / 12, i % 12 + 1, 1), 1000, 100000 + i * 100));
+            });
+            std::string r = "TMP" + std::to_string(i % 10);
+            if (!sz.vanAuto(r))
+                sz.ujAuto(Auto(r, "Opel", "Astra", 1000, Datum(2020, 1, 1), SzervizRekordLista(), nullptr), "Kovacs Anna");
+            else
+                sz.torolAuto(r);
+        }
+        stop = true;
+        for (size_t t = 0; t < olvasok.size(); t++)
+            olvasok[t].join();
+
+        EXPECT_FALSE(hiba.load());
+        EXPECT_TRUE(olvasasok.load() > 0);
+        Auto a;
+        EXPECT_TRUE(sz.keresAuto("THR001", a));
+        EXPECT_EQ(a.getKmOra(), 120000);
+        EXPECT_EQ(fromSizetToUnsigned(a.getSzervizRekordok().size()), 200u);
+        EXPECT_FALSE(sz.vanAuto("TMP0"));
+        EXPECT_TRUE(sz.torolUgyfel("Kovacs Anna"));
+        EXPECT_FALSE(sz.vanAuto("THR001"));
+        EXPECT_FALSE(sz.vanUgyfel("Kovacs Anna"));
+    } END
+
+    TEST(OlvasoSzamlalo, TurelmiIdoCsakARegiOlvasokraVar) {
+        OlvasoSzamlalo sz;
+        std::atomic<bool> regiBent(false), regiKilep(false), iroKesz(false), stop(false);
+
+        // A turelmi ido elott belepett olvaso: amig bent van, az iro var
+        std::thread regi([&sz, &regiBent, &regiKilep]() {
+            const unsigned k = sz.belep();
+            regiBent = true;
+            while (!regiKilep.load()) std::this_thread::yield();
+            sz.kilep(k);
+        });
+        while (!regiBent.load()) std::this_thread::yield();
+
+        // Folyamatos, egymast atfedo rovid olvasasok minden szalon: az iro ezek mellett is vegez
+        std::vector<std::thread> folyam;
+        std::atomic<long> olvasasok(0);
+        for (int t = 0; t < 4; t++) {
+            folyam.push_back(std::thread([&sz, &stop, &olvasasok]() {
+                unsigned k = sz.belep();
+                while (!stop.load()) {
+                    const unsigned k2 = sz.belep();     // a kovetkezo olvasas a korabbi vege elott kezdodik
+                    sz.kilep(k);
+                    k = k2;
+                    olvasasok++;
+                }
+                sz.kilep(k);
+            }));
+        }
+
+        std::thread iro([&sz, &iroKesz]() {
+            for (int i = 0; i < 100; i++) sz.turelmiIdo();
+            iroKesz = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_FALSE(iroKesz.load());
+        regiKilep = true;
+        regi.join();
+
+        const std::chrono::steady_clock::time_point hatarido = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!iroKesz.load() && std::chrono::steady_clock::now() < hatarido)
+            std::this_thread::yield();
+        EXPECT_TRUE(iroKesz.load());
+        stop = true;
+        iro.join();
+        for (size_t t = 0; t < folyam.size(); t++)
+            folyam[t].join();
+        EXPECT_TRUE(olvasasok.load() > 0);
+    } END
+
+    TEST(SzalbiztosNyilvantarto, IrasUtanFrissSzarmaztatottAdatok) {
+        SzalbiztosNyilvantarto sz;
+        sz.ujUgyfel(Ugyfel("Friss Ferenc", "+36 1 555", "friss@f.hu"));
+
+        // A megosztott zar alatt az olvasok a szarmaztatott adatokat mindig kesz allapotban talaljak:
+        // egy iras sem hagyhatja elavultan oket, kulonben az olvasok egyszerre epitenek ujra
+        std::atomic<bool> stop(false), elavult(false), eltero(false);
+        std::vector<std::thread> olvasok;
+        for (int t = 0; t < 2; t++) {
+            olvasok.push_back(std::thread([&sz, &stop, &elavult, &eltero]() {
+                while (!stop.load()) {
+                    sz.olvas([&elavult, &eltero](const SzervizNyilvantartoRendszer& d) {
+                        if (!d.szarmaztatottAdatokFrissek()) {
+                            elavult = true;
+                            return;
+                        }
+                        size_t szervizek = 0;
+                        for (size_t i = 0; i < d.getAutok().size(); i++)
+                            szervizek += d.getAutok()[i].getSzervizRekordok().size();
+                        if (d.getEsemenyTar().meret() != szervizek) eltero = true;
+                    });
+                }
+            }));
+        }
+        for (int i = 0; i < 100; i++) {
+            std::string r = "FRS" + std::to_string(100 + i);
+            sz.ujAuto(Auto(r, "Opel", "Astra", 1000, Datum(2020, 1, 1), SzervizRekordLista(), nullptr), "Friss Ferenc");
+            sz.rogzitesVegzettMuvelet(r, SzervizRekord(MuveletTipus::Javitas, "Fek", Datum(2024, 1, 1 + i % 28), 5000, 2000));
+            sz.frissitKmOra(r, 3000);
+            sz.frissitUgyfel(Ugyfel("Friss Ferenc", "+36 1 " + std::to_string(i), "friss@f.hu"));
+            if (i % 3 == 0) sz.torolMuvelet(r, Datum(2024, 1, 1 + i % 28));
+            if (i % 5 == 0) sz.torolAuto(r);
+            if (i % 10 == 0) sz.ir([](SzervizNyilvantartoRendszer& d) { d.getAutok(); });
+        }
+        stop = true;
+        for (size_t t = 0; t < olvasok.size(); t++)
+            olvasok[t].join();
+
+        EXPECT_FALSE(elavult.load());
+        EXPECT_FALSE(eltero.load());
+        sz.olvas([](const SzervizNyilvantartoRendszer& d) {
+            EXPECT_TRUE(d.szarmaztatottAdatokFrissek());
+            EXPECT_EQ(fromSizetToUnsigned(d.getAutok().size()), 80u);
+            EXPECT_EQ(d.getUgyfelOsszesito("Friss Ferenc").koltes, 5000LL * 53);
+        });
+    } END
+
+    TEST(Pillanatkep, ValtozatokSzerkezetmegosztassal) {
+        // A perzisztens vektor: a regi valtozat valtozatlan, a nem erintett elemek megosztva
+        PerzisztensVektor<int> v0;
+        for (int i = 0; i < 1100; i++)
+            v0 = v0.hozzafuz(std::shared_ptr<const int>(new int(i)));
+        PerzisztensVektor<int> v1 = v0.csere(1050, std::shared_ptr<const int>(new int(-1)));
+        PerzisztensVektor<int> v2 = v1.torol(0);
+        EXPECT_EQ(v0[1050], 1050);
+        EXPECT_EQ(v1[1050], -1);
+        EXPECT_EQ(fromSizetToUnsigned(v2.size()), 1099u);
+        EXPECT_EQ(v2[1049], -1);
+        EXPECT_TRUE(&v0[7] == &v1[7] && &v1[8] == &v2[7]);
+        long osszeg = 0;
+        v0.bejar([&osszeg](int x) { osszeg += x; });
+        EXPECT_EQ(osszeg, 1099L * 1100L / 2L);
+
+        // Torles sirkovel: minden harmadik elem kiesik, a sorrend es a regi valtozat megmarad
+        PerzisztensVektor<int> v3 = v0;
+        for (int i = 1098; i >= 0; i -= 3)
+            v3 = v3.torol(static_cast<size_t>(i));
+        v3 = v3.hozzafuz(std::shared_ptr<const int>(new int(5000)));
+        EXPECT_EQ(fromSizetToUnsigned(v3.size()), 734u);
+        EXPECT_EQ(v3[0], 1);
+        EXPECT_EQ(v3[1], 2);
+        EXPECT_EQ(v3[732], 1099);
+        EXPECT_EQ(v3[733], 5000);
+        EXPECT_TRUE(&v3[1] == &v0[2]);
+        std::vector<int> bejart;
+        v3.bejar([&bejart](int x) { bejart.push_back(x); });
+        bool egyezik = bejart.size() == v3.size();
+        for (size_t i = 0; egyezik && i < bejart.size(); i++)
+            egyezik = bejart[i] == v3[i];
+        EXPECT_TRUE(egyezik);
+        EXPECT_EQ(v0[1098], 1098);
+
+        // Tomorites: a sirkovek tulsulya utan is ugyanazok az elemek
+        PerzisztensVektor<int> v4 = v0;
+        for (int i = 0; i < 1000; i++)
+            v4 = v4.torol(0);
+        EXPECT_EQ(fromSizetToUnsigned(v4.size()), 100u);
+        EXPECT_EQ(v4[0], 1000);
+        EXPECT_EQ(v4[99], 1099);
+        for (int i = 0; i < 100; i++)
+            v4 = v4.torol(0);
+        EXPECT_TRUE(v4.empty());
+
+        SzalbiztosNyilvantarto sz;
+        sz.ujUgyfel(Ugyfel("Nagy Bence", "+36 20 123 4567", "nagy.bence@gmail.com"));
+        sz.ujAuto(Auto("SNP001", "Ford", "Focus", 50000, Datum(2016, 1, 1), SzervizRekordLista(), nullptr), "Nagy Bence");
+        sz.ujAuto(Auto("SNP002", "Ford", "Fiesta", 30000, Datum(2018, 1, 1), SzervizRekordLista(), nullptr), "Nagy Bence");
+
+        // A riport pillanatkepe nem latja a kesobbi irasokat
+        std::shared_ptr<const Pillanatkep> regi = sz.pillanatkep();
+        sz.rogzitesVegzettMuvelet("SNP001", SzervizRekord(MuveletTipus::Javitas, "Fekcsere", Datum(2024, 3, 1), 60000, 51000));
+        sz.frissitUgyfel(Ugyfel("Nagy Bence", "+36 20 999 9999", "nagy.bence@gmail.com"));
+        sz.torolAuto("SNP002");
+        std::shared_ptr<const Pillanatkep> uj = sz.pillanatkep();
+
+        EXPECT_EQ(fromSizetToUnsigned(regi->autokSzama()), 2u);
+        EXPECT_EQ(fromSizetToUnsigned(regi->getAuto(0).getSzervizRekordok().size()), 0u);
+        EXPECT_EQ(regi->getAuto(0).getTulajdonos()->getTelefonszam(), "+36 20 123 4567");
+        EXPECT_EQ(fromSizetToUnsigned(uj->autokSzama()), 1u);
+        EXPECT_EQ(fromSizetToUnsigned(uj->getAuto(0).getSzervizRekordok().size()), 1u);
+        EXPECT_EQ(uj->getAuto(0).getTulajdonos()->getTelefonszam(), "+36 20 999 9999");
+        EXPECT_TRUE(uj->getVerzio() > regi->getVerzio());
+
+        // A pillanatkep mentese ugyanazt a fajlt adja, mint a rendszer mentese
+        sz.mentesFajlba("pillanatkep_auo.txt");
+        sz.olvas([](const SzervizNyilvantartoRendszer& d) { d.mentesFajlba("rendszer_auo.txt"); });
+        std::ifstream f1("pillanatkep_auo.txt"), f2("rendszer_auo.txt");
+        std::string s1((std::istreambuf_iterator<char>(f1)), std::istreambuf_iterator<char>());
+        std::string s2((std::istreambuf_iterator<char>(f2)), std::istreambuf_iterator<char>());
+        EXPECT_TRUE(!s1.empty() && s1 == s2);
+        f1.close();
+        f2.close();
+        std::remove("pillanatkep_auo.txt");
+        std::remove("rendszer_auo.txt");
+
+        // Ugyfel frissitese es torlese: csak az o autoi valtoznak, a pillanatkep a rendszerrel egyezik
+        sz.ujUgyfel(Ugyfel("Kiss Anna", "+36 30 111 2222", "kiss.anna@gmail.com"));
+        sz.ujAuto(Auto("SNP003", "Opel", "Astra", 10000, Datum(2019, 1, 1), SzervizRekordLista(), nullptr), "Kiss Anna");
+        sz.ujAuto(Auto("SNP004", "Ford", "Ka", 20000, Datum(2019, 1, 1), SzervizRekordLista(), nullptr), "Nagy Bence");
+        sz.ujAuto(Auto("SNP005", "Opel", "Corsa", 30000, Datum(2019, 1, 1), SzervizRekordLista(), nullptr), "Kiss Anna");
+        sz.frissitUgyfel(Ugyfel("Kiss Anna", "+36 30 333 4444", "kiss.anna@gmail.com"));
+        std::shared_ptr<const Pillanatkep> frissitett = sz.pillanatkep();
+        EXPECT_EQ(frissitett->getAuto(1).getTulajdonos()->getTelefonszam(), "+36 30 333 4444");
+        EXPECT_EQ(frissitett->getAuto(3).getTulajdonos()->getTelefonszam(), "+36 30 333 4444");
+        EXPECT_EQ(frissitett->getAuto(2).getTulajdonos()->getTelefonszam(), "+36 20 999 9999");
+
+        EXPECT_TRUE(sz.torolUgyfel("Nagy Bence"));
+        std::shared_ptr<const Pillanatkep> torolt = sz.pillanatkep();
+        EXPECT_EQ(fromSizetToUnsigned(torolt->autokSzama()), 2u);
+        EXPECT_EQ(fromSizetToUnsigned(torolt->ugyfelekSzama()), 1u);
+        EXPECT_EQ(torolt->getAuto(0).getRendszam(), "SNP003");
+        EXPECT_EQ(torolt->getAuto(1).getRendszam(), "SNP005");
+        EXPECT_FALSE(sz.vanAuto("SNP001") || sz.vanAuto("SNP004"));
+        EXPECT_TRUE(sz.vanAuto("SNP005"));
+        EXPECT_EQ(fromSizetToUnsigned(frissitett->autokSzama()), 4u);
+        sz.olvas([](const SzervizNyilvantartoRendszer& d) {
+            EXPECT_EQ(fromSizetToUnsigned(d.autoSorszam("SNP005")), 1u);
+            EXPECT_EQ(fromSizetToUnsigned(d.tulajdonosAutoSorszamai("Kiss Anna").size()), 2u);
+            EXPECT_EQ(fromSizetToUnsigned(d.tulajdonosAutoSorszamai("Kiss Anna")[1]), 1u);
+            EXPECT_EQ(fromSizetToUnsigned(d.ugyfelSorszam("Kiss Anna")), 0u);
+            EXPECT_TRUE(d.getAutok()[1].getTulajdonos() == &d.getUgyfelek()[0]);
+        });
+        sz.mentesFajlba("pillanatkep_auo.txt");
+        sz.olvas([](const SzervizNyilvantartoRendszer& d) { d.mentesFajlba("rendszer_auo.txt"); });
+        std::ifstream f3("pillanatkep_auo.txt"), f4("rendszer_auo.txt");
+        std::string s3((std::istreambuf_iterator<char>(f3)), std::istreambuf_iterator<char>());
+        std::string s4((std::istreambuf_iterator<char>(f4)), std::istreambuf_iterator<char>());
+        EXPECT_TRUE(!s3.empty() && s3 == s4);
+        f3.close();
+        f4.close();
+        std::remove("pillanatkep_auo.txt");
+        std::remove("rendszer_auo.txt");
+    } END
+
+    TEST(Szerver, SoralapuProtokollEsPipelining) {
+        SzervizNyilvantartoRendszer tdb;
+        tdb.ujUgyfel(Ugyfel("Kiss Anna", "+36 30 111 2222", "kiss.anna@gmail.com"));
+
+        // A vegrehajto kozvetlenul: OK/ERR valaszok, mezoszam es szamformatum ellenorzes
+        ParancsVegrehajto pv(tdb);
+        std::string ki;
+        EXPECT_TRUE(pv.vegrehajt("auto_uj\tSRV001\tOpel\tAstra\t80000\t2015.05.05\tKiss Anna\r\n", ki));
+        EXPECT_FALSE(pv.vegrehajt("km\tSRV001\t79000", ki));
+        EXPECT_FALSE(pv.vegrehajt("km\tSRV001\tsok", ki));
+        EXPECT_FALSE(pv.vegrehajt("auto_torol", ki));
+        EXPECT_TRUE(pv.vegrehajt("", ki));
+        EXPECT_EQ(ki, std::string("OK 0\nERR A km ora allasa nem csokkenhet!\nERR Hibas km: sok\nERR Hibas mezoszam: auto_torol\n"));
+
+#ifdef __linux__
+        // Szerver Unix socketen: egy irasban kuldott, egymasra varas nelkuli keresek
+        const std::string ut = "/tmp/szerviz_teszt_" + std::to_string(getpid()) + ".sock";
+        Szerver szerver(tdb);
+        szerver.figyel("unix:" + ut);
+        std::thread hurok([&szerver]() { szerver.futtat(); });
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un cim;
+        std::memset(&cim, 0, sizeof(cim));
+        cim.sun_family = AF_UNIX;
+        std::strcpy(cim.sun_path, ut.c_str());
+        EXPECT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&cim), sizeof(cim)), 0);
+        const std::string keresek =
+            "ping\n"
+            "szerviz\tSRV001\tJ\t2024.06.01\tKuplung\t150000\t82000\n"
+            "km\tSRV001\t83000\n"
+            "auto\tSRV001\n"
+            "ugyfel_torol\tNincs Ilyen\n"
+            "keres\tauto\tmarka = \"Opel\"\n";
+        EXPECT_EQ(write(fd, keresek.data(), keresek.size()), static_cast<ssize_t>(keresek.size()));
+        shutdown(fd, SHUT_WR);
+        std::string valasz;
+        char puffer[4096];
+        ssize_t n;
+        while ((n = read(fd, puffer, sizeof(puffer))) > 0) valasz.append(puffer, static_cast<size_t>(n));
+        close(fd);
+        szerver.leallit();
+        hurok.join();
+
+        EXPECT_EQ(valasz, std::string(
+            "OK 0\nOK 0\nOK 0\n"
+            "OK 2\nSRV001\tOpel\tAstra\t83000\t2015.05.05\tKiss Anna\n"
+            "J\t2024.06.01\tKuplung\t150000\t82000\t0\n"
+            "ERR Nincs ilyen nevu ugyfel!\n"
+            "OK 1\nSRV001\n"));
+        EXPECT_EQ(tdb.keresAuto("SRV001").getKmOra(), 83000);
+        EXPECT_EQ(access(ut.c_str(), F_OK), 0);
+        EXPECT_THROW(Szerver(tdb).figyel("192.168.1.1:7070"), const std::invalid_argument&);
+#endif
+    } END
+
+    TEST(ParancsVegrehajto, KotegekEsCsoportosNaploiras) {
+        std::remove("teszt_naplo.txt");
+        std::string ki;
+        {
+            SzervizNyilvantartoRendszer tdb;
+            tdb.ujUgyfel(Ugyfel("Kovacs Bela", "+36 70 555 1234", "kovacs.bela@gmail.com"));
+            Naplo naplo("teszt_naplo.txt");
+            ParancsVegrehajto pv(tdb);
+            pv.setNaplo(&naplo);
+
+            // Egy koteg (benne egy hibas parancs), utana egy kulon keres es egy befejezetlen koteg
+            const std::string adat =
+                "batch\t3\n"
+                "auto_uj\tBAT001\tSkoda\tOctavia\t120000\t2017.03.01\tKovacs Bela\n"
+                "szerviz\tBAT001\tK\t2024.09.01\tOlajcsere\t35000\t121000\n"
+                "szerviz\tNINCS1\tK\t2024.09.01\tOlajcsere\t35000\t1000\n"
+                "km\tBAT001\t125000\n"
+                "batch\t2\n"
+                "km\tBAT001\t126000\n";
+            const size_t feldolgozott = pv.feldolgoz(adat.data(), adat.size(), ki);
+            EXPECT_EQ(ki, std::string("OK 3\nOK 0\nOK 0\nERR Nincs ilyen rendszamu auto!\nOK 0\n"));
+            EXPECT_EQ(adat.substr(feldolgozott), std::string("batch\t2\nkm\tBAT001\t126000\n"));
+            EXPECT_EQ(fromSizetToUnsigned(naplo.getIrasok()), 1u);
+
+            // A koteg befejezese (masodik parancsa egy lekerdezes, ami nem naplozodik): ujabb egyetlen iras
+            const std::string maradek = adat.substr(feldolgozott) + "auto\tBAT001\n";
+            ki.clear();
+            EXPECT_EQ(pv.feldolgoz(maradek.data(), maradek.size(), ki), maradek.size());
+            EXPECT_EQ(ki, std::string("OK 4\nOK 0\nOK 2\nBAT001\tSkoda\tOctavia\t126000\t2017.03.01\tKovacs Bela\n"
+                                      "K\t2024.09.01\tOlajcsere\t35000\t121000\t0\n"));
+            EXPECT_EQ(fromSizetToUnsigned(naplo.getIrasok()), 2u);
+
+            ki.clear();
+            const std::string hibas = "batch\t0\nbatch\n";
+            pv.feldolgoz(hibas.data(), hibas.size(), ki);
+            EXPECT_EQ(ki, std::string("ERR Hibas kotegmeret: 0\nERR A kotegfejlec csak onallo keretkent kuldheto\n"));
+            EXPECT_EQ(fromSizetToUnsigned(naplo.getIrasok()), 2u);
+        }
+
+        // A naplo visszajatszasa ugyanazt az allapotot allitja elo
+        SzervizNyilvantartoRendszer ujra;
+        ujra.ujUgyfel(Ugyfel("Kovacs Bela", "+36 70 555 1234", "kovacs.bela@gmail.com"));
+        ParancsVegrehajto pv2(ujra);
+        EXPECT_EQ(fromSizetToUnsigned(Naplo::visszajatszas("teszt_naplo.txt", pv2)), 4u);
+        EXPECT_EQ(ujra.keresAuto("BAT001").getKmOra(), 126000);
+        EXPECT_EQ(fromSizetToUnsigned(ujra.keresAuto("BAT001").getSzervizRekordok().size()), 1u);
+        std::remove("teszt_naplo.txt");
+    } END
+
+    TEST(Naplo, ImportHatasaTiltottBetoltesEsEllenorzopont) {
+        std::remove("teszt_naplo.txt");
+        {
+            std::ofstream csv("teszt_import.csv");
+            csv << "JRN001,K,2024.05.01,Olajcsere,30000,101000\n"
+                << "JRN001,V,2024.06.01,Muszaki vizsga,25000,104000,1\n"
+                << "JRN001,J,2024.07.01,\"Fek\tcsere\",1000,105000\n";
+        }
+        SzervizNyilvantartoRendszer tdb;
+        tdb.ujUgyfel(Ugyfel("Kovacs Bela", "+36 70 555 1234", "kovacs.bela@gmail.com"));
+        tdb.ujAuto(Auto("JRN001", "Skoda", "Fabia", 100000, Datum(2015, 1, 1), SzervizRekordLista(), &tdb.keresUgyfel("Kovacs Bela")));
+        tdb.mentesFajlba("teszt_alap_ufl.txt");
+        tdb.mentesFajlba("teszt_alap_auo.txt");
+        {
+            Naplo naplo("teszt_naplo.txt", "teszt_alap_ufl.txt", "teszt_alap_auo.txt");
+            ParancsVegrehajto pv(tdb);
+            pv.setNaplo(&naplo);
+            std::string ki;
+            pv.vegrehajt("szerviz_import\tteszt_import.csv", ki);
+            EXPECT_EQ(ki, std::string("OK 2\n2\t1\n3\tHibas leiras: Fek\tcsere\n"));
+            ki.clear();
+            EXPECT_FALSE(pv.vegrehajt("betoltes\tteszt_alap_auo.txt", ki));
+            EXPECT_EQ(ki, std::string("ERR Naplozas mellett nem hasznalhato: betoltes\n"));
+        }
+
+        // A naploban a hatas van, nem a fajlnev: a CSV nelkul is visszajatszhato
+        std::remove("teszt_import.csv");
+        {
+            SzervizNyilvantartoRendszer ujra;
+            ujra.betoltesFajlbol("teszt_alap_ufl.txt");
+            ujra.betoltesFajlbol("teszt_alap_auo.txt");
+            ParancsVegrehajto pv2(ujra);
+            EXPECT_EQ(fromSizetToUnsigned(Naplo::visszajatszas("teszt_naplo.txt", pv2)), 3u);
+            EXPECT_EQ(fromSizetToUnsigned(pv2.getHibak()), 0u);
+            const Auto& a = static_cast<const SzervizNyilvantartoRendszer&>(ujra).keresAuto("JRN001");
+            EXPECT_EQ(fromSizetToUnsigned(a.getSzervizRekordok().size()), 2u);
+            EXPECT_EQ(a.getKmOra(), 104000);
+            EXPECT_TRUE(a.getSzervizRekordok()[1].sikeres);
+        }
+
+        // Ellenorzopont: csak ha az utolso modositas ota mindket indulo fajl mentese megtortent
+        {
+            Naplo naplo("teszt_naplo.txt", "teszt_alap_ufl.txt", "teszt_alap_auo.txt");
+            ParancsVegrehajto pv(tdb);
+            pv.setNaplo(&naplo);
+            std::string ki;
+            pv.vegrehajt("mentes\tteszt_alap_ufl.txt", ki);
+            pv.vegrehajt("km\tJRN001\t110000", ki);
+            pv.vegrehajt("mentes\tteszt_alap_auo.txt", ki);
+            std::ifstream f1("teszt_naplo.txt", std::ios::binary | std::ios::ate);
+            EXPECT_TRUE(static_cast<long long>(f1.tellg()) > 0);
+            pv.vegrehajt("mentes\tteszt_alap_ufl.txt", ki);
+            std::ifstream f2("teszt_naplo.txt", std::ios::binary | std::ios::ate);
+            EXPECT_EQ(static_cast<long long>(f2.tellg()), 0LL);
+            EXPECT_EQ(ki, std::string("OK 0\nOK 0\nOK 0\nOK 0\n"));
+        }
+        SzervizNyilvantartoRendszer ujra;
+        ujra.betoltesFajlbol("teszt_alap_ufl.txt");
+        ujra.betoltesFajlbol("teszt_alap_auo.txt");
+        ParancsVegrehajto pv3(ujra);
+        EXPECT_EQ(fromSizetToUnsigned(Naplo::visszajatszas("teszt_naplo.txt", pv3)), 0u);
+        EXPECT_EQ(ujra.keresAuto("JRN001").getKmOra(), 110000);
+        EXPECT_EQ(fromSizetToUnsigned(ujra.keresAuto("JRN001").getSzervizRekordok().size()), 2u);
+
+        // A mentesi formatum hataroloit tartalmazo szovegmezok elutasitasa; a mentes ideiglenes fajlon at tortenik
+        {
+            ParancsVegrehajto pv(ujra);
+            std::string ki;
+            EXPECT_FALSE(pv.vegrehajt("szerviz\tJRN001\tJ\t2024.08.01\tfek-csere, 2; olaj\t1000\t111000", ki));
+            EXPECT_FALSE(pv.vegrehajt("szerviz\tJRN001\tJ\t2024.08.01\tfek:csere\t1000\t111000", ki));
+            EXPECT_FALSE(pv.vegrehajt("szerviz\tJRN001\tJ\t2024.08.01\t\t1000\t111000", ki));
+            EXPECT_FALSE(pv.vegrehajt("szerviz\tJRN001\tJ\t2024.08.1x\tfek csere\t1000\t111000", ki));
+            EXPECT_FALSE(pv.vegrehajt("ugyfel_uj\tNagy_Anna\t+36 1\ta@b.hu", ki));
+            EXPECT_FALSE(pv.vegrehajt("ugyfel_frissit\tKovacs Bela\t+36-1\ta@b.hu", ki));
+            EXPECT_FALSE(pv.vegrehajt("auto_uj\tJRN002\tSkoda\tFabia-RS\t0\t2020.01.01\tKovacs Bela", ki));
+            EXPECT_FALSE(pv.vegrehajt("auto_uj\tJR-002\tSkoda\tFabia\t0\t2020.01.01\tKovacs Bela", ki));
+            EXPECT_EQ(fromSizetToUnsigned(pv.getHibak()), 8u);
+            ki.clear();
+            EXPECT_TRUE(pv.vegrehajt("ugyfel_uj\tNagy Anna\t+36 1 234\tnagy_anna-1@b.hu", ki));
+            EXPECT_TRUE(pv.vegrehajt("szerviz\tJRN001\tJ\t2024.08.01\tfek csere\t1000\t111000", ki));
+            EXPECT_TRUE(pv.vegrehajt("mentes\tteszt_alap_ufl.txt", ki));
+            EXPECT_TRUE(pv.vegrehajt("mentes\tteszt_alap_auo.txt", ki));
+            EXPECT_FALSE(static_cast<bool>(std::ifstream("teszt_alap_auo.txt.tmp")));
+            SzervizNyilvantartoRendszer vissza;
+            vissza.betoltesFajlbol("teszt_alap_ufl.txt");
+            vissza.betoltesFajlbol("teszt_alap_auo.txt");
+            EXPECT_EQ(vissza.keresUgyfel("Nagy Anna").getEmail(), std::string("nagy_anna-1@b.hu"));
+            EXPECT_EQ(vissza.keresAuto("JRN001").getSzervizRekordok()[2].muvelet, std::string("fek csere"));
+            // Ismeretlen kiterjesztes: a celfajl nem nyilik meg, igy nem is csonkolodik
+            { std::ofstream m("teszt_alap.txt"); m << "x"; }
+            EXPECT_THROW(vissza.mentesFajlba("teszt_alap.txt"), const std::invalid_argument&);
+            std::ifstream m("teszt_alap.txt", std::ios::binary | std::ios::ate);
+            EXPECT_EQ(static_cast<long long>(m.tellg()), 1LL);
+        }
+        std::remove("teszt_alap.txt");
+        std::remove("teszt_naplo.txt");
+        std::remove("teszt_alap_ufl.txt");
+        std::remove("teszt_alap_auo.txt");
+    } END
+
+    TEST(SzalKeszlet, MunkalopasRedukcioEsParhuzamosBetoltes) {
+        SzalKeszlet keszlet(3);
+
+        // Redukcio: osszeg, es nem kommutativ osszefuzes, ami csak darabsorrendben jo
+        const long long osszeg = keszlet.parhuzamosRedukcio(100000, 0LL, [](size_t tol, size_t ig) {
+            long long r = 0;
+            for (size_t i = tol; i < ig; i++) r += static_cast<long long>(i);
+            return r;
+        }, [](long long a, long long b) { return a + b; }, 100);
+        EXPECT_EQ(osszeg, 99999LL * 100000LL / 2LL);
+        const std::string sorrend = keszlet.parhuzamosRedukcio(500, std::string(), [](size_t tol, size_t ig) {
+            std::string r;
+            for (size_t i = tol; i < ig; i++) r += static_cast<char>('a' + i % 26);
+            return r;
+        }, [](std::string a, const std::string& b) { a += b; return a; }, 7);
+        std::string vart;
+        for (size_t i = 0; i < 500; i++) vart += static_cast<char>('a' + i % 26);
+        EXPECT_EQ(sorrend, vart);
+
+        // Egymasba agyazott hivasok: a belso darabokat a tobbi szal ellophatja, nem akad el
+        std::atomic<int> szamlalo(0);
+        keszlet.parhuzamosFor(8, [&](size_t tol, size_t ig) {
+            for (size_t k = tol; k < ig; k++)
+                keszlet.parhuzamosFor(1000, [&](size_t a, size_t b) { szamlalo += static_cast<int>(b - a); }, 10);
+        }, 1);
+        EXPECT_EQ(szamlalo.load(), 8000);
+
+        // Vector segedfuggvenyek
+        Vector<int> v;
+        for (int i = 0; i < 10000; i++) v.push_back(i);
+        keszlet.parhuzamosMinden(v, [](int& x) { x *= 2; });
+        const long long ketszeres = keszlet.parhuzamosRedukcio(static_cast<const Vector<int>&>(v), 0LL,
+            [](const int& x) { return static_cast<long long>(x); }, [](long long a, long long b) { return a + b; });
+        EXPECT_EQ(ketszeres, 9999LL * 10000LL);
+
+        // Nagy fajl betoltese es mentese a kozos keszleten: a mentes bajtra azonos a bemenettel
+        {
+            std::ofstream u("nagy_ufl.txt"), a("nagy_auo.txt");
+            u << "Teszt_Elek-+36_1_234_5678-teszt.elek@gmail.com\n";
+            for (int i = 0; i < 3000; i++) {
+                a << "NGY" << std::setw(4) << std::setfill('0') << i << "-Opel-Astra-" << 100000 + i << "-2015.01.01-";
+                if (i % 3 == 0) a << "nincs";
+                else a << "K:olaj_csere," << 2020 + i % 5 << ".01.0" << 1 + i % 9 << ",30000," << 90000 + i;
+                a << "-Teszt_Elek\n";
+            }
+        }
+        SzervizNyilvantartoRendszer nagy;
+        nagy.betoltesFajlbol("nagy_ufl.txt");
+        nagy.betoltesFajlbol("nagy_auo.txt");
+        EXPECT_EQ(fromSizetToUnsigned(nagy.getAutok().size()), 3000u);
+        EXPECT_EQ(nagy.getAutok()[2999].getRendszam(), "NGY2999");
+        EXPECT_TRUE(nagy.getAutok()[1500].getTulajdonos() == &nagy.keresUgyfel("Teszt Elek"));
+        nagy.mentesFajlba("nagy2_auo.txt");
+        std::ifstream f1("nagy_auo.txt"), f2("nagy2_auo.txt");
+        std::string s1((std::istreambuf_iterator<char>(f1)), std::istreambuf_iterator<char>());
+        std::string s2((std::istreambuf_iterator<char>(f2)), std::istreambuf_iterator<char>());
+        EXPECT_TRUE(!s1.empty() && s1 == s2);
+        f1.close();
+        f2.close();
+
+        // Egy hibas sor eseten a fajlbol semmi sem kerul be
+        {
+            std::ofstream a("nagy_auo.txt", std::ios::app);
+            a << "HIBAS1-Opel-Astra-sok-2015.01.01-nincs-Teszt_Elek\n";
+        }
+        EXPECT_THROW(nagy.betoltesFajlbol("nagy_auo.txt"), const std::invalid_argument&);
+        EXPECT_EQ(fromSizetToUnsigned(nagy.getAutok().size()), 3000u);
+        std::remove("nagy_ufl.txt");
+        std::remove("nagy_auo.txt");
+        std::remove("nagy2_auo.txt");
+    } END
+
+    TEST(ParticionaltNyilvantarto, SzeletenkentiIrokEsKaszkadTorles) {
+        EXPECT_THROW(ParticionaltNyilvantarto(0), const std::invalid_argument&);
+        ParticionaltNyilvantarto p(4);
+        EXPECT_TRUE(p.ujUgyfel(Ugyfel("Kovacs Anna", "+36 30 555 6666", "kovacs.anna@gmail.com")));
+        EXPECT_TRUE(p.ujUgyfel(Ugyfel("Szabo Bela", "+36 20 111 2222", "szabo.bela@gmail.com")));
+        EXPECT_FALSE(p.ujAuto(Auto("SHD000", "Opel", "Astra", 1000, Datum(2020, 1, 1), SzervizRekordLista(), nullptr), "Nincs Ilyen"));
+
+        // Negy iro parhuzamosan, mindegyik a sajat autoit modositja (a rendszamok tobb szeletbe esnek)
+        std::vector<std::thread> irok;
+        for (int t = 0; t < 4; t++) {
+            irok.push_back(std::thread([&p, t]() {
+                const std::string tulaj = t % 2 == 0 ? "Kovacs Anna" : "Szabo Bela";
+                for (int i = 0; i < 25; i++) {
+                    const std::string r = "SH" + std::to_string(t) + std::to_string(100 + i);
+                    p.ujAuto(Auto(r, "Skoda", "Fabia", 1000, Datum(2015, 1, 1), SzervizRekordLista(), nullptr), tulaj);
+                    for (int k = 1; k <= 4; k++) {
+                        p.frissitKmOra(r, 1000 + k * 500);
+                        p.rogzitesVegzettMuvelet(r, SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2016 + k, 1, 1), 1000, 1000 + k * 500));
+                    }
+                }
+            }));
+        }
+        // Olvasok mar az elso irasok elott is (az ures szeletek indexe sem epulhet az olvasasi zar alatt)
+        std::atomic<int> talalt(0);
+        for (int t = 0; t < 2; t++) {
+            irok.push_back(std::thread([&p, &talalt, t]() {
+                Auto a;
+                for (int i = 0; i < 200; i++) {
+                    const std::string r = "SH" + std::to_string((i + t) % 4) + std::to_string(100 + i % 25);
+                    if (p.vanAuto(r) && p.keresAuto(r, a)) talalt++;
+                }
+            }));
+        }
+        for (size_t t = 0; t < irok.size(); t++)
+            irok[t].join();
+        EXPECT_TRUE(talalt.load() <= 400);
+        EXPECT_EQ(fromSizetToUnsigned(p.autokSzama()), 100u);
+        std::vector<bool> hasznalt(p.getSzeletekSzama(), false);
+        for (int t = 0; t < 4; t++)
+            for (int i = 0; i < 25; i++)
+                hasznalt[p.szeletIndex("SH" + std::to_string(t) + std::to_string(100 + i))] = true;
+        EXPECT_EQ(static_cast<int>(std::count(hasznalt.begin(), hasznalt.end(), true)), 4);
+
+        Auto a;
+        Ugyfel u;
+        EXPECT_TRUE(p.keresAuto("SH1107", a, &u));
+        EXPECT_EQ(a.getKmOra(), 3000);
+        EXPECT_EQ(fromSizetToUnsigned(a.getSzervizRekordok().size()), 4u);
+        EXPECT_EQ(u.getNev(), "Szabo Bela");
+        EXPECT_TRUE(a.getTulajdonos() == nullptr);
+
+        // Az ugyfel frissitese minden szeletbeli masolatba eljut
+        EXPECT_TRUE(p.frissitUgyfel(Ugyfel("Szabo Bela", "+36 70 999 0000", "bela@example.com")));
+        EXPECT_TRUE(p.keresAuto("SH3100", a, &u));
+        EXPECT_EQ(u.getEmail(), "bela@example.com");
+
+        // Mentes es visszatoltes: ugyanannyi auto, az adatok megmaradnak
+        p.mentesFajlba("szelet_ufl.txt");
+        p.mentesFajlba("szelet_auo.txt");
+        ParticionaltNyilvantarto q(3);
+        q.betoltesFajlbol("szelet_ufl.txt");
+        q.betoltesFajlbol("szelet_auo.txt");
+        EXPECT_EQ(fromSizetToUnsigned(q.autokSzama()), 100u);
+        EXPECT_TRUE(q.keresAuto("SH1107", a, &u));
+        EXPECT_EQ(a.getKmOra(), 3000);
+        EXPECT_EQ(u.getTelefonszam(), "+36 70 999 0000");
+        std::remove("szelet_ufl.txt");
+        std::remove("szelet_auo.txt");
+
+        // A kaszkad torles minden szeletbol eltavolitja az ugyfel autoit
+        EXPECT_TRUE(p.torolUgyfel("Kovacs Anna"));
+        EXPECT_FALSE(p.torolUgyfel("Kovacs Anna"));
+        EXPECT_FALSE(p.vanUgyfel("Kovacs Anna"));
+        EXPECT_EQ(fromSizetToUnsigned(p.autokSzama()), 50u);
+        EXPECT_FALSE(p.vanAuto("SH0100"));
+        EXPECT_FALSE(p.vanAuto("SH2124"));
+        EXPECT_TRUE(p.vanAuto("SH1124"));
+        EXPECT_TRUE(p.flottaFigyelmeztetesek().size() > 0);
+    } END
+
+    TEST(ParancsVegrehajto, HibakSzamlalasaKotegeltModban) {
+        SzervizNyilvantartoRendszer db;
+        ParancsVegrehajto pv(db);
+        const std::string be = "ugyfel_uj\tKiss Pal\t+36 1 111\tkiss@pal.hu\n"
+                               "auto_uj\tKTG001\tOpel\tAstra\t1000\t2020.01.01\tKiss Pal\n"
+                               "km\tKTG001\t500\n"
+                               "batch\t3\nkm\tKTG001\t2000\n\nismeretlen\n"
+                               "batch\tsok\n"
+                               "ping";
+        std::string ki;
+        const size_t n = pv.feldolgoz(be.data(), be.size(), ki);
+        // A lezaratlan utolso sor megmarad a kovetkezo olvasasig
+        EXPECT_EQ(fromSizetToUnsigned(n), fromSizetToUnsigned(be.size() - 4));
+        EXPECT_EQ(fromSizetToUnsigned(pv.getHibak()), 4u);
+        EXPECT_EQ(ki.substr(0, 18), std::string("OK 0\nOK 0\nERR A km"));
+        EXPECT_TRUE(ki.find("OK 3\nOK 0\nERR Ures parancs\nERR ") != std::string::npos);
+        EXPECT_TRUE(ki.find("ERR Hibas kotegmeret: sok\n") != std::string::npos);
+        EXPECT_EQ(db.keresAuto("KTG001").getKmOra(), 2000);
+
+        ki.clear();
+        EXPECT_EQ(fromSizetToUnsigned(pv.feldolgoz("ping\n", 5, ki)), 5u);
+        EXPECT_EQ(ki, std::string("OK 0\n"));
+        EXPECT_EQ(fromSizetToUnsigned(pv.getHibak()), 4u);
+    } END
+
+    TEST(SzervizImport, CsvTomegesEllenorzesEsHozzafuzes) {
+        SzervizNyilvantartoRendszer db;
+        db.ujUgyfel(Ugyfel("Kiss Pal", "+36 1 111", "kiss@pal.hu"));
+        SzervizRekordLista l;
+        l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 1, 10), 20000, 50000));
+        db.ujAuto(Auto("CSV001", "Opel", "Astra", 50000, Datum(2015, 1, 1), l, &db.keresUgyfel("Kiss Pal")));
+        db.ujAuto(Auto("CSV002", "Skoda", "Fabia", 1000, Datum(2023, 1, 1), SzervizRekordLista(), &db.keresUgyfel("Kiss Pal")));
+        EXPECT_EQ(fromSizetToUnsigned(db.getEmlekezteto().meret()), 1u);
+
+        std::istringstream csv("rendszam,tipus,datum,leiras,ar,km,sikeres\r\n"
+                               "CSV001,J,2024.06.01,Fekbetet csere,45000,61000\n"       // 2: a datum szerinti sorrendben a masodik
+                               "CSV001,K,2024.03.01, \"Szuro es \"\"olaj\"\"\" ,30000,55000\n" // 3: idezojeles mezo
+                               "CSV001,V,2024.05.01,Muszaki vizsga,25000,54000,1\n"      // 4: km visszaesett
+                               "CSV001,K,2023.12.01,Korabbi,1000,49000\n"                // 5: a meglevo rekordnal korabbi
+                               "abc123,J,2024.01.01,Rossz rendszam,1,1\n"                // 6
+                               "XYZ999,J,2024.01.01,Nincs ilyen,1,1\n"                   // 7
+                               "CSV002,V,2024.02.30,Nem letezo nap,1,9500\n"             // 8: nem fordulhat at 03.01-re
+                               "\n"
+                               "CSV002,V,2024.02.01,Muszaki vizsga,20000,9000,1\n"       // 10
+                               "CSV002,X,2024.02.01,Ismeretlen,1,1\n"                    // 11
+                               "CSV002,J,2024.02.01,\"Lezaratlan,1,1\n");                // 12
+        const ImportEredmeny e = db.szervizImportCsv(csv);
+        EXPECT_EQ(fromSizetToUnsigned(e.rogzitett), 3u);
+        EXPECT_EQ(fromSizetToUnsigned(e.hibak.size()), 7u);
+        const size_t vartSorok[] = { 4, 5, 6, 7, 8, 11, 12 };
+        for (size_t i = 0; i < e.hibak.size() && i < 7; i++)
+            EXPECT_EQ(fromSizetToUnsigned(e.hibak[i].sor), fromSizetToUnsigned(vartSorok[i]));
+        EXPECT_EQ(e.hibak[0].indok, std::string("A km ora allasa nem csokkenhet: 54000 < 55000"));
+        EXPECT_EQ(e.hibak[4].indok, std::string("Hibas datum: 2024.02.30"));
+
+        const Auto& a = db.keresAuto("CSV001");
+        EXPECT_EQ(fromSizetToUnsigned(a.getSzervizRekordok().size()), 3u);
+        EXPECT_EQ(a.getSzervizRekordok()[1].muvelet, std::string("Szuro es \"olaj\""));
+        EXPECT_EQ(a.getSzervizRekordok()[2].akt_kmOra, 61000);
+        EXPECT_EQ(a.getKmOra(), 61000);
+        EXPECT_EQ(db.keresAuto("CSV002").getKmOra(), 9000);
+        EXPECT_TRUE(db.keresAuto("CSV002").getSzervizRekordok()[0].sikeres);
+
+        // A szarmaztatott adatok az import utan egyszer, a kovetkezo lekereskor epulnek ujra
+        EXPECT_EQ(fromSizetToUnsigned(db.getEsemenyTar().meret()), 4u);
+        EXPECT_EQ(db.getUgyfelOsszesito("Kiss Pal").koltes, 20000LL + 45000LL + 30000LL + 20000LL);
+
+        // Protokoll parancs
+        {
+            std::ofstream f("import_teszt.csv");
+            f << "CSV002,K,2024.09.01,Olajcsere,15000,12000\nCSV002,K,2024.08.01,Szurok,5000,11000\nCSV002,J,2024.10.01,Kuplung,90000,8000\n";
+        }
+        ParancsVegrehajto pv(db);
+        std::string ki;
+        EXPECT_TRUE(pv.vegrehajt("szerviz_import\timport_teszt.csv", ki));
+        EXPECT_EQ(ki, std::string("OK 2\n2\t1\n3\tA km ora allasa nem csokkenhet: 8000 < 12000\n"));
+        ki.clear();
+        EXPECT_FALSE(pv.vegrehajt("szerviz_import\tnincs_ilyen.csv", ki));
+        std::remove("import_teszt.csv");
+    } END
+
+    TEST(KimenetiPuffer, BlokkosIrasEsLapozottListazas) {
+        SzervizNyilvantartoRendszer db;
+        db.ujUgyfel(Ugyfel("Lap Elek", "+36 1 222", "lap@elek.hu"));
+        for (int i = 0; i < 25; i++) {
+            std::string r = "LAP0" + std::to_string(10 + i);
+            db.ujAuto(Auto(r, "Opel", "Corsa", 1000 * i, Datum(2020, 1, 1), SzervizRekordLista(), &db.keresUgyfel("Lap Elek")));
+        }
+
+        std::ostringstream kozvetlen;
+        for (const auto& a : db.getAutok()) kozvetlen << a;
+
+        // A puffer csak megtelt tar vagy kiurites eseten ir a celfolyamba
+        std::ostringstream cel;
+        {
+            KimenetiPuffer puffer(cel, 4096);
+            size_t kurzor = 0;
+            size_t lapok = 0;
+            while (kurzor < db.getAutok().size()) {
+                kurzor = db.listazAutok(puffer.folyam(), kurzor, 10);
+                lapok++;
+            }
+            EXPECT_EQ(fromSizetToUnsigned(lapok), 3u);
+            EXPECT_EQ(fromSizetToUnsigned(kurzor), 25u);
+            EXPECT_TRUE(puffer.getIrasok() <= kozvetlen.str().size() / 4096 + 1);
+            puffer.kiurit();
+            const size_t irasok = puffer.getIrasok();
+            puffer.kiurit();    // ures tar: nincs ujabb iras
+            EXPECT_EQ(fromSizetToUnsigned(puffer.getIrasok()), fromSizetToUnsigned(irasok));
+
+            // A tarnal nagyobb darab kozvetlenul a celfolyamba kerul
+            puffer.folyam() << std::string(10000, 'x');
+        }
+        EXPECT_EQ(cel.str(), kozvetlen.str() + std::string(10000, 'x'));
+
+        // Kurzor: a kovetkezo lap eleje, a vegen (vagy azon tul) a darabszam
+        std::ostringstream lap;
+        EXPECT_EQ(fromSizetToUnsigned(db.listazAutok(lap, 20, 10)), 25u);
+        std::ostringstream vart;
+        for (size_t i = 20; i < 25; i++) vart << db.getAutok()[i];
+        EXPECT_EQ(lap.str(), vart.str());
+        EXPECT_EQ(fromSizetToUnsigned(db.listazAutok(lap, 40, 10)), 25u);
+        EXPECT_EQ(lap.str(), vart.str());
+        std::ostringstream ugyfelLap;
+        EXPECT_EQ(fromSizetToUnsigned(db.listazUgyfelek(ugyfelLap, 0, 10)), 1u);
+        EXPECT_TRUE(ugyfelLap.str().find("Lap Elek") != std::string::npos);
+    } END
+
+    TEST(NdjsonExport, FolyamosEsSzurtExport) {
+        SzervizNyilvantartoRendszer db;
+        db.ujUgyfel(Ugyfel("Json \"Jani\"", "+36 1 333", "a\\b@c.hu"));
+        db.ujUgyfel(Ugyfel("Masik Mari", "+36 1 444", "mari@x.hu"));
+        SzervizRekordLista l;
+        l.push_back(SzervizRekord(MuveletTipus::Karbantartas, "Olajcsere", Datum(2024, 1, 10), 20000, 50000));
+        l.push_back(SzervizRekord(MuveletTipus::Vizsga, "Muszaki\tvizsga", Datum(2024, 3, 5), 25000, 51000, true));
+        db.ujAuto(Auto("JSN001", "Opel", "Astra", 51000, Datum(2015, 1, 1), l, &db.keresUgyfel("Json \"Jani\"")));
+        db.ujAuto(Auto("JSN002", "Skoda", "Fabia", -5, Datum(987, 3, 9), SzervizRekordLista(), &db.keresUgyfel("Masik Mari")));
+
+        std::ostringstream teljes;
+        {
+            NdjsonExport e(teljes);
+            e.adatbazis(db);
+            e.kiurit();
+            EXPECT_EQ(fromSizetToUnsigned(e.getUgyfelek()), 2u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getAutok()), 2u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getSzervizek()), 2u);
+        }
+        EXPECT_EQ(teljes.str(), std::string(
+            "{\"rekord\":\"ugyfel\",\"nev\":\"Json \\\"Jani\\\"\",\"telefonszam\":\"+36 1 333\",\"email\":\"a\\\\b@c.hu\"}\n"
+            "{\"rekord\":\"ugyfel\",\"nev\":\"Masik Mari\",\"telefonszam\":\"+36 1 444\",\"email\":\"mari@x.hu\"}\n"
+            "{\"rekord\":\"auto\",\"rendszam\":\"JSN001\",\"marka\":\"Opel\",\"tipus\":\"Astra\",\"kmOra\":51000,"
+            "\"uzembeHelyezes\":\"2015-01-01\",\"tulajdonos\":\"Json \\\"Jani\\\"\"}\n"
+            "{\"rekord\":\"szerviz\",\"rendszam\":\"JSN001\",\"muveletTipus\":\"karbantartas\",\"muvelet\":\"Olajcsere\","
+            "\"datum\":\"2024-01-10\",\"ar\":20000,\"kmOra\":50000}\n"
+            "{\"rekord\":\"szerviz\",\"rendszam\":\"JSN001\",\"muveletTipus\":\"vizsga\",\"muvelet\":\"Muszaki\\tvizsga\","
+            "\"datum\":\"2024-03-05\",\"ar\":25000,\"kmOra\":51000,\"sikeres\":true}\n"
+            "{\"rekord\":\"auto\",\"rendszam\":\"JSN002\",\"marka\":\"Skoda\",\"tipus\":\"Fabia\",\"kmOra\":-5,"
+            "\"uzembeHelyezes\":\"0987-03-09\",\"tulajdonos\":\"Masik Mari\"}\n"));
+
+        // A legkisebb tarral is ugyanaz a kimenet (sok kisebb atadassal)
+        std::ostringstream kicsi;
+        {
+            NdjsonExport e(kicsi, 1);
+            e.adatbazis(db);
+        }
+        EXPECT_EQ(kicsi.str(), teljes.str());
+
+        // Szurt export: a talalt auto, szervizei es tulajdonosa; illetve a talalt ugyfel es autoi
+        std::ostringstream szurt;
+        {
+            NdjsonExport e(szurt);
+            e.adatbazis(db, "marka = \"Skoda\"", LekerdezesCel::Auto);
+            EXPECT_EQ(fromSizetToUnsigned(e.getUgyfelek()), 1u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getAutok()), 1u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getSzervizek()), 0u);
+            e.adatbazis(db, "nev ~ \"Jani\"", LekerdezesCel::Ugyfel);
+            EXPECT_EQ(fromSizetToUnsigned(e.getUgyfelek()), 2u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getAutok()), 2u);
+            EXPECT_EQ(fromSizetToUnsigned(e.getSzervizek()), 2u);
+            EXPECT_THROW(e.adatbazis(db, "nincs_ilyen = 1", LekerdezesCel::Auto), const std::invalid_argument&);
+        }
+        EXPECT_TRUE(szurt.str().find("\"nev\":\"Masik Mari\"") < szurt.str().find("\"rendszam\":\"JSN002\""));
+
+        // Protokoll parancs
+        ParancsVegrehajto pv(db);
+        std::string ki;
+        EXPECT_TRUE(pv.vegrehajt("export\texport_teszt.ndjson\tauto\tkmOra > 1000", ki));
+        EXPECT_EQ(ki, std::string("OK 1\n1\t1\t2\n"));
+        ki.clear();
+        EXPECT_FALSE(pv.vegrehajt("export\texport_teszt.ndjson\tauto", ki));
+        std::remove("export_teszt.ndjson");
+    } END
+
     segedFuggvenyekEleresehez.varakozasEnterre("\nNyomj Entert a folytatashoz...");
     segedFuggvenyekEleresehez.torolKonzol();
 }
\ No newline at end of file
@@ -93,7 +93,7 @@ void Ugyfel::kiir(std::ostream& os) const {
     os << "\tNev: " << nev << "\n"
         << "\tTelefonszam: " << telefonszam << "\n"
         << "\tEmail: " << email << "\n"
-        << std::endl;
+        << '\n';
 }
 
 
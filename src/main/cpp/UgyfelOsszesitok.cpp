@@ -0,0 +1,127 @@
+/**
+*   \file UgyfelOsszesitok.cpp
+*   Az UgyfelOsszesitok tagfuggvenyeinek megvalositasa.
+*/
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include "UgyfelOsszesitok.h"
+#include "Auto.h"
+#include "Ugyfel.h"
+
+/*-------------------------------------------
+        Belso segedfuggvenyek
+-------------------------------------------*/
+/// A bejegyzes utolso latogatasanak frissitese a datumok alapjan.
+/// @param b - A bejegyzes
+void UgyfelOsszesitok::utolsoFrissit(Bejegyzes& b) {
+    b.osszesito.utolsoLatogatas = b.napok.empty() ? Datum() : Datum::fromNapSorszam(b.napok.rbegin()->first);
+}
+
+/// Egy muvelet hozzaadasa a bejegyzeshez (az utolso latogatas frissitese nelkul).
+/// @param b - A bejegyzes
+/// @param r - A szervizrekord
+void UgyfelOsszesitok::muveletHozzaad(Bejegyzes& b, const SzervizRekord& r) {
+    b.osszesito.koltes += r.ar;
+    b.osszesito.muveletekSzama++;
+    b.napok[r.idopont.getNapSorszam()]++;
+}
+
+/// Egy muvelet elvetele a bejegyzesbol (az utolso latogatas frissitese nelkul).
+/// @param b - A bejegyzes
+/// @param r - A szervizrekord
+void UgyfelOsszesitok::muveletElvesz(Bejegyzes& b, const SzervizRekord& r) {
+    b.osszesito.koltes -= r.ar;
+    b.osszesito.muveletekSzama--;
+    std::map<int32_t, size_t>::iterator it = b.napok.find(r.idopont.getNapSorszam());
+    if (it != b.napok.end() && --it->second == 0)
+        b.napok.erase(it);
+}
+
+
+
+/*-------------------------------------------
+            Fontos tagmuveletek
+-------------------------------------------*/
+/// Az osszes bejegyzes torlese.
+void UgyfelOsszesitok::torol() {
+    ugyfelek.clear();
+}
+
+/// Ujraepiti az osszesitoket az autok alapjan (O(osszes muvelet)).
+/// @param autok - A rendszer autoi
+void UgyfelOsszesitok::ujraepit(const Vector<Auto>& autok) {
+    ugyfelek.clear();
+    for (size_t i = 0; i < autok.size(); i++)
+        autoHozzaad(autok[i]);
+}
+
+/// Egy auto es teljes szerviztortenetenek hozzaadasa a tulajdonosahoz.
+/// @param a - Az auto (tulajdonos nelkul nincs hatasa)
+void UgyfelOsszesitok::autoHozzaad(const Auto& a) {
+    if (a.getTulajdonos() == nullptr) return;
+    Bejegyzes& b = ugyfelek[a.getTulajdonos()->getNev()];
+    b.osszesito.autokSzama++;
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    for (size_t i = 0; i < rekordok.size(); i++)
+        muveletHozzaad(b, rekordok[i]);
+    utolsoFrissit(b);
+}
+
+/// Egy auto es teljes szerviztortenetenek elvetele a tulajdonosatol.
+/// @param a - Az auto (tulajdonos nelkul nincs hatasa)
+void UgyfelOsszesitok::autoElvesz(const Auto& a) {
+    if (a.getTulajdonos() == nullptr) return;
+    std::unordered_map<std::string, Bejegyzes>::iterator it = ugyfelek.find(a.getTulajdonos()->getNev());
+    if (it == ugyfelek.end()) return;
+    Bejegyzes& b = it->second;
+    b.osszesito.autokSzama--;
+    const SzervizRekordLista& rekordok = a.getSzervizRekordok();
+    for (size_t i = 0; i < rekordok.size(); i++)
+        muveletElvesz(b, rekordok[i]);
+    if (b.osszesito.autokSzama == 0)
+        ugyfelek.erase(it);
+    else
+        utolsoFrissit(b);
+}
+
+/// Egy szervizmuvelet hozzaadasa az ugyfelhez.
+/// @param nev - Az ugyfel neve
+/// @param r - A szervizrekord
+void UgyfelOsszesitok::rekordHozzaad(const std::string& nev, const SzervizRekord& r) {
+    Bejegyzes& b = ugyfelek[nev];
+    muveletHozzaad(b, r);
+    utolsoFrissit(b);
+}
+
+/// Egy szervizmuvelet elvetele az ugyfeltol.
+/// @param nev - Az ugyfel neve
+/// @param r - A szervizrekord
+void UgyfelOsszesitok::rekordElvesz(const std::string& nev, const SzervizRekord& r) {
+    std::unordered_map<std::string, Bejegyzes>::iterator it = ugyfelek.find(nev);
+    if (it == ugyfelek.end()) return;
+    muveletElvesz(it->second, r);
+    utolsoFrissit(it->second);
+}
+
+/// Egy ugyfel bejegyzesenek torlese.
+/// @param nev - Az ugyfel neve
+void UgyfelOsszesitok::ugyfelTorol(const std::string& nev) {
+    ugyfelek.erase(nev);
+}
+
+
+
+/*-------------------------------------------
+              Lekerdezesek
+-------------------------------------------*/
+/// Az ugyfel osszesitoje (O(1)).
+/// @param nev - Az ugyfel neve
+/// @return - Az osszesito (ismeretlen vagy auto nelkuli ugyfelre csupa nulla)
+const UgyfelOsszesito& UgyfelOsszesitok::lekerdez(const std::string& nev) const {
+    static const UgyfelOsszesito ures;
+    std::unordered_map<std::string, Bejegyzes>::const_iterator it = ugyfelek.find(nev);
+    return it == ugyfelek.end() ? ures : it->second.osszesito;
+}
\ No newline at end of file
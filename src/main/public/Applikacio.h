@@ -6,10 +6,27 @@
 #ifndef APPLIKACIO_H
 #define APPLIKACIO_H
 
+#include <string>
+
 struct Applikacio {
 	/// Futtatja a programot, beleertve a menut es a felhasznaloi interakciot
 	/// @return - true, ha a program sikeresen befejezodott, kulonben false.
     bool applikacio();
+
+	/// Szerver modban futtatja a programot: a teszt adatok betoltese utan a megadott helyi cimen
+	/// fogadja a ParancsVegrehajto protokolljanak kereseit, amig SIGINT vagy SIGTERM nem erkezik.
+	/// Naplofajl megadasa eseten indulaskor visszajatssza, majd folytatja a naplot.
+	/// @param cim - "unix:<ut>", vagy "<helyi IPv4 cim vagy localhost>:<port>"
+	/// @param naploFajl - A modosito parancsok naploja (ures: nincs naplozas)
+	/// @return - true, ha a szerver rendben leallt, kulonben false.
+    bool szerver(const std::string& cim, const std::string& naploFajl = "");
+
+	/// Kotegelt (nem interaktiv) modban futtatja a programot: a ParancsVegrehajto protokolljanak
+	/// parancsait olvassa a fajlbol (vagy a standard bemenetrol) es a valaszokat a standard kimenetre irja,
+	/// kepernyotorles es varakozas nelkul. A rendszer uresen indul (betoltes paranccsal tolthato fel).
+	/// @param forras - A parancsfajl neve ("-": standard bemenet)
+	/// @return - true, ha minden parancs OK valaszt kapott, kulonben false.
+    bool koteg(const std::string& forras);
 };
 
 #endif // APPLIKACIO_H
\ No newline at end of file
@@ -20,6 +20,9 @@
 #include "Ugyfel.h"
 #include "Vector.hpp"
 #include "VegzettMuvelet.h"
+#include "SzervizRekord.h"
+#include "SzervizTortenet.h"
+#include "KmRegresszio.h"
 
 class Auto {
     std::string rendszam;                               ///< Az auto rendszama  
@@ -27,7 +30,7 @@ class Auto {
     std::string tipus;                                  ///< Az auto tipusa  
     int kmOra;                                          ///< Kilometerora allasa  
     Datum uzembeHelyezes;                               ///< uzembe helyezes datuma  
-    Vector<VegzettMuvelet*> vegzettSzervizMuveletek;    ///< Elvegzett szervizmuveletek  
+    SzervizTortenet vegzettSzervizMuveletek;            ///< Elvegzett szervizmuveletek (megosztott, copy-on-write lista)
     Ugyfel* tulajdonos;                                 ///< Az auto tulajdonosa  
 public:
     /*-------------------------------------------
@@ -53,7 +56,27 @@ public:
     /// @param u - Az auto tulajdonosa  
     Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const Vector<VegzettMuvelet*>& v, Ugyfel* u);
 
-    /// Masolo konstruktor.  
+    /// Parameteres konstruktor szervizrekordokkal.  
+    /// @param r - Az auto rendszama  
+    /// @param m - Az auto markaja  
+    /// @param t - Az auto tipusa  
+    /// @param k - A kilometerora allasa  
+    /// @param d - Az uzembe helyezes datuma  
+    /// @param v - Az autohoz tartozo szervizrekordok listaja  
+    /// @param u - Az auto tulajdonosa  
+    Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const SzervizRekordLista& v, Ugyfel* u);
+
+    /// Parameteres konstruktor megosztott szerviztortenettel (a tortenet nem masolodik).  
+    /// @param r - Az auto rendszama  
+    /// @param m - Az auto markaja  
+    /// @param t - Az auto tipusa  
+    /// @param k - A kilometerora allasa  
+    /// @param d - Az uzembe helyezes datuma  
+    /// @param v - Az autohoz tartozo szerviztortenet  
+    /// @param u - Az auto tulajdonosa  
+    Auto(const std::string& r, const std::string& m, const std::string& t, int k, const Datum& d, const SzervizTortenet& v, Ugyfel* u);
+
+    /// Masolo konstruktor. A szerviztortenet megosztva marad, igy a masolas O(1).  
     /// @param a - Masolando Auto objektum  
     Auto(const Auto& a);
 
@@ -100,13 +123,33 @@ public:
     /// @return - Datum .
     const Datum& getUzembeHelyezes() const;
 
-    /// Visszaadja az autohoz tartozo szervizmuveletek listajat.
-    /// @return - Szervizmuveletek vektora.
-    Vector<VegzettMuvelet*>& getSzervizMuveletek();
+    /// Visszaadja az autohoz tartozo szervizrekordok listajat.
+    /// @return - Szervizrekordok vektora (idorendben).
+    const SzervizRekordLista& getSzervizRekordok() const;
 
-    /// Visszaadja az autohoz tartozo szervizmuveletek listajat (const valtozat).
+    /// Visszaadja az autohoz tartozo szerviztortenet leirojat (masolasa O(1)).
+    /// @return - A szerviztortenet.
+    const SzervizTortenet& getSzervizTortenet() const;
+
+    /// Visszaadja a szervizrekordok (datum, km) pontjaira illesztett regresszio futo osszegeit.
+    /// @return - A regresszio (O(1), novekmenyesen karbantartva).
+    const KmRegresszio& getKmRegresszio() const;
+
+    /// Becsult napi futasteljesitmeny a szerviztortenet alapjan.
+    /// @return - km/nap, vagy 0, ha nincs legalabb ket kulonbozo napon rogzitett muvelet.
+    double becsultNapiKm() const;
+
+    /// Megbecsuli, mikor eri el az auto a megadott km ora allast (O(1)).
+    /// A becsles az utolso szervizrekordbol indul ki, a regresszio meredeksegevel.
+    /// @param km - A cel km ora allas
+    /// @param ki - A becsult datum (csak sikeres becslesnel irodik)
+    /// @return - true, ha van ervenyes, pozitiv napi km becsles
+    bool becsultDatumKmOraig(int km, Datum& ki) const;
+
+    /// Visszaadja az autohoz tartozo szervizmuveletek listajat polimorf objektumokkent (kompatibilitasi felulet).
+    /// Minden hivas uj peldanyokat hoz letre a rekordokbol; a visszaadott vektor birtokolja oket.
     /// @return - Szervizmuveletek vektora.
-    const Vector<VegzettMuvelet*>& getSzervizMuveletek() const;
+    Vector<VegzettMuvelet*> getSzervizMuveletek() const;
 
     // Visszaadja az auto tulajdonosat.
     /// @return - Az auto tulajdonosa.
@@ -143,6 +186,11 @@ public:
     virtual Auto* clone() const;
 
     /// Hozzaad egy szervizmuveletet az auto szervizlistajahoz.
+    /// @param m - A hozzaadando szervizrekord
+    void addVegzettSzerviz(const SzervizRekord& m);
+
+    /// Hozzaad egy szervizmuveletet az auto szervizlistajahoz (kompatibilitasi felulet).
+    /// Az objektum rekordda alakitva kerul a listaba, a pointert a fuggveny felszabaditja.
     /// @param m - A hozzaadando szervizmuvelet pointere
     void addVegzettSzerviz(VegzettMuvelet* m);
 
@@ -9,24 +9,47 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <cstdint>
 
+/// A datumot egyetlen 32 bites napsorszamkent taroljuk (1970.01.01 ota eltelt napok, proleptikus Gergely-naptar szerint).
+/// igy ket datum kulonbsege es osszehasonlitasa egyetlen egesz muvelet, az ev/honap/nap bontas csak kiiraskor kell.
 class Datum {
-    int ev;     ///< ev  
-    int ho;     ///< Honap  
-    int nap;    ///< Nap  
+    int32_t napSorszam;     ///< 1970.01.01 ota eltelt napok szama (negativ is lehet)
+
+    /// Ev/honap/nap harmasbol napsorszamot szamol.
+    /// Letezo naptari napot var (a hivo ervenyes()-sel ellenoriz); atfordulo mezoket nem normalizal.
+    /// @param e - ev
+    /// @param h - honap
+    /// @param n - nap
+    /// @return - A napsorszam
+    static int32_t sorszamFromDatum(int e, int h, int n);
+
+    /// Napsorszambol ev/honap/nap harmast allit elo.
+    /// @param s - napsorszam
+    /// @param e - kimeneti ev
+    /// @param h - kimeneti honap
+    /// @param n - kimeneti nap
+    static void datumFromSorszam(int32_t s, int& e, int& h, int& n);
 
 public:
+    /// Az "EEEE.HH.NN" formatum hossza (lezaro nulla nelkul).
+    static const size_t SZOVEG_HOSSZ = 10;
+
+    /// A formatToBuffer altal irt szoveg maximalis hossza (negyjegyunel hosszabb evszamokkal egyutt).
+    static const size_t MAX_SZOVEG_HOSSZ = 16;
+
     /*-------------------------------------------
             Konstruktorok es destruktor
     -------------------------------------------*/
     /// Alapertelmezett konstruktor
-    /// 0-ra inicializalja az evet, honapot es napot.
+    /// A napsorszam nullpontjara (1970.01.01) inicializal; a korabbi 0.0.0 nem letezo datum, igy nem abrazolhato.
     Datum();
 
     /// Parameteres konstruktor
     /// @param e - ev
     /// @param h - honap
     /// @param n - nap
+    /// @throws std::invalid_argument - ha a honap vagy a nap a naptar szerint ervenytelen (lasd ervenyes())
     Datum(int e, int h, int n);
 
     /// Masolo konstruktor
@@ -51,6 +74,31 @@ public:
     /// @return - true, ha az objektumok megegyeznek, kulonben false.
     bool operator==(const Datum& d) const;
 
+    /// Nem egyenlo operator
+    /// @param d - osszehasonlitando Datum objektum
+    /// @return - true, ha a ket datum kulonbozik.
+    bool operator!=(const Datum& d) const;
+
+    /// Kisebb operator (korabbi datum)
+    /// @param d - osszehasonlitando Datum objektum
+    /// @return - true, ha az aktualis datum korabbi.
+    bool operator<(const Datum& d) const;
+
+    /// Kisebb-egyenlo operator
+    /// @param d - osszehasonlitando Datum objektum
+    /// @return - true, ha az aktualis datum nem kesobbi.
+    bool operator<=(const Datum& d) const;
+
+    /// Nagyobb operator (kesobbi datum)
+    /// @param d - osszehasonlitando Datum objektum
+    /// @return - true, ha az aktualis datum kesobbi.
+    bool operator>(const Datum& d) const;
+
+    /// Nagyobb-egyenlo operator
+    /// @param d - osszehasonlitando Datum objektum
+    /// @return - true, ha az aktualis datum nem korabbi.
+    bool operator>=(const Datum& d) const;
+
 
 
     /*-------------------------------------------
@@ -68,10 +116,16 @@ public:
     /// @return - nap
     int getNap() const;
 
-    /// Datum eltelt napok szamanak lekerdezese
+    /// Datum eltelt napok szamanak lekerdezese (pontos, szokoevekkel szamolva)
     /// @param d - masik Datum objektum
+    /// @return - d es az aktualis datum kozott eltelt napok (negativ, ha d a korabbi)
     int elteltNap(const Datum& d) const;
 
+    /// A nyers napsorszam lekerdezese (1970.01.01 = 0).
+    /// Tartomany szureshez es rendezeshez elegendo ezt az egy egeszet osszehasonlitani.
+    /// @return - napsorszam
+    int32_t getNapSorszam() const;
+
 
 
     /*-------------------------------------------
@@ -81,6 +135,7 @@ public:
     /// @param e - ev
     /// @param h - honap
     /// @param n - nap
+    /// @throws std::invalid_argument - ha a honap vagy a nap a naptar szerint ervenytelen (ekkor a datum nem valtozik)
     void setDatum(int e, int h, int n);
 
 
@@ -88,8 +143,21 @@ public:
     /*-------------------------------------------
                    Segedfuggvenyek
     -------------------------------------------*/
+    /// Letezo naptari nap-e (1 <= h <= 12, 1 <= n <= a honap napjainak szama, szokoevvel szamolva).
+    /// A szamitas atfordulo mezoket nem normalizal: a 2023.02.29 vagy a 2024.13.01 ervenytelen.
+    /// @param e - ev
+    /// @param h - honap
+    /// @param n - nap
+    /// @return - true, ha a datum letezik
+    static bool ervenyes(int e, int h, int n);
+
+    /// Letrehoz egy Datum objektumot a nyers napsorszambol.
+    /// @param s - napsorszam (1970.01.01 = 0)
+    /// @return - A letrehozott Datum objektum.
+    static Datum fromNapSorszam(int32_t s);
+
     /// Letrehoz egy Datum objektumot egy stringbõl.
-    /// A string formatuma: "eeee.HH.NN".
+    /// A string formatuma: "eeee.HH.NN"; a datum utan csak szokoz allhat (lasd parseMezo).
     /// @param str - A datumot tartalmazo string.
     /// @return - A letrehozott Datum objektum.
     static Datum parseFromString(const std::string& str);
@@ -97,6 +165,30 @@ public:
     /// Egy Datum objektumot stringge alakit "eeee.HH.NN" formatumban.
     /// @return std::string A formazott datum szovegkent.
     const std::string toString() const;
+
+    /// Datum ertelmezese karakterpuffer elejerol, memoriafoglalas nelkul.
+    /// A rogzitett "EEEE.HH.NN" elrendezest egy gyors uton kezeli, a rovidebb mezoket (pl. "2025.4.1") altalanos uton.
+    /// A datum utan barmi allhat, ami nem szamjegy (pl. "2025.02.15,40000"); egesz mezohoz a parseMezo valo.
+    /// @param buf - A datum elso karakterere mutato pointer (nem kell nullaval lezartnak lennie).
+    /// @param hossz - A pufferbol legfeljebb ennyi karakter olvashato.
+    /// @param ki - Sikeres ertelmezes eseten ide kerul az eredmeny.
+    /// @return - Az ertelmezett karakterek szama (a bevezeto szokozokkel egyutt), vagy 0, ha a puffer
+    ///           eleje nem ervenyes datum (ekkor ki nem valtozik). Nem letezo naptari nap (pl. "2024.02.30") is 0.
+    static size_t parseBuffer(const char* buf, size_t hossz, Datum& ki);
+
+    /// Egy teljes mezo ertelmezese datumkent: a datum elott es utan csak szokoz vagy tabulator allhat,
+    /// igy pl. a "2021.1.1x" vagy a "2021.02.3a" hibas.
+    /// @param buf - A mezo elso karakterere mutato pointer (nem kell nullaval lezartnak lennie).
+    /// @param hossz - A mezo hossza.
+    /// @param ki - Sikeres ertelmezes eseten ide kerul az eredmeny.
+    /// @return - true, ha a mezo ervenyes datum, kulonben false (ekkor ki nem valtozik).
+    static bool parseMezo(const char* buf, size_t hossz, Datum& ki);
+
+    /// A datumot "EEEE.HH.NN" formatumban a megadott pufferbe irja, memoriafoglalas nelkul.
+    /// Lezaro nullat nem ir.
+    /// @param buf - Legalabb MAX_SZOVEG_HOSSZ meretu puffer.
+    /// @return - A beirt karakterek szama (0000..9999 kozotti evszamra mindig SZOVEG_HOSSZ).
+    size_t formatToBuffer(char* buf) const;
 };
 /*-------------------------------------------
             Globalis operatorok
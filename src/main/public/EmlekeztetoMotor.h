@@ -0,0 +1,130 @@
+/**
+*   \file EmlekeztetoMotor.h
+*   A flotta szervizemlekeztetoit nyilvantarto motor deklaracioja.
+*
+*   Minden auto (amelyre a figyelmeztetesi szabalyok kozul legalabb egy vonatkozik) ket kupacban szerepel:
+*     - a datum-kupac kulcsa a kovetkezo esedekesseg napja (a legkorabbi nap, amikor valamelyik nap kuszobu szabaly jar),
+*     - a km-kupac kulcsa a kovetkezo esedekessegig hatralevo km (a legkisebb esedekes km ora allas - km ora).
+*   A kulcsokat a FigyelmeztetesiSzabalyok::esedekesseg adja, igy a motor ugyanazt mondja, mint a figyelmeztetesek.
+*   Egy auto modositasakor csak az o bejegyzese mozdul el a kupacokban (O(log n)), a "mely autok esedekesek
+*   X datumig" kerdes pedig O(k log n) ideju, ahol k a talalatok szama.
+*/
+
+#ifndef EMLEKEZTETOMOTOR_H
+#define EMLEKEZTETOMOTOR_H
+
+#include <string>
+#include <map>
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "Datum.h"
+#include "FigyelmeztetesiSzabalyok.h"
+
+class Auto;
+
+/// Egy esedekes auto adatai a lekerdezesek eredmenyeben.
+struct Esedekesseg {
+    std::string rendszam;   ///< Az auto rendszama
+    Datum esedekesDatum;    ///< Az elso nap, amikor a datum alapu figyelmeztetes mar jar (Datum(), ha nincs nap kuszobu szabaly)
+    int esedekesKm;         ///< Az a km ora allas, amelytol a km alapu figyelmeztetes mar jar (NINCS_KM, ha nincs km kuszobu szabaly)
+    int kmOra;              ///< Az auto aktualis km ora allasa
+
+    Esedekesseg() : rendszam(""), esedekesDatum(), esedekesKm(0), kmOra(0) {}
+};
+
+/// Egy auto becsult kovetkezo km alapu szervize a futasteljesitmeny-regresszio alapjan.
+struct SzervizBecsles {
+    std::string rendszam;   ///< Az auto rendszama
+    double napiKm;          ///< A becsult napi futasteljesitmeny
+    int esedekesKm;         ///< Az a km ora allas, amelytol a km alapu figyelmeztetes mar jar
+    Datum becsultDatum;     ///< A becsult datum, amikor az auto eleri az esedekesKm-t
+
+    SzervizBecsles() : rendszam(""), napiKm(0.0), esedekesKm(0), becsultDatum() {}
+};
+
+class EmlekeztetoMotor {
+public:
+    static const int VIZSGA_ERVENYESSEG_NAP = 365 * 2;  ///< Az alapertelmezett nap kuszob: ennyi nappal az utolso szerviz utan meg nem jar figyelmeztetes
+    static const int SZERVIZ_INTERVALLUM_KM = 10000;    ///< Az alapertelmezett km kuszob: ennyi km-rel az utolso szerviz utan meg nem jar figyelmeztetes
+
+private:
+    /// Egy auto bejegyzese. A kupacok az elemek indexeit taroljak, az elemek a kupacbeli poziciojukat.
+    struct Elem {
+        std::string rendszam;   ///< Az auto rendszama
+        int32_t esedekesNap;    ///< A kovetkezo esedekesseg napsorszama
+        int esedekesKm;         ///< A kovetkezo esedekesseg km ora allasa
+        int kmOra;              ///< Az auto aktualis km ora allasa
+        size_t datumPoz;        ///< Pozicio a datum-kupacban
+        size_t kmPoz;           ///< Pozicio a km-kupacban
+
+        Elem() : rendszam(""), esedekesNap(0), esedekesKm(0), kmOra(0), datumPoz(0), kmPoz(0) {}
+    };
+
+    Vector<Elem> elemek;                    ///< Az elemek (a torolt elemek helye ujrahasznosul)
+    Vector<size_t> szabadElemek;            ///< A torolt elemek indexei
+    Vector<size_t> datumKupac;              ///< Min-kupac az esedekesseg napja szerint
+    Vector<size_t> kmKupac;                 ///< Min-kupac a hatralevo km szerint
+    std::map<std::string, size_t> index;    ///< Rendszam -> elem index
+
+    int32_t datumKulcs(size_t e) const { return elemek[e].esedekesNap; }
+    long long kmKulcs(size_t e) const {
+        // Km kuszob nelkul az elem a kupac aljara kerul, es egyetlen km lekerdezesben sem szerepel
+        if (elemek[e].esedekesKm == FigyelmeztetesiSzabalyok::NINCS_KM) return LLONG_MAX;
+        return static_cast<long long>(elemek[e].esedekesKm) - elemek[e].kmOra;
+    }
+
+    void datumFel(size_t poz);
+    void datumLe(size_t poz);
+    void kmFel(size_t poz);
+    void kmLe(size_t poz);
+
+    /// Elem eltavolitasa mindket kupacbol es az indexbol.
+    /// @param e - Az elem indexe
+    void eltavolit(size_t e);
+
+public:
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Az osszes bejegyzes torlese.
+    void torol();
+
+    /// Ujraepiti a motort az autok alapjan (O(n)); szabalycsere utan is ezt kell hivni.
+    /// @param autok - A rendszer autoi
+    /// @param sz - A figyelmeztetesi szabalyok, amelyekbol az esedekessegek szamolodnak
+    void ujraepit(const Vector<Auto>& autok, const FigyelmeztetesiSzabalyok& sz);
+
+    /// Egy auto bejegyzesenek felvetele vagy frissitese (O(log n)).
+    /// Ha egyik szabaly sem vonatkozik az autora (pl. nincs szervizmuvelete), a bejegyzes megszunik.
+    /// @param a - Az auto aktualis allapota
+    /// @param sz - A figyelmeztetesi szabalyok (ugyanazok, mint az ujraepitesnel)
+    void frissit(const Auto& a, const FigyelmeztetesiSzabalyok& sz);
+
+    /// Egy auto bejegyzesenek torlese (O(log n)).
+    /// @param r - Az auto rendszama
+    void torol(const std::string& r);
+
+    /// A nyilvantartott autok szama.
+    /// @return - size_t
+    size_t meret() const { return index.size(); }
+
+
+
+    /*-------------------------------------------
+                  Lekerdezesek
+    -------------------------------------------*/
+    /// Azok az autok, amelyeknel a datum alapu figyelmeztetes legkesobb a megadott napon mar jar.
+    /// Az eredmeny az esedekesseg napja szerint novekvo sorrendu. O(k log n).
+    /// @param ig - A referencia datum (pl. a mai nap, vagy a het utolso napja)
+    /// @param ki - Az eredmenylista (a vegere fuz)
+    void esedekesekDatumig(const Datum& ig, Vector<Esedekesseg>& ki) const;
+
+    /// Azok az autok, amelyeknel a km alapu figyelmeztetes legfeljebb tartalekKm km utan mar jar.
+    /// Az eredmeny a hatralevo km szerint novekvo sorrendu. O(k log n).
+    /// @param tartalekKm - 0 eseten a mar esedekes autok, pozitiv ertek eseten az ennyi km-en belul esedekesek is
+    /// @param ki - Az eredmenylista (a vegere fuz)
+    void esedekesekKmAlapjan(int tartalekKm, Vector<Esedekesseg>& ki) const;
+};
+
+#endif // EMLEKEZTETOMOTOR_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+*   \file FigyelmeztetesiSzabalyok.h
+*   Adatkent megadott figyelmeztetesi szabalyok es a beloluk forditott predikatumtabla deklaracioja.
+*
+*   Egy szabaly harom adatbol all: mely muvelettipusok szamitanak (tipusmaszk), es hany nap, illetve
+*   hany km telhet el a legutobbi ilyen muvelet ota. A szabalyok felvetelkor egy lapos tablaba fordulnak,
+*   amelynek minden sora egyetlen kuszobot ellenoriz (tipusmaszk, mertek, kuszob). A kiertekeles egy
+*   autora egyszer keresi meg visszafele a tipusonkenti utolso muveletet, utana a tabla sorai elagazas
+*   nelkuli, egyforma lepesekkel ertekelhetok ki, igy egy uj szabaly csak egy-egy tablasort jelent.
+*   Ugyanebbol a tablabol szamolhato az auto kovetkezo esedekessege is (az emlekezteto motor kulcsai).
+*/
+
+#ifndef FIGYELMEZTETESISZABALYOK_H
+#define FIGYELMEZTETESISZABALYOK_H
+
+#include <string>
+#include <cstdint>
+#include <climits>
+
+#include "Vector.hpp"
+#include "Datum.h"
+#include "MuveletTipus.h"
+
+class Auto;
+
+/// A kuszob merteke: eltelt napok vagy megtett km.
+enum class FigyelmeztetesMertek : char {
+    Nap = 'D',  ///< A legutobbi muvelet ota eltelt napok szama
+    Km = 'K'    ///< A legutobbi muvelet ota megtett km
+};
+
+/// Egy adatkent megadott figyelmeztetesi szabaly.
+struct FigyelmeztetesiSzabaly {
+    static const unsigned char JAVITAS = 1;         ///< Tipusmaszk bit: javitas
+    static const unsigned char KARBANTARTAS = 2;    ///< Tipusmaszk bit: karbantartas
+    static const unsigned char VIZSGA = 4;          ///< Tipusmaszk bit: vizsga
+    static const unsigned char BARMELY = 7;         ///< Tipusmaszk: barmely muvelet
+    static const int NINCS = -1;                    ///< Nem hasznalt kuszob
+
+    std::string uzenet;         ///< A figyelmeztetes szovege (pl. "muszaki vizsgaja lejart")
+    std::string hivatkozas;     ///< A viszonyitasi muvelet megnevezese a szovegben (pl. "vizsga")
+    unsigned char tipusMaszk;   ///< Mely muvelettipusok szamitanak (a fenti bitek kombinacioja)
+    int napKuszob;              ///< Ennyi napnal tobb nem telhet el (NINCS, ha nem hasznalt)
+    int kmKuszob;               ///< Ennyi km-nel tobb nem telhet el (NINCS, ha nem hasznalt)
+
+    FigyelmeztetesiSzabaly() : uzenet(""), hivatkozas(""), tipusMaszk(BARMELY), napKuszob(NINCS), kmKuszob(NINCS) {}
+    FigyelmeztetesiSzabaly(const std::string& u, const std::string& h, unsigned char m, int nap, int km)
+        : uzenet(u), hivatkozas(h), tipusMaszk(m), napKuszob(nap), kmKuszob(km) {}
+
+    /// A muvelettipushoz tartozo maszk bit.
+    /// @param t - A muvelet tipusa
+    /// @return - JAVITAS, KARBANTARTAS vagy VIZSGA
+    static unsigned char tipusBit(MuveletTipus t);
+};
+
+/// Egy auto egy figyelmeztetese a flottaszintu kiertekeles eredmenyeben.
+struct Figyelmeztetes {
+    std::string rendszam;           ///< Az auto rendszama
+    size_t szabaly;                 ///< A megsertett szabaly sorszama a szabalykeszletben
+    FigyelmeztetesMertek mertek;    ///< A tullepett kuszob merteke
+    int tullepes;                   ///< Mennyivel lepte tul a kuszobot (napban vagy km-ben)
+
+    Figyelmeztetes() : rendszam(""), szabaly(0), mertek(FigyelmeztetesMertek::Nap), tullepes(0) {}
+    Figyelmeztetes(const std::string& r, size_t sz, FigyelmeztetesMertek m, int t) : rendszam(r), szabaly(sz), mertek(m), tullepes(t) {}
+
+    /// Rendezes rendszam, azon belul szabaly, azon belul mertek szerint.
+    bool operator<(const Figyelmeztetes& f) const {
+        int c = rendszam.compare(f.rendszam);
+        if (c != 0) return c < 0;
+        if (szabaly != f.szabaly) return szabaly < f.szabaly;
+        return mertek < f.mertek;
+    }
+};
+
+class FigyelmeztetesiSzabalyok {
+public:
+    static const int32_t NINCS_NAP = INT32_MAX; ///< Esedekesseg napja, ha egyik nap kuszobu sor sem vonatkozik az autora
+    static const int NINCS_KM = INT_MAX;        ///< Esedekes km, ha egyik km kuszobu sor sem vonatkozik az autora
+
+    /// Egy tablasor teljesulese egy auton.
+    struct Talalat {
+        size_t szabaly;                 ///< A szabaly sorszama
+        FigyelmeztetesMertek mertek;    ///< A tullepett kuszob merteke
+        int eltelt;                     ///< A legutobbi szamito muvelet ota eltelt napok vagy km
+        int tullepes;                   ///< eltelt - kuszob
+        size_t rekord;                  ///< A viszonyitasi muvelet indexe az auto szerviztorteneteben
+
+        Talalat() : szabaly(0), mertek(FigyelmeztetesMertek::Nap), eltelt(0), tullepes(0), rekord(0) {}
+    };
+
+private:
+    Vector<FigyelmeztetesiSzabaly> szabalyok;   ///< A megadott szabalyok
+
+    // A forditott predikatumtabla (soronkent egy kuszob, oszloposan)
+    Vector<unsigned char> sorMaszk;     ///< A sor tipusmaszkja
+    Vector<char> sorKm;                 ///< 1, ha a sor km kuszob, 0, ha nap kuszob
+    Vector<int32_t> sorKuszob;          ///< A sor kuszobe
+    Vector<uint32_t> sorSzabaly;        ///< A sorhoz tartozo szabaly sorszama
+
+public:
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// A program eredeti ket szabalya: barmely muvelet utan 2 ev, illetve 10000 km.
+    /// @return - Az alapertelmezett szabalykeszlet
+    static FigyelmeztetesiSzabalyok alapertelmezett();
+
+    /// Szabaly felvetele; a szabaly azonnal a predikatumtablaba fordul.
+    /// @param sz - A szabaly
+    /// @return - A szabaly sorszama
+    /// @throws std::invalid_argument - ha a tipusmaszk ures, vagy egyik kuszob sincs megadva
+    size_t hozzaad(const FigyelmeztetesiSzabaly& sz);
+
+    /// Az osszes szabaly torlese.
+    void torol();
+
+    /// A szabalyok szama.
+    /// @return - size_t
+    size_t meret() const { return szabalyok.size(); }
+
+    /// A predikatumtabla sorainak szama.
+    /// @return - size_t
+    size_t sorokSzama() const { return sorKuszob.size(); }
+
+    /// Az adott sorszamu szabaly.
+    /// @param i - A szabaly sorszama
+    /// @return - A szabaly
+    const FigyelmeztetesiSzabaly& operator[](size_t i) const { return szabalyok[i]; }
+
+    /// Az auto kiertekelese az osszes szabalyra, egy menetben.
+    /// Az a szabaly, amelynek tipusaihoz az autonak nincs muvelete, nem teljesul.
+    /// @param a - Az auto
+    /// @param ma - A referencia datum
+    /// @param ki - A teljesult sorok (a vegere fuz, a tabla soraival azonos sorrendben)
+    void kiertekel(const Auto& a, const Datum& ma, Vector<Talalat>& ki) const;
+
+    /// Az auto kovetkezo esedekessege az osszes szabaly szerint: az a legkorabbi nap, illetve legkisebb
+    /// km ora allas, amelytol valamelyik nap, illetve km kuszobu sor a kiertekel szerint mar teljesul.
+    /// @param a - Az auto
+    /// @param nap - Ide kerul az esedekesseg napsorszama (NINCS_NAP, ha nincs ilyen sor)
+    /// @param km - Ide kerul az esedekes km ora allas (NINCS_KM, ha nincs ilyen sor)
+    /// @return - true, ha legalabb az egyik esedekesseg letezik
+    bool esedekesseg(const Auto& a, int32_t& nap, int& km) const;
+};
+
+#endif // FIGYELMEZTETESISZABALYOK_H
\ No newline at end of file
@@ -62,6 +62,16 @@ public:
         return new Javitas(*this);
     }
 
+    /// Ertek szerinti rekordda alakito fuggveny feluldefinialasa
+    /// @return - A muveletnek megfelelo SzervizRekord
+    SzervizRekord toRekord() const override {
+        return SzervizRekord(MuveletTipus::Javitas, getMuvelet(), getDatum(), getAr(), getAktKmOra());
+    }
+
+    /// Tipuslekerdezo fuggveny feluldefinialasa
+    /// @return - MuveletTipus::Javitas
+    MuveletTipus getTipus() const override { return MuveletTipus::Javitas; }
+
     /// Kiiro fuggveny feluldefinialasa
     /// @param os - kimeneti stream
     void kiir(std::ostream& os) const override {
@@ -69,7 +79,7 @@ public:
             << ", Datum: " << getDatum()
             << ", Ar: " << getAr() << " Ft"
             << ", Akt. km: " << getAktKmOra()
-            << std::endl;
+            << '\n';
     }
 };
 
@@ -0,0 +1,74 @@
+/**
+*   \file KimenetiPuffer.h
+*   Nagy blokkokban iro, ujrahasznalhato kimeneti puffer deklaracioja.
+*
+*   A listazasok (Auto::kiir, Ugyfel::kiir, a szervizmuveletek kiirasa) egy std::ostream-be irnak. Ha ez
+*   kozvetlenul a std::cout, minden sor kulon kerul a terminalhoz; a KimenetiPuffer folyama egy rogzitett
+*   meretu tarba gyujti a szoveget, es csak akkor adja tovabb a celfolyamnak egyetlen irassal, ha a tar
+*   megtelt, vagy ha a hivo kiuriti (peldaul egy lap vegen). A tar a kiuritesek kozott megmarad, igy egy
+*   puffer tetszoleges szamu lapon at ujrahasznalhato.
+*/
+
+#ifndef KIMENETIPUFFER_H
+#define KIMENETIPUFFER_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+class KimenetiPuffer : private std::streambuf {
+    std::ostream& cel;          ///< A celfolyam, ahova a megtelt tar kerul
+    std::vector<char> tar;      ///< A rogzitett meretu tar
+    std::ostream kimenet;       ///< A tarba iro folyam
+    size_t irasok;              ///< A celfolyamnak atadott blokkok szama
+
+    /// A tar tartalmanak atadasa a celfolyamnak egyetlen irassal.
+    /// @return - false, ha a celfolyam hibat jelzett
+    bool atad();
+
+    /// Megtelt tar: atadas, majd a karakter elhelyezese.
+    /// @param c - A karakter (vagy eof)
+    /// @return - A karakter, vagy eof hiba eseten
+    int_type overflow(int_type c) override;
+
+    /// Tobb karakter irasa; a tarnal nagyobb darab a tar kiuritese utan kozvetlenul a celfolyamba kerul.
+    /// @param s - A karakterek
+    /// @param n - A karakterek szama
+    /// @return - A kiirt karakterek szama
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+    /// A flush() es az std::endl hatasa: a tar atadasa es a celfolyam uritese.
+    /// @return - 0, vagy -1 hiba eseten
+    int sync() override;
+
+    /// Masolo konstruktor (nem hasznalhato).
+    KimenetiPuffer(const KimenetiPuffer&);
+
+    /// Ertekado operator (nem hasznalhato).
+    KimenetiPuffer& operator=(const KimenetiPuffer&);
+
+public:
+    static const size_t ALAP_MERET = 64 * 1024;    ///< Az alapertelmezett tarmeret
+
+    /// Konstruktor.
+    /// @param c - A celfolyam (a puffernel tovabb kell elnie)
+    /// @param meret - A tar merete bajtban (legalabb 1)
+    explicit KimenetiPuffer(std::ostream& c, size_t meret = ALAP_MERET);
+
+    /// Destruktor, a maradekot atadja a celfolyamnak.
+    ~KimenetiPuffer();
+
+    /// A tarba iro folyam; a kiir() fuggvenyek es a << operatorok ebbe irhatnak.
+    /// @return - A folyam referenciaja
+    std::ostream& folyam() { return kimenet; }
+
+    /// A tar atadasa a celfolyamnak es a celfolyam uritese (peldaul egy lap vegen, bevitel kerese elott).
+    void kiurit();
+
+    /// A celfolyamnak eddig atadott blokkok szama.
+    /// @return - size_t
+    size_t getIrasok() const { return irasok; }
+};
+
+#endif // KIMENETIPUFFER_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+*   \file KmRegresszio.h
+*   Egy auto km ora allasainak linearis regressziojat futo osszegekkel szamolo osztaly deklaracioja.
+*
+*   A pontok (x = a szerviz napsorszama, y = a km ora allas a szervizkor). Az osztaly csak az
+*   n, Sx, Sy, Sxy, Sxx osszegeket tarolja 64 bites egeszekben, igy egy pont hozzaadasa es elvetele
+*   pontos (nincs lebegopontos sodrodas), a meredekseg (napi atlagos km) pedig O(1) idoben adodik.
+*   Az osszegek az elso ponthoz (x0, y0) kepest vett elteresekbol szamolodnak: ezek egy auto
+*   eleteben kicsik, igy a negyzet- es szorzatosszegek nem csordulnak tul, mint a nyers napsorszamok
+*   es km allasok szorzatai. Az n-nel szorzott osszegek kulonbseget a becsles lebegopontosan kepzi.
+*/
+
+#ifndef KMREGRESSZIO_H
+#define KMREGRESSZIO_H
+
+#include <cstdint>
+
+class KmRegresszio {
+    long long n;        ///< A pontok szama
+    int32_t x0;         ///< A viszonyitasi napsorszam (az elso pont napja)
+    int y0;             ///< A viszonyitasi km ora allas (az elso pont km-e)
+    long long sx;       ///< A napsorszam-elteresek osszege
+    long long sy;       ///< A km-elteresek osszege
+    long long sxy;      ///< A napsorszam-elteres * km-elteres szorzatok osszege
+    long long sxx;      ///< A napsorszam-elteresek negyzetosszege
+public:
+    /// Alapertelmezett konstruktor (ures regresszio).
+    KmRegresszio();
+
+    /// Egy pont hozzaadasa.
+    /// @param nap - A szerviz napsorszama
+    /// @param km - A km ora allas a szervizkor
+    void hozzaad(int32_t nap, int km);
+
+    /// Egy korabban hozzaadott pont elvetele.
+    /// @param nap - A szerviz napsorszama
+    /// @param km - A km ora allas a szervizkor
+    void elvesz(int32_t nap, int km);
+
+    /// Az osszes pont torlese.
+    void torol();
+
+    /// A pontok szama.
+    /// @return - long long
+    long long darab() const { return n; }
+
+    /// Van-e eleg adat a becslesehez (legalabb ket kulonbozo napon vett pont).
+    /// @return - true, ha a meredekseg ertelmezett
+    bool ervenyes() const;
+
+    /// A becsult napi futasteljesitmeny (a regresszios egyenes meredeksege).
+    /// @return - km/nap, vagy 0, ha a regresszio nem ervenyes
+    double napiKm() const;
+};
+
+#endif // KMREGRESSZIO_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+/**
+*   \file Lekerdezes.h
+*   Az autok es ugyfelek szuresere szolgalo kis lekerdezonyelv forditojanak es vegrehajtojanak deklaracioja.
+*
+*   Nyelvtan (a kulcsszavak es mezonevek kis- es nagybetu-erzeketlenek):
+*       kifejezes := es { "or" es }
+*       es        := nem { "and" nem }
+*       nem       := "not" nem | "(" kifejezes ")" | mezo relacio ertek
+*       relacio   := "=" | "!=" | "<" | "<=" | ">" | ">=" | "~" (szoveg tartalmazza)
+*       ertek     := "szoveg" | egesz szam | EEEE.HH.NN datum
+*   Pl.: marka = "Toyota" and kmOra > 200000 and last_vizsga < 2024.01.01
+*
+*   A fordito a kifejezest csomopontok tombjeve alakitja, a legfelso szintu "and" tagokat pedig egy
+*   koltseg szerint rendezett szurolancca. Ha valamelyik tag egy kulcs szerinti egyezes (rendszam, nev,
+*   tulajdonos), a jelolteket az adatbazis rendszam-, nev- vagy tulajdonosindexe adja bejaras nelkul,
+*   es a vegrehajtas csak rajtuk fut; kulonben teljes bejaras tortenik.
+*   A szerviztortenetbol szarmazo mezoket (last_*, szervizek, koltes) egyetlen menetben szamolja ki az
+*   esemenytar oszlopaibol, es csak akkor, ha a lekerdezes hivatkozik rajuk. Datum szerinti index nincs:
+*   a datum feltetelek (uzembe, last_*) mindig a jelolteken, a szurolanc tagjakent ertekelodnek ki.
+*   Ha egy datum mezonek nincs erteke (pl. az autonak nem volt vizsgaja), minden ra vonatkozo relacio hamis.
+*   Az elemzes es a kiertekeles rekurziv, ezert a zarojelek es tagadasok egymasba agyazasa legfeljebb
+*   MAX_AGYAZAS, a kifejezesfa magassaga (az "and"/"or" lancokat is beleertve) legfeljebb MAX_MAGASSAG lehet.
+*/
+
+#ifndef LEKERDEZES_H
+#define LEKERDEZES_H
+
+#include <string>
+#include <cstdint>
+
+#include "Vector.hpp"
+
+class SzervizNyilvantartoRendszer;
+
+/// A lekerdezes celja: mely tombben keres.
+enum class LekerdezesCel { Auto, Ugyfel };
+
+/// A jeloltek eloallitasanak modja (a legszukebb hasznalhato index).
+enum class LekerdezesHozzaferes {
+    Teljes,         ///< Minden elem bejarasa
+    Rendszam,       ///< rendszam = "..." (legfeljebb egy auto, a rendszamindexbol)
+    Nev,            ///< nev = "..." (legfeljebb egy ugyfel, a nevindexbol)
+    Tulajdonos      ///< tulajdonos = "..." (az ugyfel autoi, a tulajdonosindexbol)
+};
+
+class Lekerdezes {
+public:
+    /// A mezok erteketipusa.
+    enum class Tipus : char { Szoveg, Egesz, Datum };
+
+    /// Az osszehasonlitas fajtaja.
+    enum class Relacio : char { Egyenlo, NemEgyenlo, Kisebb, KisebbEgyenlo, Nagyobb, NagyobbEgyenlo, Tartalmaz };
+
+private:
+    /// A kifejezes egy csomopontja. A gyermekek a csomopontok tombjebeli indexukkel szerepelnek.
+    struct Csomopont {
+        enum Fajta { Es, Vagy, Nem, Feltetel } fajta;
+        size_t bal;             ///< Bal (vagy egyetlen) gyermek
+        size_t jobb;            ///< Jobb gyermek
+        size_t mezo;            ///< Feltetel eseten a mezo sorszama a mezotablaban
+        Relacio relacio;        ///< Feltetel eseten az osszehasonlitas
+        std::string szoveg;     ///< Szoveges ertek
+        long long szam;         ///< Egesz ertek, vagy datum eseten a napsorszam
+        size_t magassag;        ///< A csomoponttal kezdodo reszfa magassaga (feltetelnel 1)
+
+        Csomopont() : fajta(Feltetel), bal(0), jobb(0), mezo(0), relacio(Relacio::Egyenlo), szoveg(""), szam(0), magassag(1) {}
+    };
+
+    /// A vegrehajtas kozbeni adatok: a szerviztortenetbol szarmazo, autonkenti oszlopok.
+    struct Kornyezet;
+
+    LekerdezesCel cel;                  ///< Autokra vagy ugyfelekre vonatkozik
+    Vector<Csomopont> csomopontok;      ///< A kifejezesfa csomopontjai
+    Vector<size_t> szurok;              ///< A legfelso szintu "and" tagok, becsult koltseg szerint novekvoen
+    LekerdezesHozzaferes hozzaferes;    ///< A jeloltek eloallitasanak modja
+    std::string kulcs;                  ///< A hozzafereshez tartozo kulcs (rendszam vagy nev)
+    bool oszloposKell;                  ///< Hivatkozik-e a szerviztortenetbol szarmazo mezore
+    size_t agyazas;                     ///< Elemzes kozben: az aktualis zarojel- es tagadasmelyseg
+
+    /*-------------------------------------------
+                    Forditas
+    -------------------------------------------*/
+    /// "or" lanc elemzese.
+    /// @param s - A kifejezes
+    /// @param poz - Az aktualis pozicio (tovabblep)
+    /// @return - A letrehozott csomopont indexe
+    size_t vagyElemez(const std::string& s, size_t& poz);
+
+    /// "and" lanc elemzese.
+    /// @param s - A kifejezes
+    /// @param poz - Az aktualis pozicio (tovabblep)
+    /// @return - A letrehozott csomopont indexe
+    size_t esElemez(const std::string& s, size_t& poz);
+
+    /// Tagadas, zarojelezett kifejezes vagy feltetel elemzese.
+    /// @param s - A kifejezes
+    /// @param poz - Az aktualis pozicio (tovabblep)
+    /// @return - A letrehozott csomopont indexe
+    size_t nemElemez(const std::string& s, size_t& poz);
+
+    /// Egy "mezo relacio ertek" feltetel elemzese es tipusellenorzese.
+    /// @param s - A kifejezes
+    /// @param poz - Az aktualis pozicio (tovabblep)
+    /// @return - A letrehozott csomopont indexe
+    size_t feltetelElemez(const std::string& s, size_t& poz);
+
+    /// Uj logikai csomopont felvetele.
+    /// @param f - A csomopont fajtaja
+    /// @param bal - Bal (vagy egyetlen) gyermek
+    /// @param jobb - Jobb gyermek
+    /// @param poz - Az elemzes aktualis pozicioja (a hibauzenethez)
+    /// @return - Az uj csomopont indexe
+    /// @throws std::invalid_argument - ha a fa magassaga meghaladna a MAX_MAGASSAG-ot
+    size_t uj(Csomopont::Fajta f, size_t bal, size_t jobb, size_t poz);
+
+    /// A legfelso szintu "and" tagok osszegyujtese.
+    /// @param cs - A csomopont indexe
+    void tagokGyujtese(size_t cs);
+
+    /// A csomopont kiertekelesenek becsult koltsege (a szurolanc rendezesehez).
+    /// @param cs - A csomopont indexe
+    /// @return - Relativ koltseg
+    unsigned koltseg(size_t cs) const;
+
+    /// A hozzaferesi mod kivalasztasa a tagok kozul.
+    void hozzaferesValasztas();
+
+    /*-------------------------------------------
+                  Kiertekeles
+    -------------------------------------------*/
+    /// Egy csomopont kiertekelese egy elemre.
+    /// @param cs - A csomopont indexe
+    /// @param elem - Az auto vagy ugyfel indexe
+    /// @param k - A vegrehajtasi kornyezet
+    /// @return - true, ha az elem megfelel
+    bool kiertekel(size_t cs, size_t elem, const Kornyezet& k) const;
+
+    /// Az elem megfelel-e a szurolanc minden tagjanak (az elso hamis tagnal megall).
+    /// @param elem - Az auto vagy ugyfel indexe
+    /// @param k - A vegrehajtasi kornyezet
+    /// @return - true, ha minden tag teljesul
+    bool megfelel(size_t elem, const Kornyezet& k) const;
+
+public:
+    static const size_t MAX_AGYAZAS = 64;       ///< A zarojelek es tagadasok legnagyobb egymasba agyazasa
+    static const size_t MAX_MAGASSAG = 1024;    ///< A kifejezesfa legnagyobb magassaga
+
+    /*-------------------------------------------
+            Konstruktorok es destruktor
+    -------------------------------------------*/
+    /// Konstruktor. A kifejezest azonnal leforditja.
+    /// @param kifejezes - A szuro kifejezes
+    /// @param cel - Autokra vagy ugyfelekre vonatkozik
+    /// @throws - std::invalid_argument Szintaktikai hiba, ismeretlen mezo vagy tipuselteres eseten
+    Lekerdezes(const std::string& kifejezes, LekerdezesCel cel);
+
+
+
+    /*-------------------------------------------
+                  Lekerdezesek
+    -------------------------------------------*/
+    /// A lekerdezes vegrehajtasa.
+    /// @param db - Az adatbazis
+    /// @return - A talalatok indexei a getAutok(), illetve getUgyfelek() tombben, novekvo sorrendben
+    Vector<size_t> futtat(const SzervizNyilvantartoRendszer& db) const;
+
+    /// A valasztott hozzaferesi mod (teszteleshez es diagnosztikahoz).
+    /// @return - LekerdezesHozzaferes
+    LekerdezesHozzaferes getHozzaferes() const { return hozzaferes; }
+
+    /// A szurolanc tagjainak szama.
+    /// @return - size_t
+    size_t szurokSzama() const { return szurok.size(); }
+};
+
+#endif // LEKERDEZES_H
\ No newline at end of file
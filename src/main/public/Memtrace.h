@@ -150,7 +150,9 @@ END_NAMESPACE
 #include <sstream>
 #include <vector>
 #include <list>
+#include <deque>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <functional>
 #include <memory>
@@ -160,6 +162,10 @@ END_NAMESPACE
 #include <ostream>
 #include <stdexcept>
 #include <ctime>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #endif
 #ifdef MEMTRACE_CPP
 namespace std {
@@ -0,0 +1,17 @@
+/**
+*	\file MuveletTipus.h
+*   Ez a fajl a szervizmuveletek tipusait definialja.
+*/
+
+#ifndef MUVELETTIPUS_H
+#define MUVELETTIPUS_H
+
+/// A szervizmuvelet tipusat jelzo enum.
+/// Az ertekek megegyeznek a fajlformatumban hasznalt betujelekkel.
+enum class MuveletTipus : char {
+    Javitas = 'J',
+    Karbantartas = 'K',
+    Vizsga = 'V'
+};
+
+#endif // !MUVELETTIPUS_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+*   \file Naplo.h
+*   A modosito parancsok hozzafuzo naplojanak (journal) deklaracioja.
+*
+*   A ParancsVegrehajto a sikeresen vegrehajtott modosito parancsokat (ugyfel_uj, auto_uj, km, szerviz, ...)
+*   szo szerint gyujti, es feldolgozasi korenkent egyetlen irassal fuzi a naplo vegere: egy koteg, vagy egy
+*   olvasasbol szarmazo, egymas utan kuldott keresek sorozata egy irast jelent, nem parancsonkent egyet.
+*   Ujrainditaskor a naplo visszajatszasa ugyanazt az allapotot allitja elo.
+*
+*   A visszajatszas az indulo fajlokbol (alapallapot) betoltott rendszeren indul, ezert a naploba csak a
+*   parancsok hatasa kerulhet, kulso fajl tartalma nem: a szerviz_import a rogzitett rekordokat szerviz
+*   (es km) sorokkent naplozza, a betoltes pedig naplozas mellett nem hasznalhato. Ha mindket indulo fajl
+*   mentese megtortent, es kozben nem volt modositas, az alapallapot maga tartalmazza a naplozott
+*   parancsokat: ekkor a naplo kiurul (ellenorzopont). A ket mentes kozotti leallas utan a mar felulirt
+*   indulo fajl es a naplo egyutt nem jatszhato vissza; ilyenkor inditas elott a masik fajlt is menteni kell.
+*/
+
+#ifndef NAPLO_H
+#define NAPLO_H
+
+#include <cstddef>
+#include <string>
+#include <fstream>
+
+class ParancsVegrehajto;
+
+class Naplo {
+    std::ofstream fajl;     ///< A naplofajl (hozzafuzes modban)
+    std::string fajlNev;    ///< A naplofajl neve a hibauzenetekhez
+    std::string alapFajlok[2];  ///< Az indulo ugyfel- es autofajl (ures: nincs ellenorzopont)
+    size_t irasok;          ///< Az eddigi irasok szama
+
+    /// Masolo konstruktor (nem hasznalhato).
+    Naplo(const Naplo&);
+
+    /// Ertekado operator (nem hasznalhato).
+    Naplo& operator=(const Naplo&);
+
+public:
+    /// Konstruktor. Megnyitja (szukseg eseten letrehozza) a naplofajlt hozzafuzesre.
+    /// @param f - A naplofajl neve
+    /// @param ufl - Az indulo ugyfelfajl, amelybol a visszajatszas indul (ures: nincs ellenorzopont)
+    /// @param auo - Az indulo autofajl
+    /// @throws std::runtime_error - ha a fajl nem nyithato meg
+    explicit Naplo(const std::string& f, const std::string& ufl = "", const std::string& auo = "");
+
+    /// Parancssorok hozzafuzese egyetlen irassal.
+    /// @param sorok - Egy vagy tobb '\n'-nel lezart parancssor
+    /// @throws std::runtime_error - ha az iras sikertelen
+    void ir(const std::string& sorok);
+
+    /// Az indulo fajlok kozul melyik a megadott.
+    /// @param f - A fajl neve
+    /// @return - 0 az ugyfelfajlnal, 1 az autofajlnal, -1 egyebkent
+    int alapFajl(const std::string& f) const;
+
+    /// A naplo kiuritese (ellenorzopont): a tartalma mar benne van az indulo fajlokban.
+    /// @throws std::runtime_error - ha a fajl nem nyithato meg ujra
+    void csonkit();
+
+    /// Az eddigi irasok szama.
+    /// @return - Az irasok szama
+    size_t getIrasok() const { return irasok; }
+
+    /// A naplo visszajatszasa. A vegrehajtohoz ekkor meg nem szabad naplot rendelni,
+    /// kulonben a visszajatszott parancsok ujra a naplo vegere kerulnenek.
+    /// @param f - A naplofajl neve (ha nem letezik, nincs mit visszajatszani)
+    /// @param pv - A vegrehajto, amely a parancsokat futtatja
+    /// @return - A visszajatszott sorok szama
+    static size_t visszajatszas(const std::string& f, ParancsVegrehajto& pv);
+};
+
+#endif // NAPLO_H
\ No newline at end of file
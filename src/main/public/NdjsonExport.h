@@ -0,0 +1,138 @@
+/**
+*   \file NdjsonExport.h
+*   A rendszer adatainak folyamos NDJSON (soronkent egy JSON objektum) exportjanak deklaracioja.
+*
+*   Minden sor egy ugyfelet, autot vagy szervizmuveletet ir le; a "rekord" mezo adja meg, melyiket:
+*       {"rekord":"ugyfel","nev":"Kiss Pal","telefonszam":"+36 1 111","email":"kiss@pal.hu"}
+*       {"rekord":"auto","rendszam":"ABC123","marka":"Opel","tipus":"Astra","kmOra":50000,
+*        "uzembeHelyezes":"2015-01-01","tulajdonos":"Kiss Pal"}
+*       {"rekord":"szerviz","rendszam":"ABC123","muveletTipus":"karbantartas","muvelet":"Olajcsere",
+*        "datum":"2024-01-10","ar":20000,"kmOra":50000}     (vizsganal meg: "sikeres":true|false)
+*   Elobb az ugyfelek, utana autonkent az auto es kozvetlenul utana a szervizmuveletei kovetkeznek.
+*   A datumok ISO 8601 (EEEE-HH-NN) formatumuak.
+*
+*   Az exportalo egy rogzitett meretu tarba formaz (a szamokat es datumokat kezzel, a szovegeket a JSON
+*   szabalyai szerint escape-elve), es csak a megtelt tarat adja at a celfolyamnak egyetlen irassal, ezert
+*   rekordonkent nincs memoriafoglalas es nincs folyam-hivas; nagy exportnal a sebesseget a lemez szabja meg.
+*   A szovegek bajtjai valtozatlanul kerulnek ki (a rendszer csak ekezet nelkuli szoveget tarol).
+*/
+
+#ifndef NDJSONEXPORT_H
+#define NDJSONEXPORT_H
+
+#include <cstddef>
+#include <string>
+#include <ostream>
+#include <vector>
+
+#include "Lekerdezes.h"
+
+class SzervizNyilvantartoRendszer;
+class Datum;
+class Ugyfel;
+class Auto;
+struct SzervizRekord;
+
+class NdjsonExport {
+    std::ostream& cel;          ///< A celfolyam
+    std::vector<char> tar;      ///< A rogzitett meretu tar
+    char* poz;                  ///< Az elso szabad bajt a tarban
+    char* veg;                  ///< A tar vege
+    size_t ugyfelek;            ///< Az eddig kiirt ugyfelsorok szama
+    size_t autok;               ///< Az eddig kiirt autosorok szama
+    size_t szervizek;           ///< Az eddig kiirt szervizsorok szama
+
+    /// A tar tartalmanak atadasa a celfolyamnak egyetlen irassal.
+    /// @throws std::runtime_error - ha a celfolyam hibat jelzett
+    void atad();
+
+    /// Legalabb n szabad bajt biztositasa a tarban (szukseg eseten atad).
+    /// @param n - A szukseges bajtok szama (legfeljebb a tar merete)
+    void hely(size_t n) { if (static_cast<size_t>(veg - poz) < n) atad(); }
+
+    /// Rovid, escape-elest nem igenylo szoveg (kulcsok, irasjelek) irasa.
+    /// @param s - A szoveg
+    /// @param n - A hossza (legfeljebb a tar merete)
+    void nyers(const char* s, size_t n);
+
+    /// Szoveg irasa JSON szovegkent, idezojelek kozott, escape-elve.
+    /// @param s - A szoveg
+    void szoveg(const std::string& s);
+
+    /// Egesz szam irasa.
+    /// @param x - A szam
+    void szam(long long x);
+
+    /// Datum irasa "EEEE-HH-NN" JSON szovegkent.
+    /// @param d - A datum
+    void datum(const Datum& d);
+
+    /// Masolo konstruktor (nem hasznalhato).
+    NdjsonExport(const NdjsonExport&);
+
+    /// Ertekado operator (nem hasznalhato).
+    NdjsonExport& operator=(const NdjsonExport&);
+
+public:
+    static const size_t ALAP_MERET = 1024 * 1024;  ///< Az alapertelmezett tarmeret
+    static const size_t MIN_MERET = 64;            ///< A legkisebb tarmeret (egy sor fix reszei elferjenek)
+
+    /*-------------------------------------------
+            Konstruktor es destruktor
+    -------------------------------------------*/
+    /// Konstruktor.
+    /// @param c - A celfolyam (az exportalonal tovabb kell elnie)
+    /// @param meret - A tar merete bajtban (legalabb MIN_MERET)
+    explicit NdjsonExport(std::ostream& c, size_t meret = ALAP_MERET);
+
+    /// Destruktor, a maradekot atadja a celfolyamnak (a hibat itt mar nem jelzi; ehhez kiurit() kell).
+    ~NdjsonExport();
+
+
+
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Egy ugyfel soranak kiirasa.
+    /// @param u - Az ugyfel
+    void ugyfel(const Ugyfel& u);
+
+    /// Egy auto soranak kiirasa (a szervizmuveletei nelkul).
+    /// @param a - Az auto
+    void autoSor(const Auto& a);
+
+    /// Egy szervizmuvelet soranak kiirasa.
+    /// @param rendszam - Az auto rendszama
+    /// @param r - A muvelet rekordja
+    void szerviz(const std::string& rendszam, const SzervizRekord& r);
+
+    /// Az egesz rendszer exportja: az ugyfelek, majd autonkent az auto es a szervizmuveletei.
+    /// @param db - A rendszer
+    void adatbazis(const SzervizNyilvantartoRendszer& db);
+
+    /// Szurt export. Autokra szurve a talalt autok, szervizmuveleteik es tulajdonosaik; ugyfelekre
+    /// szurve a talalt ugyfelek, autoik es azok szervizmuveletei kerulnek ki, az eredeti sorrendben.
+    /// @param db - A rendszer
+    /// @param szuro - A szuro kifejezes (lasd Lekerdezes)
+    /// @param c - Autokra vagy ugyfelekre vonatkozik
+    /// @throws std::invalid_argument - ha a szuro hibas
+    void adatbazis(const SzervizNyilvantartoRendszer& db, const std::string& szuro, LekerdezesCel c);
+
+    /// A tar atadasa es a celfolyam uritese.
+    /// @throws std::runtime_error - ha a celfolyam hibat jelzett
+    void kiurit();
+
+    /// Az eddig kiirt ugyfelsorok szama.
+    /// @return - size_t
+    size_t getUgyfelek() const { return ugyfelek; }
+
+    /// Az eddig kiirt autosorok szama.
+    /// @return - size_t
+    size_t getAutok() const { return autok; }
+
+    /// Az eddig kiirt szervizsorok szama.
+    /// @return - size_t
+    size_t getSzervizek() const { return szervizek; }
+};
+
+#endif // NDJSONEXPORT_H
\ No newline at end of file
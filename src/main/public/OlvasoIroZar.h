@@ -0,0 +1,133 @@
+/**
+*   \file OlvasoIroZar.h
+*   Olvaso-iro zar es savozott olvasoszamlalo deklaracioja.
+*
+*   Az olvasok egy savozott szamlalot hasznalnak: minden szal a sajat, kulon gyorsitotar-sorba eso
+*   szamlalojat noveli, igy a parhuzamos olvasok nem versenyeznek ugyanazert a memoriateruletert, es az
+*   olvasasi atbocsatokepesseg a magok szamaval skalazodik. Az iro eloszor jelzi a szandekat (az uj
+*   olvasok ekkor varnak), majd megvarja, hogy az osszes sav kiuruljon. A C++11 szabvanykonyvtarban
+*   meg nincs std::shared_mutex, ezert sajat megvalositas.
+*
+*   A zarolas nelkuli olvasok (RendszamIndex) nem varnak az irora, ezert nekik a szamlalo ket korszakot
+*   tart: az olvaso a belepeskor ervenyes korszak szamlalojat noveli, a turelmiIdo() pedig korszakot valt,
+*   es csak a regi korszak kiurulesere var. A valtas utan belepo olvasok az uj korszakba kerulnek, igy az
+*   iro csak veges szamu, mar megkezdett olvasasra var, es folyamatos olvasoforgalom sem eheztetheti ki.
+*/
+
+#ifndef OLVASOIROZAR_H
+#define OLVASOIROZAR_H
+
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+/// Savozott, ket korszakos szamlalo: szalankent (sav szerint) es korszakonkent kulon atomi szamlalo.
+class OlvasoSzamlalo {
+public:
+    static const size_t SAVOK = 16;     ///< A savok szama
+
+private:
+    /// Egy sav a ket korszak szamlalojaval; a kitoltes miatt a szomszedos savok kulon gyorsitotar-sorba esnek.
+    struct Sav {
+        std::atomic<long> db[2];
+        char kitoltes[64 - 2 * sizeof(std::atomic<long>)];
+        Sav() { db[0].store(0); db[1].store(0); }
+    };
+
+    Sav savok[SAVOK];           ///< A savok
+    std::atomic<unsigned> korszak;  ///< Az uj olvasok korszaka (0 vagy 1)
+
+    /// Megvarja, amig a korszak minden savja legalabb egyszer nullanak latszik.
+    /// @param k - A korszak
+    void korszakKiurulesereVar(unsigned k) const;
+
+    /// Masolo konstruktor (nem hasznalhato).
+    OlvasoSzamlalo(const OlvasoSzamlalo&);
+
+    /// Ertekado operator (nem hasznalhato).
+    OlvasoSzamlalo& operator=(const OlvasoSzamlalo&);
+
+public:
+    /// Alapertelmezett konstruktor (minden sav nulla, a 0. korszak ervenyes).
+    OlvasoSzamlalo() : korszak(0) {}
+
+    /// A hivo szal savjanak sorszama (szalankent egyszer osztodik ki, korbeforgo modon).
+    /// @return - 0 <= sav < SAVOK
+    static size_t sajatSav();
+
+    /// Belepes: a hivo szal savjanak novelese az aktualis korszakban.
+    /// @return - A korszak, amelyet a kilep()-nek vissza kell adni
+    unsigned belep() {
+        const unsigned k = korszak.load();
+        savok[sajatSav()].db[k].fetch_add(1);
+        return k;
+    }
+
+    /// Kilepes: a hivo szal savjanak csokkentese a belepeskori korszakban.
+    /// @param k - A belep() altal visszaadott korszak
+    void kilep(unsigned k) { savok[sajatSav()].db[k].fetch_sub(1); }
+
+    /// Megvarja, amig minden sav mindket korszakban legalabb egyszer nullanak latszik.
+    /// Csak akkor er veget, ha uj belepok nem jonnek (az OlvasoIroZar ezert elobb feltartja oket).
+    void kiurulesreVar() const;
+
+    /// Turelmi ido: a hivas elott belepett olvasok mind kilepnek, mire visszater. Ket korszakvaltas kell,
+    /// mert egy olvaso a korszak kiolvasasa es a novelese kozott az elso valtason at is kesleltetodhet;
+    /// legfeljebb a masodik valtas elott belepett olvasokra var, a kesobb belepokre nem.
+    /// Egyszerre csak egy szal hivhatja.
+    void turelmiIdo();
+};
+
+/// Olvaso-iro zar: tobb olvaso egyszerre, iro csak egyedul. Az iro elsobbseget elvez.
+class OlvasoIroZar {
+    OlvasoSzamlalo olvasok;             ///< A zarat tarto olvasok
+    std::atomic<bool> iroVar;           ///< Iro jelezte a szandekat vagy tartja a zarat
+    std::mutex irokZar;                 ///< Az irokat egymas kozott sorba allito zar
+    std::mutex jelzesZar;               ///< Az iro tavozasat jelzo valtozohoz tartozo zar
+    std::condition_variable iroTavozott;///< Az iro tavozasat jelzo valtozo
+
+    /// Masolo konstruktor (nem hasznalhato).
+    OlvasoIroZar(const OlvasoIroZar&);
+
+    /// Ertekado operator (nem hasznalhato).
+    OlvasoIroZar& operator=(const OlvasoIroZar&);
+
+public:
+    /// Alapertelmezett konstruktor.
+    OlvasoIroZar() : iroVar(false) {}
+
+    /// Megosztott (olvasasi) zarolas. Ha iro var vagy dolgozik, a hivo blokkolodik.
+    void olvasoZarol();
+
+    /// A megosztott zar elengedese. A zar nem valt korszakot, ezert minden olvaso a 0. korszakban van.
+    void olvasoElenged() { olvasok.kilep(0); }
+
+    /// Kizarolagos (irasi) zarolas: megvarja a bent levo olvasokat, az ujakat feltartja.
+    void iroZarol();
+
+    /// A kizarolagos zar elengedese, a varakozo olvasok felebresztese.
+    void iroElenged();
+};
+
+/// RAII olvasasi zar az OlvasoIroZar-hoz.
+class MegosztottZar {
+    OlvasoIroZar& zar;
+    MegosztottZar(const MegosztottZar&);
+    MegosztottZar& operator=(const MegosztottZar&);
+public:
+    explicit MegosztottZar(OlvasoIroZar& z) : zar(z) { zar.olvasoZarol(); }
+    ~MegosztottZar() { zar.olvasoElenged(); }
+};
+
+/// RAII irasi zar az OlvasoIroZar-hoz.
+class KizarolagosZar {
+    OlvasoIroZar& zar;
+    KizarolagosZar(const KizarolagosZar&);
+    KizarolagosZar& operator=(const KizarolagosZar&);
+public:
+    explicit KizarolagosZar(OlvasoIroZar& z) : zar(z) { zar.iroZarol(); }
+    ~KizarolagosZar() { zar.iroElenged(); }
+};
+
+#endif // OLVASOIROZAR_H
\ No newline at end of file
@@ -0,0 +1,139 @@
+/**
+*   \file ParancsVegrehajto.h
+*   Soralapu szoveges parancsok ertelmezese es vegrehajtasa a SzervizNyilvantartoRendszer-en.
+*
+*   Egy parancs egy sor, a mezoket tabulator valasztja el, az elso mezo a parancs neve.
+*   A valasz elso sora "OK <n>" vagy "ERR <uzenet>"; OK utan n adatsor kovetkezik, a mezok
+*   szinten tabulatorral elvalasztva. Igy a valasz gepileg egyszeruen feldolgozhato, es egy
+*   kapcsolaton tobb keres is elkuldheto a valaszok megvarasa nelkul (a valaszok sorrendje azonos).
+*
+*   Parancsok (a <> mezok kotelezoek, a [] mezok elhagyhatok):
+*       ping
+*       ugyfel_uj       <nev> <telefon> <email>
+*       ugyfel_frissit  <nev> <telefon> <email>
+*       ugyfel_torol    <nev>                       (az ugyfel autoival egyutt)
+*       ugyfel          <nev>                       -> nev, telefon, email, autok, szervizek, koltes, utolso latogatas
+*       auto_uj         <rendszam> <marka> <tipus> <km> <uzembe helyezes> <tulajdonos>
+*       km              <rendszam> <km>
+*       auto_torol      <rendszam>
+*       auto            <rendszam>                  -> rendszam, marka, tipus, km, uzembe helyezes, tulajdonos;
+*                                                      utana muveletenkent: tipus, datum, leiras, ar, km, sikeres
+*       szerviz         <rendszam> <J|K|V> <datum> <leiras> <ar> <km> [sikeres: 0|1]
+*       szerviz_torol   <rendszam> <datum>
+*       keres           <auto|ugyfel> <szuro>       -> rendszamok vagy nevek (lasd Lekerdezes)
+*       figyelmeztetes  [datum]                     -> rendszam, uzenet, D|K, tullepes
+*       mentes          <fajl>                      (az indulo fajlok mentese naplo-ellenorzopont lehet, lasd Naplo)
+*       betoltes        <fajl>                      (naplozas mellett nem hasznalhato)
+*       szerviz_import  <csv fajl>                  -> rogzitett, elutasitott; utana elutasitott soronkent: sorszam, ok
+*                                                      (lasd SzervizNyilvantartoRendszer::szervizImportCsv());
+*                                                      a naploba a rogzitett rekordok kerulnek szerviz sorokkent
+*       export          <fajl> [<auto|ugyfel> <szuro>]  -> ugyfelek, autok, szervizek szama (NDJSON, lasd NdjsonExport)
+*   A datumok formatuma EEEE.HH.NN.
+*
+*   Koteg (batch): a "batch <n>" sort kovetoen n parancssor egyetlen egysegkent fut le (lasd feldolgoz()).
+*   Valasza egyetlen "OK <m>" keret, amelynek m sora az n parancs valasza egymas utan. A koteg nem
+*   tranzakcio: egy hibas parancs ERR valaszt kap, a tobbi ettol meg vegrehajtodik.
+*/
+
+#ifndef PARANCSVEGREHAJTO_H
+#define PARANCSVEGREHAJTO_H
+
+#include <cstddef>
+#include <string>
+
+class SzervizNyilvantartoRendszer;
+class Naplo;
+
+class ParancsVegrehajto {
+public:
+    static const size_t MAX_MEZO = 8;           ///< Egy parancs legfeljebb ennyi mezobol allhat
+    static const size_t MAX_KOTEG = 1000000;    ///< Egy koteg legfeljebb ennyi parancsbol allhat
+
+    /// Egy mezo a parancssorban (a sor egy szelete, masolas nelkul).
+    struct Mezo {
+        const char* p;  ///< A mezo elso karaktere
+        size_t n;       ///< A mezo hossza
+    };
+
+private:
+    SzervizNyilvantartoRendszer& db;    ///< A rendszer, amelyen a parancsok futnak
+    Naplo* naplo;                       ///< A modosito parancsok naploja (nullptr, ha nincs)
+    std::string naploPuffer;            ///< A naplozando, meg ki nem irt parancssorok
+    std::string kotegPuffer;            ///< Egy koteg valaszai a fejlec megirasaig
+    size_t hibak;                       ///< Az eddig adott ERR valaszok szama
+    unsigned mentettAlapFajlok;         ///< Az utolso modositas ota mentett indulo fajlok (bitenkent)
+
+    /// Egy parancssor vegrehajtasa; a sikeres modosito parancsot a naploPuffer-be gyujti.
+    /// @param sor - A sor elso karaktere
+    /// @param hossz - A sor hossza
+    /// @param ki - A valasz a vegere kerul
+    /// @return - false, ha a valasz ERR, kulonben true
+    bool egyVegrehajt(const char* sor, size_t hossz, std::string& ki);
+
+    /// Egy koteg vegrehajtasa.
+    /// @param sorok - A koteg elso parancssora
+    /// @param veg - A koteg utolso sora utani pozicio
+    /// @param n - A parancsok szama (a hivo ellenorizte, hogy mind az n sor '\n'-nel lezart)
+    /// @param ki - Az "OK <m>" keret a vegere kerul
+    void kotegVegrehajt(const char* sorok, const char* veg, size_t n, std::string& ki);
+
+    /// Sikeres mentes utan a naplo kiuritese, ha az utolso modositas ota mindket indulo fajl mentese megtortent.
+    /// @param fajl - A mentett fajl neve
+    /// @throws std::runtime_error - ha a naplofajl nem nyithato meg ujra
+    void ellenorzopont(const std::string& fajl);
+
+    /// A naploPuffer kiirasa egyetlen irassal.
+    void naploKiir();
+
+    /// Masolo konstruktor (nem hasznalhato).
+    ParancsVegrehajto(const ParancsVegrehajto&);
+
+    /// Ertekado operator (nem hasznalhato).
+    ParancsVegrehajto& operator=(const ParancsVegrehajto&);
+
+public:
+    /// Konstruktor.
+    /// @param d - A rendszer, amelyen a parancsok futnak
+    explicit ParancsVegrehajto(SzervizNyilvantartoRendszer& d) : db(d), naplo(nullptr), naploPuffer(), kotegPuffer(), hibak(0), mentettAlapFajlok(0) {}
+
+    /// Naplo hozzarendelese. A modosito parancsok ezutan feldolgozasi korenkent egy irassal naplozodnak.
+    /// @param n - A naplo (nullptr: nincs naplozas); a vegrehajtonal tovabb kell elnie
+    void setNaplo(Naplo* n) { naplo = n; mentettAlapFajlok = 0; }
+
+    /// Az eddig adott ERR valaszok szama (a kotegeken belulieket is beleertve).
+    /// @return - size_t
+    size_t getHibak() const { return hibak; }
+
+    /// Egy parancssor vegrehajtasa. A sor vegi '\r' es '\n' nem szamit bele.
+    /// Ures sor eseten nem ir valaszt. Kotegfejlecet nem fogad el (lasd feldolgoz()).
+    /// @param sor - A sor elso karaktere
+    /// @param hossz - A sor hossza
+    /// @param ki - A valasz a vegere kerul
+    /// @return - false, ha a valasz ERR, kulonben true
+    bool vegrehajt(const char* sor, size_t hossz, std::string& ki);
+
+    /// Egy parancssor vegrehajtasa.
+    /// @param sor - A sor
+    /// @param ki - A valasz a vegere kerul
+    /// @return - false, ha a valasz ERR, kulonben true
+    bool vegrehajt(const std::string& sor, std::string& ki) { return vegrehajt(sor.data(), sor.size(), ki); }
+
+    /// A pufferben levo teljes keretek (parancssorok es kotegek) vegrehajtasa sorrendben.
+    /// A modosito parancsok a hivas vegen egyetlen naploirassal rogzulnek, a valaszok kuldese elott.
+    /// @param adat - A beolvasott adatok eleje
+    /// @param hossz - A beolvasott adatok hossza
+    /// @param ki - A valaszok a vegere kerulnek
+    /// @param kiKorlat - Ha ki merete ezt meghaladja, nem kezd uj keretbe
+    /// @return - A feldolgozott bajtok szama (a maradek egy befejezetlen sor vagy koteg)
+    /// @throws std::runtime_error - ha a naploiras sikertelen (a valaszok ekkor nem kuldhetok el)
+    size_t feldolgoz(const char* adat, size_t hossz, std::string& ki, size_t kiKorlat = static_cast<size_t>(-1));
+
+    /// A sor mezokre bontasa tabulatorok menten.
+    /// @param sor - A sor elso karaktere
+    /// @param hossz - A sor hossza ('\r' es '\n' nelkul)
+    /// @param mezok - Legalabb MAX_MEZO + 1 elemu tomb
+    /// @return - A mezok szama (MAX_MEZO + 1, ha tul sok)
+    static size_t feloszt(const char* sor, size_t hossz, Mezo* mezok);
+};
+
+#endif // PARANCSVEGREHAJTO_H
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+*   \file ParticionaltNyilvantarto.h
+*   Rendszam szerint szeletekre (shard) osztott, tobbszalu hasznalatra keszult nyilvantarto deklaracioja.
+*
+*   Az autok a rendszamuk hasitokodja szerint N szelet egyikebe kerulnek. Minden szelet egy sajat
+*   SzervizNyilvantartoRendszer a sajat zarjaval: a szelet autoit, azok szarmaztatott strukturait
+*   (esemenytar, emlekezteto, ugyfelosszesitok) es az autok tulajdonosainak masolatat tartja. Igy a
+*   kulonbozo szeletekbe eso autok modositasai (km ora, uj szerviz) parhuzamosan futnak. Egy auto
+*   modositasa a szelet szarmaztatott adatait (rendszamindex is) helyben, az auto tortenetevel aranyos
+*   idoben frissiti; a szelet irasonkenti szarmaztatottAdatokFrissitese() hivasa ilyenkor mar nem epit ujra.
+*
+*   Az ugyfelek torzsadatai egyetlen, kulon zarolt ugyfeltarban vannak; a szeletekben levo tulajdonos-
+*   masolatokat az ugyfeltar modositasai (frissites, kaszkad torles) hangoljak ossze. A tobb szeletet
+*   erinto muveletek mindig az ugyfeltar zarjat veszik elobb, utana a szeletekeit novekvo sorrendben,
+*   ezert nem alakulhat ki holtpont.
+*/
+
+#ifndef PARTICIONALTNYILVANTARTO_H
+#define PARTICIONALTNYILVANTARTO_H
+
+#include <cstddef>
+#include <string>
+#include <ostream>
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "SzervizNyilvantartoRendszer.h"
+#include "OlvasoIroZar.h"
+
+class ParticionaltNyilvantarto {
+    /// Egy szelet: a hozza tartozo autok rendszere es zarja.
+    struct Szelet {
+        SzervizNyilvantartoRendszer db;     ///< A szelet autoi es azok tulajdonosainak masolatai
+        mutable OlvasoIroZar zar;           ///< Olvasok: lekerdezesek, iro: a szelet modositasai
+    };
+
+    std::vector<std::unique_ptr<Szelet> > szeletek; ///< A szeletek
+    SzervizNyilvantartoRendszer ugyfelTar;          ///< Az ugyfelek torzsadatai (autok nelkul)
+    mutable OlvasoIroZar ugyfelZar;                 ///< Az ugyfeltar zarja
+
+    /// A rendszamhoz tartozo szelet.
+    /// @param r - A rendszam
+    /// @return - A szelet
+    Szelet& szelet(const std::string& r) const { return *szeletek[szeletIndex(r)]; }
+
+    /// Az osszes szelet zarolasa novekvo sorrendben, a fuggveny futtatasa, majd a zarak elengedese.
+    /// @param kizarolagos - Irasi (true) vagy olvasasi (false) zarak
+    /// @param f - A zarak alatt futo fuggveny
+    void mindenSzeletZarral(bool kizarolagos, const std::function<void()>& f) const;
+
+    /// Masolo konstruktor (nem hasznalhato).
+    ParticionaltNyilvantarto(const ParticionaltNyilvantarto&);
+
+    /// Ertekado operator (nem hasznalhato).
+    ParticionaltNyilvantarto& operator=(const ParticionaltNyilvantarto&);
+
+public:
+    /*-------------------------------------------
+            Konstruktor es destruktor
+    -------------------------------------------*/
+    /// Konstruktor (ures rendszer).
+    /// @param szeletekSzama - A szeletek szama
+    /// @throws std::invalid_argument - ha a szeletek szama 0
+    explicit ParticionaltNyilvantarto(size_t szeletekSzama = 8);
+
+
+
+    /*-------------------------------------------
+            Lekerdezesek (megosztott zar)
+    -------------------------------------------*/
+    /// A szeletek szama.
+    /// @return - size_t
+    size_t getSzeletekSzama() const { return szeletek.size(); }
+
+    /// A rendszamhoz tartozo szelet sorszama.
+    /// @param r - A rendszam
+    /// @return - A szelet sorszama [0, getSzeletekSzama())
+    size_t szeletIndex(const std::string& r) const;
+
+    /// Az autok szama (szeletenkent osszegezve).
+    /// @return - size_t
+    size_t autokSzama() const;
+
+    /// Auto letezesenek ellenorzese (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @return - true, ha az auto szerepel
+    bool vanAuto(const std::string& r) const;
+
+    /// Ugyfel letezesenek ellenorzese.
+    /// @param n - Az ugyfel neve
+    /// @return - true, ha az ugyfel szerepel
+    bool vanUgyfel(const std::string& n) const;
+
+    /// Auto keresese rendszam alapjan (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+    /// @param tulajdonos - Ha nem nullptr, ide kerul a tulajdonos masolata
+    /// @return - true, ha az auto szerepel
+    bool keresAuto(const std::string& r, Auto& ki, Ugyfel* tulajdonos = nullptr) const;
+
+    /// Ugyfel keresese nev alapjan.
+    /// @param n - Az ugyfel neve
+    /// @param ki - Az ugyfel masolata
+    /// @return - true, ha az ugyfel szerepel
+    bool keresUgyfel(const std::string& n, Ugyfel& ki) const;
+
+    /// Az auto szervizmuveleteinek kiirasa.
+    /// @param os - A kimeneti adatfolyam
+    /// @param r - A rendszam
+    void lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const;
+
+    /// A flotta figyelmeztetesei: a szeletek parhuzamosan, a kozos szalkeszleten ertekelodnek ki.
+    /// @param ma - A referencia datum
+    /// @return - A figyelmeztetesek rendszam, azon belul szabaly szerint rendezve
+    Vector<Figyelmeztetes> flottaFigyelmeztetesek(const Datum& ma = Datum(2025, 4, 14)) const;
+
+    /// Mentes fajlba ("_ufl.txt": az ugyfeltar, "_auo.txt": az autok szeletenkent).
+    /// Az autofajl az osszes szelet olvasasi zarja alatt, konzisztens allapotbol keszul.
+    /// @param f - A celfajl neve
+    void mentesFajlba(const std::string& f) const;
+
+
+
+    /*-------------------------------------------
+        Modositasok (kizarolagos zar)
+    -------------------------------------------*/
+    /// Uj ugyfel felvetele.
+    /// @param u - Az ugyfel
+    /// @return - false, ha mar letezik
+    bool ujUgyfel(const Ugyfel& u);
+
+    /// Ugyfel adatainak frissitese az ugyfeltarban es a szeletekben levo masolataiban.
+    /// @param u - Az ugyfel uj adatai (nev szerint azonositva)
+    /// @return - false, ha nem talalhato
+    bool frissitUgyfel(const Ugyfel& u);
+
+    /// Ugyfel es autoinak torlese az osszes szeletbol (kaszkad torles, minden zar alatt).
+    /// @param n - Az ugyfel neve
+    /// @return - false, ha nem talalhato
+    bool torolUgyfel(const std::string& n);
+
+    /// Uj auto felvetele a sajat szeletebe.
+    /// @param a - Az auto (a tulajdonos-mutatoja figyelmen kivul marad)
+    /// @param tulajdonosNev - A tulajdonos neve
+    /// @return - false, ha az auto mar letezik vagy a tulajdonos nem talalhato
+    bool ujAuto(const Auto& a, const std::string& tulajdonosNev);
+
+    /// Km ora frissitese (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @param k - Az uj km ora allas
+    /// @return - false, ha az auto nem talalhato
+    bool frissitKmOra(const std::string& r, int k);
+
+    /// Szervizmuvelet rogzitese (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @param m - A muvelet rekordja
+    /// @return - false, ha az auto nem talalhato
+    bool rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m);
+
+    /// Szervizmuvelet torlese datum alapjan (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @param d - A muvelet datuma
+    /// @return - false, ha az auto vagy a muvelet nem talalhato
+    bool torolMuvelet(const std::string& r, const Datum& d);
+
+    /// Auto torlese (csak a sajat szeletet zarolja).
+    /// @param r - A rendszam
+    /// @return - false, ha nem talalhato
+    bool torolAuto(const std::string& r);
+
+    /// Rendszeradatok betoltese fajlbol (az ugyfeltar es az osszes szelet zarja alatt).
+    /// Az autofajlban szereplo, meg nem letezo tulajdonosok ures elerhetoseggel jonnek letre;
+    /// a mar letezo rendszamu autok kimaradnak.
+    /// @param f - A fajl neve ("_ufl.txt" vagy "_auo.txt")
+    void betoltesFajlbol(const std::string& f);
+};
+
+#endif // PARTICIONALTNYILVANTARTO_H
\ No newline at end of file
@@ -0,0 +1,268 @@
+/**
+*   \file PerzisztensVektor.hpp
+*   Megvaltoztathatatlan, szerkezetmegoszto (perzisztens) vektor sablon osztaly.
+*
+*   Az elemek egy 32-es elagazasu fa leveleiben allnak. A "modosito" muveletek (hozzafuz, csere) nem
+*   valtoztatjak meg a vektort, hanem uj valtozatot adnak vissza: csak a gyokertol az erintett levelig
+*   vezeto utat masoljak le (legfeljebb log32(n) csomopont), minden mas csomopontot es elemet a regi
+*   valtozattal megosztva hasznalnak. A regi valtozat igy valtozatlanul olvashato tovabb, tetszoleges
+*   szalrol, zarolas nelkul; a csomopontokat a hivatkozasszamlalas szabaditja fel, amikor az utolso
+*   valtozat is megszunik, amely hasznalta oket.
+*
+*   A torles sem epiti ujra a fat: a torolt elem helyen ures hely (sirko) marad, a belso csomopontok
+*   pedig gyerekenkent szamontartjak az elo elemeket, igy az i. elo elem O(AG * log32(n)) lepesben
+*   megtalalhato. Sirko nelkul az indexeles a bitekbol kozvetlenul szamol. Ha a sirkovek szama
+*   meghaladja az elo elemeket, a torles egyszer tomoriti a fat, igy a torlesek koltsege atlagosan
+*   is logaritmikus marad.
+*/
+
+#ifndef PERZISZTENSVEKTOR_HPP
+#define PERZISZTENSVEKTOR_HPP
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// Perzisztens vektor.
+/// @tparam T A tarolt elemek tipusa (az elemek megvaltoztathatatlanok, mutatokent megosztva).
+template <typename T>
+class PerzisztensVektor {
+public:
+    typedef std::shared_ptr<const T> ElemMutato;   ///< Megosztott, megvaltoztathatatlan elem
+
+private:
+    static const unsigned BITEK = 5;                ///< Az egy szinten felhasznalt indexbitek
+    static const size_t AG = size_t(1) << BITEK;    ///< Az elagazasi tenyezo
+    static const size_t MASZK = AG - 1;             ///< Az egy szintre eso indexresz maszkja
+
+    /// A fa csomopontjainak kozos ose (a melyseg donti el, hogy level vagy belso csomopont).
+    struct Csomopont {
+        virtual ~Csomopont() {}
+    };
+    typedef std::shared_ptr<const Csomopont> CsomopontMutato;
+
+    /// Levelcsomopont: legfeljebb AG hely, balrol folytonosan kiosztva (a torolt elemek helye nullptr).
+    struct Level : Csomopont {
+        ElemMutato elemek[AG];
+    };
+
+    /// Belso csomopont: legfeljebb AG gyerek, balrol folytonosan kitoltve, gyerekenkent az elo elemek szamaval.
+    struct Belso : Csomopont {
+        CsomopontMutato gyerekek[AG];
+        size_t darab[AG];       ///< Az egyes gyerekek reszfajaban levo elo elemek szama
+
+        Belso() : Csomopont(), gyerekek(), darab() {}
+    };
+
+    CsomopontMutato gyoker;     ///< A fa gyokere (nullptr, ha a vektor ures)
+    size_t meret;               ///< Az elo elemek szama
+    size_t helyek;              ///< A kiosztott helyek szama (elo elemek es sirkovek)
+    unsigned eltolas;           ///< A gyoker szintjenek eltolasa bitekben (0: a gyoker level)
+
+    /// Konstruktor a reszekbol.
+    PerzisztensVektor(const CsomopontMutato& g, size_t m, size_t h, unsigned e) : gyoker(g), meret(m), helyek(h), eltolas(e) {}
+
+    /// Az i. hely beirasa: a csomopont masolata (vagy uj csomopont), az erintett gyerek rekurzivan.
+    /// @param cs - A csomopont (nullptr: meg nem letezo csomopont)
+    /// @param e - A csomopont szintjenek eltolasa
+    /// @param h - A hely indexe
+    /// @param x - Az elem (nullptr: sirko)
+    /// @param valtozas - Az elo elemek szamanak valtozasa (+1 uj elem, 0 csere, -1 torles)
+    /// @return - Az uj csomopont
+    static CsomopontMutato beir(const CsomopontMutato& cs, unsigned e, size_t h, const ElemMutato& x, int valtozas) {
+        if (e == 0) {
+            std::unique_ptr<Level> uj(cs ? new Level(static_cast<const Level&>(*cs)) : new Level());
+            uj->elemek[h & MASZK] = x;
+            return CsomopontMutato(uj.release());
+        }
+        std::unique_ptr<Belso> uj(cs ? new Belso(static_cast<const Belso&>(*cs)) : new Belso());
+        const size_t j = (h >> e) & MASZK;
+        uj->gyerekek[j] = beir(uj->gyerekek[j], e - BITEK, h, x, valtozas);
+        uj->darab[j] += valtozas;
+        return CsomopontMutato(uj.release());
+    }
+
+    /// Az i. elo elem helye a faban.
+    /// @param i - Az elem indexe (< size())
+    /// @return - A hely indexe
+    size_t hely(size_t i) const {
+        if (meret == helyek) return i; // nincs sirko: az index es a hely egybeesik
+        const Csomopont* cs = gyoker.get();
+        size_t h = 0;
+        for (unsigned e = eltolas; e > 0; e -= BITEK) {
+            const Belso* b = static_cast<const Belso*>(cs);
+            size_t j = 0;
+            while (b->darab[j] <= i)
+                i -= b->darab[j++];
+            h |= j << e;
+            cs = b->gyerekek[j].get();
+        }
+        const Level* l = static_cast<const Level*>(cs);
+        for (size_t k = 0; ; k++)
+            if (l->elemek[k] && i-- == 0) return h | k;
+    }
+
+    /// A reszfa elemeinek bejarasa sorrendben.
+    /// @param cs - A csomopont
+    /// @param e - A csomopont szintjenek eltolasa
+    /// @param f - A minden elemre meghivott fuggveny
+    template <typename F>
+    static void bejar(const Csomopont& cs, unsigned e, F& f) {
+        if (e == 0) {
+            const Level& l = static_cast<const Level&>(cs);
+            for (size_t k = 0; k < AG; k++)
+                if (l.elemek[k]) f(*l.elemek[k]);
+            return;
+        }
+        const Belso& b = static_cast<const Belso&>(cs);
+        for (size_t k = 0; k < AG && b.gyerekek[k]; k++)
+            bejar(*b.gyerekek[k], e - BITEK, f);
+    }
+
+    /// A reszfa elo elemeinek mutatoi sorrendben (a tomoriteshez).
+    /// @param cs - A csomopont
+    /// @param e - A csomopont szintjenek eltolasa
+    /// @param v - A kimeneti tomb
+    static void gyujt(const Csomopont& cs, unsigned e, std::vector<ElemMutato>& v) {
+        if (e == 0) {
+            const Level& l = static_cast<const Level&>(cs);
+            for (size_t k = 0; k < AG; k++)
+                if (l.elemek[k]) v.push_back(l.elemek[k]);
+            return;
+        }
+        const Belso& b = static_cast<const Belso&>(cs);
+        for (size_t k = 0; k < AG && b.gyerekek[k]; k++)
+            gyujt(*b.gyerekek[k], e - BITEK, v);
+    }
+
+public:
+    /*-------------------------------------------
+                Konstruktor es letrehozas
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor (ures vektor).
+    PerzisztensVektor() : gyoker(), meret(0), helyek(0), eltolas(0) {}
+
+    /// Vektor felepitese elemek sorozatabol, alulrol felfele, O(n) idoben.
+    /// @param v - Az elemek sorrendben
+    /// @return - Az uj vektor
+    static PerzisztensVektor felepit(const std::vector<ElemMutato>& v) {
+        if (v.empty()) return PerzisztensVektor();
+
+        std::vector<CsomopontMutato> szint;
+        std::vector<size_t> darab;
+        for (size_t i = 0; i < v.size(); i += AG) {
+            std::unique_ptr<Level> l(new Level());
+            size_t k = 0;
+            for (; k < AG && i + k < v.size(); k++)
+                l->elemek[k] = v[i + k];
+            szint.push_back(CsomopontMutato(l.release()));
+            darab.push_back(k);
+        }
+
+        unsigned e = 0;
+        while (szint.size() > 1) {
+            std::vector<CsomopontMutato> felette;
+            std::vector<size_t> felettiDarab;
+            for (size_t i = 0; i < szint.size(); i += AG) {
+                std::unique_ptr<Belso> b(new Belso());
+                size_t osszes = 0;
+                for (size_t k = 0; k < AG && i + k < szint.size(); k++) {
+                    b->gyerekek[k] = szint[i + k];
+                    b->darab[k] = darab[i + k];
+                    osszes += darab[i + k];
+                }
+                felette.push_back(CsomopontMutato(b.release()));
+                felettiDarab.push_back(osszes);
+            }
+            szint.swap(felette);
+            darab.swap(felettiDarab);
+            e += BITEK;
+        }
+        return PerzisztensVektor(szint[0], v.size(), v.size(), e);
+    }
+
+
+
+    /*-------------------------------------------
+                Olvasas
+    -------------------------------------------*/
+    /// Az elemek szama.
+    size_t size() const { return meret; }
+
+    /// Ures-e a vektor.
+    bool empty() const { return meret == 0; }
+
+    /// Az i. elem megosztott mutatoja (ellenorzes nelkul, i < size()).
+    /// @param i - Az index
+    /// @return - Az elem mutatoja
+    const ElemMutato& mutato(size_t i) const {
+        i = hely(i);
+        const Csomopont* cs = gyoker.get();
+        for (unsigned e = eltolas; e > 0; e -= BITEK)
+            cs = static_cast<const Belso*>(cs)->gyerekek[(i >> e) & MASZK].get();
+        return static_cast<const Level*>(cs)->elemek[i & MASZK];
+    }
+
+    /// Az i. elem (ellenorzes nelkul, i < size()).
+    /// @param i - Az index
+    /// @return - Az elem referenciaja (amig a vektor valamelyik valtozata el)
+    const T& operator[](size_t i) const { return *mutato(i); }
+
+    /// Az elemek bejarasa sorrendben (gyorsabb, mint az indexeles, mert minden csomopontot egyszer er el).
+    /// @param f - A minden elemre meghivott fuggveny: f(const T&)
+    template <typename F>
+    void bejar(F f) const {
+        if (gyoker) bejar(*gyoker, eltolas, f);
+    }
+
+
+
+    /*-------------------------------------------
+                Uj valtozatok
+    -------------------------------------------*/
+    /// Uj valtozat egy elemmel a vegen.
+    /// @param x - Az uj elem (nem nullptr)
+    /// @return - Az uj valtozat
+    PerzisztensVektor hozzafuz(const ElemMutato& x) const {
+        if (!gyoker)
+            return PerzisztensVektor(beir(CsomopontMutato(), 0, 0, x, 1), 1, 1, 0);
+        if (helyek == AG << eltolas) {
+            // A fa megtelt: uj gyoker, amelynek elso gyereke a regi gyoker
+            std::unique_ptr<Belso> g(new Belso());
+            g->gyerekek[0] = gyoker;
+            g->darab[0] = meret;
+            CsomopontMutato ujGyoker(g.release());
+            return PerzisztensVektor(beir(ujGyoker, eltolas + BITEK, helyek, x, 1), meret + 1, helyek + 1, eltolas + BITEK);
+        }
+        return PerzisztensVektor(beir(gyoker, eltolas, helyek, x, 1), meret + 1, helyek + 1, eltolas);
+    }
+
+    /// Uj valtozat, amelyben az i. elem le van cserelve (i < size()).
+    /// @param i - Az index
+    /// @param x - Az uj elem (nem nullptr)
+    /// @return - Az uj valtozat
+    PerzisztensVektor csere(size_t i, const ElemMutato& x) const {
+        return PerzisztensVektor(beir(gyoker, eltolas, hely(i), x, 0), meret, helyek, eltolas);
+    }
+
+    /// Uj valtozat az i. elem nelkul (i < size()); a mogotte levo elemek indexe eggyel csokken.
+    /// A helyen sirko marad, csak a gyokerhez vezeto ut masolodik. Ha a sirkovek tobben vannak az elo
+    /// elemeknel, a fa tomoritve ujraepul (O(n), de legfeljebb minden meret/2. torlesnel).
+    /// @param i - Az index
+    /// @return - Az uj valtozat
+    PerzisztensVektor torol(size_t i) const {
+        if (meret == 1) return PerzisztensVektor();
+        PerzisztensVektor uj(beir(gyoker, eltolas, hely(i), ElemMutato(), -1), meret - 1, helyek, eltolas);
+        if (uj.helyek - uj.meret <= uj.meret) return uj;
+        std::vector<ElemMutato> v;
+        v.reserve(uj.meret);
+        gyujt(*uj.gyoker, uj.eltolas, v);
+        return felepit(v);
+    }
+};
+
+#endif // PERZISZTENSVEKTOR_HPP
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+*   \file Pillanatkep.h
+*   A rendszer egy megvaltoztathatatlan valtozatanak (pillanatkepenek) deklaracioja.
+*
+*   A pillanatkep az autok es az ugyfelek perzisztens vektorait tartja. Az iro minden modositas utan
+*   a kovetkezo valtozatot allitja elo a regibol: csak a modositott auto vagy ugyfel masolodik le, es a
+*   hozza vezeto ut a fakban, minden mas megosztva marad. A kozzetett pillanatkepet egy hosszu riport
+*   vagy mentes O(1) idoben megkapja, es zarolas nelkul bejarja, mikozben az irok mar a kovetkezo
+*   valtozaton dolgoznak; a regi valtozat az utolso hasznaloja elengedesekor szabadul fel.
+*/
+
+#ifndef PILLANATKEP_H
+#define PILLANATKEP_H
+
+#include <string>
+#include <ostream>
+#include <memory>
+#include <vector>
+
+#include "PerzisztensVektor.hpp"
+#include "Auto.h"
+#include "Ugyfel.h"
+
+class SzervizNyilvantartoRendszer;
+
+/// Egy auto valtozata: az auto masolata, amelynek tulajdonos-mutatoja a tulajdonos ugyanebben a
+/// pillanatkepben szereplo (megosztott) peldanyara mutat.
+struct AutoValtozat {
+    std::shared_ptr<const Ugyfel> tulajdonos;   ///< A tulajdonos valtozata (nullptr, ha nincs)
+    Auto autoAdat;                              ///< Az auto masolata (a szerviztortenet megosztva)
+
+    /// Konstruktor.
+    /// @param a - Az auto
+    /// @param t - A tulajdonos valtozata
+    AutoValtozat(const Auto& a, const std::shared_ptr<const Ugyfel>& t);
+};
+
+class Pillanatkep {
+    PerzisztensVektor<Ugyfel> ugyfelek;         ///< Az ugyfelek a rendszer sorrendjeben
+    PerzisztensVektor<AutoValtozat> autok;      ///< Az autok a rendszer sorrendjeben
+    unsigned long verzio;                       ///< A valtozat sorszama
+
+public:
+    /*-------------------------------------------
+            Konstruktor es letrehozas
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor (ures, 0. valtozat).
+    Pillanatkep() : ugyfelek(), autok(), verzio(0) {}
+
+    /// Pillanatkep a rendszer teljes tartalmabol (O(n)).
+    /// @param db - A rendszer (a hivo zarja alatt)
+    /// @param v - A valtozat sorszama
+    /// @return - Az uj pillanatkep
+    static Pillanatkep felepit(const SzervizNyilvantartoRendszer& db, unsigned long v);
+
+
+
+    /*-------------------------------------------
+            Kovetkezo valtozatok (az iro hivja)
+    -------------------------------------------*/
+    /// Uj ugyfel a vegen.
+    /// @param u - Az ugyfel
+    /// @return - A kovetkezo valtozat
+    Pillanatkep ugyfelHozzafuz(const Ugyfel& u) const;
+
+    /// Az i. ugyfel csereje; az autoi az uj peldanyra mutatnak at.
+    /// @param i - Az ugyfel indexe
+    /// @param u - Az ugyfel uj adatai
+    /// @param autoi - Az ugyfel autoinak indexei (a rendszer tulajdonosindexebol)
+    /// @return - A kovetkezo valtozat
+    Pillanatkep ugyfelCsere(size_t i, const Ugyfel& u, const std::vector<size_t>& autoi) const;
+
+    /// Az i. ugyfel torlese az autoival egyutt.
+    /// @param i - Az ugyfel indexe
+    /// @param autoi - Az ugyfel autoinak indexei novekvo sorrendben (a torles elotti allapotban)
+    /// @return - A kovetkezo valtozat
+    Pillanatkep ugyfelTorol(size_t i, const std::vector<size_t>& autoi) const;
+
+    /// Uj auto a vegen.
+    /// @param a - Az auto
+    /// @param tulajdonosIndex - A tulajdonos indexe az ugyfelek kozott (ugyfelekSzama(), ha nincs)
+    /// @return - A kovetkezo valtozat
+    Pillanatkep autoHozzafuz(const Auto& a, size_t tulajdonosIndex) const;
+
+    /// Az i. auto csereje (a tulajdonos valtozatlan).
+    /// @param i - Az auto indexe
+    /// @param a - Az auto uj allapota
+    /// @return - A kovetkezo valtozat
+    Pillanatkep autoCsere(size_t i, const Auto& a) const;
+
+    /// Az i. auto torlese.
+    /// @param i - Az auto indexe
+    /// @return - A kovetkezo valtozat
+    Pillanatkep autoTorol(size_t i) const;
+
+
+
+    /*-------------------------------------------
+            Olvasas (barmely szalrol, zar nelkul)
+    -------------------------------------------*/
+    /// A valtozat sorszama.
+    unsigned long getVerzio() const { return verzio; }
+
+    /// Az autok szama.
+    size_t autokSzama() const { return autok.size(); }
+
+    /// Az ugyfelek szama.
+    size_t ugyfelekSzama() const { return ugyfelek.size(); }
+
+    /// Az i. auto valtozata.
+    /// @param i - Az index (< autokSzama())
+    const AutoValtozat& autoValtozat(size_t i) const { return autok[i]; }
+
+    /// Az i. auto (a tulajdonos-mutatoja a pillanatkep ugyfelere mutat).
+    /// @param i - Az index (< autokSzama())
+    const Auto& getAuto(size_t i) const { return autok[i].autoAdat; }
+
+    /// Az i. ugyfel.
+    /// @param i - Az index (< ugyfelekSzama())
+    const Ugyfel& getUgyfel(size_t i) const { return ugyfelek[i]; }
+
+    /// Az osszes auto kiirasa.
+    /// @param os - A kimeneti adatfolyam
+    void listazAutok(std::ostream& os) const;
+
+    /// Az osszes ugyfel kiirasa.
+    /// @param os - A kimeneti adatfolyam
+    void listazUgyfelek(std::ostream& os) const;
+
+    /// Mentes fajlba, a SzervizNyilvantartoRendszer::mentesFajlba formatumaban.
+    /// @param f - A celfajl neve ("_ufl.txt" vagy "_auo.txt")
+    void mentesFajlba(const std::string& f) const;
+};
+
+#endif // PILLANATKEP_H
\ No newline at end of file
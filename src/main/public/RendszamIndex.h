@@ -0,0 +1,131 @@
+/**
+*   \file RendszamIndex.h
+*   Zarolas nelkul olvashato rendszam -> auto hasitotabla deklaracioja.
+*
+*   A tabla nyilt cimzesu (linearis probalkozas), a helyek atomi mutatok megvaltoztathatatlan
+*   bejegyzesekre. Az olvaso nem zarol: a sajat savjanak szamlalojat noveli (OlvasoSzamlalo), kiolvassa
+*   a bejegyzest, majd csokkenti a szamlalot. Az iro a bejegyzest uj peldanyra csereli egyetlen atomi
+*   irassal, es a regit csak akkor szabaditja fel, ha a csere elott belepett olvasok mind kileptek, vagyis
+*   egyetlen olvaso sem hasznalhatja mar (turelmi ido, mint az RCU-nal). A csere utan belepo olvasok uj
+*   korszakba kerulnek, ezert a folyamatos keresesek sem eheztetik ki az irot. Atmeretezeskor a teljes
+*   tabla cserelodik ugyanigy.
+*
+*   A bejegyzesek az auto masolatat tartalmazzak (a szerviztortenet megosztva, O(1)), a tulajdonos
+*   mutatoja helyett a tulajdonos masolataval, mert a rendszer ugyfelek tombje az olvasas alatt is
+*   athelyezodhet.
+*
+*   Irni egyszerre csak egy szal irhat (a hivo kizarolagos zarja alatt), olvasni barmennyi, barmikor.
+*/
+
+#ifndef RENDSZAMINDEX_H
+#define RENDSZAMINDEX_H
+
+#include <string>
+#include <atomic>
+
+#include "Vector.hpp"
+#include "Auto.h"
+#include "Ugyfel.h"
+#include "OlvasoIroZar.h"
+
+class RendszamIndex {
+    /// Egy auto megvaltoztathatatlan pillanatkepe.
+    struct Bejegyzes {
+        Auto autoAdat;          ///< Az auto masolata, tulajdonos-mutato nelkul
+        bool vanTulajdonos;     ///< Van-e az autonak tulajdonosa
+        Ugyfel tulajdonos;      ///< A tulajdonos masolata (ha van)
+
+        explicit Bejegyzes(const Auto& a);
+    };
+
+    /// A helyek tombje es a kitoltottseg.
+    struct Tabla {
+        size_t kapacitas;                           ///< A helyek szama (2 hatvanya)
+        std::atomic<const Bejegyzes*>* helyek;      ///< nullptr: ures, sirko(): torolt, egyebkent bejegyzes
+        size_t foglalt;                             ///< A nem ures helyek szama (elo + torolt)
+        size_t elo;                                 ///< Az elo bejegyzesek szama
+
+        explicit Tabla(size_t k);
+        ~Tabla();
+    };
+
+    std::atomic<Tabla*> tabla;          ///< Az aktualis tabla
+    mutable OlvasoSzamlalo olvasok;     ///< A tablat eppen olvaso szalak
+
+    /// A torolt helyet jelolo mutato (soha nem olvasodik ki).
+    static const Bejegyzes* sirko();
+
+    /// A rendszam hasitokodja.
+    /// @param r - A rendszam
+    /// @return - size_t
+    static size_t hasit(const std::string& r);
+
+    /// Megvarja, hogy a jelenleg bent levo olvasok kilepjenek (utana a regi bejegyzesek felszabadithatok).
+    /// A kozben folyamatosan belepo uj olvasok nem tartjak fel.
+    void turelmiIdo() const { olvasok.turelmiIdo(); }
+
+    /// Bejegyzes elhelyezese a tablaban (uj tabla feltoltesekor, olvasok nelkul).
+    /// @param t - A tabla
+    /// @param b - A bejegyzes
+    static void elhelyez(Tabla& t, const Bejegyzes* b);
+
+    /// A tabla cserejehez: uj, nagyobb tabla a meglevo bejegyzesekkel, majd csere es a regi tabla felszabaditasa.
+    /// @param kapacitas - Az uj tabla merete
+    void atmeretez(size_t kapacitas);
+
+    /// Masolo konstruktor (nem hasznalhato).
+    RendszamIndex(const RendszamIndex&);
+
+    /// Ertekado operator (nem hasznalhato).
+    RendszamIndex& operator=(const RendszamIndex&);
+
+public:
+    /*-------------------------------------------
+            Konstruktorok es destruktor
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor (ures index).
+    RendszamIndex();
+
+    /// Destruktor. Felszabaditja a tablat es a bejegyzeseket.
+    ~RendszamIndex();
+
+
+
+    /*-------------------------------------------
+            Olvasas (zarolas nelkul, barmely szalrol)
+    -------------------------------------------*/
+    /// Auto keresese rendszam alapjan.
+    /// @param r - A rendszam
+    /// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+    /// @param tulajdonos - Ha nem nullptr es az autonak van tulajdonosa, ide kerul a masolata
+    /// @return - true, ha az auto szerepel az indexben
+    bool keres(const std::string& r, Auto& ki, Ugyfel* tulajdonos = nullptr) const;
+
+    /// Szerepel-e a rendszam az indexben.
+    /// @param r - A rendszam
+    /// @return - true, ha szerepel
+    bool tartalmaz(const std::string& r) const;
+
+
+
+    /*-------------------------------------------
+            Iras (egyszerre egy szalbol)
+    -------------------------------------------*/
+    /// Auto felvetele vagy a meglevo bejegyzes csereje.
+    /// @param a - Az auto (a tulajdonosa is masolodik)
+    void beallit(const Auto& a);
+
+    /// Auto eltavolitasa.
+    /// @param r - A rendszam
+    void torol(const std::string& r);
+
+    /// Az index teljes ujraepitese.
+    /// @param autok - Az autok
+    void ujraepit(const Vector<Auto>& autok);
+
+    /// Az elo bejegyzesek szama.
+    /// @return - size_t
+    size_t meret() const { return tabla.load()->elo; }
+};
+
+#endif // RENDSZAMINDEX_H
\ No newline at end of file
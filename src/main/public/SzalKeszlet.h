@@ -0,0 +1,181 @@
+/**
+*   \file SzalKeszlet.h
+*   Munkalopo (work-stealing) szalkeszlet (thread pool) deklaracioja.
+*
+*   Minden munkaszalnak sajat feladatsora van: a szal a sajat sorara tett feladatokat a sor vegerol
+*   (LIFO) veszi ki, igy a frissen szetbontott, meg a gyorsitotarban levo munkat folytatja; ha a sora
+*   kiurult, a kulso hivasok kozos sorabol, vegul a tobbi szal soranak elejerol (FIFO) lop. A sorokat
+*   kulon zarak vedik, ezert a szalak nem versengenek egyetlen kozos zaron.
+*
+*   A parhuzamosFor() egy [0, n) indextartomanyt osszefuggo darabokra bont, a darabokat a keszlet szalai
+*   es a hivo szal egyutt dolgozzak fel, a fuggveny pedig csak az osszes darab elkeszulte utan ter vissza.
+*   A hivo szal varakozas kozben maga is feladatokat vesz ki (vagy lop), ezert a keszlet egymasba agyazott
+*   hivasoknal sem akad el. A parhuzamosRedukcio() es a Vector-okra szabott parhuzamosMinden() erre epul.
+*
+*   A program kozos keszletet (alapertelmezett()) hasznal a betolteshez, a menteshez es a flotta szintu
+*   kiertekelesekhez; szalszama indulaskor allithato (beallitAlapertelmezettSzalszam(), SZERVIZ_SZALAK).
+*/
+
+#ifndef SZALKESZLET_H
+#define SZALKESZLET_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <utility>
+
+#include "Vector.hpp"
+
+class SzalKeszlet {
+    /// Egy feladatsor a sajat zarjaval.
+    struct Sor {
+        std::mutex zar;                                 ///< A sort vedo zar
+        std::deque<std::function<void()> > feladatok;   ///< A vegrehajtasra varo feladatok
+    };
+
+    std::vector<std::thread> szalak;                ///< A munkaszalak
+    std::vector<std::unique_ptr<Sor> > sorok;       ///< Munkaszalankent egy sor, az utolso a kulso hivasoke
+    std::atomic<size_t> fuggo;                      ///< A sorokban varakozo feladatok szama
+    std::mutex alvoZar;                             ///< A varakozo szalak zarja
+    std::condition_variable jelzes;                 ///< Uj feladat vagy elkeszult parhuzamos hivas jelzese
+    bool leall;                                     ///< A destruktor beallitja, a szalak ekkor kilepnek (az alvoZar vedi)
+
+    /// A munkaszalak ciklusa: feladatok kivetele, lopasa es vegrehajtasa a leallitasig.
+    /// @param index - A szal sorszama (a sajat sor indexe)
+    void munkaszal(size_t index);
+
+    /// Feladat elhelyezese: munkaszalrol a sajat sor vegere, mas szalrol a kulso hivasok soraba.
+    /// @param feladat - A feladat
+    void betesz(std::function<void()> feladat);
+
+    /// Egy feladat kivetele: a sajat sor vegerol, a kulso sorbol, vegul mas szal sorarol lopva.
+    /// @param feladat - Ide kerul a kivett feladat
+    /// @return - true, ha sikerult feladatot kivenni
+    bool kivesz(std::function<void()>& feladat);
+
+    /// A hivo szal sajat soranak indexe.
+    /// @return - A munkaszal sorszama, vagy a kulso sor indexe, ha a hivo nem ennek a keszletnek a szala
+    size_t sajatSor() const;
+
+    /// A darabok szama egy n meretu tartomanyhoz.
+    /// @param n - A tartomany merete
+    /// @param minDarab - A legkisebb darabmeret
+    /// @return - A darabok szama (legalabb 1)
+    size_t darabokSzama(size_t n, size_t minDarab) const;
+
+    /// Masolo konstruktor (nem hasznalhato).
+    SzalKeszlet(const SzalKeszlet&);
+
+    /// Ertekado operator (nem hasznalhato).
+    SzalKeszlet& operator=(const SzalKeszlet&);
+
+public:
+    /*-------------------------------------------
+            Konstruktor es destruktor
+    -------------------------------------------*/
+    /// Konstruktor, elinditja a munkaszalakat.
+    /// @param szalakSzama - A munkaszalak szama (0 eseten a hardver altal tamogatott szalak szama)
+    explicit SzalKeszlet(size_t szalakSzama = 0);
+
+    /// Destruktor, megvarja a folyamatban levo feladatokat es leallitja a szalakat.
+    ~SzalKeszlet();
+
+
+
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// A munkaszalak szama.
+    /// @return - size_t
+    size_t szalakSzama() const { return szalak.size(); }
+
+    /// A [0, n) tartomany parhuzamos feldolgozasa osszefuggo darabokban.
+    /// A fuggveny minden darabra egyszer hivodik meg (tol, ig) parameterekkel; a darabok
+    /// kulonbozo szalakon, tetszoleges sorrendben futhatnak. Ha valamelyik darab kivetelt dob,
+    /// az elso kivetel az osszes darab befejezese utan a hivonal ujra dobodik.
+    /// @param n - A tartomany merete
+    /// @param f - A darabot feldolgozo fuggveny
+    /// @param minDarab - Ennel kisebb darabokra nem bontja a tartomanyt
+    void parhuzamosFor(size_t n, const std::function<void(size_t, size_t)>& f, size_t minDarab = 64);
+
+    /// A [0, n) tartomany parhuzamos redukcioja. A darabok reszeredmenyei darabsorrendben
+    /// kombinalodnak, igy az eredmeny nem fugg az utemezestol (nem kommutativ kombinalasnal sem).
+    /// @param n - A tartomany merete
+    /// @param kezdo - A kombinalas egysegeleme (ures tartomany eredmenye)
+    /// @param darab - (tol, ig) -> T, egy darab reszeredmenye
+    /// @param kombinal - (T, T) -> T, ket egymast koveto reszeredmeny osszevonasa (az elso
+    ///                   parameter mozgatva erkezik, ertek szerint atveve helyben bovitheto)
+    /// @param minDarab - Ennel kisebb darabokra nem bontja a tartomanyt
+    /// @return - Az osszevont eredmeny
+    template<typename T, typename D, typename K>
+    T parhuzamosRedukcio(size_t n, const T& kezdo, D darab, K kombinal, size_t minDarab = 64) {
+        if (minDarab == 0) minDarab = 1;
+        const size_t darabok = darabokSzama(n, minDarab);
+        std::vector<T> reszek(darabok, kezdo);
+        parhuzamosFor(darabok, [&](size_t tol, size_t ig) {
+            for (size_t d = tol; d < ig; d++)
+                reszek[d] = darab(n * d / darabok, n * (d + 1) / darabok);
+        }, 1);
+        T eredmeny = kezdo;
+        for (size_t d = 0; d < darabok; d++)
+            eredmeny = kombinal(std::move(eredmeny), reszek[d]);
+        return eredmeny;
+    }
+
+    /// A vektor minden elemenek parhuzamos feldolgozasa.
+    /// @param v - A vektor
+    /// @param f - Elemenkent hivott fuggveny (T&)
+    /// @param minDarab - Ennel kisebb darabokra nem bontja a vektort
+    template<typename T, typename F>
+    void parhuzamosMinden(Vector<T>& v, F f, size_t minDarab = 64) {
+        parhuzamosFor(v.size(), [&](size_t tol, size_t ig) {
+            for (size_t i = tol; i < ig; i++) f(v[i]);
+        }, minDarab);
+    }
+
+    /// A vektor minden elemenek parhuzamos feldolgozasa (csak olvasva).
+    /// @param v - A vektor
+    /// @param f - Elemenkent hivott fuggveny (const T&)
+    /// @param minDarab - Ennel kisebb darabokra nem bontja a vektort
+    template<typename T, typename F>
+    void parhuzamosMinden(const Vector<T>& v, F f, size_t minDarab = 64) {
+        parhuzamosFor(v.size(), [&](size_t tol, size_t ig) {
+            for (size_t i = tol; i < ig; i++) f(v[i]);
+        }, minDarab);
+    }
+
+    /// A vektor elemeinek parhuzamos lekepezese es redukcioja (elemsorrendben kombinalva).
+    /// @param v - A vektor
+    /// @param kezdo - A kombinalas egysegeleme
+    /// @param lekepez - (const T&) -> R, egy elem erteke
+    /// @param kombinal - (R, R) -> R, ket ertek osszevonasa
+    /// @param minDarab - Ennel kisebb darabokra nem bontja a vektort
+    /// @return - Az osszevont eredmeny
+    template<typename T, typename R, typename L, typename K>
+    R parhuzamosRedukcio(const Vector<T>& v, const R& kezdo, L lekepez, K kombinal, size_t minDarab = 64) {
+        return parhuzamosRedukcio(v.size(), kezdo, [&](size_t tol, size_t ig) {
+            R r = kezdo;
+            for (size_t i = tol; i < ig; i++) r = kombinal(std::move(r), lekepez(v[i]));
+            return r;
+        }, kombinal, minDarab);
+    }
+
+    /// A program kozos szalkeszlete (elso hasznalatkor jon letre).
+    /// A szalszam a beallitAlapertelmezettSzalszam() erteke, ennek hianyaban a SZERVIZ_SZALAK
+    /// kornyezeti valtozo, vegul a hardver altal tamogatott szalak szama.
+    /// @return - A keszlet referenciaja
+    static SzalKeszlet& alapertelmezett();
+
+    /// A kozos keszlet szalszamanak beallitasa indulaskor.
+    /// @param szalakSzama - A munkaszalak szama (0: a hardver altal tamogatott szalak szama)
+    /// @return - false, ha a kozos keszlet mar letrejott (ekkor a beallitas hatastalan)
+    static bool beallitAlapertelmezettSzalszam(size_t szalakSzama);
+};
+
+#endif // SZALKESZLET_H
\ No newline at end of file
@@ -0,0 +1,201 @@
+/**
+*   \file SzalbiztosNyilvantarto.h
+*   A SzervizNyilvantartoRendszer tobbszalu (szalbiztos) hasznalatat lehetove tevo burkolo osztaly deklaracioja.
+*
+*   A lekerdezesek megosztott (olvasasi), a modositasok kizarolagos (irasi) zarat vesznek az
+*   OlvasoIroZar-on, igy tobb pult vagy egy riportszal is dolgozhat a modositasokkal parhuzamosan.
+*   Minden iras vegen a szarmaztatott strukturak (esemenytar, emlekezteto, ugyfelosszesitok) azonnal
+*   frissulnek, ezert a megosztott zar alatti konstans lekerdezesek mar nem irnak a rendszerbe.
+*
+*   A leggyakoribb kerdes, a rendszam szerinti kereses, zarolas nelkul fut a RendszamIndex-en: ezt a
+*   modositasok a kizarolagos zar alatt, autonkent frissitik. Mivel a rendszer belso objektumaira mutato
+*   referencia a zar elengedese utan ervenytelenne valhat, a lekerdezesek masolatot adnak vissza.
+*
+*   A teljes bejarast igenylo lekerdezesek (listazas, mentes) zar helyett a legutobb kozzetett
+*   Pillanatkep-et hasznaljak: ezt minden iras a zar alatt, szerkezetmegosztassal allitja elo, igy egy
+*   hosszu riport nem tartja fel az irokat, es vegig ugyanazt a konzisztens valtozatot latja.
+*/
+
+#ifndef SZALBIZTOSNYILVANTARTO_H
+#define SZALBIZTOSNYILVANTARTO_H
+
+#include <string>
+#include <ostream>
+#include <functional>
+#include <memory>
+
+#include "SzervizNyilvantartoRendszer.h"
+#include "OlvasoIroZar.h"
+#include "RendszamIndex.h"
+#include "Pillanatkep.h"
+
+class SzalbiztosNyilvantarto {
+    SzervizNyilvantartoRendszer db;     ///< A burkolt rendszer
+    mutable OlvasoIroZar zar;           ///< Olvasok: lekerdezesek, iro: modositasok
+    RendszamIndex rendszamIndex;        ///< Zarolas nelkul olvashato rendszam-index
+    std::shared_ptr<const Pillanatkep> aktualis;    ///< A legutobb kozzetett valtozat (csak atomi muveletekkel)
+
+    /// Az auto bejegyzesenek frissitese (vagy torlese) az indexben es a kovetkezo pillanatkepben
+    /// a rendszer aktualis allapota alapjan.
+    /// Csak a kizarolagos zar alatt hivhato.
+    /// @param r - A rendszam
+    void indexFrissit(const std::string& r);
+
+    /// Iras utani teendok: a szarmaztatott strukturak frissitese. Csak a kizarolagos zar alatt hivhato.
+    /// Az egy autot erinto modositasok a strukturakat helyben frissitik, ilyenkor ez mar nem epit ujra semmit.
+    void irasUtan();
+
+    /// A rendszer csak olvashato nezete. Az iras utani lekeresek ezen at tortennek: a nem konstans
+    /// getterek a szarmaztatott adatokat ujra elavultnak jelolnek, es akkor a megosztott zar alatt
+    /// futo olvasok egyszerre epitenek ujra.
+    /// @return - A rendszer konstans referenciaja
+    const SzervizNyilvantartoRendszer& allapot() const { return db; }
+
+    /// Uj valtozat kozzetetele. Csak a kizarolagos zar alatt hivhato.
+    /// @param p - A kovetkezo valtozat
+    void kozzetesz(const Pillanatkep& p);
+
+    /// Az auto indexe a rendszerben (a megosztott vagy a kizarolagos zar alatt hivhato).
+    /// @param r - A rendszam
+    /// @return - Az index, vagy az autok szama, ha nem talalhato
+    size_t autoSorszam(const std::string& r) const;
+
+    /// Az ugyfel indexe a rendszerben (a megosztott vagy a kizarolagos zar alatt hivhato).
+    /// @param n - Az ugyfel neve
+    /// @return - Az index, vagy az ugyfelek szama, ha nem talalhato
+    size_t ugyfelSorszam(const std::string& n) const;
+
+    /// Masolo konstruktor (nem hasznalhato).
+    SzalbiztosNyilvantarto(const SzalbiztosNyilvantarto&);
+
+    /// Ertekado operator (nem hasznalhato).
+    SzalbiztosNyilvantarto& operator=(const SzalbiztosNyilvantarto&);
+
+public:
+    /*-------------------------------------------
+            Konstruktorok es destruktor
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor (ures rendszer).
+    SzalbiztosNyilvantarto();
+
+    /// Konstruktor egy meglevo rendszer masolatabol.
+    /// @param kezdo - A kiindulo rendszer
+    explicit SzalbiztosNyilvantarto(const SzervizNyilvantartoRendszer& kezdo);
+
+
+
+    /*-------------------------------------------
+        Lekerdezesek (megosztott zar vagy zar nelkul)
+    -------------------------------------------*/
+    /// Auto letezesenek ellenorzese (zarolas nelkul, az indexbol).
+    /// @param r - A rendszam
+    /// @return - true, ha az auto szerepel
+    bool vanAuto(const std::string& r) const;
+
+    /// Ugyfel letezesenek ellenorzese.
+    /// @param n - Az ugyfel neve
+    /// @return - true, ha az ugyfel szerepel
+    bool vanUgyfel(const std::string& n) const;
+
+    /// Auto keresese rendszam alapjan (zarolas nelkul, az indexbol).
+    /// @param r - A rendszam
+    /// @param ki - Az auto masolata (a tulajdonos-mutato nullptr)
+    /// @param tulajdonos - Ha nem nullptr es az autonak van tulajdonosa, ide kerul a masolata
+    /// @return - true, ha az auto szerepel
+    bool keresAuto(const std::string& r, Auto& ki, Ugyfel* tulajdonos = nullptr) const;
+
+    /// Ugyfel keresese nev alapjan.
+    /// @param n - Az ugyfel neve
+    /// @param ki - Az ugyfel masolata
+    /// @return - true, ha az ugyfel szerepel
+    bool keresUgyfel(const std::string& n, Ugyfel& ki) const;
+
+    /// Az auto szervizmuveleteinek kiirasa.
+    /// @param os - A kimeneti adatfolyam
+    /// @param r - A rendszam
+    void lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const;
+
+    /// A legutobb kozzetett pillanatkep (O(1), zarolas nelkul). Amig a hivo tartja, valtozatlan marad.
+    /// @return - A pillanatkep
+    std::shared_ptr<const Pillanatkep> pillanatkep() const;
+
+    /// Az osszes auto kiirasa (pillanatkepbol, zarolas nelkul).
+    /// @param os - A kimeneti adatfolyam
+    void listazAutok(std::ostream& os) const;
+
+    /// Az osszes ugyfel kiirasa (pillanatkepbol, zarolas nelkul).
+    /// @param os - A kimeneti adatfolyam
+    void listazUgyfelek(std::ostream& os) const;
+
+    /// A flotta figyelmeztetesei (lasd SzervizNyilvantartoRendszer::flottaFigyelmeztetesek).
+    /// @param ma - A referencia datum
+    /// @return - A figyelmeztetesek
+    Vector<Figyelmeztetes> flottaFigyelmeztetesek(const Datum& ma = Datum(2025, 4, 14)) const;
+
+    /// Mentes fajlba (pillanatkepbol, zarolas nelkul).
+    /// @param f - A celfajl neve
+    void mentesFajlba(const std::string& f) const;
+
+    /// Tetszoleges lekerdezes a megosztott zar alatt. A fuggveny nem tarthat meg referenciat a rendszerre.
+    /// @param f - A lekerdezes
+    void olvas(const std::function<void(const SzervizNyilvantartoRendszer&)>& f) const;
+
+
+
+    /*-------------------------------------------
+            Modositasok (kizarolagos zar)
+    -------------------------------------------*/
+    /// Uj ugyfel felvetele.
+    /// @param u - Az ugyfel
+    /// @return - false, ha mar letezik
+    bool ujUgyfel(const Ugyfel& u);
+
+    /// Uj auto felvetele; a tulajdonost a zar alatt, nev szerint koti be.
+    /// @param a - Az auto (a tulajdonos-mutatoja figyelmen kivul marad)
+    /// @param tulajdonosNev - A tulajdonos neve (ures: nincs tulajdonos)
+    /// @return - false, ha az auto mar letezik vagy a tulajdonos nem talalhato
+    bool ujAuto(const Auto& a, const std::string& tulajdonosNev);
+
+    /// Ugyfel adatainak frissitese.
+    /// @param u - Az ugyfel uj adatai (nev szerint azonositva)
+    /// @return - false, ha nem talalhato
+    bool frissitUgyfel(const Ugyfel& u);
+
+    /// Km ora frissitese.
+    /// @param r - A rendszam
+    /// @param k - Az uj km ora allas
+    /// @return - false, ha az auto nem talalhato
+    bool frissitKmOra(const std::string& r, int k);
+
+    /// Szervizmuvelet rogzitese.
+    /// @param r - A rendszam
+    /// @param m - A muvelet rekordja
+    /// @return - false, ha az auto nem talalhato
+    bool rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m);
+
+    /// Szervizmuvelet torlese datum alapjan.
+    /// @param r - A rendszam
+    /// @param d - A muvelet datuma
+    /// @return - false, ha az auto vagy a muvelet nem talalhato
+    bool torolMuvelet(const std::string& r, const Datum& d);
+
+    /// Auto torlese.
+    /// @param r - A rendszam
+    /// @return - false, ha nem talalhato
+    bool torolAuto(const std::string& r);
+
+    /// Ugyfel (es autoi) torlese.
+    /// @param n - Az ugyfel neve
+    /// @return - false, ha nem talalhato
+    bool torolUgyfel(const std::string& n);
+
+    /// Rendszeradatok betoltese fajlbol.
+    /// @param f - A fajl neve
+    void betoltesFajlbol(const std::string& f);
+
+    /// Tetszoleges modositas a kizarolagos zar alatt; utana az index teljesen ujraepul.
+    /// @param f - A modositas
+    void ir(const std::function<void(SzervizNyilvantartoRendszer&)>& f);
+};
+
+#endif // SZALBIZTOSNYILVANTARTO_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+*   \file Szerver.h
+*   Helyi (Unix domain vagy localhost TCP) socket szerver deklaracioja.
+*
+*   A szerver egyetlen szalon, nem blokkolo socketekkel es epoll esemenyhurokkal szolgal ki tetszoleges
+*   szamu kapcsolatot. A keresek a ParancsVegrehajto soralapu protokolljat hasznaljak: egy kapcsolaton
+*   a kliens a valaszok megvarasa nelkul is kuldhet tobb kerest, a szerver a beolvasott teljes sorokat
+*   es kotegeket sorban hajtja vegre, es a valaszokat egyetlen irassal kuldi vissza; a modosito parancsokat
+*   pedig olvasasonkent egyetlen irassal naplozza, ha a vegrehajtohoz naplo tartozik. Mivel minden keres a hurok
+*   szalan fut, a rendszerhez nem kell zar, es egy keres sem lat felig vegrehajtott masikat.
+*
+*   A szerver nem hitelesit, ezert csak helyi cimre kothet: Unix domain socketre ("unix:/ut/a.sock")
+*   vagy a 127.0.0.0/8 tartomany egy cimere ("127.0.0.1:7070", "localhost:7070").
+*
+*   Csak Linuxon erheto el (epoll, eventfd).
+*/
+
+#ifndef SZERVER_H
+#define SZERVER_H
+
+#ifdef __linux__
+
+#include <cstddef>
+#include <string>
+#include <atomic>
+#include <unordered_map>
+
+#include "ParancsVegrehajto.h"
+
+class SzervizNyilvantartoRendszer;
+class Naplo;
+
+class Szerver {
+    static const size_t MAX_SOR = 64 * 1024;            ///< Ennel hosszabb sor utan a kapcsolat lezarul
+    static const size_t MAX_KIMENET = 4 * 1024 * 1024;  ///< Ennyi el nem kuldott valasz felett a kapcsolat nem olvasodik tovabb
+    static const size_t MAX_BEMENET = 64 * 1024 * 1024; ///< Ennel nagyobb befejezetlen koteg utan a kapcsolat lezarul
+
+    /// Egy kliens kapcsolat allapota.
+    struct Kapcsolat {
+        std::string be;         ///< A beolvasott, meg fel nem dolgozott bajtok
+        std::string ki;         ///< A kuldesre varo valaszok
+        size_t kiPoz;           ///< A ki-bol mar elkuldott bajtok szama
+        unsigned maszk;         ///< Az epoll-ban jelenleg figyelt esemenyek (EPOLLIN, EPOLLOUT)
+        bool lezarando;         ///< A kliens lezarta az iranyat: a valaszok elkuldese utan lezarjuk
+
+        Kapcsolat() : be(), ki(), kiPoz(0), maszk(0), lezarando(false) {}
+    };
+
+    ParancsVegrehajto vegrehajto;                   ///< A keresek vegrehajtoja
+    int figyeloFd;                                  ///< A figyelo socket (-1, ha nincs)
+    int epollFd;                                    ///< Az epoll peldany
+    int ebresztoFd;                                 ///< eventfd a leallitas jelzesere
+    std::string unixUt;                             ///< A Unix socket fajl utvonala (a destruktor torli)
+    int port;                                       ///< A TCP port (0, ha Unix socket)
+    std::unordered_map<int, Kapcsolat> kapcsolatok; ///< A nyitott kapcsolatok fajlleiro szerint
+    std::atomic<bool> fut;                          ///< Hamis, ha leallitast kertek
+
+    /// Az osszes varakozo kapcsolat elfogadasa.
+    void elfogad();
+
+    /// Egy kapcsolat esemenyeinek kiszolgalasa: beolvasas, a teljes sorok vegrehajtasa, a valaszok kuldese.
+    /// @param fd - A kapcsolat leiroja
+    /// @param k - A kapcsolat allapota
+    /// @param esemenyek - Az epoll altal jelzett esemenyek
+    /// @return - false, ha a kapcsolatot le kell zarni
+    bool kiszolgal(int fd, Kapcsolat& k, unsigned esemenyek);
+
+    /// Beolvasas, amig van adat (vagy amig a kimeneti puffer meg nem telik).
+    /// @param fd - A kapcsolat leiroja
+    /// @param k - A kapcsolat allapota
+    /// @return - false, ha olvasasi hiba tortent
+    bool beolvas(int fd, Kapcsolat& k);
+
+    /// A beolvasott teljes keretek (sorok es kotegek) vegrehajtasa (amig a kimeneti puffer meg nem telik).
+    /// @param k - A kapcsolat allapota
+    /// @return - false, ha egy sor vagy egy befejezetlen koteg tul hosszu (a kapcsolatot le kell zarni)
+    bool feldolgoz(Kapcsolat& k);
+
+    /// A varakozo valaszok kuldese, amig a socket fogadja.
+    /// @param fd - A kapcsolat leiroja
+    /// @param k - A kapcsolat allapota
+    /// @return - false, ha kuldesi hiba tortent
+    bool kuld(int fd, Kapcsolat& k);
+
+    /// A figyelt esemenyek igazitasa az allapothoz: olvasas, ha van hely a kimeneti pufferben,
+    /// iras, ha van el nem kuldott valasz.
+    /// @param fd - A kapcsolat leiroja
+    /// @param k - A kapcsolat allapota
+    /// @return - false, ha az epoll_ctl hibat adott
+    bool figyelesBeallit(int fd, Kapcsolat& k);
+
+    /// A kapcsolat lezarasa es eltavolitasa.
+    /// @param fd - A kapcsolat leiroja
+    void lezar(int fd);
+
+    /// Masolo konstruktor (nem hasznalhato).
+    Szerver(const Szerver&);
+
+    /// Ertekado operator (nem hasznalhato).
+    Szerver& operator=(const Szerver&);
+
+public:
+    /*-------------------------------------------
+            Konstruktor es destruktor
+    -------------------------------------------*/
+    /// Konstruktor. Letrehozza az epoll peldanyt; figyelni a figyel() hivas utan kezd.
+    /// @param db - A kiszolgalt rendszer (a futtat() alatt mas szal nem hasznalhatja)
+    /// @param naplo - A modosito parancsok naploja (nullptr: nincs naplozas)
+    /// @throws std::runtime_error - ha az epoll vagy az eventfd nem hozhato letre
+    explicit Szerver(SzervizNyilvantartoRendszer& db, Naplo* naplo = nullptr);
+
+    /// Destruktor. Lezarja a kapcsolatokat es a socketeket, torli a Unix socket fajlt.
+    ~Szerver();
+
+
+
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Figyeles inditasa a megadott cimen.
+    /// @param cim - "unix:<ut>", vagy "<helyi IPv4 cim vagy localhost>:<port>" (0: szabad port)
+    /// @throws std::invalid_argument - ha a cim hibas vagy nem helyi
+    /// @throws std::runtime_error - ha a socket nem hozhato letre
+    void figyel(const std::string& cim);
+
+    /// A TCP port, amelyen a szerver figyel (0-s port kerese eseten a kapott port).
+    /// @return - A port, vagy 0, ha Unix socketen figyel
+    int getPort() const { return port; }
+
+    /// Az esemenyhurok futtatasa a leallit() hivasig.
+    /// @throws std::runtime_error - ha az epoll_wait vegzetes hibat ad, vagy a naploiras sikertelen
+    void futtat();
+
+    /// Leallitas kerese. Barmely szalrol es jelkezelobol is hivhato; a futtat() a kovetkezo
+    /// esemeny feldolgozasa utan visszater.
+    void leallit();
+};
+
+#endif // __linux__
+
+#endif // SZERVER_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+/**
+*   \file SzervizEsemenyTar.h
+*   A flotta osszes szervizesemenyet oszloposan (struct-of-arrays) tarolo osztaly deklaracioja.
+*
+*   Minden oszlop egy-egy folytonos tomb, az i. esemeny adatai az oszlopok i. elemei:
+*   az auto helye, a rekord sorszama az auto szerviztorteneteben, a muvelet tipusa, a datum
+*   napsorszama, az ar, a km ora allas es a vizsga sikeressege. A flottaszintu osszesitesek igy
+*   szoros, vektorizalhato ciklusok a folytonos memoriaban, es nem kell autonkent a
+*   szerviztorteneteket bejarni.
+*
+*   Az esemenyek sorrendje kotetlen: barmely auto uj rekordja a tar vegere kerul, torleskor a
+*   helyere az utolso esemeny lep (swap-remove). Minden auto egy allando helyet kap, amit az
+*   autok tombjenek torlesei nem tolnak el; a hely -> auto sorszam tabla es a helyenkenti,
+*   tortenetsorrendu esemenylista tartja karban a kapcsolatot. Igy minden modositas koltsege
+*   az erintett auto tortenetevel (autotorleskor az autok szamaval) aranyos, nem a teljes tarral.
+*/
+
+#ifndef SZERVIZESEMENYTAR_H
+#define SZERVIZESEMENYTAR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Vector.hpp"
+#include "Datum.h"
+#include "SzervizRekord.h"
+
+class Auto;
+
+/// Egy bevetelcsoport (honap, tipus vagy marka) osszesitett adatai.
+struct BevetelCsoport {
+    std::string kulcs;      ///< A csoport neve (pl. "2024.03", "J", "Toyota")
+    long long osszeg;       ///< Az arak osszege
+    long long darab;        ///< A muveletek szama
+
+    BevetelCsoport() : kulcs(""), osszeg(0), darab(0) {}
+
+    /// Az atlagos ar a csoportban.
+    /// @return - osszeg / darab, vagy 0, ha a csoport ures
+    double atlag() const { return darab == 0 ? 0.0 : static_cast<double>(osszeg) / darab; }
+};
+
+/// A bevetel egyszerre szamolt bontasai.
+struct BevetelOsszesites {
+    Vector<BevetelCsoport> honapok;     ///< Honaponkent ("EEEE.HH"), idorendben, csak a nem ures honapok
+    Vector<BevetelCsoport> tipusok;     ///< Muvelettipusonkent ("J", "K", "V" sorrendben)
+    Vector<BevetelCsoport> csoportok;   ///< Autocsoportonkent (pl. marka), a csoport sorszama szerint
+    long long osszeg;                   ///< Az osszes ar osszege
+    long long darab;                    ///< Az osszes muvelet szama
+
+    BevetelOsszesites() : osszeg(0), darab(0) {}
+};
+
+class SzervizEsemenyTar {
+    Vector<uint32_t> helyek;        ///< Az esemenyhez tartozo auto helye
+    Vector<uint32_t> rekordIdk;     ///< A rekord sorszama az auto szerviztorteneteben
+    Vector<char> tipusok;           ///< A muvelet tipusa ('J', 'K', 'V')
+    Vector<int32_t> datumok;        ///< A muvelet datuma napsorszamkent (Datum::getNapSorszam())
+    Vector<int32_t> arak;           ///< A muvelet ara
+    Vector<int32_t> kmek;           ///< A km ora allas a muveletkor
+    Vector<char> sikeresek;         ///< 1, ha sikeres vizsga, kulonben 0
+
+    std::vector<std::vector<uint32_t> > helyEsemenyei;  ///< Helyenkent az esemenyek indexei tortenetsorrendben
+    Vector<uint32_t> helyAutok;     ///< Helyenkent az auto sorszama (NINCS_AUTO, ha a hely szabad)
+    Vector<uint32_t> autoHelyek;    ///< Az auto sorszama -> helye
+    Vector<uint32_t> szabadHelyek;  ///< Torolt autok ujrahasznosithato helyei
+
+    /// Egy esemeny hozzafuzese a tar vegere.
+    /// @param hely - Az auto helye
+    /// @param r - A szervizrekord (az auto tortenetenek vegere kerul)
+    void esemenyHozzafuz(uint32_t hely, const SzervizRekord& r);
+
+    /// Egy esemeny eltavolitasa: a helyere az utolso esemeny kerul. A hely esemenylistajat a hivo kezeli.
+    /// @param e - Az esemeny indexe
+    void esemenyEltavolit(uint32_t e);
+public:
+    /// A szabad helyek auto sorszama.
+    static const uint32_t NINCS_AUTO = UINT32_MAX;
+
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Az osszes oszlop uritese.
+    void torol();
+
+    /// Ujraepiti a tarat az autok szerviztorteneteibol (az auto sorszama az indexe a tombben).
+    /// @param autok - A rendszer autoi
+    void ujraepit(const Vector<Auto>& autok);
+
+    /// Uj auto felvetele (az autok tombjenek vegere kerult): helyet kap, a tortenete a tar vegere kerul.
+    /// @param a - Az auto
+    void autoHozzafuz(const Auto& a);
+
+    /// Egy rekord hozzafuzese barmely auto tortenetenek vegere. O(1).
+    /// @param autoId - Az auto sorszama
+    /// @param r - A szervizrekord
+    void hozzafuz(uint32_t autoId, const SzervizRekord& r);
+
+    /// Egy rekord torlese az auto tortenetebol; a mogotte levo rekordok sorszama eggyel csokken.
+    /// O(az auto rekordjainak szama).
+    /// @param autoId - Az auto sorszama
+    /// @param rekord - A rekord sorszama az auto torteneteben
+    void rekordTorol(uint32_t autoId, size_t rekord);
+
+    /// Az auto teljes tortenetenek lecserelese (a helye megmarad).
+    /// @param autoId - Az auto sorszama
+    /// @param a - Az auto uj allapota
+    void autoCsere(uint32_t autoId, const Auto& a);
+
+    /// Auto torlese (az autok tombjebol is torlodott, a mogotte levok eggyel elore csusztak).
+    /// O(az auto rekordjainak szama + az autok szama).
+    /// @param autoId - Az auto sorszama
+    void autoTorol(uint32_t autoId);
+
+
+
+    /*-------------------------------------------
+                Oszlopok elerese
+    -------------------------------------------*/
+    /// Az esemenyek szama.
+    /// @return - size_t
+    size_t meret() const { return datumok.size(); }
+
+    /// Az auto helyek oszlopa (az auto sorszama: getHelyAutok()[hely]).
+    /// @return - Mutato az elso elemre
+    const uint32_t* getHelyek() const { return helyek.begin(); }
+
+    /// Helyenkent az auto sorszama (index a rendszer autok tombjeben).
+    /// @return - Mutato az elso elemre
+    const uint32_t* getHelyAutok() const { return helyAutok.begin(); }
+
+    /// Az esemeny autojanak sorszama.
+    /// @param e - Az esemeny indexe
+    /// @return - Index a rendszer autok tombjeben
+    uint32_t autoIndex(size_t e) const { return helyAutok[helyek[e]]; }
+
+    /// A tipusok oszlopa.
+    /// @return - Mutato az elso elemre
+    const char* getTipusok() const { return tipusok.begin(); }
+
+    /// A datumok (napsorszamok) oszlopa.
+    /// @return - Mutato az elso elemre
+    const int32_t* getDatumok() const { return datumok.begin(); }
+
+    /// Az arak oszlopa.
+    /// @return - Mutato az elso elemre
+    const int32_t* getArak() const { return arak.begin(); }
+
+    /// A km ora allasok oszlopa.
+    /// @return - Mutato az elso elemre
+    const int32_t* getKmek() const { return kmek.begin(); }
+
+    /// A vizsgaeredmenyek oszlopa.
+    /// @return - Mutato az elso elemre
+    const char* getSikeresek() const { return sikeresek.begin(); }
+
+
+
+    /*-------------------------------------------
+                  Osszesitesek
+    -------------------------------------------*/
+    /// Az osszes koltes a [tol, ig) idoszakban.
+    /// @param tol - Az idoszak eleje (benne van)
+    /// @param ig - Az idoszak vege (nincs benne)
+    /// @return - Az arak osszege (64 bites)
+    long long koltesIdoszakban(const Datum& tol, const Datum& ig) const;
+
+    /// Az osszes koltes egy adott evben.
+    /// @param ev - Az ev
+    /// @return - Az arak osszege (64 bites)
+    long long koltesEvben(int ev) const;
+
+    /// Evenkenti koltes egy evtartomanyra.
+    /// @param elsoEv - Az elso ev
+    /// @param evekSzama - Az evek szama
+    /// @param ki - Legalabb evekSzama elemu tomb, ki[i] az (elsoEv + i). ev koltese lesz
+    void koltesEvente(int elsoEv, int evekSzama, long long* ki) const;
+
+    /// Atlagos km ket egymast koveto szerviz kozott ugyanannal az autonal. O(autok szama).
+    /// @return - Az atlag, vagy 0, ha egyik autonak sincs legalabb ket szervize
+    double atlagKmSzervizekKozott() const;
+
+    /// A sikertelen vizsgak szama.
+    /// @return - size_t
+    size_t sikertelenVizsgakSzama() const;
+
+    /// Bevetel osszesitese honap, tipus es autocsoport szerint, egyetlen menetben, 64 bites gyujtokkel.
+    /// A csoportok kulcsat a hivo tolti ki (a tar nem ismeri a csoportok nevet).
+    /// @param autoCsoport - Autonkent a csoport sorszama (az auto sorszamaval indexelve, < csoportokSzama)
+    /// @param csoportokSzama - A csoportok szama
+    /// @param ki - Az eredmeny (felulirja)
+    void bevetelOsszesites(const uint32_t* autoCsoport, size_t csoportokSzama, BevetelOsszesites& ki) const;
+
+    /// A k legdragabb esemeny a [tol, ig) idoszakban, korlatos kupaccal (O(n log k) ido, O(k) memoria).
+    /// @param k - A keresett esemenyek szama
+    /// @param tipus - Csak ilyen tipusu esemenyek ('J', 'K', 'V'), vagy 0 eseten barmely
+    /// @param tol - Az idoszak eleje (benne van)
+    /// @param ig - Az idoszak vege (nincs benne)
+    /// @param ki - Az esemenyek indexei ar szerint csokkenoen, egyenlo arnal a korabbi index elol (felulirja)
+    void legdragabbak(size_t k, char tipus, const Datum& tol, const Datum& ig, Vector<size_t>& ki) const;
+
+    /// Az esemeny sorszama az autoja szerviztorteneten belul.
+    /// @param esemeny - Az esemeny indexe
+    /// @return - A rekord indexe az auto szervizrekordjai kozott
+    size_t autonBeluliIndex(size_t esemeny) const { return rekordIdk[esemeny]; }
+};
+
+#endif // SZERVIZESEMENYTAR_H
\ No newline at end of file
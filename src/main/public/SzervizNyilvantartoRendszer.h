@@ -11,14 +11,83 @@
 #define SZERVIZNYILVANTARTORENDSZER_H
 
 #include <string>
+#include <vector>
+#include <unordered_map>
 
 #include "Vector.hpp"
 #include "Auto.h"
 #include "Ugyfel.h"
+#include "SzervizEsemenyTar.h"
+#include "EmlekeztetoMotor.h"
+#include "SzalKeszlet.h"
+#include "FigyelmeztetesiSzabalyok.h"
+#include "UgyfelOsszesitok.h"
+#include "TopK.hpp"
+#include "Datum.h"
+
+/// A szerviz CSV import egy elutasitott sora.
+struct ImportHiba {
+	size_t sor;			///< A sor sorszama a bemenetben (1-tol)
+	std::string indok;	///< Az elutasitas oka
+
+	ImportHiba() : sor(0), indok("") {}
+	ImportHiba(size_t s, const std::string& i) : sor(s), indok(i) {}
+};
+
+/// A szerviz CSV import eredmenye.
+struct ImportEredmeny {
+	size_t rogzitett;			///< A rogzitett szervizrekordok szama
+	Vector<ImportHiba> hibak;	///< Az elutasitott sorok, sorszam szerint
+
+	ImportEredmeny() : rogzitett(0), hibak() {}
+};
 
 class SzervizNyilvantartoRendszer {
 	Vector<Auto> autok;			///< Az autok listaja
 	Vector<Ugyfel> ugyfelek;	///< Az ugyfelek listaja
+	mutable std::unordered_map<std::string, size_t> autoIndexek;	///< Rendszam -> az auto indexe az autok tombjeben
+	mutable bool autoIndexekFriss;			///< Hamis, ha a rendszamindexet a kovetkezo lekereskor ujra kell epiteni
+	mutable std::unordered_map<std::string, size_t> ugyfelIndexek;	///< Nev -> az ugyfel indexe az ugyfelek tombjeben
+	mutable std::unordered_map<std::string, std::vector<size_t> > tulajdonosAutoi;	///< Tulajdonos neve -> autoinak indexei, novekvoen
+	mutable bool ugyfelIndexekFriss;		///< Hamis, ha a nev- es tulajdonosindexet a kovetkezo lekereskor ujra kell epiteni
+	mutable SzervizEsemenyTar esemenyTar;	///< Az osszes szervizesemeny oszloposan (flottaszintu osszesitesekhez)
+	mutable bool esemenyTarFriss;			///< Hamis, ha az esemenytarat a kovetkezo lekereskor ujra kell epiteni
+	mutable EmlekeztetoMotor emlekezteto;	///< Az autok kovetkezo esedekessege szerint rendezett kupacok
+	mutable bool emlekeztetoFriss;			///< Hamis, ha az emlekeztetot a kovetkezo lekereskor ujra kell epiteni
+	mutable UgyfelOsszesitok ugyfelOsszesitok;	///< Ugyfelenkenti koltes, autoszam es utolso latogatas
+	mutable bool ugyfelOsszesitokFriss;			///< Hamis, ha az ugyfelosszesitoket a kovetkezo lekereskor ujra kell epiteni
+	FigyelmeztetesiSzabalyok szabalyok;		///< A figyelmeztetesek szabalyai (predikatumtablaba forditva)
+
+	/// Az autokbol szarmaztatott segedstrukturak (rendszamindex, esemenytar, emlekezteto, ugyfelosszesitok) ervenytelenitese.
+	/// A kovetkezo lekereskor egyszer, teljesen ujraepulnek.
+	void szarmaztatottAdatokElavultak() const;
+
+	/// A rendszamindex ujraepitese az autok tombjebol (azonos rendszamnal az elso auto szamit).
+	void autoIndexekUjraepitese() const;
+
+	/// Az autok torlese utan a rendszamindex ertekeinek atszamozasa.
+	/// @param torolt - A torolt autok korabbi indexei novekvo sorrendben
+	void autoIndexekAtszamozasa(const std::vector<size_t>& torolt);
+
+	/// A nevindex es a tulajdonosindex ujraepitese az ugyfelek es az autok tombjebol.
+	void ugyfelIndexekUjraepitese() const;
+
+	/// Egy auto torlese utan a tulajdonosindex atszamozasa (a torolt auto kikerul, a mogotte levok eggyel elore csusznak).
+	/// @param torolt - A torolt auto korabbi indexe
+	/// @param tulajdonos - A torolt auto tulajdonosanak neve (ures, ha nem volt tulajdonosa)
+	void tulajdonosAutoiAtszamozasa(size_t torolt, const std::string& tulajdonos);
+
+	/// Ugyfel hozzafuzese az ugyfelek tombjehez; ha a tomb athelyezodik, az autok tulajdonos-mutatoit atallitja.
+	/// @param u - Az uj ugyfel
+	/// @return - A tombben levo ugyfel referenciaja
+	Ugyfel& ugyfelHozzafuz(const Ugyfel& u);
+
+	/// Az autok tulajdonos-mutatoinak atallitasa, miutan az ugyfelek tombje athelyezodott vagy elemet torolt.
+	/// A regi tombbe mutato tulajdonosok az uj tomb azonos (torles utan eggyel kisebb) indexu elemere mutatnak.
+	/// @param regiAlap - Az ugyfelek tombjenek korabbi kezdocime
+	/// @param regiMeret - Az ugyfelek korabbi szama
+	/// @param torolt - A torolt ugyfel indexe (regiMeret, ha nem tortent torles)
+	void tulajdonosokAtkotese(const Ugyfel* regiAlap, size_t regiMeret, size_t torolt);
 public:
 	/*-------------------------------------------
 			Konstruktorok es destruktor
@@ -54,6 +123,7 @@ public:
 	const Vector<Auto>& getAutok() const;
 
 	/// Visszaadja az osszes ugyfel objektumot.
+	/// A hivo atnevezheti az ugyfeleket, ezert a nev- es tulajdonosindex a kovetkezo lekereskor ujraepul.
 	/// @return - Egy Vector<Ugyfel> peldany, amely az osszes jelenleg nyilvantartott ugyfelet tartalmazza.
 	Vector<Ugyfel>& getUgyfelek();
 
@@ -61,6 +131,38 @@ public:
 	/// @return - Egy const Vector<Ugyfel> peldany, amely az osszes jelenleg nyilvantartott ugyfelet tartalmazza.
 	const Vector<Ugyfel>& getUgyfelek() const;
 
+	/// Visszaadja a flotta szervizesemenyeit oszlopos formaban (pl. eves koltes, atlagos szervizkoz).
+	/// Uj auto, barmely autohoz rogzitett muvelet, muvelet- es autotorles, valamint autofrissites helyben,
+	/// az erintett auto tortenetevel aranyos idoben frissiti; a nem konstans hozzaferes az autokhoz,
+	/// a fajlbetoltes es a CSV import utan a kovetkezo lekereskor ujraepul.
+	/// @return - Az aktualis esemenytar.
+	const SzervizEsemenyTar& getEsemenyTar() const;
+
+	/// Visszaadja a flotta emlekezteto motorjat (pl. "mely autok esedekesek a het vegeig").
+	/// Uj auto, rogzites, km ora frissites es torles helyben, O(log n) idoben frissiti; a nem konstans
+	/// hozzaferes az autokhoz es a fajlbetoltes utan a kovetkezo lekereskor ujraepul.
+	/// @return - Az aktualis emlekezteto motor.
+	const EmlekeztetoMotor& getEmlekezteto() const;
+
+	/// Visszaadja egy ugyfel osszesitett adatait (koltes, autok szama, utolso latogatas).
+	/// Uj auto, rogzites, muvelet- es autotorles helyben frissiti; a nem konstans hozzaferes az autokhoz
+	/// es a fajlbetoltes utan a kovetkezo lekereskor ujraepul.
+	/// @param n - Az ugyfel neve.
+	/// @return - Az osszesito (ismeretlen ugyfelre csupa nulla).
+	const UgyfelOsszesito& getUgyfelOsszesito(const std::string& n) const;
+
+	/// Visszaadja a figyelmeztetesek szabalyait.
+	/// @return - A szabalykeszlet.
+	const FigyelmeztetesiSzabalyok& getFigyelmeztetesiSzabalyok() const;
+
+	/// Az elavult szarmaztatott strukturak (rendszam-, nev- es tulajdonosindex, esemenytar, emlekezteto, ugyfelosszesitok) azonnali ujraepitese.
+	/// Utana a konstans lekerdezesek mar nem irnak a mutable tagokba, igy tobb szalrol parhuzamosan hivhatok.
+	void szarmaztatottAdatokFrissitese() const;
+
+	/// Friss-e minden szarmaztatott struktura (ekkor a konstans lekerdezesek nem irnak a mutable tagokba).
+	/// @return - true, ha egyiket sem kell ujraepiteni
+	bool szarmaztatottAdatokFrissek() const { return autoIndexekFriss && ugyfelIndexekFriss && esemenyTarFriss && emlekeztetoFriss && ugyfelOsszesitokFriss; }
+
 
 
 	/*-------------------------------------------
@@ -87,6 +189,18 @@ public:
 	/// @return - True, ha az auto sikeresen frissitve lett, false, ha nem talalhato.
 	bool frissitAuto(const Auto& a);
 
+	/// A figyelmeztetesek szabalyainak lecserelese (alapertelmezesben FigyelmeztetesiSzabalyok::alapertelmezett()).
+	/// Az emlekezteto motor es a becsultSzervizek is az uj szabalyok szerint szamol.
+	/// @param sz - Az uj szabalykeszlet.
+	void setFigyelmeztetesiSzabalyok(const FigyelmeztetesiSzabalyok& sz);
+
+	/// Egy auto kilometerora allasanak frissitese (csak novelni lehet, lasd Auto::setKmOra).
+	/// Az emlekezteto motort is frissiti.
+	/// @param r - Az auto rendszama.
+	/// @param k - Az uj km ora allas.
+	/// @return - True, ha az auto megtalalhato, false egyebkent.
+	bool frissitKmOra(const std::string& r, int k);
+
 	/// Egy ugyfel adatainak frissitese a rendszeren belul.
 	/// Ha a rendszeren belul mar letezik az ugyfel (nev alapjan), akkor az adatai frissulnek.
 	/// @param u - Az ugyfel uj adatai.
@@ -114,6 +228,9 @@ public:
 	/// @return - True, ha a muvelet sikeresen torolve lett, false, ha az auto vagy a megadott datumu muvelet nem talalhato.
 	bool torolMuvelet(const std::string& r, const Datum& d);
 
+	/// Az adatbazis teljes uritese: torli az osszes autot es ugyfelet, es kiuriti a szarmaztatott strukturakat.
+	void torolMindent();
+
 
 
 	/*-------------------------------------------
@@ -122,9 +239,16 @@ public:
 	// Auto keresese rendszam alapjan.
 	/// @param r - A keresett auto rendszama (teljes egyezes).
 	/// @return - Az auto referenciaja, ha megtalalta.
+	/// A hivo modosithatja az autot, ezert a szarmaztatott adatok elavultnak szamitanak.
 	/// @throw - Hibat dob ha nem talalt meg a kerest rendszamu autot
 	Auto& keresAuto(const std::string& r);
 
+	/// Auto keresese rendszam alapjan (const valtozat, a szarmaztatott adatok frissek maradnak).
+	/// @param r - A keresett auto rendszama (teljes egyezes).
+	/// @return - Az auto konstans referenciaja, ha megtalalta.
+	/// @throw - Hibat dob ha nem talalt meg a kerest rendszamu autot
+	const Auto& keresAuto(const std::string& r) const;
+
 	/// ugyfel keresese nev alapjan.
 	/// @param n - A keresett ugyfel neve (teljes egyezes).
 	/// @return - Az ugyfel referenciaja, ha megtalalta.
@@ -136,11 +260,31 @@ public:
 	/// @return - True, ha az auto megtalalhato a rendszerben, false egyebkent.
 	bool vanAuto(const std::string& r) const;
 
+	/// Az auto indexe az autok tombjeben, a rendszamindexbol (atlagosan O(1)).
+	/// Az index a modositasokkal helyben frissul; a nem konstans hozzaferes az autokhoz es a
+	/// fajlbetoltes utan a kovetkezo lekereskor ujraepul.
+	/// @param r - A keresett auto rendszama (teljes egyezes).
+	/// @return - Az index, vagy az autok szama, ha nem talalhato.
+	size_t autoSorszam(const std::string& r) const;
+
 	/// ugyfel letezesenek ellenorzese nev alapjan.
 	/// @param n - A keresett ugyfel neve (teljes egyezes).
 	/// @return - True, ha az ugyfel megtalalhato a rendszerben, false egyebkent.
 	bool vanUgyfel(const std::string& n) const;
 
+	/// Az ugyfel indexe az ugyfelek tombjeben, a nevindexbol (atlagosan O(1)).
+	/// Az index uj ugyfel es uj auto eseten helyben frissul; torles, a nem konstans hozzaferes az autokhoz
+	/// vagy az ugyfelekhez es a fajlbetoltes utan a kovetkezo lekereskor ujraepul.
+	/// A nev a kulcs: a keresUgyfel altal visszaadott ugyfelet nem szabad atnevezni.
+	/// @param n - A keresett ugyfel neve (teljes egyezes).
+	/// @return - Az index, vagy az ugyfelek szama, ha nem talalhato.
+	size_t ugyfelSorszam(const std::string& n) const;
+
+	/// Az ugyfel autoinak indexei az autok tombjeben, a tulajdonosindexbol.
+	/// @param n - A tulajdonos neve (teljes egyezes).
+	/// @return - Az indexek novekvo sorrendben (ismeretlen vagy auto nelkuli ugyfelre ures).
+	const std::vector<size_t>& tulajdonosAutoSorszamai(const std::string& n) const;
+
 
 
 	/*-------------------------------------------
@@ -152,29 +296,135 @@ public:
 	/// @return - True, ha a muvelet sikeresen rogzitve lett, false, ha az auto nem talalhato.
 	bool rogzitesVegzettMuvelet(const std::string& r, const VegzettMuvelet& m);
 
+	/// Egy vegzett szervizmuvelet rogzitese adott autohoz, rekord formaban.
+	/// @param r - Az auto rendszama.
+	/// @param m - A vegzett szervizmuvelet rekordja.
+	/// @return - True, ha a muvelet sikeresen rogzitve lett, false, ha az auto nem talalhato.
+	bool rogzitesVegzettMuvelet(const std::string& r, const SzervizRekord& m);
+
 	/// Lekerdezi az adott autohoz tartozo szervizmuveleteket.u
 	/// @param os - A kimeneti adatfolyam.
 	/// @param r - Az auto rendszama.
 	void lekeroVegzettMuvelet(std::ostream& os, const std::string& r) const;
 
-	/// Figyelmezteteseket general az auto allapota alapjan.
+	/// Az autok egy lapjanak kiirasa (offset/limit kurzor).
+	/// @param os - A kimeneti adatfolyam (nagy listanal erdemes KimenetiPuffer folyamat adni).
+	/// @param tol - Az elso kiirando auto indexe (az elozo hivas visszateresi erteke, kezdetben 0).
+	/// @param db - Legfeljebb ennyi auto kerul kiirasra.
+	/// @return - A kovetkezo lap kurzora; getAutok().size(), ha nincs tobb auto.
+	size_t listazAutok(std::ostream& os, size_t tol, size_t db) const;
+
+	/// Az ugyfelek egy lapjanak kiirasa (offset/limit kurzor).
+	/// @param os - A kimeneti adatfolyam.
+	/// @param tol - Az elso kiirando ugyfel indexe (kezdetben 0).
+	/// @param db - Legfeljebb ennyi ugyfel kerul kiirasra.
+	/// @return - A kovetkezo lap kurzora; getUgyfelek().size(), ha nincs tobb ugyfel.
+	size_t listazUgyfelek(std::ostream& os, size_t tol, size_t db) const;
+
+	/// Figyelmezteteseket general az auto allapota alapjan, a rendszer szabalyai szerint.
 	/// @param os - A kimeneti adatfolyam.
 	/// @param a - Az auto peldany.
-	void figyelmeztetesek(std::ostream& os, const Auto& a) const;
+	/// @param ma - A referencia datum, amelyhez az eltelt idot merjuk.
+	void figyelmeztetesek(std::ostream& os, const Auto& a, const Datum& ma = Datum(2025, 4, 14)) const;
+
+	/// Az osszes auto figyelmezteteseinek kiertekelese a szalkeszleten, autonkent parhuzamosan.
+	/// A szabalyok ugyanazok, mint a figyelmeztetesek() fuggvenyben; a szervizmuvelet nelkuli autok kimaradnak.
+	/// A Figyelmeztetes::szabaly a getFigyelmeztetesiSzabalyok() keszletbeli sorszam.
+	/// @param ma - A referencia datum, amelyhez az eltelt idot merjuk.
+	/// @param keszlet - A kiertekelest vegzo szalkeszlet.
+	/// @return - A figyelmeztetesek rendszam, azon belul szabaly szerint rendezve.
+	Vector<Figyelmeztetes> flottaFigyelmeztetesek(const Datum& ma = Datum(2025, 4, 14), SzalKeszlet& keszlet = SzalKeszlet::alapertelmezett()) const;
+
+	/// Bevetel osszesitese honaponkent, muvelettipusonkent (J/K/V) es markankent, egyetlen menetben.
+	/// Az esemenytar oszlopain dolgozik, 64 bites osszegekkel es darabszamokkal.
+	/// @return - Az osszesites; a markak nev szerint rendezve, a kulcs a marka neve.
+	BevetelOsszesites bevetelOsszesites() const;
+
+	/// Proaktiv utemezes: mely autok erik el a kovetkezo km alapu szervizhatart a megadott datumig.
+	/// Autonkent O(1): a szerviztortenet futo regressziojabol becsult napi km-bol szamol.
+	/// A hatar ugyanaz, mint az emlekezteto motorban (a szabalyok km kuszobeibol, FigyelmeztetesiSzabalyok::esedekesseg).
+	/// @param ig - Az utolso figyelembe vett nap (bezarolag).
+	/// @return - A becslesek a becsult datum, azon belul rendszam szerint rendezve.
+	Vector<SzervizBecsles> becsultSzervizek(const Datum& ig) const;
+
+	/// Az adott ev k legdragabb szervizmuvelete (alapertelmezes szerint javitasa), korlatos kupaccal.
+	/// @param k - A keresett muveletek szama.
+	/// @param ev - Az ev.
+	/// @param t - A muvelet tipusa.
+	/// @return - A muveletek ar szerint csokkenoen.
+	Vector<RekordTalalat> legdragabbMuveletek(size_t k, int ev, MuveletTipus t = MuveletTipus::Javitas) const;
+
+	/// A k legtobb km-t futott auto. O(n log k).
+	/// @param k - A keresett autok szama.
+	/// @return - (rendszam, km ora) parok km szerint csokkenoen, egyenloseg eseten rendszam szerint.
+	Vector<RangsorTalalat> legtobbKmAutok(size_t k) const;
+
+	/// A k ugyfel, akiknek az autoin a legtobb sikertelen muszaki vizsga tortent.
+	/// A sikertelen vizsga nelkuli ugyfelek nem szerepelnek az eredmenyben.
+	/// @param k - A keresett ugyfelek szama.
+	/// @return - (nev, sikertelen vizsgak szama) parok csokkenoen, egyenloseg eseten nev szerint.
+	Vector<RangsorTalalat> legtobbSikertelenVizsgaUgyfelek(size_t k) const;
 
 
 
 	/*-------------------------------------------
 			 Fajlkezelo tagfuggvenyek
 	-------------------------------------------*/
-	/// Az aktualis rendszeradatok mentese fajlba.
-	/// @param f - A celfajl neve.
+	/// Az aktualis rendszeradatok mentese fajlba. Az adatok ideiglenes fajlba irodnak, ami lemezre
+	/// kenyszerites utan atomi atnevezessel valtja a celfajlt (hiba eseten a regi tartalom megmarad).
+	/// @param f - A celfajl neve ("_ufl.txt" vagy "_auo.txt").
+	/// @throws std::invalid_argument - Ismeretlen fajlformatum eseten.
+	/// @throws std::runtime_error - Ha a fajl nem irhato vagy nem nevezheto at.
 	void mentesFajlba(const std::string& f) const;
 
+	/// Egy ugyfel sora a mentesi formatumban (az ugyfelfajlba).
+	/// @param os - A kimeneti adatfolyam.
+	/// @param u - Az ugyfel.
+	static void mentesSor(std::ostream& os, const Ugyfel& u);
+
+	/// Egy auto sora a mentesi formatumban (az autofajlba).
+	/// @param os - A kimeneti adatfolyam.
+	/// @param a - Az auto (a tulajdonosa nem lehet nullptr).
+	static void mentesSor(std::ostream& os, const Auto& a);
+
 	/// Rendszeradatok betoltese fajlbol.
 	/// @param f - A forrasfajl neve.
 	void betoltesFajlbol(const std::string& f);
 
+	/// Az adatbazis ujratoltese: torolMindent(), majd az ugyfel- es az autofajl betoltese.
+	/// @param ufl - Az ugyfelfajl neve ("_ufl.txt").
+	/// @param auo - Az autofajl neve ("_auo.txt").
+	void ujratoltes(const std::string& ufl, const std::string& auo);
+
+	/// Szervizrekordok tomeges importja CSV fajlbol (lasd szervizImportCsv(std::istream&)).
+	/// @param f - A CSV fajl neve.
+	/// @return - A rogzitett rekordok szama es az elutasitott sorok.
+	ImportEredmeny szervizImportCsv(const std::string& f);
+
+	/// Szervizrekordok tomeges importja CSV adatfolyambol.
+	/// Sorformatum: "rendszam,tipus,datum,leiras,ar,km[,sikeres]" (tipus: J/K/V, sikeres: 0/1); a mezok
+	/// idezojelek koze is tehetok. Az elso sor fejlec is lehet, ha "rendszam"-mal kezdodik.
+	/// A sorok ertelmezese es ellenorzese egyben (nagy bemenetnel parhuzamosan) tortenik, a rekordok
+	/// autonkent datum szerint rendezve fuzodnek hozza az autok tortenetehez; a szarmaztatott adatok
+	/// csak a vegen, egyszer avulnak el. Elutasitott sor: hibas formatum vagy rendszam, ismeretlen auto,
+	/// az auto utolso szervizenel korabbi datum, vagy az elozo rekordnal kisebb km ora allas.
+	/// Az auto km oraja a legnagyobb rogzitett allasra no. A tobbi sor az elutasitottaktol fuggetlenul bekerul.
+	/// @param be - A bemenet.
+	/// @return - A rogzitett rekordok szama es az elutasitott sorok.
+	ImportEredmeny szervizImportCsv(std::istream& be);
+
+	/// Ellenorzi a rendszam formatumat (harom nagybetu, majd harom szamjegy).
+	/// @param r - A rendszam.
+	/// @return - true, ha a formatum helyes.
+	static bool helyesRendszam(const std::string& r);
+
+	/// Ellenorzi, hogy a szoveg beirhato-e a mentesi formatum egy mezojebe: nem tartalmazhatja
+	/// a '-' (sormezo), ';' (muvelet), ':' es ',' (muveletmezo) hataroloit, sem a szokozt jelolo '_'-t
+	/// es sortorest. Az e-mail cim kivetel: a sor utolso mezojekent valtozatlanul mentodik.
+	/// @param s - A szoveg.
+	/// @return - true, ha a szoveg visszaolvashato a mentett fajlbol.
+	static bool helyesSzoveg(const std::string& s);
+
 	/**
 	 * Fontos tudnivalok a fajlkezelo fuggvenyek mukodeserol:
 	 *
@@ -0,0 +1,90 @@
+/**
+*   \file SzervizRekord.h
+*   Egy elvegzett szervizmuveletet leiro, ertek szerint tarolt rekord deklaracioja.
+*
+*   A Javitas, Karbantartas es Vizsga osztalyok csak a tipusukban es a vizsga sikeressegeben kulonboznek,
+*   ezert az autok a szerviztortenetet ilyen rekordok folytonos tombjeben taroljak (nincs kulon heap foglalas
+*   es virtualis hivas muveletenkent). A VegzettMuvelet hierarchia kompatibilitasi feluletkent megmaradt.
+*
+*   Az osztalyban szereplo osszes std::string tipusu adattag feltetelezi, hogy nem kell ekezetes betuket kezelnie.
+*/
+
+#ifndef SZERVIZREKORD_H
+#define SZERVIZREKORD_H
+
+#include <string>
+#include <iostream>
+
+#include "Datum.h"
+#include "MuveletTipus.h"
+#include "Vector.hpp"
+
+class VegzettMuvelet;
+
+struct SzervizRekord {
+    std::string muvelet;    ///< A muvelet megnevezese
+    Datum idopont;          ///< A muvelet idopontja
+    int ar;                 ///< A muvelet ara
+    int akt_kmOra;          ///< Az aktualis kilometerora allas
+    MuveletTipus tipus;     ///< A muvelet tipusa (J/K/V)
+    bool sikeres;           ///< A vizsga sikeressege (csak Vizsga tipus eseten ertelmezett)
+
+    /*-------------------------------------------
+                  Konstruktorok
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor
+    SzervizRekord() : muvelet(""), idopont(), ar(0), akt_kmOra(0), tipus(MuveletTipus::Javitas), sikeres(false) {}
+
+    /// Parameteres konstruktor
+    /// @param t - A muvelet tipusa
+    /// @param m - Muvelet neve
+    /// @param d - Muvelet idopontja
+    /// @param a - Muvelet ara
+    /// @param k - Aktualis km ora allas
+    /// @param s - Vizsga sikeressege (a tobbi tipusnal figyelmen kivul marad)
+    SzervizRekord(MuveletTipus t, const std::string& m, const Datum& d, int a, int k, bool s = false)
+        : muvelet(m), idopont(d), ar(a), akt_kmOra(k), tipus(t), sikeres(t == MuveletTipus::Vizsga && s) {}
+
+
+
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Kiirja a rekordot ugyanabban a formaban, mint a megfelelo VegzettMuvelet leszarmazott.
+    /// @param os - A kimeneti stream
+    void kiir(std::ostream& os) const;
+
+    /// Letrehozza a rekordnak megfelelo polimorf objektumot (kompatibilitasi felulet).
+    /// @return - Uj, dinamikusan foglalt Javitas, Karbantartas vagy Vizsga peldany; a hivo szabaditja fel.
+    VegzettMuvelet* toVegzettMuvelet() const;
+
+    /// A rekord kiirasa a mentesi fajlformatumban ("tipus:leiras,datum,ar,kmora[,extra]").
+    /// @param os - A kimeneti stream
+    void mentes(std::ostream& os) const;
+
+
+
+    /*-------------------------------------------
+            Kozos mentesi segedfuggvenyek
+    -------------------------------------------*/
+    /// A minden muvelettipusnal kozos mezok kiirasa ("tipus:leiras,datum,ar,kmora").
+    /// A leirasban a szokozok alahuzaskent kerulnek a fajlba.
+    /// @param os - A kimeneti stream
+    /// @param t - A muvelet tipusa
+    /// @param m - Muvelet neve
+    /// @param d - Muvelet idopontja
+    /// @param a - Muvelet ara
+    /// @param k - Aktualis km ora allas
+    static void alapMezokMentese(std::ostream& os, MuveletTipus t, const std::string& m, const Datum& d, int a, int k);
+
+    /// A vizsga eredmenyenek kiirasa extra mezokent (",sikeres" vagy ",sikertelen").
+    /// @param os - A kimeneti stream
+    /// @param s - A vizsga sikeressege
+    static void vizsgaEredmenyMentese(std::ostream& os, bool s);
+};
+
+/// Egy auto szerviztortenete: a rekordok egyetlen folytonos tombben.
+/// Kis kezdokapacitassal, mert egy autohoz jellemzoen csak nehany szervizmuvelet tartozik.
+typedef Vector<SzervizRekord, 4> SzervizRekordLista;
+
+#endif // SZERVIZREKORD_H
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**
+*   \file SzervizTortenet.h
+*   Egy auto szerviztortenetet tarolo, referenciaszamlalt, copy-on-write leiro osztaly deklaracioja.
+*
+*   A masolas O(1): a masolatok ugyanarra a rekordlistara mutatnak, es csak egy szamlalo no.
+*   A lista csak akkor masolodik le, ha egy megosztott tortenetet modositanak (push_back, erase, modosit).
+*   Az ures tortenet nem foglal memoriat. A szamlalo atomi, igy a kulonbozo szalakon levo masolatok
+*   masolasa es megszuntetese biztonsagos.
+*
+*   A blokk a rekordok km ora allasainak futo regresszios osszegeit is tartja (KmRegresszio): push_back
+*   es erase novekmenyesen frissiti, a modosit() utan pedig az elso lekerdezes szamolja ujra. A modosit()
+*   hivoi a lista kitoltese utan egyszer lekerdezik, igy a kesz tortenetek olvasasa sosem ir a blokkba.
+*/
+
+#ifndef SZERVIZTORTENET_H
+#define SZERVIZTORTENET_H
+
+#include <atomic>
+
+#include "SzervizRekord.h"
+#include "KmRegresszio.h"
+
+class SzervizTortenet {
+    /// A megosztott adat: a rekordlista es a ra hivatkozo leirok szama.
+    struct Blokk {
+        std::atomic<int> hivatkozasok;  ///< Hany SzervizTortenet mutat erre a blokkra
+        SzervizRekordLista rekordok;    ///< A szervizrekordok idorendben
+        mutable KmRegresszio regresszio;///< A rekordok (datum, km) pontjainak futo osszegei
+        mutable bool regresszioFriss;   ///< Naprakesz-e a regresszio (modosit() utan hamis)
+
+        Blokk() : hivatkozasok(1), rekordok(), regresszio(), regresszioFriss(true) {}
+        explicit Blokk(const SzervizRekordLista& l) : hivatkozasok(1), rekordok(l), regresszio(), regresszioFriss(true) {
+            for (size_t i = 0; i < rekordok.size(); i++)
+                regresszio.hozzaad(rekordok[i].idopont.getNapSorszam(), rekordok[i].akt_kmOra);
+        }
+    };
+
+    Blokk* blokk; ///< A megosztott blokk, vagy nullptr ures tortenet eseten
+
+    /// Elengedi a blokkot; az utolso hivatkozo felszabaditja.
+    void elenged();
+
+    /// Biztositja, hogy a blokk csak ehhez a leirohoz tartozzon (szukseg eseten lemasolja).
+    /// @return - A sajat, modosithato blokk
+    Blokk* sajatBlokk();
+public:
+    /*-------------------------------------------
+            Konstruktorok es destruktor
+    -------------------------------------------*/
+    /// Alapertelmezett konstruktor. Ures tortenet, foglalas nelkul.
+    SzervizTortenet();
+
+    /// Konstruktor egy meglevo rekordlistabol (a lista egyszer masolodik).
+    /// @param l - A rekordok listaja
+    explicit SzervizTortenet(const SzervizRekordLista& l);
+
+    /// Masolo konstruktor. O(1), a blokk megosztva marad.
+    /// @param t - Masolando tortenet
+    SzervizTortenet(const SzervizTortenet& t);
+
+    /// Destruktor.
+    ~SzervizTortenet();
+
+
+
+    /*-------------------------------------------
+                    Operatorok
+    -------------------------------------------*/
+    /// Ertekado operator. O(1), a blokk megosztva marad.
+    /// @param t - Masolando tortenet
+    /// @return - Az aktualis objektum referenciaja
+    SzervizTortenet& operator=(const SzervizTortenet& t);
+
+    /// Konstans indexelo operator
+    /// @param idx - Index
+    /// @return - Az adott indexu rekord
+    /// @note - Nincs hatarellenorzes!
+    const SzervizRekord& operator[](size_t idx) const { return blokk->rekordok[idx]; }
+
+
+
+    /*-------------------------------------------
+                  Lekerdezesek
+    -------------------------------------------*/
+    /// A rekordok listaja (csak olvasasra).
+    /// @return - A rekordlista konstans referenciaja
+    const SzervizRekordLista& lista() const;
+
+    /// A rekordok szama.
+    /// @return - size_t
+    size_t size() const { return blokk == nullptr ? 0 : blokk->rekordok.size(); }
+
+    /// Ures-e a tortenet.
+    /// @return - true, ha nincs rekord
+    bool empty() const { return size() == 0; }
+
+    /// Megosztott-e a tortenet mas leirokkal (tesztelesi es diagnosztikai celra).
+    /// @return - true, ha legalabb ket leiro mutat ugyanarra a blokkra
+    bool megosztott() const { return blokk != nullptr && blokk->hivatkozasok.load() > 1; }
+
+    /// A rekordok km ora allasainak regresszioja (O(1), a modosit() utani elso hivaskor O(n)).
+    /// @return - A regresszio konstans referenciaja
+    /// @note - A modosit() utani elso hivas ir a blokkba, ezert azt nem szabad parhuzamosan hivni.
+    const KmRegresszio& kmRegresszio() const;
+
+
+
+    /*-------------------------------------------
+                Modosito muveletek
+    -------------------------------------------*/
+    /// Rekord hozzafuzese a vegere (megosztott tortenetnel elotte lemasolja a listat).
+    /// @param r - A hozzaadando rekord
+    void push_back(const SzervizRekord& r);
+
+    /// Rekord torlese index alapjan (megosztott tortenetnel elotte lemasolja a listat).
+    /// @param idx - A torlendo rekord indexe
+    /// @throws - std::out_of_range Ha az index ervenytelen
+    void erase(size_t idx);
+
+    /// Modosithato hozzaferes a rekordlistahoz (megosztott tortenetnel elotte lemasolja).
+    /// @return - A sajat rekordlista referenciaja
+    SzervizRekordLista& modosit();
+
+    /// Az osszes rekord torlese.
+    void clear();
+};
+
+#endif // SZERVIZTORTENET_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+*   \file TopK.hpp
+*   Korlatos meretu kupacon alapulo "legjobb k elem" gyujto sablon osztaly.
+*
+*   A gyujto legfeljebb k elemet tart egy min-kupacban (a kupac tetejen a jelenleg k. legjobb elem all).
+*   Egy uj elem csak akkor kerul be, ha jobb a kupac tetejenel, igy n elem feldolgozasa O(n log k)
+*   ideju es O(k) memoriaju, fuggetlenul n-tol.
+*/
+
+#ifndef TOPK_HPP
+#define TOPK_HPP
+
+#ifdef MEMTRACE
+#include "Memtrace.h"
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "Vector.hpp"
+#include "SzervizRekord.h"
+
+/// Legjobb k elem gyujtese korlatos kupaccal.
+/// @tparam T A gyujtott elemek tipusa.
+/// @tparam Kisebb Rendezes: Kisebb()(a, b) igaz, ha a rosszabb b-nel (alapertelmezes: a nagyobb a jobb).
+template <typename T, typename Kisebb = std::less<T> >
+class TopK {
+    /// A kupac rendezese: a kupac tetejen a legrosszabb megtartott elem all.
+    struct KupacRend {
+        Kisebb kisebb;
+        explicit KupacRend(const Kisebb& k) : kisebb(k) {}
+        bool operator()(const T& a, const T& b) const { return kisebb(b, a); }
+    };
+
+    size_t k;           ///< A megtartott elemek legnagyobb szama
+    Vector<T> kupac;    ///< A megtartott elemek (min-kupac a rendezes szerint)
+    KupacRend rend;     ///< A kupac osszehasonlitoja
+public:
+    /// Konstruktor.
+    /// @param k - A megtartando elemek szama
+    /// @param kisebb - Az osszehasonlito
+    explicit TopK(size_t k, const Kisebb& kisebb = Kisebb()) : k(k), kupac(), rend(kisebb) {
+        kupac.reserve(k);
+    }
+
+    /// Egy elem felajanlasa; bekerul, ha a jelenlegi k legjobb koze tartozik. O(log k).
+    /// @param x - Az elem
+    void ajanl(const T& x) {
+        if (k == 0) return;
+        if (kupac.size() < k) {
+            kupac.push_back(x);
+            std::push_heap(kupac.begin(), kupac.end(), rend);
+        }
+        else if (rend.kisebb(kupac[0], x)) {
+            std::pop_heap(kupac.begin(), kupac.end(), rend);
+            kupac[kupac.size() - 1] = x;
+            std::push_heap(kupac.begin(), kupac.end(), rend);
+        }
+    }
+
+    /// A jelenleg megtartott elemek szama.
+    /// @return - size_t (legfeljebb k)
+    size_t size() const { return kupac.size(); }
+
+    /// A megtartott elemek a legjobbtol a legrosszabbig rendezve. O(k log k).
+    /// @return - Az elemek rendezett masolata
+    Vector<T> eredmeny() const {
+        Vector<T> ki(kupac);
+        std::sort(ki.begin(), ki.end(), rend);
+        return ki;
+    }
+};
+
+/// Egy rangsor eleme (pl. rendszam es km ora allas, ugyfel neve es sikertelen vizsgak szama).
+struct RangsorTalalat {
+    std::string kulcs;  ///< A rangsorolt elem neve
+    long long ertek;    ///< A rangsorolas alapja (a nagyobb a jobb)
+
+    RangsorTalalat() : kulcs(""), ertek(0) {}
+    RangsorTalalat(const std::string& k, long long e) : kulcs(k), ertek(e) {}
+
+    /// Rendezes a TopK-hoz: a kisebb ertek a rosszabb, egyenlo erteknel a nev szerint hatrabb levo.
+    struct Rosszabb {
+        bool operator()(const RangsorTalalat& a, const RangsorTalalat& b) const {
+            return a.ertek != b.ertek ? a.ertek < b.ertek : a.kulcs > b.kulcs;
+        }
+    };
+};
+
+/// Egy szervizmuvelet a rangsorban, az autoja rendszamaval.
+struct RekordTalalat {
+    std::string rendszam;   ///< Az auto rendszama
+    SzervizRekord rekord;   ///< A szervizmuvelet
+
+    RekordTalalat() : rendszam(""), rekord() {}
+    RekordTalalat(const std::string& r, const SzervizRekord& sz) : rendszam(r), rekord(sz) {}
+};
+
+#endif // TOPK_HPP
\ No newline at end of file
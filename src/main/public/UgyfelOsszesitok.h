@@ -0,0 +1,105 @@
+/**
+*   \file UgyfelOsszesitok.h
+*   Az ugyfelenkenti osszesitett adatokat (koltes, autok szama, utolso latogatas) nyilvantarto osztaly deklaracioja.
+*
+*   Az osszesitok az ugyfel neve szerinti hasitotablaban vannak, es minden auto- vagy muveletvaltozaskor
+*   csak az erintett ugyfel bejegyzese modosul. Az utolso latogatashoz ugyfelenkent a szervizdatumok
+*   darabszama is nyilvan van tartva, igy a legutolso muvelet torlese utan sem kell ujraszamolni.
+*/
+
+#ifndef UGYFELOSSZESITOK_H
+#define UGYFELOSSZESITOK_H
+
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "Datum.h"
+#include "SzervizRekord.h"
+
+class Auto;
+
+/// Egy ugyfel osszesitett adatai.
+struct UgyfelOsszesito {
+    long long koltes;           ///< Az ugyfel autoin vegzett osszes szervizmuvelet ara
+    size_t autokSzama;          ///< Az ugyfel autoinak szama
+    size_t muveletekSzama;      ///< Az ugyfel autoin vegzett szervizmuveletek szama
+    Datum utolsoLatogatas;      ///< A legutolso szervizmuvelet datuma (csak ha muveletekSzama > 0)
+
+    UgyfelOsszesito() : koltes(0), autokSzama(0), muveletekSzama(0), utolsoLatogatas() {}
+};
+
+class UgyfelOsszesitok {
+    /// Egy ugyfel bejegyzese: az osszesito es a szervizdatumok darabszama.
+    struct Bejegyzes {
+        UgyfelOsszesito osszesito;          ///< A lekerdezheto osszesito
+        std::map<int32_t, size_t> napok;    ///< Szervizdatum (napsorszam) -> muveletek szama aznap
+    };
+
+    std::unordered_map<std::string, Bejegyzes> ugyfelek;   ///< Ugyfel neve -> bejegyzes
+
+    /// A bejegyzes utolso latogatasanak frissitese a datumok alapjan.
+    /// @param b - A bejegyzes
+    static void utolsoFrissit(Bejegyzes& b);
+
+    /// Egy muvelet hozzaadasa a bejegyzeshez (az utolso latogatas frissitese nelkul).
+    /// @param b - A bejegyzes
+    /// @param r - A szervizrekord
+    static void muveletHozzaad(Bejegyzes& b, const SzervizRekord& r);
+
+    /// Egy muvelet elvetele a bejegyzesbol (az utolso latogatas frissitese nelkul).
+    /// @param b - A bejegyzes
+    /// @param r - A szervizrekord
+    static void muveletElvesz(Bejegyzes& b, const SzervizRekord& r);
+
+public:
+    /*-------------------------------------------
+                Fontos tagmuveletek
+    -------------------------------------------*/
+    /// Az osszes bejegyzes torlese.
+    void torol();
+
+    /// Ujraepiti az osszesitoket az autok alapjan (O(osszes muvelet)).
+    /// @param autok - A rendszer autoi
+    void ujraepit(const Vector<Auto>& autok);
+
+    /// Egy auto es teljes szerviztortenetenek hozzaadasa a tulajdonosahoz.
+    /// @param a - Az auto (tulajdonos nelkul nincs hatasa)
+    void autoHozzaad(const Auto& a);
+
+    /// Egy auto es teljes szerviztortenetenek elvetele a tulajdonosatol.
+    /// @param a - Az auto (tulajdonos nelkul nincs hatasa)
+    void autoElvesz(const Auto& a);
+
+    /// Egy szervizmuvelet hozzaadasa az ugyfelhez.
+    /// @param nev - Az ugyfel neve
+    /// @param r - A szervizrekord
+    void rekordHozzaad(const std::string& nev, const SzervizRekord& r);
+
+    /// Egy szervizmuvelet elvetele az ugyfeltol.
+    /// @param nev - Az ugyfel neve
+    /// @param r - A szervizrekord
+    void rekordElvesz(const std::string& nev, const SzervizRekord& r);
+
+    /// Egy ugyfel bejegyzesenek torlese.
+    /// @param nev - Az ugyfel neve
+    void ugyfelTorol(const std::string& nev);
+
+
+
+    /*-------------------------------------------
+                  Lekerdezesek
+    -------------------------------------------*/
+    /// Az ugyfel osszesitoje (O(1)).
+    /// @param nev - Az ugyfel neve
+    /// @return - Az osszesito (ismeretlen vagy auto nelkuli ugyfelre csupa nulla)
+    const UgyfelOsszesito& lekerdez(const std::string& nev) const;
+
+    /// A nyilvantartott ugyfelek szama.
+    /// @return - size_t
+    size_t meret() const { return ugyfelek.size(); }
+};
+
+#endif // UGYFELOSSZESITOK_H
\ No newline at end of file
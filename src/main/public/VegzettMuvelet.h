@@ -9,8 +9,10 @@
 #define VEGZETTMUVELET_H 
 
 #include <string>
+#include <iostream>
 
 #include "Datum.h"
+#include "SzervizRekord.h"
 
 class VegzettMuvelet {
     std::string muvelet;    ///< A muvelet megnevezese  
@@ -108,6 +110,28 @@ public:
     /// @return - Egy uj VegzettMuvelet pointer, amely a masolt objektumot reprezentalja
     virtual VegzettMuvelet* clone() const = 0;
 
+    /// Ertek szerinti rekordda alakito fuggveny (virtualis, tisztan absztrakt)
+    /// Az autok a szerviztortenetet ilyen rekordokkent taroljak.
+    /// @return - A muveletnek megfelelo SzervizRekord
+    virtual SzervizRekord toRekord() const = 0;
+
+    /// A muvelet tipusanak lekerdezese (virtualis, tisztan absztrakt)
+    /// @return - A leszarmazottnak megfelelo MuveletTipus
+    virtual MuveletTipus getTipus() const = 0;
+
+    /// A tipusfuggo extra mezok fajlba irasa (egyetlen virtualis hivas muveletenkent).
+    /// Alapertelmezetten nincs extra mezo; uj muvelettipus ezt definialja felul, ha kell.
+    /// @param os - A kimeneti stream
+    virtual void mentesExtra(std::ostream& os) const { (void)os; }
+
+    /// A muvelet kiirasa a mentesi fajlformatumban ("tipus:leiras,datum,ar,kmora[,extra]").
+    /// A tipus a getTipus()-bol, az extra mezok a mentesExtra()-bol jonnek, RTTI nelkul.
+    /// @param os - A kimeneti stream
+    void mentes(std::ostream& os) const {
+        SzervizRekord::alapMezokMentese(os, getTipus(), muvelet, idopont, ar, akt_kmOra);
+        mentesExtra(os);
+    }
+
     /// Virtualis destruktor
     virtual ~VegzettMuvelet() = default;
 };
@@ -81,6 +81,22 @@ public:
         return new Vizsga(*this);
     }
 
+    /// Ertek szerinti rekordda alakito fuggveny feluldefinialasa
+    /// @return - A muveletnek megfelelo SzervizRekord
+    SzervizRekord toRekord() const override {
+        return SzervizRekord(MuveletTipus::Vizsga, getMuvelet(), getDatum(), getAr(), getAktKmOra(), sikeres);
+    }
+
+    /// Tipuslekerdezo fuggveny feluldefinialasa
+    /// @return - MuveletTipus::Vizsga
+    MuveletTipus getTipus() const override { return MuveletTipus::Vizsga; }
+
+    /// Extra mezo mentese: a vizsga eredmenye
+    /// @param os - kimeneti stream
+    void mentesExtra(std::ostream& os) const override {
+        SzervizRekord::vizsgaEredmenyMentese(os, sikeres);
+    }
+
     /// Kiiro fuggveny feluldefinialasa
     /// @param os - kimeneti stream
     void kiir(std::ostream& os) const override {
@@ -89,7 +105,7 @@ public:
             << ", Ar: " << getAr()
             << " Ft, Sikeres: " << (sikeres ? "igen" : "nem")
             << ", Akt. km: " << getAktKmOra()
-            << std::endl;
+            << '\n';
     }
 };
 